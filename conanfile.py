@@ -64,6 +64,7 @@ class ErpProcessingContext(ConanFile):
     exports_sources = "."
     requires = [
         'antlr4-cppruntime/4.13.2',
+        'benchmark/1.9.4',
         'boost/1.90.0',
         'botan/3.11.1',
         'date/3.0.4',  # date can be removed as soon as we use C++20
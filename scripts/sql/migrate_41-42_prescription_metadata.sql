@@ -0,0 +1,28 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+BEGIN;
+
+CALL erp.expect_version('41');
+CALL erp.set_version('42');
+
+-- Encrypted metadata of the signed prescription (message digest), written by $activate.
+ALTER TABLE erp.task ADD COLUMN IF NOT EXISTS prescription_metadata BYTEA;
+ALTER TABLE erp.task_162 ADD COLUMN IF NOT EXISTS prescription_metadata BYTEA;
+ALTER TABLE erp.task_166 ADD COLUMN IF NOT EXISTS prescription_metadata BYTEA;
+ALTER TABLE erp.task_169 ADD COLUMN IF NOT EXISTS prescription_metadata BYTEA;
+ALTER TABLE erp.task_200 ADD COLUMN IF NOT EXISTS prescription_metadata BYTEA;
+ALTER TABLE erp.task_209 ADD COLUMN IF NOT EXISTS prescription_metadata BYTEA;
+
+ALTER TABLE erp.task ALTER COLUMN prescription_metadata SET STORAGE PLAIN;
+ALTER TABLE erp.task_162 ALTER COLUMN prescription_metadata SET STORAGE PLAIN;
+ALTER TABLE erp.task_166 ALTER COLUMN prescription_metadata SET STORAGE PLAIN;
+ALTER TABLE erp.task_169 ALTER COLUMN prescription_metadata SET STORAGE PLAIN;
+ALTER TABLE erp.task_200 ALTER COLUMN prescription_metadata SET STORAGE PLAIN;
+ALTER TABLE erp.task_209 ALTER COLUMN prescription_metadata SET STORAGE PLAIN;
+
+COMMIT;
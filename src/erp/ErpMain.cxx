@@ -401,7 +401,7 @@ bool ErpMain::waitForHealthUp (PcServiceContext& serviceContext)
         if (loopCount % loopHealthCheckInterval == 0)
         {
             TVLOG(1) << "running health check";
-            HealthCheck::update(serviceContext);
+            serviceContext.healthCheck().update();
         }
         healthCheckIsUp = serviceContext.applicationHealth().isUp();
         if (healthCheckIsUp)
@@ -0,0 +1,325 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "erp/database/AuditEventWriter.hxx"
+#include "erp/database/Database.hxx"
+#include "shared/util/Configuration.hxx"
+#include "shared/util/Demangle.hxx"
+#include "shared/util/Expect.hxx"
+#include "shared/util/TLog.hxx"
+
+#include <algorithm>
+#include <gsl/gsl-lite.hpp>
+#include <magic_enum/magic_enum.hpp>
+#include <utility>
+
+
+AuditEventWriter::AuditEventWriter(DatabaseFactory databaseFactory, size_t capacity, size_t maxBatchSize)
+    : mDatabaseFactory(std::move(databaseFactory))
+    , mCapacity(std::max<size_t>(capacity, 1))
+    , mMaxBatchSize(std::max<size_t>(maxBatchSize, 1))
+{
+    Expect3(mDatabaseFactory != nullptr, "database factory is missing", std::logic_error);
+}
+
+
+AuditEventWriter::~AuditEventWriter()
+{
+    stop();
+}
+
+
+std::unique_ptr<AuditEventWriter> AuditEventWriter::fromConfiguration(const Configuration& configuration,
+                                                                      DatabaseFactory databaseFactory)
+{
+    if (! configuration.getBoolValue(ConfigurationKey::SERVICE_AUDIT_EVENT_ASYNC_WRITE))
+    {
+        return nullptr;
+    }
+    auto writer = std::make_unique<AuditEventWriter>(
+        std::move(databaseFactory),
+        gsl::narrow<size_t>(configuration.getIntValue(ConfigurationKey::SERVICE_AUDIT_EVENT_QUEUE_SIZE)),
+        gsl::narrow<size_t>(configuration.getIntValue(ConfigurationKey::SERVICE_AUDIT_EVENT_BATCH_SIZE)));
+    writer->start();
+    return writer;
+}
+
+
+void AuditEventWriter::start()
+{
+    std::lock_guard lock{mMutex};
+    if (mRunning)
+    {
+        return;
+    }
+    mStopRequested = false;
+    mRunning = true;
+    mWriterThread = std::thread{&AuditEventWriter::run, this};
+}
+
+
+void AuditEventWriter::stop()
+{
+    std::thread writerThread;
+    {
+        std::lock_guard lock{mMutex};
+        if (! mRunning)
+        {
+            return;
+        }
+        mRunning = false;
+        mStopRequested = true;
+        writerThread = std::move(mWriterThread);
+    }
+    mWakeUp.notify_all();
+    writerThread.join();
+}
+
+
+AuditEventWriter::Reservation::Reservation(AuditEventWriter& writer)
+    : mWriter(&writer)
+{
+}
+
+
+AuditEventWriter::Reservation::~Reservation()
+{
+    release();
+}
+
+
+AuditEventWriter::Reservation::Reservation(Reservation&& other) noexcept
+    : mWriter(std::exchange(other.mWriter, nullptr))
+{
+}
+
+
+AuditEventWriter::Reservation& AuditEventWriter::Reservation::operator=(Reservation&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        mWriter = std::exchange(other.mWriter, nullptr);
+    }
+    return *this;
+}
+
+
+void AuditEventWriter::Reservation::enqueue(model::AuditData&& auditData)
+{
+    auto* writer = std::exchange(mWriter, nullptr);
+    Expect3(writer != nullptr, "audit event reservation has already been used", std::logic_error);
+    {
+        std::lock_guard lock{writer->mMutex};
+        --writer->mReserved;
+        if (writer->mRunning)
+        {
+            writer->mQueue.emplace_back(std::move(auditData));
+            writer->mWakeUp.notify_one();
+            return;
+        }
+    }
+    TLOG(WARNING) << "audit event writer has been stopped, writing record synchronously";
+    std::vector<model::AuditData> records;
+    records.emplace_back(std::move(auditData));
+    writer->dropRecords(writer->writeSingleRecords(records));
+}
+
+
+void AuditEventWriter::Reservation::release()
+{
+    if (mWriter != nullptr)
+    {
+        std::lock_guard lock{mWriter->mMutex};
+        --mWriter->mReserved;
+        mWriter = nullptr;
+    }
+}
+
+
+AuditEventWriter::Reservation AuditEventWriter::reserve()
+{
+    std::lock_guard lock{mMutex};
+    ErpExpect(mRunning, HttpStatus::ServiceUnavailable, "audit event writer is not running");
+    if (mQueue.size() + mReserved >= mCapacity)
+    {
+        TLOG(WARNING) << "audit event queue is full, rejecting request";
+        ErpFail(HttpStatus::ServiceUnavailable, "audit event queue is full");
+    }
+    ++mReserved;
+    return Reservation{*this};
+}
+
+
+void AuditEventWriter::enqueue(model::AuditData&& auditData)
+{
+    reserve().enqueue(std::move(auditData));
+}
+
+
+void AuditEventWriter::healthCheck() const
+{
+    const auto failedRecords = mFailedRecords.load(std::memory_order_relaxed);
+    Expect3(failedRecords == 0, std::to_string(failedRecords) + " audit event records could not be written",
+            std::runtime_error);
+}
+
+
+size_t AuditEventWriter::queueSize() const
+{
+    std::lock_guard lock{mMutex};
+    return mQueue.size();
+}
+
+
+uint64_t AuditEventWriter::writtenRecords() const
+{
+    return mWrittenRecords.load(std::memory_order_relaxed);
+}
+
+
+uint64_t AuditEventWriter::failedRecords() const
+{
+    return mFailedRecords.load(std::memory_order_relaxed);
+}
+
+
+uint64_t AuditEventWriter::droppedRecords() const
+{
+    return mDroppedRecords.load(std::memory_order_relaxed);
+}
+
+
+void AuditEventWriter::run()
+{
+    ThreadNames::instance().setCurrentThreadName("audit-event-writer");
+    std::vector<model::AuditData> batch;
+    std::unique_lock lock{mMutex};
+    for (;;)
+    {
+        mWakeUp.wait(lock, [this] {
+            return mStopRequested || ! mQueue.empty();
+        });
+        // the queue is drained before the thread ends
+        if (mQueue.empty())
+        {
+            return;
+        }
+        const auto count = std::min(mQueue.size(), mMaxBatchSize);
+        batch.reserve(count);
+        // AuditData is not assignable, records are moved one by one
+        for (size_t index = 0; index < count; ++index)
+        {
+            batch.emplace_back(std::move(mQueue.front()));
+            mQueue.pop_front();
+        }
+        lock.unlock();
+        auto failed = writeBatch(batch);
+        batch.clear();
+        lock.lock();
+        if (failed.empty())
+        {
+            continue;
+        }
+        if (mStopRequested)
+        {
+            lock.unlock();
+            dropRecords(failed);
+            lock.lock();
+            continue;
+        }
+        // keep the order of the records, the failed records are retried first
+        for (auto record = failed.rbegin(); record != failed.rend(); ++record)
+        {
+            mQueue.emplace_front(std::move(*record));
+        }
+        TLOG(ERROR) << failed.size() << " audit event records could not be written, retrying in "
+                    << failedRecordsRetryDelay.count() << "s";
+        mWakeUp.wait_for(lock, failedRecordsRetryDelay, [this] {
+            return mStopRequested;
+        });
+    }
+}
+
+
+std::vector<model::AuditData> AuditEventWriter::writeBatch(std::vector<model::AuditData>& batch)
+{
+    for (size_t attempt = 1; attempt <= maxWriteAttempts; ++attempt)
+    {
+        try
+        {
+            write(batch, 0, batch.size());
+            mWrittenRecords.fetch_add(batch.size(), std::memory_order_relaxed);
+            mFailedRecords.store(0, std::memory_order_relaxed);
+            TVLOG(1) << "written " << batch.size() << " audit event records";
+            return {};
+        }
+        catch (const std::exception& exc)
+        {
+            TLOG(WARNING) << "writing " << batch.size() << " audit event records failed (attempt " << attempt
+                          << "): " << util::demangle(typeid(exc).name());
+            TVLOG(1) << "Error reason: " << exc.what();
+        }
+        catch (...)
+        {
+            TLOG(WARNING) << "writing " << batch.size() << " audit event records failed (attempt " << attempt
+                          << "): unknown exception";
+        }
+        if (attempt < maxWriteAttempts)
+        {
+            std::this_thread::sleep_for(retryDelay);
+        }
+    }
+    auto failed = writeSingleRecords(batch);
+    mFailedRecords.store(failed.size(), std::memory_order_relaxed);
+    return failed;
+}
+
+
+std::vector<model::AuditData> AuditEventWriter::writeSingleRecords(std::vector<model::AuditData>& batch)
+{
+    std::vector<model::AuditData> failed;
+    for (size_t index = 0; index < batch.size(); ++index)
+    {
+        try
+        {
+            write(batch, index, index + 1);
+            mWrittenRecords.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        catch (const std::exception& exc)
+        {
+            TVLOG(1) << "Error reason: " << exc.what();
+        }
+        catch (...)
+        {
+        }
+        failed.emplace_back(std::move(batch[index]));
+    }
+    return failed;
+}
+
+
+void AuditEventWriter::dropRecords(const std::vector<model::AuditData>& records)
+{
+    for (const auto& record : records)
+    {
+        mDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+        TLOG(ERROR) << "dropped audit event record of type " << magic_enum::enum_name(record.eventId());
+    }
+}
+
+
+void AuditEventWriter::write(std::vector<model::AuditData>& batch, size_t begin, size_t end)
+{
+    auto database = mDatabaseFactory();
+    for (size_t index = begin; index < end; ++index)
+    {
+        database->storeAuditEventData(batch[index]);
+    }
+    database->commitTransaction();
+}
@@ -0,0 +1,154 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#ifndef ERP_PROCESSING_CONTEXT_SRC_ERP_DATABASE_AUDITEVENTWRITER_HXX
+#define ERP_PROCESSING_CONTEXT_SRC_ERP_DATABASE_AUDITEVENTWRITER_HXX
+
+#include "shared/model/AuditData.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Configuration;
+class Database;
+
+
+/**
+ * Writes audit events on a dedicated thread, so that requests do not wait for the audit event insert.
+ *
+ * Request threads add their audit data to a bounded in-memory queue. The writer thread takes up to `maxBatchSize`
+ * records from the queue and writes them in a single transaction (group commit). There is only one writer thread
+ * and the queue is processed in order, therefore audit events are written in the order in which they were added.
+ *
+ * Records must only be queued after the transaction of the request has been committed, so that no audit event is
+ * written for a change that was rolled back. To still be able to reject a request while its transaction can be rolled
+ * back, a request reserves its place in the queue with reserve() before the commit and hands over the record with
+ * Reservation::enqueue() after the commit.
+ *
+ * A batch that can not be written is retried `maxWriteAttempts` times. After that its records are written one by one,
+ * so that a single bad record does not take the others with it. Records that still fail are put back at the front of
+ * the queue and retried after `failedRecordsRetryDelay`. While there are such records, healthCheck() fails, which
+ * marks the Postgres service as down. Records are only dropped, with an error log, if they still can not be written
+ * when the writer is stopped.
+ *
+ * Records that are still queued when the process terminates unexpectedly (crash, SIGKILL) are lost, even though the
+ * requests they belong to have already been answered successfully. Therefore the writer is disabled by default,
+ * see ERP_SERVICE_AUDIT_EVENT_ASYNC_WRITE.
+ */
+class AuditEventWriter
+{
+public:
+    using DatabaseFactory = std::function<std::unique_ptr<Database>()>;
+
+    static constexpr size_t maxWriteAttempts = 3;
+    static constexpr std::chrono::milliseconds retryDelay{200};
+    static constexpr std::chrono::seconds failedRecordsRetryDelay{5};
+
+    /**
+     * A place in the queue that has been reserved for a record.
+     * The place is released if the reservation is destroyed without a record having been enqueued.
+     */
+    class Reservation
+    {
+    public:
+        Reservation() = default;
+        explicit Reservation(AuditEventWriter& writer);
+        ~Reservation();
+        Reservation(Reservation&& other) noexcept;
+        Reservation& operator=(Reservation&& other) noexcept;
+        Reservation(const Reservation&) = delete;
+        Reservation& operator=(const Reservation&) = delete;
+
+        /**
+         * Add `auditData` to the reserved place in the queue. If the writer has been stopped in the meantime, the
+         * record is written synchronously. Does not throw, errors are logged.
+         */
+        void enqueue(model::AuditData&& auditData);
+
+    private:
+        void release();
+
+        AuditEventWriter* mWriter{nullptr};
+    };
+
+    AuditEventWriter(DatabaseFactory databaseFactory, size_t capacity, size_t maxBatchSize);
+    ~AuditEventWriter();
+    AuditEventWriter(const AuditEventWriter&) = delete;
+    AuditEventWriter(AuditEventWriter&&) = delete;
+    AuditEventWriter& operator=(const AuditEventWriter&) = delete;
+    AuditEventWriter& operator=(AuditEventWriter&&) = delete;
+
+    /**
+     * Create and start the writer with the settings from the configuration.
+     * Returns nullptr when audit events are to be written synchronously.
+     */
+    static std::unique_ptr<AuditEventWriter> fromConfiguration(const Configuration& configuration,
+                                                               DatabaseFactory databaseFactory);
+
+    void start();
+
+    /// Writes all queued records and stops the writer thread.
+    void stop();
+
+    /**
+     * Reserve a place in the queue.
+     * @throws ErpException with status 503 if the queue is full or the writer is not running
+     */
+    Reservation reserve();
+
+    /**
+     * Add `auditData` to the queue.
+     * @throws ErpException with status 503 if the queue is full or the writer is not running
+     */
+    void enqueue(model::AuditData&& auditData);
+
+    /**
+     * @throws std::runtime_error if there are records that could not be written and are waiting for a retry
+     */
+    void healthCheck() const;
+
+    size_t queueSize() const;
+    uint64_t writtenRecords() const;
+    uint64_t failedRecords() const;
+    uint64_t droppedRecords() const;
+
+private:
+    void run();
+    /// returns the records that could not be written
+    std::vector<model::AuditData> writeBatch(std::vector<model::AuditData>& batch);
+    std::vector<model::AuditData> writeSingleRecords(std::vector<model::AuditData>& batch);
+    void write(std::vector<model::AuditData>& batch, size_t begin, size_t end);
+    void dropRecords(const std::vector<model::AuditData>& records);
+
+    const DatabaseFactory mDatabaseFactory;
+    const size_t mCapacity;
+    const size_t mMaxBatchSize;
+
+    mutable std::mutex mMutex;
+    std::condition_variable mWakeUp;
+    std::deque<model::AuditData> mQueue;
+    size_t mReserved{0};
+    bool mRunning{false};
+    bool mStopRequested{false};
+    std::thread mWriterThread;
+
+    std::atomic<uint64_t> mWrittenRecords{0};
+    /// number of records at the front of the queue that failed in the last attempt
+    std::atomic<uint64_t> mFailedRecords{0};
+    std::atomic<uint64_t> mDroppedRecords{0};
+};
+
+
+#endif// ERP_PROCESSING_CONTEXT_SRC_ERP_DATABASE_AUDITEVENTWRITER_HXX
@@ -9,8 +9,11 @@
 #define ERP_PROCESSING_CONTEXT_DATABASE_DATABASE_HXX
 
 #include "erp/database/ErpDatabaseModel.hxx"
+#include "erp/database/LazyDecoded.hxx"
+#include "erp/util/search/PagingArgument.hxx"
 #include "shared/crypto/RandomSource.hxx"
 #include "shared/database/DatabaseConnectionInfo.hxx"
+#include "shared/database/PrescriptionSignatureMetadata.hxx"
 #include "shared/hsm/ErpTypes.hxx"
 
 #include <date/date.h>
@@ -57,7 +60,7 @@ enum class CmacKeyCategory : int8_t;
 class ReadOnlyDatabase
 {
 public:
-    static constexpr const char* expectedSchemaVersion = "41";
+    static constexpr const char* expectedSchemaVersion = "42";
 
     // NOLINTNEXTLINE(bugprone-exception-escape)
     struct TaskAndKey {
@@ -95,7 +98,25 @@ public:
     retrieveAllEgkRedeemableTasksWithAccessCode(const model::Kvnr& kvnr, const std::optional<UrlArguments>& search) = 0;
     virtual uint64_t countAllTasksForPatient (const model::Kvnr& kvnr, const std::optional<UrlArguments>& search) = 0;
     virtual uint64_t countAllEgkRedeemableTasks (const model::Kvnr& kvnr, const std::optional<UrlArguments>& search) = 0;
-    virtual std::vector<std::tuple<model::Task, model::Binary>>
+    /**
+     * Like retrieveAllTasksForPatient() and countAllTasksForPatient() but with a single database statement.
+     * @return the tasks of the requested page, the total number of tasks that match the search arguments and,
+     *         with keyset paging, the seek position of the last task when further tasks follow the page.
+     */
+    virtual std::tuple<std::vector<model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+    retrieveAllTasksForPatientWithTotal(const model::Kvnr& kvnr, const std::optional<UrlArguments>& search) = 0;
+    /**
+     * Like retrieveAllEgkRedeemableTasksWithAccessCode() and countAllEgkRedeemableTasks() but with a single
+     * database statement.
+     */
+    virtual std::tuple<std::vector<model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+    retrieveAllEgkRedeemableTasksWithAccessCodeAndTotal(const model::Kvnr& kvnr,
+                                                        const std::optional<UrlArguments>& search) = 0;
+    /**
+     * The prescriptions are only decrypted and parsed on first access, as the caller
+     * filters the result on the task properties first.
+     */
+    virtual std::vector<std::tuple<model::Task, LazyDecoded<model::Binary>>>
     retrieveAllTasksForEu(const model::Kvnr& kvnr, const std::optional<UrlArguments>& search) = 0;
     virtual uint64_t countAllTasksForEu(const model::Kvnr& kvnr, const std::optional<UrlArguments>& search) = 0;
     // @return <medications, hasNextPage>
@@ -168,7 +189,9 @@ public:
     virtual void activateTask(const model::Task& task, const model::Binary& healthCareProviderPrescription,
                               const JWT& doctorIdentity) = 0;
     virtual void activateTask(const model::Task& task, const SafeString& key,
-                              const model::Binary& healthCareProviderPrescription, const JWT& doctorIdentity) = 0;
+                              const model::Binary& healthCareProviderPrescription,
+                              const std::optional<db_model::PrescriptionSignatureMetadata>& signatureMetadata,
+                              const JWT& doctorIdentity) = 0;
     virtual void updateTaskReceipt(const model::Task& task, const model::ErxReceipt& receipt, const SafeString& key,
                                    const JWT& pharmacyIdentity) = 0;
     virtual void updateTaskMedicationDispense(const model::Task& task,
@@ -188,6 +211,15 @@ public:
     virtual std::optional<TaskAndKey> retrieveTaskForUpdate (const model::PrescriptionId& taskId) = 0;
     [[nodiscard]] virtual std::tuple<std::optional<TaskAndKey>, std::optional<model::Binary>>
     retrieveTaskForUpdateAndPrescription(const model::PrescriptionId& taskId) = 0;
+    /**
+     * Like retrieveTaskForUpdateAndPrescription but returns the signature metadata that has been stored during
+     * $activate instead of the prescription. The prescription is neither selected nor decrypted. Only for tasks that
+     * have been activated without metadata, it is loaded with a second query and returned so that the caller can
+     * extract the data itself.
+     */
+    [[nodiscard]] virtual std::tuple<std::optional<TaskAndKey>, std::optional<db_model::PrescriptionSignatureMetadata>,
+                                     std::optional<model::Binary>>
+    retrieveTaskForUpdateAndPrescriptionMetadata(const model::PrescriptionId& taskId) = 0;
 
     virtual std::tuple<std::optional<TaskAndKey>, std::optional<model::Binary>> retrieveTaskAndPrescription(const model::PrescriptionId& taskId) = 0;
     [[nodiscard]] virtual std::tuple<std::optional<model::Task>, std::optional<model::Binary>, std::optional<model::Bundle>>
@@ -7,6 +7,7 @@
 
 #include "erp/database/DatabaseFrontend.hxx"
 #include "erp/database/ErpDatabaseBackend.hxx"
+#include "erp/database/ParallelDecoder.hxx"
 #include "erp/model/ChargeItem.hxx"
 #include "erp/model/Communication.hxx"
 #include "erp/model/Consent.hxx"
@@ -83,11 +84,10 @@ DatabaseFrontend::retrieveAllMedicationDispenses(const model::Kvnr& kvnr, const
 
     const auto encryptedResult = mBackend->retrieveAllMedicationDispenses(hashedKvnr, {}, search);
 
-    model::MedicationsAndDispenses resultSet;
-    std::list<model::EuMedicationDispenseInfos> euInfos;
-
+    // Key derivation uses the HSM and stays on this thread, decryption and parsing is done by the ParallelDecoder.
     std::map<BlobId, SafeString> keys;
-
+    std::vector<std::pair<const db_model::MedicationDispense*, const SafeString*>> rows;
+    rows.reserve(encryptedResult.size());
     for (const auto& res : encryptedResult)
     {
         auto key = keys.find(res.blobId);
@@ -96,28 +96,49 @@ DatabaseFrontend::retrieveAllMedicationDispenses(const model::Kvnr& kvnr, const
             std::tie(key, std::ignore) = keys.emplace(
                 res.blobId, mDerivation.medicationDispenseKey(hashedKvnr, res.blobId, res.medicationDispenseSalt));
         }
-        auto unspecified =
-            model::UnspecifiedResource::fromJsonNoValidation(mCodec.decode(res.medicationDispense, key->second));
+        rows.emplace_back(&res, &key->second);
+    }
+
+    struct DecodedRow {
+        std::optional<model::MedicationDispense> medicationDispense;
+        std::optional<model::MedicationDispenseBundle> bundle;
+        std::optional<model::EuMedicationDispenseInfos> euInfo;
+    };
+    auto decodedRows = ParallelDecoder::instance().transform(rows, [this](const auto& row) {
+        const auto& [res, key] = row;
+        auto unspecified = model::UnspecifiedResource::fromJsonNoValidation(mCodec.decode(res->medicationDispense, *key));
+        DecodedRow decoded;
         if (unspecified.getResourceType() == model::MedicationDispense::resourceTypeName)
         {
-            resultSet.medicationDispenses.emplace_back(model::MedicationDispense::fromJson(unspecified.jsonDocument()));
+            decoded.medicationDispense.emplace(model::MedicationDispense::fromJson(unspecified.jsonDocument()));
         }
         else if (unspecified.getResourceType() == model::Bundle::resourceTypeName)
         {
-            const auto& bundle = model::MedicationDispenseBundle::fromJson(unspecified.jsonDocument());
-            // Ignores expected eu resources.
-            resultSet.addFromBundle(model::MedicationDispenseBundle::fromJson(unspecified.jsonDocument()));
-            // Handle ignored eu resources here:
-            auto euInfo = EuMedicationDispenseInfos::create(bundle);
-            if (euInfo.has_value())
-            {
-                euInfos.push_back( std::move(*euInfo) );
-            }
+            decoded.bundle.emplace(model::MedicationDispenseBundle::fromJson(unspecified.jsonDocument()));
+            // Handle eu resources here, they are ignored by addFromBundle:
+            decoded.euInfo = EuMedicationDispenseInfos::create(*decoded.bundle);
         }
         else
         {
             Fail2("unable to detect resource type of stored medication dispense", std::logic_error);
         }
+        return decoded;
+    });
+
+    model::MedicationsAndDispenses resultSet;
+    std::list<model::EuMedicationDispenseInfos> euInfos;
+    for (auto& decoded : decodedRows)
+    {
+        if (decoded.medicationDispense.has_value())
+        {
+            resultSet.medicationDispenses.emplace_back(std::move(*decoded.medicationDispense));
+            continue;
+        }
+        resultSet.addFromBundle(*decoded.bundle);
+        if (decoded.euInfo.has_value())
+        {
+            euInfos.push_back(std::move(*decoded.euInfo));
+        }
     }
     return {std::move(resultSet), std::move(euInfos)};
 }
@@ -225,11 +246,13 @@ void DatabaseFrontend::updateTaskStatusAndSecret(const Task& task, const SafeStr
 void DatabaseFrontend::activateTask(const model::Task& task, const Binary& healthCareProviderPrescription,
                                     const JWT& doctorIdentity)
 {
-    activateTask(task, taskKey(task.prescriptionId()), healthCareProviderPrescription, doctorIdentity);
+    activateTask(task, taskKey(task.prescriptionId()), healthCareProviderPrescription, std::nullopt, doctorIdentity);
 }
 
 void DatabaseFrontend::activateTask(const model::Task& task, const SafeString& key,
-                                    const Binary& healthCareProviderPrescription, const JWT& doctorIdentity)
+                                    const Binary& healthCareProviderPrescription,
+                                    const std::optional<db_model::PrescriptionSignatureMetadata>& signatureMetadata,
+                                    const JWT& doctorIdentity)
 {
     A_19688.start("encrypt kvnr and prescription.");
     const auto encryptedPrescription = mCodec.encode(healthCareProviderPrescription.serializeToJsonString(), key,
@@ -243,10 +266,17 @@ void DatabaseFrontend::activateTask(const model::Task& task, const SafeString& k
 
     const auto encryptedDoctorIdentity = mCodec.encode(db_model::AccessTokenIdentity(doctorIdentity).getJson(), key,
                                                        Compression::DictionaryUse::Default_json);
+    std::optional<db_model::EncryptedBlob> encryptedSignatureMetadata;
+    if (signatureMetadata.has_value())
+    {
+        encryptedSignatureMetadata =
+            mCodec.encode(signatureMetadata->getJson(), key, Compression::DictionaryUse::Default_json);
+    }
 
     mBackend->activateTask(task.prescriptionId(), encrypedKvnr, hashedKvnr, task.status(), task.lastModifiedDate(),
-                           task.expiryDate(), task.acceptDate(), encryptedPrescription, encryptedDoctorIdentity,
-                           task.lastStatusChangeDate(), task.isEuRedeemableByProperties(), task.isPkv());
+                           task.expiryDate(), task.acceptDate(), encryptedPrescription, encryptedSignatureMetadata,
+                           encryptedDoctorIdentity, task.lastStatusChangeDate(), task.isEuRedeemableByProperties(),
+                           task.isPkv());
 }
 
 void DatabaseFrontend::updateTaskMedicationDispense(const model::Task& task,
@@ -470,6 +500,40 @@ DatabaseFrontend::retrieveTaskForUpdateAndPrescription(const model::Prescription
     return std::make_tuple(std::move(taskAndKey), std::move(prescription));
 }
 
+std::tuple<std::optional<Database::TaskAndKey>, std::optional<db_model::PrescriptionSignatureMetadata>,
+           std::optional<model::Binary>>
+DatabaseFrontend::retrieveTaskForUpdateAndPrescriptionMetadata(const model::PrescriptionId& taskId)
+{
+    const auto& dbTask = mBackend->retrieveTaskForUpdateAndPrescriptionMetadata(taskId);
+    if (! dbTask)
+    {
+        return {};
+    }
+    auto keyForTask = taskKey(*dbTask);
+    auto task = getModelTask(*dbTask, keyForTask);
+    auto taskAndKey = TaskAndKey{.task = std::move(task), .key = std::move(keyForTask)};
+    std::optional<db_model::PrescriptionSignatureMetadata> signatureMetadata;
+    std::optional<model::Binary> prescription;
+    if (taskAndKey.key)
+    {
+        if (dbTask->prescriptionMetadata)
+        {
+            signatureMetadata = db_model::PrescriptionSignatureMetadata::fromJson(
+                std::string(mCodec.decode(*dbTask->prescriptionMetadata, *taskAndKey.key)));
+        }
+        else
+        {
+            // task has been activated before the metadata has been stored, the row is already locked
+            const auto& dbTaskWithPrescription = mBackend->retrieveTaskAndPrescription(taskId);
+            if (dbTaskWithPrescription)
+            {
+                prescription = getHealthcareProviderPrescription(*dbTaskWithPrescription, *taskAndKey.key);
+            }
+        }
+    }
+    return std::make_tuple(std::move(taskAndKey), std::move(signatureMetadata), std::move(prescription));
+}
+
 std::tuple<std::optional<Task>, std::optional<Bundle>>
 DatabaseFrontend::retrieveTaskAndReceipt(const PrescriptionId& taskId)
 {
@@ -535,7 +599,45 @@ std::vector<model::Task> DatabaseFrontend::retrieveAllTasksForPatient(const mode
     ErpExpect(kvnr.validFormat(), HttpStatus::BadRequest, "Invalid KVNR");
 
     auto dbTaskList = mBackend->retrieveAllTasksForPatient(mDerivation.hashKvnr(kvnr), search);
+    return tasksForPatientFromDbTasks(kvnr, dbTaskList);
+}
+
+std::vector<model::Task> DatabaseFrontend::retrieveAllEgkRedeemableTasksWithAccessCode(const model::Kvnr& kvnr,
+                                                                             const std::optional<UrlArguments>& search)
+{
+    ErpExpect(kvnr.validFormat(), HttpStatus::BadRequest, "Invalid KVNR");
+
+    auto dbTaskList = mBackend->retrieveAllEgkRedeemableTasksWithAccessCode(mDerivation.hashKvnr(kvnr), search);
+    return tasksWithAccessCodeFromDbTasks(dbTaskList);
+}
+
+std::tuple<std::vector<model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+DatabaseFrontend::retrieveAllTasksForPatientWithTotal(const model::Kvnr& kvnr,
+                                                      const std::optional<UrlArguments>& search)
+{
+    ErpExpect(kvnr.validFormat(), HttpStatus::BadRequest, "Invalid KVNR");
+
+    auto [dbTaskList, total, nextSeek] =
+        mBackend->retrieveAllTasksForPatientWithTotal(mDerivation.hashKvnr(kvnr), search);
+    return {tasksForPatientFromDbTasks(kvnr, dbTaskList), total, std::move(nextSeek)};
+}
+
+std::tuple<std::vector<model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+DatabaseFrontend::retrieveAllEgkRedeemableTasksWithAccessCodeAndTotal(const model::Kvnr& kvnr,
+                                                                      const std::optional<UrlArguments>& search)
+{
+    ErpExpect(kvnr.validFormat(), HttpStatus::BadRequest, "Invalid KVNR");
+
+    auto [dbTaskList, total, nextSeek] =
+        mBackend->retrieveAllEgkRedeemableTasksWithAccessCodeAndTotal(mDerivation.hashKvnr(kvnr), search);
+    return {tasksWithAccessCodeFromDbTasks(dbTaskList), total, std::move(nextSeek)};
+}
+
+std::vector<model::Task> DatabaseFrontend::tasksForPatientFromDbTasks(const model::Kvnr& kvnr,
+                                                                      const std::vector<db_model::Task>& dbTaskList)
+{
     std::vector<model::Task> allTasks;
+    allTasks.reserve(dbTaskList.size());
     for (const auto& dbTask : dbTaskList)
     {
         auto modelTask = getModelTask(dbTask);
@@ -545,13 +647,10 @@ std::vector<model::Task> DatabaseFrontend::retrieveAllTasksForPatient(const mode
     return allTasks;
 }
 
-std::vector<model::Task> DatabaseFrontend::retrieveAllEgkRedeemableTasksWithAccessCode(const model::Kvnr& kvnr,
-                                                                             const std::optional<UrlArguments>& search)
+std::vector<model::Task> DatabaseFrontend::tasksWithAccessCodeFromDbTasks(const std::vector<db_model::Task>& dbTaskList)
 {
-    ErpExpect(kvnr.validFormat(), HttpStatus::BadRequest, "Invalid KVNR");
-
-    auto dbTaskList = mBackend->retrieveAllEgkRedeemableTasksWithAccessCode(mDerivation.hashKvnr(kvnr), search);
     std::vector<model::Task> allTasks;
+    allTasks.reserve(dbTaskList.size());
     for (const auto& dbTask : dbTaskList)
     {
         auto keyForTask = taskKey(dbTask);
@@ -571,19 +670,25 @@ uint64_t DatabaseFrontend::countAllEgkRedeemableTasks(const model::Kvnr& kvnr, c
     return mBackend->countAllEgkRedeemableTasks(mDerivation.hashKvnr(kvnr), search);
 }
 
-std::vector<std::tuple<model::Task, model::Binary>>
+std::vector<std::tuple<model::Task, LazyDecoded<model::Binary>>>
 DatabaseFrontend::retrieveAllTasksForEu(const model::Kvnr& kvnr, const std::optional<UrlArguments>& search)
 {
     auto dbModelTasks = mBackend->retrieveAllTasksForEu(mDerivation.hashKvnr(kvnr), search);
-    std::vector<std::tuple<model::Task, model::Binary>> tasks;
+    std::vector<std::tuple<model::Task, LazyDecoded<model::Binary>>> tasks;
     tasks.reserve(dbModelTasks.size());
-    for (const auto& dbModelTask : dbModelTasks)
+    for (auto& dbModelTask : dbModelTasks)
     {
         auto keyForTask = taskKey(dbModelTask);
         Expect(keyForTask, "Key for task must be set in database.");
-        auto decryptedPrescription = getHealthcareProviderPrescription(dbModelTask, *keyForTask);
-        Expect(decryptedPrescription, "Failed to decrypt Prescription");
-        tasks.emplace_back(getModelTask(dbModelTask, keyForTask), std::move(*decryptedPrescription));
+        Expect(dbModelTask.healthcareProviderPrescription, "Prescription must be set in database.");
+        auto task = getModelTask(dbModelTask, keyForTask);
+        // the codec is copied, the result may outlive this database frontend
+        tasks.emplace_back(std::move(task),
+                           LazyDecoded<model::Binary>{
+                               [codec = mCodec, prescription = std::move(*dbModelTask.healthcareProviderPrescription),
+                                key = std::move(*keyForTask)] {
+                                   return codec.decode(prescription, key);
+                               }});
     }
     return tasks;
 }
@@ -644,8 +749,8 @@ std::vector<Communication> DatabaseFrontend::retrieveCommunications(const std::s
     auto hashedUser = mDerivation.hashIdentity(user);
     auto dbCommunications = mBackend->retrieveCommunications(hashedUser, communicationId, search);
     std::map<BlobId, SafeString> keys;
-    std::vector<Communication> communications;
-    communications.reserve(dbCommunications.size());
+    std::vector<std::pair<const db_model::Communication*, const SafeString*>> rows;
+    rows.reserve(dbCommunications.size());
     for (const auto& item : dbCommunications)
     {
         auto [key, needDerivation] = keys.try_emplace(item.blobId, SafeString{});
@@ -653,20 +758,23 @@ std::vector<Communication> DatabaseFrontend::retrieveCommunications(const std::s
         {
             key->second = mDerivation.communicationKey(user, hashedUser, item.blobId, item.salt);
         }
-        auto communicationJson = mCodec.decode(item.communication, key->second);
+        rows.emplace_back(&item, &key->second);
+    }
+    return ParallelDecoder::instance().transform(rows, [this](const auto& row) {
+        const auto& [item, key] = row;
+        auto communicationJson = mCodec.decode(item->communication, *key);
         model::Communication communication = model::Communication::fromJsonNoValidation(communicationJson);
         // Please note that the communication id is not stored in the json string of the message
         // column as the id is only available after the data row has been inserted in the table.
         // To return a valid communication object the id will be set here.
-        communication.setId(item.id);
+        communication.setId(item->id);
         // Same applies to the time the communication has been received by the user.
-        if (item.received)
+        if (item->received)
         {
-            communication.setTimeReceived(*item.received);
+            communication.setTimeReceived(*item->received);
         }
-        communications.emplace_back(std::move(communication));
-    }
-    return communications;
+        return communication;
+    });
 }
 
 uint64_t DatabaseFrontend::countCommunications(const std::string& user, const std::optional<UrlArguments>& search)
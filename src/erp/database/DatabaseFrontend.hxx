@@ -56,7 +56,9 @@ public:
     void activateTask(const model::Task& task, const model::Binary& healthCareProviderPrescription,
                       const JWT& doctorIdentity) override;
     void activateTask(const model::Task& task, const SafeString& key,
-                      const model::Binary& healthCareProviderPrescription, const JWT& doctorIdentity) override;
+                      const model::Binary& healthCareProviderPrescription,
+                      const std::optional<db_model::PrescriptionSignatureMetadata>& signatureMetadata,
+                      const JWT& doctorIdentity) override;
     void updateTaskReceipt(const model::Task& task, const model::ErxReceipt& receipt, const SafeString& key,
                            const JWT& pharmacyIdentity) override;
     void updateTaskMedicationDispense(const model::Task& task,
@@ -80,6 +82,9 @@ public:
     [[nodiscard]] std::optional<TaskAndKey> retrieveTaskForUpdate(const model::PrescriptionId& taskId) override;
     [[nodiscard]] std::tuple<std::optional<TaskAndKey>, std::optional<model::Binary>>
     retrieveTaskForUpdateAndPrescription(const model::PrescriptionId& taskId) override;
+    [[nodiscard]] std::tuple<std::optional<TaskAndKey>, std::optional<db_model::PrescriptionSignatureMetadata>,
+                             std::optional<model::Binary>>
+    retrieveTaskForUpdateAndPrescriptionMetadata(const model::PrescriptionId& taskId) override;
 
     [[nodiscard]] std::tuple<std::optional<model::Task>, std::optional<model::Bundle>>
     retrieveTaskAndReceipt(const model::PrescriptionId& taskId) override;
@@ -97,7 +102,12 @@ public:
     countAllTasksForPatient (const model::Kvnr& kvnr, const std::optional<UrlArguments>& search) override;
     [[nodiscard]] uint64_t countAllEgkRedeemableTasks(const model::Kvnr& kvnr,
                                             const std::optional<UrlArguments>& search) override;
-    [[nodiscard]] std::vector<std::tuple<model::Task, model::Binary>>
+    [[nodiscard]] std::tuple<std::vector<model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+    retrieveAllTasksForPatientWithTotal(const model::Kvnr& kvnr, const std::optional<UrlArguments>& search) override;
+    [[nodiscard]] std::tuple<std::vector<model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+    retrieveAllEgkRedeemableTasksWithAccessCodeAndTotal(const model::Kvnr& kvnr,
+                                                        const std::optional<UrlArguments>& search) override;
+    [[nodiscard]] std::vector<std::tuple<model::Task, LazyDecoded<model::Binary>>>
     retrieveAllTasksForEu(const model::Kvnr& kvnr, const std::optional<UrlArguments>& search) override;
     [[nodiscard]] uint64_t countAllTasksForEu(const model::Kvnr& kvnr,
                                               const std::optional<UrlArguments>& search) override;
@@ -169,6 +179,9 @@ private:
     static std::shared_ptr<Compression> compressionInstance();
     [[nodiscard]] model::Task getModelTask(const db_model::Task& dbTask,
                                            const std::optional<SafeString>& key = std::nullopt);
+    [[nodiscard]] std::vector<model::Task> tasksForPatientFromDbTasks(const model::Kvnr& kvnr,
+                                                                      const std::vector<db_model::Task>& dbTaskList);
+    [[nodiscard]] std::vector<model::Task> tasksWithAccessCodeFromDbTasks(const std::vector<db_model::Task>& dbTaskList);
     [[nodiscard]] std::optional<model::Binary> getHealthcareProviderPrescription(const db_model::Task& dbTask,
                                                                                  const SafeString& key);
     [[nodiscard]] std::optional<model::Bundle> getReceipt(const db_model::Task& dbTask, const SafeString& key);
@@ -11,6 +11,7 @@
 #include "ErpDatabaseModel.hxx"
 #include "erp/model/Communication.hxx"
 #include "erp/model/Task.hxx"
+#include "erp/util/search/PagingArgument.hxx"
 #include "shared/database/DatabaseBackend.hxx"
 #include "shared/hsm/ErpTypes.hxx"
 
@@ -84,6 +85,7 @@ public:
                               const model::Timestamp& lastModified, const model::Timestamp& expiryDate,
                               const model::Timestamp& acceptDate,
                               const db_model::EncryptedBlob& healthCareProviderPrescription,
+                              const std::optional<db_model::EncryptedBlob>& prescriptionMetadata,
                               const db_model::EncryptedBlob& doctorIdentity,
                               const model::Timestamp& lastStatusUpdate,
                               bool euRedeemable, bool isPkv) = 0;
@@ -128,6 +130,9 @@ public:
     virtual std::optional<db_model::Task> retrieveTaskForUpdate(const model::PrescriptionId& taskId) = 0;
     [[nodiscard]] virtual ::std::optional<::db_model::Task>
     retrieveTaskForUpdateAndPrescription(const ::model::PrescriptionId& taskId) = 0;
+    /// like retrieveTaskForUpdateAndPrescription but with the prescription metadata instead of the prescription
+    [[nodiscard]] virtual std::optional<db_model::Task>
+    retrieveTaskForUpdateAndPrescriptionMetadata(const model::PrescriptionId& taskId) = 0;
 
     virtual std::optional<db_model::Task> retrieveTaskAndReceipt(const model::PrescriptionId& taskId) = 0;
     virtual std::optional<db_model::Task> retrieveTaskAndPrescription(const model::PrescriptionId& taskId) = 0;
@@ -142,6 +147,12 @@ public:
                                              const std::optional<UrlArguments>& search) = 0;
     virtual uint64_t countAllEgkRedeemableTasks(const db_model::HashedKvnr& kvnr,
                                                 const std::optional<UrlArguments>& search) = 0;
+    virtual std::tuple<std::vector<db_model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+    retrieveAllTasksForPatientWithTotal(const db_model::HashedKvnr& kvnrHashed,
+                                        const std::optional<UrlArguments>& search) = 0;
+    virtual std::tuple<std::vector<db_model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+    retrieveAllEgkRedeemableTasksWithAccessCodeAndTotal(const db_model::HashedKvnr& kvnrHashed,
+                                                        const std::optional<UrlArguments>& search) = 0;
     virtual std::vector<db_model::Task> retrieveAllTasksForEu(const db_model::HashedKvnr& kvnr,
                                                               const std::optional<UrlArguments>& search) = 0;
     virtual uint64_t countAllTasksForEu(const db_model::HashedKvnr& kvnr, const std::optional<UrlArguments>& search) = 0;
@@ -49,6 +49,7 @@ public:
     std::optional<EncryptedBlob> secret;
     std::optional<EncryptedBlob> receipt;
     std::optional<EncryptedBlob> healthcareProviderPrescription;
+    std::optional<EncryptedBlob> prescriptionMetadata;
     std::optional<EncryptedBlob> owner;
     std::optional<model::Timestamp> lastMedicationDispense;
     bool euRedeemableByPatient{false};
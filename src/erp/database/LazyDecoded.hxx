@@ -0,0 +1,77 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#ifndef ERP_PROCESSING_CONTEXT_DATABASE_LAZYDECODED_HXX
+#define ERP_PROCESSING_CONTEXT_DATABASE_LAZYDECODED_HXX
+
+#include "shared/util/SafeString.hxx"
+
+#include <functional>
+#include <utility>
+#include <variant>
+
+/**
+ * Holds a stored resource and decrypts and parses it into ModelT on first access.
+ *
+ * List operations that filter or limit their result after reading it from the database use this to avoid
+ * decrypting and parsing resources that are not part of the response. After parsing, the encrypted data and the
+ * json are released. The class is not thread safe.
+ */
+template<typename ModelT>
+class LazyDecoded
+{
+public:
+    /// returns the decrypted json, usually bound to the encrypted blob and its key
+    using Decrypt = std::function<SafeString()>;
+
+    explicit LazyDecoded(Decrypt decrypt)
+        : mData{std::in_place_type<Decrypt>, std::move(decrypt)}
+    {
+    }
+
+    explicit LazyDecoded(SafeString json)
+        : mData{std::in_place_type<SafeString>, std::move(json)}
+    {
+    }
+
+    explicit LazyDecoded(ModelT model)
+        : mData{std::in_place_type<ModelT>, std::move(model)}
+    {
+    }
+
+    /// @throws model::ModelException if the stored json can not be parsed, or the exception of the decryption
+    const ModelT& get() const
+    {
+        if (const auto* decrypt = std::get_if<Decrypt>(&mData))
+        {
+            // on failure the encrypted data is kept
+            auto json = (*decrypt)();
+            mData.template emplace<SafeString>(std::move(json));
+        }
+        if (const auto* json = std::get_if<SafeString>(&mData))
+        {
+            mData.template emplace<ModelT>(ModelT::fromJsonNoValidation(std::string_view{*json}));
+        }
+        return std::get<ModelT>(mData);
+    }
+
+    ModelT& get()
+    {
+        return const_cast<ModelT&>(std::as_const(*this).get());
+    }
+
+    [[nodiscard]] bool isParsed() const
+    {
+        return std::holds_alternative<ModelT>(mData);
+    }
+
+private:
+    mutable std::variant<Decrypt, SafeString, ModelT> mData;
+};
+
+
+#endif// ERP_PROCESSING_CONTEXT_DATABASE_LAZYDECODED_HXX
@@ -0,0 +1,101 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "erp/database/ParallelDecoder.hxx"
+#include "shared/util/Configuration.hxx"
+#include "shared/util/TLog.hxx"
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <gsl/gsl-lite.hpp>
+#include <algorithm>
+#include <exception>
+#include <future>
+
+
+ParallelDecoder& ParallelDecoder::instance()
+{
+    const auto& configuration = Configuration::instance();
+    static ParallelDecoder decoder{
+        gsl::narrow<size_t>(
+            std::max(0, configuration.getOptionalIntValue(ConfigurationKey::POSTGRES_DECODE_THREAD_COUNT, 0))),
+        gsl::narrow<size_t>(
+            std::max(0, configuration.getOptionalIntValue(ConfigurationKey::POSTGRES_DECODE_PARALLEL_THRESHOLD, 16)))};
+    return decoder;
+}
+
+
+ParallelDecoder::ParallelDecoder(size_t threadCount, size_t parallelThreshold)
+    : mThreadCount(threadCount)
+    , mParallelThreshold(parallelThreshold)
+    , mPool(threadCount > 0 ? std::make_unique<boost::asio::thread_pool>(threadCount) : nullptr)
+{
+    TVLOG(1) << "database results with at least " << mParallelThreshold << " rows are decoded with " << mThreadCount
+             << " helper threads";
+}
+
+
+ParallelDecoder::~ParallelDecoder()
+{
+    if (mPool)
+    {
+        mPool->join();
+    }
+}
+
+
+size_t ParallelDecoder::threadCount() const
+{
+    return mThreadCount;
+}
+
+
+void ParallelDecoder::runChunks(std::vector<std::function<void()>>& chunks) const
+{
+    std::vector<std::future<void>> pending;
+    pending.reserve(chunks.size());
+    for (size_t index = 1; index < chunks.size(); ++index)
+    {
+        // log messages of the helper threads carry the session and request id of the calling thread
+        std::packaged_task<void()> task{[logContext = tlogContext, chunk = std::move(chunks[index])] {
+            const ScopedLogContext scopedLogContext{logContext};
+            chunk();
+        }};
+        pending.emplace_back(task.get_future());
+        boost::asio::post(*mPool, std::move(task));
+    }
+
+    // The chunks refer to data of the caller, therefore all of them must have finished before returning,
+    // also when one of them has failed.
+    std::exception_ptr error;
+    try
+    {
+        chunks.front()();
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+    for (auto& future : pending)
+    {
+        try
+        {
+            future.get();
+        }
+        catch (...)
+        {
+            if (! error)
+            {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#ifndef ERP_PROCESSING_CONTEXT_DATABASE_PARALLELDECODER_HXX
+#define ERP_PROCESSING_CONTEXT_DATABASE_PARALLELDECODER_HXX
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace boost::asio
+{
+class thread_pool;
+}
+
+/**
+ * Decrypts and parses the rows of large database results on a small pool of helper threads.
+ *
+ * The rows are split into one chunk per helper thread plus one chunk that is processed by the calling thread.
+ * Results below the threshold are decoded on the calling thread only. The order of the results is always the
+ * order of the input rows. The decode function is called concurrently and must therefore not modify shared state;
+ * key derivation (HSM) has to be done before. The log context of the calling thread is set on the helper threads.
+ *
+ * Only use it where rows are actually decrypted or parsed, for cheap row mappings the hand-off costs more than it
+ * saves.
+ */
+class ParallelDecoder
+{
+public:
+    /// Shared instance, configured with POSTGRES_DECODE_THREAD_COUNT and POSTGRES_DECODE_PARALLEL_THRESHOLD.
+    static ParallelDecoder& instance();
+
+    ParallelDecoder(size_t threadCount, size_t parallelThreshold);
+    ~ParallelDecoder();
+
+    template<typename Row, typename Decode>
+    std::vector<std::invoke_result_t<const Decode&, const Row&>> transform(const std::vector<Row>& rows,
+                                                                           const Decode& decode) const;
+
+    size_t threadCount() const;
+
+private:
+    /// runs chunks[0] on the calling thread and the others on the pool, returns when all are done
+    void runChunks(std::vector<std::function<void()>>& chunks) const;
+
+    const size_t mThreadCount;
+    const size_t mParallelThreshold;
+    std::unique_ptr<boost::asio::thread_pool> mPool;
+};
+
+
+template<typename Row, typename Decode>
+std::vector<std::invoke_result_t<const Decode&, const Row&>>
+ParallelDecoder::transform(const std::vector<Row>& rows, const Decode& decode) const
+{
+    using Result = std::invoke_result_t<const Decode&, const Row&>;
+    std::vector<Result> results;
+    results.reserve(rows.size());
+    if (mThreadCount == 0 || rows.size() < std::max<size_t>(mParallelThreshold, 2))
+    {
+        for (const auto& row : rows)
+        {
+            results.emplace_back(decode(row));
+        }
+        return results;
+    }
+
+    std::vector<std::optional<Result>> decoded(rows.size());
+    const size_t chunkCount = std::min(mThreadCount + 1, rows.size());
+    const size_t chunkSize = (rows.size() + chunkCount - 1) / chunkCount;
+    std::vector<std::function<void()>> chunks;
+    chunks.reserve(chunkCount);
+    for (size_t begin = 0; begin < rows.size(); begin += chunkSize)
+    {
+        const size_t end = std::min(begin + chunkSize, rows.size());
+        chunks.emplace_back([&rows, &decode, &decoded, begin, end] {
+            for (size_t index = begin; index < end; ++index)
+            {
+                decoded[index].emplace(decode(rows[index]));
+            }
+        });
+    }
+    runChunks(chunks);
+
+    for (auto& item : decoded)
+    {
+        results.emplace_back(std::move(*item));
+    }
+    return results;
+}
+
+
+#endif// ERP_PROCESSING_CONTEXT_DATABASE_PARALLELDECODER_HXX
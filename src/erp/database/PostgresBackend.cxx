@@ -22,6 +22,26 @@
 
 namespace
 {
+// The columns and the source of the task queries by KVNR are kept apart, so that retrieveTasksWithTotal() can add
+// the count of all matches as another column.
+constexpr std::string_view allTasksByKvnrColumns = R"--(
+        prescription_id, kvnr, EXTRACT(EPOCH FROM last_modified) as last_modified, EXTRACT(EPOCH FROM authored_on) as authored_on,
+            EXTRACT(EPOCH FROM expiry_date) as expiry_date, EXTRACT(EPOCH FROM accept_date) as accept_date, status, EXTRACT(EPOCH FROM last_status_update) as last_status_update, salt, task_key_blob_id, prescription_type,
+            eu_redeemable_patient, eu_redeemable, is_pkv)--";
+constexpr std::string_view allTasksByKvnrWithAccessCodeColumns = R"--(
+        prescription_id, kvnr, EXTRACT(EPOCH FROM last_modified) as last_modified, EXTRACT(EPOCH FROM authored_on) as authored_on,
+            EXTRACT(EPOCH FROM expiry_date) as expiry_date, EXTRACT(EPOCH FROM accept_date) as accept_date, status, EXTRACT(EPOCH FROM last_status_update) as last_status_update, salt, task_key_blob_id, prescription_type,
+            access_code, eu_redeemable_patient, eu_redeemable, is_pkv)--";
+constexpr std::string_view allTasksByKvnrSource = R"--(
+        FROM erp.task_view
+        WHERE kvnr_hashed = $1
+        )--";
+
+std::string selectQuery(std::string_view columns, std::string_view source)
+{
+    return std::string{"SELECT "}.append(columns).append(source);
+}
+
 #define QUERY(name, query) const QueryDefinition name = {# name, query};
     QUERY(retrieveCmac                        , "SELECT cmac FROM erp.vau_cmac WHERE valid_date = $1 AND cmac_type = $2")
     // try to insert the new value
@@ -116,22 +136,11 @@ namespace
         )--")
 
 // GEMREQ-start A_19115-01#query
-    QUERY(retrieveAllTasksByKvnr, R"--(
-        SELECT prescription_id, kvnr, EXTRACT(EPOCH FROM last_modified) as last_modified, EXTRACT(EPOCH FROM authored_on) as authored_on,
-            EXTRACT(EPOCH FROM expiry_date) as expiry_date, EXTRACT(EPOCH FROM accept_date) as accept_date, status, EXTRACT(EPOCH FROM last_status_update) as last_status_update, salt, task_key_blob_id, prescription_type,
-            eu_redeemable_patient, eu_redeemable, is_pkv FROM erp.task_view
-        WHERE kvnr_hashed = $1
-        )--")
+    QUERY(retrieveAllTasksByKvnr, selectQuery(allTasksByKvnrColumns, allTasksByKvnrSource))
 // GEMREQ-end A_19115-01#query
 
 // GEMREQ-start A_23452-02#query
-QUERY(retrieveAllTasksByKvnrWithAccessCode, R"--(
-        SELECT prescription_id, kvnr, EXTRACT(EPOCH FROM last_modified) as last_modified, EXTRACT(EPOCH FROM authored_on) as authored_on,
-            EXTRACT(EPOCH FROM expiry_date) as expiry_date, EXTRACT(EPOCH FROM accept_date) as accept_date, status, EXTRACT(EPOCH FROM last_status_update) as last_status_update, salt, task_key_blob_id, prescription_type,
-            access_code, eu_redeemable_patient, eu_redeemable, is_pkv
-        FROM erp.task_view
-        WHERE kvnr_hashed = $1
-        )--")
+QUERY(retrieveAllTasksByKvnrWithAccessCode, selectQuery(allTasksByKvnrWithAccessCodeColumns, allTasksByKvnrSource))
 // GEMREQ-end A_23452-02#query
 
     QUERY(countAllTasksByKvnr, R"--( SELECT COUNT(*) FROM erp.task_view WHERE kvnr_hashed = $1)--")
@@ -172,6 +181,32 @@ QUERY(retrieveAllTasksByKvnrWithAccessCode, R"--(
 #undef QUERY
 
 
+// Convert a value of EXTRACT(EPOCH FROM ...), e.g. "1676419200.123", to a timestamp, truncated to milliseconds,
+// the precision task dates are stored with. The text is evaluated directly, because a conversion to double
+// is not exact.
+model::Timestamp epochMillisecondsToTimestamp(const std::string& epoch)
+{
+    const auto separator = epoch.find('.');
+    std::string fraction = separator == std::string::npos ? std::string{} : epoch.substr(separator + 1, 3);
+    fraction.resize(3, '0');
+    try
+    {
+        size_t secondsLength = 0;
+        size_t fractionLength = 0;
+        const auto seconds = std::stoll(epoch.substr(0, separator), &secondsLength);
+        const auto milliseconds = std::stoll(fraction, &fractionLength);
+        Expect(secondsLength == std::min(separator, epoch.size()) && fractionLength == fraction.size() &&
+                   seconds >= 0 && milliseconds >= 0,
+               "invalid epoch value: " + epoch);
+        return model::Timestamp{model::Timestamp::timepoint_t{std::chrono::seconds{seconds} +
+                                                              std::chrono::milliseconds{milliseconds}}};
+    }
+    catch (const std::logic_error&)
+    {
+        Fail("invalid epoch value: " + epoch);
+    }
+}
+
 }  // anonymous namespace
 
 
@@ -318,6 +353,7 @@ void PostgresBackend::activateTask(const model::PrescriptionId& taskId, const db
                                    const model::Timestamp& lastModified, const model::Timestamp& expiryDate,
                                    const model::Timestamp& acceptDate,
                                    const db_model::EncryptedBlob& healthCareProviderPrescription,
+                                   const std::optional<db_model::EncryptedBlob>& prescriptionMetadata,
                                    const db_model::EncryptedBlob& doctorIdentity,
                                    const model::Timestamp& lastStatusUpdate,
                                    bool euRedeemable, bool isPkv)
@@ -325,7 +361,8 @@ void PostgresBackend::activateTask(const model::PrescriptionId& taskId, const db
     checkCommonPreconditions();
     getTaskBackend(taskId.type())
         .activateTask(*transaction(), taskId, encryptedKvnr, hashedKvnr, taskStatus, lastModified, expiryDate,
-                      acceptDate, healthCareProviderPrescription, doctorIdentity, lastStatusUpdate, euRedeemable, isPkv);
+                      acceptDate, healthCareProviderPrescription, prescriptionMetadata, doctorIdentity, lastStatusUpdate,
+                      euRedeemable, isPkv);
 }
 
 void PostgresBackend::updateTaskReceipt(const model::PrescriptionId& taskId, const model::Task::Status& taskStatus,
@@ -497,6 +534,13 @@ PostgresBackend::retrieveTaskForUpdateAndPrescription(const ::model::Prescriptio
     return getTaskBackend(taskId.type()).retrieveTaskForUpdateAndPrescription(*transaction(), taskId);
 }
 
+std::optional<db_model::Task>
+PostgresBackend::retrieveTaskForUpdateAndPrescriptionMetadata(const model::PrescriptionId& taskId)
+{
+    checkCommonPreconditions();
+    return getTaskBackend(taskId.type()).retrieveTaskForUpdateAndPrescriptionMetadata(*transaction(), taskId);
+}
+
 std::optional<db_model::Task> PostgresBackend::retrieveTaskAndReceipt(const model::PrescriptionId& taskId)
 {
     checkCommonPreconditions();
@@ -608,6 +652,105 @@ uint64_t PostgresBackend::countAllEgkRedeemableTasks(const db_model::HashedKvnr&
     return executeCountQuery(*transaction(), countAllTasksByKvnr.query, kvnr, search, "tasks", prescriptionTypes);
 }
 
+std::tuple<std::vector<db_model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+PostgresBackend::retrieveAllTasksForPatientWithTotal(const db_model::HashedKvnr& kvnrHashed,
+                                                     const std::optional<UrlArguments>& search)
+{
+    checkCommonPreconditions();
+    const auto timerKeepAlive = DurationConsumer::getCurrent().getTimer(DurationCategory::postgres,
+                                                                        "retrievealltasksforpatientwithtotal");
+    A_19569_03.start("Add search parameter to query");
+    auto result = retrieveTasksWithTotal(allTasksByKvnrColumns, countAllTasksByKvnr.query, kvnrHashed, search, {});
+    A_19569_03.finish();
+    return result;
+}
+
+std::tuple<std::vector<db_model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+PostgresBackend::retrieveAllEgkRedeemableTasksWithAccessCodeAndTotal(const db_model::HashedKvnr& kvnrHashed,
+                                                                     const std::optional<UrlArguments>& search)
+{
+    checkCommonPreconditions();
+    auto prescriptionTypesView{magic_enum::enum_values<model::PrescriptionType>() |
+                               std::views::filter(model::isEgkRedeemable)};
+    const std::vector<model::PrescriptionType> prescriptionTypes{prescriptionTypesView.begin(),
+                                                                 prescriptionTypesView.end()};
+    const auto timerKeepAlive = DurationConsumer::getCurrent().getTimer(
+        DurationCategory::postgres, "retrievealltasksbykvnrwithaccesscodewithtotal");
+    return retrieveTasksWithTotal(allTasksByKvnrWithAccessCodeColumns, countAllTasksByKvnr.query, kvnrHashed,
+                                  search, prescriptionTypes);
+}
+
+std::tuple<std::vector<db_model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+PostgresBackend::retrieveTasksWithTotal(const std::string_view& columns, const std::string_view& countQuery,
+                                        const db_model::HashedKvnr& kvnrHashed,
+                                        const std::optional<UrlArguments>& search,
+                                        const std::vector<model::PrescriptionType>& prescriptionTypeParam)
+{
+    const bool isPaged = search.has_value() && ! search->isPagingArgumentDisabled();
+    std::string query{"SELECT "};
+    query.append(columns);
+    if (isPaged)
+    {
+        // The count is evaluated once per statement as an uncorrelated sub query.
+        query.append(", (")
+            .append(completeCountQuery(*transaction(), countQuery, search, prescriptionTypeParam))
+            .append(") AS total_count");
+    }
+    query.append(allTasksByKvnrSource);
+    if (! prescriptionTypeParam.empty())
+    {
+        appendWherePrescriptionTypeIn(query, prescriptionTypeParam);
+    }
+    if (search.has_value())
+    {
+        // One additional row tells whether there is a next page.
+        query.append(search->getSqlExpression(transaction()->conn(), "                ", true));
+    }
+    TVLOG(2) << query;
+
+    const pqxx::result results = transaction()->exec(query, pqxx::params{kvnrHashed.binarystring()});
+
+    TVLOG(2) << "got " << results.size() << " results";
+
+    auto tasks = PostgresBackendTask::tasksFromQueryResult(results, std::nullopt);
+    std::optional<PagingArgument::SeekPosition> nextSeek;
+    const bool hasNextPage = isPaged && tasks.size() > search->pagingArgument().getCount();
+    if (hasNextPage)
+    {
+        tasks.pop_back();
+        if (search->isKeysetPaging())
+        {
+            // The seek position has to match the sort key that the database compares with. The value in the task
+            // has gone through a double and may be off by one millisecond.
+            const auto& lastRow = results.at(gsl::narrow<pqxx::result::size_type>(tasks.size() - 1));
+            nextSeek.emplace(
+                epochMillisecondsToTimestamp(lastRow.at(search->keysetSortArgument()->nameDb).as<std::string>()),
+                tasks.back().prescriptionId);
+        }
+    }
+
+    if (! isPaged)
+    {
+        const uint64_t total = tasks.size();
+        return {std::move(tasks), total, std::nullopt};
+    }
+    if (results.empty())
+    {
+        const bool isFirstPage = search->pagingArgument().getOffset() == 0 &&
+                                 ! search->pagingArgument().getSeek().has_value();
+        if (isFirstPage)
+        {
+            return {{}, 0, std::nullopt};
+        }
+        // Behind the last page there is no row that could carry the count.
+        return {{}, executeCountQuery(*transaction(), countQuery, kvnrHashed, search, "tasks", prescriptionTypeParam),
+                std::nullopt};
+    }
+    int64_t count = 0;
+    Expect(results.front().at("total_count").to(count), "Could not retrieve count of tasks as int64_t");
+    return {std::move(tasks), gsl::narrow<uint64_t>(count), std::move(nextSeek)};
+}
+
 std::vector<db_model::Task> PostgresBackend::retrieveAllTasksForEu(const db_model::HashedKvnr& kvnrHashed,
                                                                    const std::optional<UrlArguments>& search)
 {
@@ -1058,6 +1201,30 @@ void PostgresBackend::appendWherePrescriptionTypeIn(std::string& query,
     query.append(prescriptionTypeParamStr).append(")");
 }
 
+std::string PostgresBackend::completeCountQuery(pqxx::transaction_base& transaction, const std::string_view& query,
+                                                const std::optional<UrlArguments>& search,
+                                                const std::vector<model::PrescriptionType>& prescriptionTypeParam)
+{
+    std::string completeQuery(query);
+
+    if (!prescriptionTypeParam.empty())
+    {
+        appendWherePrescriptionTypeIn(completeQuery, prescriptionTypeParam);
+    }
+    // Append an expression to the query for the search arguments, if there are any.
+    // The seek position of keyset paging is deliberately not part of it, so that all matches are counted.
+    if (search.has_value())
+    {
+        const auto whereExpression = search->getSqlWhereExpression(transaction.conn());
+        if (! whereExpression.empty())
+        {
+            completeQuery += " AND ";
+            completeQuery += whereExpression;
+        }
+    }
+    return completeQuery;
+}
+
 PostgresBackend::~PostgresBackend (void) = default;
 
 PostgresConnection& PostgresBackend::connection() const
@@ -1088,22 +1255,7 @@ uint64_t PostgresBackend::executeCountQuery(pqxx::transaction_base& transaction,
                                             const std::string_view& context,
                                             const std::vector<model::PrescriptionType>& prescriptionTypeParam)
 {
-    std::string completeQuery(query);
-
-    if (!prescriptionTypeParam.empty())
-    {
-        appendWherePrescriptionTypeIn(completeQuery, prescriptionTypeParam);
-    }
-    // Append an expression to the query for the search arguments, if there are any.
-    if (search.has_value())
-    {
-        const auto whereExpression = search->getSqlWhereExpression(transaction.conn());
-        if (! whereExpression.empty())
-        {
-            completeQuery += " AND ";
-            completeQuery += whereExpression;
-        }
-    }
+    const std::string completeQuery = completeCountQuery(transaction, query, search, prescriptionTypeParam);
 
     TVLOG(1) << completeQuery;
     const pqxx::result result = transaction.exec(completeQuery, pqxx::params{paramValue.binarystring()});
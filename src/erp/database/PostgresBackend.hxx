@@ -61,6 +61,7 @@ public:
                       const model::Timestamp& expiryDate,
                       const model::Timestamp& acceptDate,
                       const db_model::EncryptedBlob& healthCareProviderPrescription,
+                      const std::optional<db_model::EncryptedBlob>& prescriptionMetadata,
                       const db_model::EncryptedBlob& doctorIdentity,
                       const model::Timestamp& lastStatusUpdate,
                       bool euRedeemable, bool isPkv) override;
@@ -109,6 +110,8 @@ public:
     std::optional<db_model::Task> retrieveTaskForUpdate(const model::PrescriptionId& taskId) override;
     [[nodiscard]] ::std::optional<::db_model::Task>
     retrieveTaskForUpdateAndPrescription(const ::model::PrescriptionId& taskId) override;
+    [[nodiscard]] std::optional<db_model::Task>
+    retrieveTaskForUpdateAndPrescriptionMetadata(const model::PrescriptionId& taskId) override;
 
     [[nodiscard]]
     std::optional<db_model::Task> retrieveTaskAndReceipt(const model::PrescriptionId& taskId) override;
@@ -126,6 +129,12 @@ public:
                                                 const std::optional<UrlArguments>& search) override;
     [[nodiscard]] uint64_t countAllTasksForPatient(const db_model::HashedKvnr& kvnr, const std::optional<UrlArguments>& search) override;
     [[nodiscard]] uint64_t countAllEgkRedeemableTasks(const db_model::HashedKvnr& kvnr, const std::optional<UrlArguments>& search) override;
+    [[nodiscard]] std::tuple<std::vector<db_model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+    retrieveAllTasksForPatientWithTotal(const db_model::HashedKvnr& kvnrHashed,
+                                        const std::optional<UrlArguments>& search) override;
+    [[nodiscard]] std::tuple<std::vector<db_model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+    retrieveAllEgkRedeemableTasksWithAccessCodeAndTotal(const db_model::HashedKvnr& kvnrHashed,
+                                                        const std::optional<UrlArguments>& search) override;
     [[nodiscard]] std::vector<db_model::Task> retrieveAllTasksForEu(const db_model::HashedKvnr& kvnr,
                                                                     const std::optional<UrlArguments>& search) override;
     [[nodiscard]] uint64_t countAllTasksForEu(const db_model::HashedKvnr& kvnr, const std::optional<UrlArguments>& search) override;
@@ -214,6 +223,19 @@ public:
 private:
     PostgresBackendTask& getTaskBackend(model::PrescriptionType prescriptionType);
     static void appendWherePrescriptionTypeIn(std::string& query, const std::vector<model::PrescriptionType>& presciptionTypes);
+    static std::string completeCountQuery(pqxx::transaction_base& transaction, const std::string_view& query,
+                                          const std::optional<UrlArguments>& search,
+                                          const std::vector<model::PrescriptionType>& prescriptionTypeParam);
+    /**
+     * Select `columns` of the tasks of `kvnrHashed`, completed with the SQL expression of `search`, with one additional
+     * row to find out whether further tasks follow the page.
+     * For paged results, all matches are counted with `countQuery` in the same statement and returned in the
+     * additional column `total_count`. Only an empty page behind the last one needs a separate count.
+     */
+    std::tuple<std::vector<db_model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+    retrieveTasksWithTotal(const std::string_view& columns, const std::string_view& countQuery,
+                           const db_model::HashedKvnr& kvnrHashed, const std::optional<UrlArguments>& search,
+                           const std::vector<model::PrescriptionType>& prescriptionTypeParam);
 
     PostgresConnection& mConnection;
     PostgresBackendTask mBackendTask;
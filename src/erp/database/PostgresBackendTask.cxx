@@ -43,6 +43,15 @@ PostgresBackendTask::PostgresBackendTask(model::PrescriptionType prescriptionTyp
         FOR UPDATE
         )--")
 
+    QUERY(retrieveTaskByIdForUpdatePlusPrescriptionMetadata, R"--(
+        SELECT prescription_id, kvnr, EXTRACT(EPOCH FROM last_modified) as last_modified, EXTRACT(EPOCH FROM authored_on) as authored_on,
+            EXTRACT(EPOCH FROM expiry_date) as expiry_date, EXTRACT(EPOCH FROM accept_date) as accept_date, status, EXTRACT(EPOCH FROM last_status_update) as last_status_update, salt, task_key_blob_id,
+            access_code, secret, owner, prescription_metadata, EXTRACT(EPOCH from last_medication_dispense) as last_medication_dispense, eu_redeemable_patient, eu_redeemable, is_pkv
+        FROM )--" + taskTableName() + R"--(
+        WHERE prescription_id = $1
+        FOR UPDATE
+        )--")
+
     QUERY(retrieveTaskByIdPlusPrescription, R"--(
         SELECT prescription_id, kvnr, EXTRACT(EPOCH FROM last_modified) as last_modified, EXTRACT(EPOCH FROM authored_on) as authored_on,
             EXTRACT(EPOCH FROM expiry_date) as expiry_date, EXTRACT(EPOCH FROM accept_date) as accept_date, status, EXTRACT(EPOCH FROM last_status_update) as last_status_update, salt, task_key_blob_id,
@@ -92,7 +101,8 @@ PostgresBackendTask::PostgresBackendTask(model::PrescriptionType prescriptionTyp
     QUERY(updateTask_activateTask, R"--(
         UPDATE )--" + taskTableName() + R"--(
         SET kvnr = $2, kvnr_hashed = $3, last_modified = $4, expiry_date = $5, accept_date = $6, status = $7,
-            healthcare_provider_prescription = $8, doctor_identity = $9, last_status_update = $10, eu_redeemable = $11, is_pkv = $12
+            healthcare_provider_prescription = $8, doctor_identity = $9, last_status_update = $10, eu_redeemable = $11, is_pkv = $12,
+            prescription_metadata = $13
         WHERE prescription_id = $1
         )--")
 
@@ -137,7 +147,7 @@ PostgresBackendTask::PostgresBackendTask(model::PrescriptionType prescriptionTyp
     QUERY(updateTask_deletePersonalData, R"--(
         UPDATE )--" + taskTableName() + R"--(
         SET status = $2, last_modified = $3, kvnr = NULL, salt = NULL, access_code = NULL,
-            secret = NULL, owner = NULL, healthcare_provider_prescription = NULL, receipt = NULL,
+            secret = NULL, owner = NULL, healthcare_provider_prescription = NULL, prescription_metadata = NULL, receipt = NULL,
             when_handed_over = NULL, when_prepared = NULL, performer = NULL,
             medication_dispense_blob_id = NULL, medication_dispense_bundle = NULL, last_medication_dispense = NULL,
             doctor_identity = NULL, pharmacy_identity=NULL, last_status_update = $4
@@ -276,6 +286,7 @@ void PostgresBackendTask::activateTask(pqxx::transaction_base& transaction, cons
                                        const model::Timestamp& lastModified, const model::Timestamp& expiryDate,
                                        const model::Timestamp& acceptDate,
                                        const db_model::EncryptedBlob& healthCareProviderPrescription,
+                                       const std::optional<db_model::EncryptedBlob>& prescriptionMetadata,
                                        const db_model::EncryptedBlob& doctorIdentity,
                                        const model::Timestamp& lastStatusUpdate,
                                        bool euRedeemable, bool isPkv) const
@@ -285,12 +296,17 @@ void PostgresBackendTask::activateTask(pqxx::transaction_base& transaction, cons
         DurationConsumer::getCurrent().getTimer(DurationCategory::postgres, "activatetask");
 
     const auto status = model::Task::toNumericalStatus(taskStatus);
+    std::optional<db_model::postgres_bytea_view> prescriptionMetadataBin;
+    if (prescriptionMetadata.has_value())
+    {
+        prescriptionMetadataBin = prescriptionMetadata->binarystring();
+    }
 
     const pqxx::result result = transaction.exec(
         mQueries.updateTask_activateTask.query, {taskId.toDatabaseId(), encryptedKvnr.binarystring(),
         hashedKvnr.binarystring(), lastModified.toXsDateTime(), expiryDate.toGermanDate(), acceptDate.toGermanDate(),
         static_cast<int>(status), healthCareProviderPrescription.binarystring(), doctorIdentity.binarystring(),
-        lastStatusUpdate.toXsDateTime(), euRedeemable, isPkv}).no_rows();
+        lastStatusUpdate.toXsDateTime(), euRedeemable, isPkv, prescriptionMetadataBin}).no_rows();
     TVLOG(2) << "got " << result.size() << " results";
 
     Expect(result.empty(), "Expected an empty result");
@@ -492,6 +508,28 @@ PostgresBackendTask::retrieveTaskForUpdateAndPrescription(::pqxx::transaction_ba
     return {};
 }
 
+std::optional<db_model::Task>
+PostgresBackendTask::retrieveTaskForUpdateAndPrescriptionMetadata(pqxx::transaction_base& transaction,
+                                                                  const model::PrescriptionId& taskId)
+{
+    TVLOG(2) << mQueries.retrieveTaskByIdForUpdatePlusPrescriptionMetadata.query;
+
+    const auto timerKeepAlive = DurationConsumer::getCurrent().getTimer(
+        DurationCategory::postgres, "retrievetaskforupdateandprescriptionmetadata");
+
+    const auto result = transaction.exec(mQueries.retrieveTaskByIdForUpdatePlusPrescriptionMetadata.query,
+                                         pqxx::params{taskId.toDatabaseId()});
+
+    TVLOG(2) << "got " << result.size() << " results";
+    Expect(result.size() <= 1, "Too many results in result set.");
+    if (! result.empty())
+    {
+        return taskFromQueryResultRow(result.front(), mPrescriptionType);
+    }
+
+    return {};
+}
+
 
 std::optional<db_model::Task> PostgresBackendTask::retrieveTaskAndReceipt(pqxx::transaction_base& transaction,
                                                                           const model::PrescriptionId& taskId)
@@ -600,6 +638,7 @@ struct TaskQueryIndexes {
     std::optional<pqxx::row::size_type> secretIndex;
     std::optional<pqxx::row::size_type> ownerIndex;
     std::optional<pqxx::row::size_type> healthcareProviderPrescriptionIndex;
+    std::optional<pqxx::row::size_type> prescriptionMetadataIndex;
     std::optional<pqxx::row::size_type> receiptIndex;
     std::optional<pqxx::row::size_type> lastMedicationDispenseIndex;
     std::optional<pqxx::row::size_type> euRedeemableByPatientIndex;
@@ -676,6 +715,9 @@ TaskQueryIndexes buildIndexes(const pqxx::row& resultRow)
         case healthcare_provider_prescription:
             result.healthcareProviderPrescriptionIndex = idx;
             break;
+        case prescription_metadata:
+            result.prescriptionMetadataIndex = idx;
+            break;
         case receipt:
             result.receiptIndex = idx;
             break;
@@ -708,6 +750,7 @@ TaskQueryIndexes buildIndexes(const pqxx::row& resultRow)
         case medication_dispense_salt:
         case doctor_identity:
         case pharmacy_identity:
+        case total_count:
             // no index
             break;
         }
@@ -829,6 +872,12 @@ db_model::Task PostgresBackendTask::taskFromQueryResultRow(const pqxx::row& resu
             resultRow.at(*indexes.healthcareProviderPrescriptionIndex).as<db_model::postgres_bytea>());
     }
 
+    if (checkIndexAndRow(indexes.prescriptionMetadataIndex, resultRow))
+    {
+        dbTask.prescriptionMetadata.emplace(
+            resultRow.at(*indexes.prescriptionMetadataIndex).as<db_model::postgres_bytea>());
+    }
+
     if (checkIndexAndRow(indexes.lastMedicationDispenseIndex, resultRow))
     {
         dbTask.lastMedicationDispense.emplace(resultRow.at(*indexes.lastMedicationDispenseIndex).as<double>());
@@ -59,6 +59,8 @@ public:
         eu_redeemable,
         eu_redeemable_patient,
         is_pkv,
+        prescription_metadata,
+        total_count,
     };
 
     explicit PostgresBackendTask(model::PrescriptionType prescriptionType);
@@ -84,6 +86,7 @@ public:
                       model::Task::Status taskStatus, const model::Timestamp& lastModified,
                       const model::Timestamp& expiryDate, const model::Timestamp& acceptDate,
                       const db_model::EncryptedBlob& healthCareProviderPrescription,
+                      const std::optional<db_model::EncryptedBlob>& prescriptionMetadata,
                       const db_model::EncryptedBlob& doctorIdentity, const model::Timestamp& lastStatusUpdate,
                       bool euRedeemable, bool isPkv) const;
 
@@ -125,6 +128,9 @@ public:
                                                         const model::PrescriptionId& taskId);
     [[nodiscard]] ::std::optional<::db_model::Task>
     retrieveTaskForUpdateAndPrescription(::pqxx::transaction_base& transaction, const ::model::PrescriptionId& taskId);
+    [[nodiscard]] std::optional<db_model::Task>
+    retrieveTaskForUpdateAndPrescriptionMetadata(pqxx::transaction_base& transaction,
+                                                 const model::PrescriptionId& taskId);
 
     [[nodiscard]] std::optional<db_model::Task> retrieveTaskAndReceipt(pqxx::transaction_base& transaction,
                                                                        const model::PrescriptionId& taskId);
@@ -165,6 +171,7 @@ private:
         QueryDefinition retrieveTaskById;
         QueryDefinition retrieveTaskByIdPlusReceipt;
         QueryDefinition retrieveTaskByIdForUpdatePlusPrescription;
+        QueryDefinition retrieveTaskByIdForUpdatePlusPrescriptionMetadata;
         QueryDefinition retrieveTaskByIdPlusPrescription;
         QueryDefinition retrieveTaskWithSecretByIdPlusPrescription;
         QueryDefinition retrieveTaskByIdPlusPrescriptionPlusReceipt;
@@ -212,6 +212,11 @@ const rapidjson::Pointer systemPointerRelToInOutArray("/type/coding/0/system");
 const rapidjson::Pointer valueStringPointerRelToInOutArray("/valueReference/reference");
 const rapidjson::Pointer systemRelPointer("/system");
 const rapidjson::Pointer valueRelPointer ("/value");
+// extension array entries
+const rapidjson::Pointer urlRelPointer("/url");
+const rapidjson::Pointer valueInstantRelPointer("/valueInstant");
+const rapidjson::Pointer valueDateRelPointer("/valueDate");
+const rapidjson::Pointer valueBooleanRelPointer("/valueBoolean");
 
 constexpr std::string_view codeInputHealthCareProviderPrescription = "1";
 constexpr std::string_view codeInputPatientConfirmation = "2";
@@ -447,10 +452,8 @@ Timestamp Task::acceptDate() const
 std::optional<Timestamp> Task::lastMedicationDispense() const
 {
     const std::string_view url(resource::structure_definition::lastMedicationDispense);
-    const rapidjson::Pointer urlPointer("/url");
-    const rapidjson::Pointer valueInstantPointer("/valueInstant");
     const auto arrayEntry = findStringInArray(
-        extensionArrayPointer, urlPointer, url, valueInstantPointer);
+        extensionArrayPointer, urlRelPointer, url, valueInstantRelPointer);
     // ModelExpect(arrayEntry.has_value(), std::string(url) + " is missing from extension array");
     if (arrayEntry.has_value()) {
         return Timestamp::fromFhirDateTime(std::string(arrayEntry.value()));
@@ -460,10 +463,8 @@ std::optional<Timestamp> Task::lastMedicationDispense() const
 
 Timestamp Task::dateFromExtensionArray(std::string_view url) const
 {
-    const rapidjson::Pointer urlPointer("/url");
-    const rapidjson::Pointer valueDatePointer("/valueDate");
     const auto arrayEntry = findStringInArray(
-        extensionArrayPointer, urlPointer, url, valueDatePointer);
+        extensionArrayPointer, urlRelPointer, url, valueDateRelPointer);
     ModelExpect(arrayEntry.has_value(), std::string(url) + " is missing from extension array");
     return Timestamp::fromGermanDate(std::string(arrayEntry.value()));
 }
@@ -621,38 +622,31 @@ void Task::setEuRedeemableByProperties(bool euRedeemable)
 
 void Task::booleanToExtensionArray(std::string_view url, bool value)
 {
-    const rapidjson::Pointer urlPointer("/url");
-    const rapidjson::Pointer valueBooleanPointer("/valueBoolean");
-    const auto found = findMemberInArray(extensionArrayPointer, urlPointer, url, valueBooleanPointer);
+    const auto found = findMemberInArray(extensionArrayPointer, urlRelPointer, url, valueBooleanRelPointer);
     if (found)
     {
         removeFromArray(extensionArrayPointer, std::get<size_t>(found.value()));
     }
     auto newValue = copyValue(*ExtensionBooleanTemplate);
-    setKeyValue(newValue, urlPointer, url);
-    setKeyValue(newValue, valueBooleanPointer, rapidjson::Value(value));
+    setKeyValue(newValue, urlRelPointer, url);
+    setKeyValue(newValue, valueBooleanRelPointer, rapidjson::Value(value));
     addToArray(extensionArrayPointer, std::move(newValue));
 }
 
 void Task::dateToExtensionArray(std::string_view url, const Timestamp& date)
 {
-    const rapidjson::Pointer urlPointer("/url");
-    const rapidjson::Pointer valueDatePointer("/valueDate");
-    const auto found = findStringInArray(extensionArrayPointer, urlPointer, url, valueDatePointer);
+    const auto found = findStringInArray(extensionArrayPointer, urlRelPointer, url, valueDateRelPointer);
     ModelExpect(!found.has_value(), std::string(url) + " can only be set once");
 
     auto newValue = copyValue(*ExtensionDateTemplate);
-    setKeyValue(newValue, urlPointer, url);
-    setKeyValue(newValue, valueDatePointer, date.toGermanDate());
+    setKeyValue(newValue, urlRelPointer, url);
+    setKeyValue(newValue, valueDateRelPointer, date.toGermanDate());
     addToArray(extensionArrayPointer, std::move(newValue));
 }
 
 void Task::instantToExtensionArray(std::string_view url, const std::optional<Timestamp>& date)
 {
-    const rapidjson::Pointer urlPointer("/url");
-    const rapidjson::Pointer valueInstantPointer("/valueInstant");
-
-    const auto instantAndPos = findMemberInArray(extensionArrayPointer, urlPointer, url, valueInstantPointer, true);
+    const auto instantAndPos = findMemberInArray(extensionArrayPointer, urlRelPointer, url, valueInstantRelPointer, true);
     if(instantAndPos)
     {
         removeFromArray(extensionArrayPointer, std::get<1>(instantAndPos.value()));
@@ -661,8 +655,8 @@ void Task::instantToExtensionArray(std::string_view url, const std::optional<Tim
     if(date)
     {
         auto newValue = copyValue(*ExtensionInstantTemplate);
-        setKeyValue(newValue, urlPointer, url);
-        setKeyValue(newValue, valueInstantPointer, date.value().toXsDateTimeWithoutFractionalSeconds());
+        setKeyValue(newValue, urlRelPointer, url);
+        setKeyValue(newValue, valueInstantRelPointer, date.value().toXsDateTimeWithoutFractionalSeconds());
         addToArray(extensionArrayPointer, std::move(newValue));
     }
 }
@@ -732,12 +726,9 @@ void Task::deleteOwner()
 
 void Task::deleteLastMedicationDispense()
 {
-    const rapidjson::Pointer urlPointer("/url");
-    const rapidjson::Pointer valueInstantPointer("/valueInstant");
-
     const auto lastMDAndPos =
-        findMemberInArray(extensionArrayPointer, urlPointer, resource::structure_definition::lastMedicationDispense,
-                          valueInstantPointer, true);
+        findMemberInArray(extensionArrayPointer, urlRelPointer, resource::structure_definition::lastMedicationDispense,
+                          valueInstantRelPointer, true);
     if (lastMDAndPos)
     {
         removeFromArray(extensionArrayPointer, std::get<1>(lastMDAndPos.value()));
@@ -746,11 +737,9 @@ void Task::deleteLastMedicationDispense()
 
 void Task::deleteEuRedeemableByProperties()
 {
-    const rapidjson::Pointer urlPointer("/url");
-    const rapidjson::Pointer valueBooleanPointer("/valueBoolean");
     const auto arrayEntryAndIndex = findMemberInArray(
-        extensionArrayPointer, urlPointer, resource::structure_definition::gem_erp_ex_eu_is_redeemable_by_properties,
-        valueBooleanPointer, true);
+        extensionArrayPointer, urlRelPointer, resource::structure_definition::gem_erp_ex_eu_is_redeemable_by_properties,
+        valueBooleanRelPointer, true);
     if (arrayEntryAndIndex)
     {
         removeFromArray(extensionArrayPointer, std::get<size_t>(*arrayEntryAndIndex));
@@ -7,6 +7,8 @@
 #include "shared/util/Expect.hxx"
 #include "shared/hsm/HsmPool.hxx"
 
+#include <atomic>
+
 
 namespace
 {
@@ -22,6 +24,16 @@ namespace
 }
 
 
+struct CFdSigErpManager::OcspSnapshot
+{
+    /// the C.FD.SIG eRP certificate the OCSP response belongs to
+    std::string certificateBase64Der;
+    /// the TSL trust store generation the certificate was validated with
+    uint64_t trustStoreGeneration;
+    OcspResponse responseData;
+};
+
+
 // GEMREQ-start A_20974-01#creation,A_20765-02#creation
 CFdSigErpManager::CFdSigErpManager(const Configuration& configuration, TslManager& tslManager, HsmPool& hsmPool)
     : TimerJobBase("CFdSigErpManager job", getOcspRequestInterval(configuration))
@@ -31,9 +43,16 @@ CFdSigErpManager::CFdSigErpManager(const Configuration& configuration, TslManage
     , mLastProducedAt()
     // the default C.FD.OSIG eRP Signer certificate OCSP grace period is defined in A_20765-02
     , mOcspRequestGracePeriod( std::chrono::seconds(configuration.getIntValue(ConfigurationKey::OCSP_C_FD_SIG_ERP_GRACE_PERIOD)))
+    , mOcspSnapshot()
     , mCFdSigErpKey()
     , mPkBlob()
 {
+    if (getOcspRequestInterval(configuration) >= mOcspRequestGracePeriod)
+    {
+        TLOG(WARNING) << "C.FD.SIG eRP validation interval is not shorter than the OCSP grace period, "
+                         "signing will fail when the OCSP response expires before the next validation";
+    }
+
     // trigger the first execution synchronously
     executeJob();
 
@@ -61,8 +80,11 @@ CFdSigErpManager::~CFdSigErpManager()
 [[nodiscard]] Certificate CFdSigErpManager::getCertificate()
 {
     auto cFdSigErp = mHsmPool.acquire().session().getVauSigCertificate();
-    // triggers certificate validation if necessary
-    internalGetOcspResponseData(cFdSigErp, false);
+    if (currentOcspSnapshot(cFdSigErp) == nullptr)
+    {
+        // triggers certificate validation if necessary
+        internalGetOcspResponseData(cFdSigErp, false);
+    }
     return cFdSigErp;
 }
 
@@ -78,6 +100,14 @@ shared_EVP_PKEY CFdSigErpManager::getPrivateKey()
 OcspResponse CFdSigErpManager::getOcspResponseData(const bool forceOcspRequest)
 {
     auto cFdSigErp = mHsmPool.acquire().session().getVauSigCertificate();
+    if (! forceOcspRequest)
+    {
+        const auto snapshot = currentOcspSnapshot(cFdSigErp);
+        if (snapshot != nullptr)
+        {
+            return snapshot->responseData;
+        }
+    }
     return internalGetOcspResponseData(cFdSigErp, forceOcspRequest);
 }
 
@@ -85,6 +115,11 @@ OcspResponse CFdSigErpManager::getOcspResponseData(const bool forceOcspRequest)
 OcspResponsePtr CFdSigErpManager::getOcspResponse()
 {
     auto cFdSigErp = mHsmPool.acquire().session().getVauSigCertificate();
+    const auto snapshot = currentOcspSnapshot(cFdSigErp);
+    if (snapshot != nullptr)
+    {
+        return OcspHelper::stringToOcspResponse(snapshot->responseData.response);
+    }
     auto responseData = internalGetOcspResponseData(cFdSigErp, false);
     return OcspHelper::stringToOcspResponse(responseData.response);
 }
@@ -94,6 +129,9 @@ OcspResponsePtr CFdSigErpManager::getOcspResponse()
 OcspResponse
 CFdSigErpManager::internalGetOcspResponseData(const Certificate& certificate, const bool forceOcspRequest)
 {
+    const auto previousSnapshot = mOcspSnapshot.load();
+    // read before the validation, a later distrust or TSL update makes the snapshot outdated
+    const auto trustStoreGeneration = mTslManager.getValidTrustStoreGeneration(TslMode::TSL);
     try
     {
         auto x509Certificate = X509Certificate::createFromBase64(certificate.toBase64Der());
@@ -125,10 +163,22 @@ CFdSigErpManager::internalGetOcspResponseData(const Certificate& certificate, co
             TLOG(WARNING) << "OCSP request has failed, last successful OCSP response was done at "
                             << model::Timestamp(responseData.receivedAt).toXsDateTime();
         }
+
+        if (trustStoreGeneration.has_value())
+        {
+            auto snapshot = std::make_shared<OcspSnapshot>(
+                OcspSnapshot{certificate.toBase64Der(), *trustStoreGeneration, responseData});
+            // later requests are answered from the snapshot, like from the OCSP cache before
+            snapshot->responseData.fromCache = true;
+            publishOcspSnapshot(std::move(snapshot));
+        }
         return responseData;
     }
     catch(const TslError& tslError)
     {
+        // only drop the snapshot this validation has started with, not one published concurrently
+        auto expectedSnapshot = previousSnapshot;
+        mOcspSnapshot.compare_exchange_strong(expectedSnapshot, std::shared_ptr<const OcspSnapshot>{});
         std::unique_lock lock{mLastProducedAtMutex};
         mLastProducedAt = std::chrono::system_clock::time_point{};
         // in this context TslError always means service unavailable error
@@ -138,6 +188,42 @@ CFdSigErpManager::internalGetOcspResponseData(const Certificate& certificate, co
 // GEMREQ-end A_20765-02#validation
 
 
+void CFdSigErpManager::publishOcspSnapshot(std::shared_ptr<const OcspSnapshot> snapshot)
+{
+    auto current = mOcspSnapshot.load();
+    do
+    {
+        if (current != nullptr && current->certificateBase64Der == snapshot->certificateBase64Der &&
+            (current->trustStoreGeneration > snapshot->trustStoreGeneration ||
+             (current->trustStoreGeneration == snapshot->trustStoreGeneration &&
+              current->responseData.producedAt >= snapshot->responseData.producedAt)))
+        {
+            // a concurrent validation has already published a response that is at least as recent
+            return;
+        }
+    } while (! mOcspSnapshot.compare_exchange_weak(current, snapshot));
+}
+
+
+std::shared_ptr<const CFdSigErpManager::OcspSnapshot>
+CFdSigErpManager::currentOcspSnapshot(const Certificate& certificate) const
+{
+    auto snapshot = mOcspSnapshot.load();
+    if (snapshot == nullptr || snapshot->certificateBase64Der != certificate.toBase64Der() ||
+        std::chrono::system_clock::now() - snapshot->responseData.producedAt > mOcspRequestGracePeriod)
+    {
+        return nullptr;
+    }
+    // GS-A_4898: the TSL validity is checked each time the certificate is used,
+    // an outdated TSL or a distrusted or updated trust store invalidates the snapshot
+    if (mTslManager.getValidTrustStoreGeneration(TslMode::TSL) != snapshot->trustStoreGeneration)
+    {
+        return nullptr;
+    }
+    return snapshot;
+}
+
+
 void CFdSigErpManager::healthCheck()
 {
     std::shared_lock lock{mLastProducedAtMutex};
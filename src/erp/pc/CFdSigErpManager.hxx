@@ -6,6 +6,8 @@
 #include "shared/deprecated/TimerJobBase.hxx"
 #include "shared/deprecated/Timer.hxx"
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 
 class Configuration;
@@ -18,6 +20,11 @@ class TslManager;
 /**
  * This class allows to manage C.FD.SIG certificate of eRP processing context
  * including required validations.
+ *
+ * The result of the last successful validation is published as an immutable snapshot with an atomic pointer swap.
+ * Signing requests are served from the snapshot without a TSL or OCSP lookup as long as it belongs to the current
+ * C.FD.SIG eRP certificate and its OCSP response is within the OCSP-Grace-Period. The snapshot is replaced by the periodic validation of the timer job, after
+ * TSL and blob cache updates, and it is dropped when a validation fails.
  */
 class CFdSigErpManager : public TimerJobBase
 {
@@ -44,7 +51,7 @@ public:
      * OCSP-Response related data for C.FD.SIG eRP certificate if the last validation was successful,
      * or throws TslError in case of problems.
      *
-     * @param forceOcspRequest if set to true the OCSP-request is forced
+     * @param forceOcspRequest if set to true the OCSP-request is forced, otherwise the published snapshot is used
      */
     OcspResponse getOcspResponseData(const bool forceOcspRequest);
 
@@ -82,8 +89,24 @@ protected:
     void onFinish(void) override;
 
 private:
+    struct OcspSnapshot;
+
     OcspResponse internalGetOcspResponseData(const Certificate& certificate, const bool forceOcspRequest);
 
+    /**
+     * Publishes the snapshot unless the current one belongs to the same certificate and is at least as recent,
+     * i.e. it has a newer trust store generation or the same one and an OCSP response that is not older.
+     * This way a slower concurrent validation does not replace a newer OCSP response.
+     */
+    void publishOcspSnapshot(std::shared_ptr<const OcspSnapshot> snapshot);
+
+    /**
+     * Returns the published snapshot or nullptr if there is none, it belongs to another certificate,
+     * its OCSP response is outside of the grace period, or the TSL trust store is too old or has changed
+     * since the snapshot was published.
+     */
+    std::shared_ptr<const OcspSnapshot> currentOcspSnapshot(const Certificate& certificate) const;
+
     TslManager& mTslManager;
     std::optional<size_t> mValidationHookId;
     HsmPool& mHsmPool;
@@ -93,6 +116,8 @@ private:
 
     std::chrono::system_clock::duration mOcspRequestGracePeriod;
 
+    std::atomic<std::shared_ptr<const OcspSnapshot>> mOcspSnapshot;
+
     // private key cache
     shared_EVP_PKEY mCFdSigErpKey;
     ErpBlob mPkBlob;
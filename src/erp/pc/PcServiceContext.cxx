@@ -8,6 +8,7 @@
 #include "erp/pc/PcServiceContext.hxx"
 #include "erp/ErpProcessingContext.hxx"
 #include "erp/admin/AdminServer.hxx"
+#include "erp/database/AuditEventWriter.hxx"
 #include "erp/database/Database.hxx"
 #include "erp/database/PostgresBackend.hxx"
 #include "erp/database/RedisClient.hxx"
@@ -16,6 +17,7 @@
 #include "erp/registration/RegistrationInterface.hxx"
 #include "erp/registration/RegistrationManager.hxx"
 #include "erp/util/RuntimeConfiguration.hxx"
+#include "erp/util/health/HealthCheck.hxx"
 #include "shared/ErpRequirements.hxx"
 #include "shared/crypto/EllipticCurveUtils.hxx"
 #include "shared/enrolment/EnrolmentServer.hxx"
@@ -84,6 +86,8 @@ PcServiceContext::PcServiceContext(const Configuration& configuration, const Fac
                 configuration.getIntValue(ConfigurationKey::HTTPCLIENT_RESOLVE_TIMEOUT_MILLISECONDS)});
         requestSender->setFollowRedirects(true);
         requestSender->setProxies(configuration.proxyParameters(ProxyMode::HTTP));
+        requestSender->setConnectionReuse(std::chrono::seconds{
+            configuration.getOptionalIntValue(ConfigurationKey::HTTPCLIENT_KEEP_ALIVE_IDLE_SECONDS, 0)});
         mCrlProvider = std::make_shared<CrlDownloadCache>(std::move(requestSender));
     }
 
@@ -107,10 +111,20 @@ PcServiceContext::PcServiceContext(const Configuration& configuration, const Fac
                                                             std::move(enrolmentHandlers), *this, false, SafeString{});
     }
     mBlobCache->registerCacheUpdateCallback([this]{mCFdSigErpManager->updateOcspResponseCacheOnBlobCacheUpdate();});
+    mAuditEventWriter = AuditEventWriter::fromConfiguration(configuration, [this] {
+        return databaseFactory();
+    });
+    mHealthCheck = std::make_unique<HealthCheck>(*this, configuration);
 }
 
 PcServiceContext::~PcServiceContext()
 {
+    // running checks use the other members
+    mHealthCheck.reset();
+    if (mAuditEventWriter != nullptr)
+    {
+        mAuditEventWriter->stop();
+    }
     if (mReportPseudonameKeyRefreshJob != nullptr)
     {
         mReportPseudonameKeyRefreshJob->shutdown();
@@ -176,6 +190,16 @@ const AuditEventTextTemplates& PcServiceContext::auditEventTextTemplates() const
     return mAuditEventTextTemplates;
 }
 
+AuditEventWriter* PcServiceContext::auditEventWriter() const
+{
+    return mAuditEventWriter.get();
+}
+
+HealthCheck& PcServiceContext::healthCheck()
+{
+    return *mHealthCheck;
+}
+
 void PcServiceContext::setPrngSeeder(std::unique_ptr<SeedTimer>&& prngTimer)
 {
     mPrngSeeder = std::move(prngTimer);
@@ -24,6 +24,8 @@
 #include <memory>
 
 
+class AuditEventWriter;
+class HealthCheck;
 class BlobCache;
 class BlobDatabase;
 class VsdmKeyBlobDatabase;
@@ -95,6 +97,14 @@ public:
 
     const AuditEventTextTemplates& auditEventTextTemplates() const;
 
+    /**
+     * Returns the background writer for audit events or nullptr when audit events are written in the
+     * request transaction.
+     */
+    AuditEventWriter* auditEventWriter() const;
+
+    HealthCheck& healthCheck();
+
     const SeedTimer* getPrngSeeder() const;
 
     const IPoPPCertificateVerifierService& getPoPPService() const;
@@ -137,6 +147,8 @@ private:
     gsl::not_null<std::shared_ptr<erp::RuntimeConfiguration>> mRuntimeConfiguration;
 
     std::unique_ptr<IPoPPCertificateVerifierService> mPoPPService;
+    std::unique_ptr<AuditEventWriter> mAuditEventWriter;
+    std::unique_ptr<HealthCheck> mHealthCheck;
 };
 
 class SessionContext;
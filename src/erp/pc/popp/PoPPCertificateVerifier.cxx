@@ -341,6 +341,8 @@ PoPPCertificateVerifier::PoPPCertificateVerifier(boost::asio::io_context& contex
     , mTslManager(tslManager)
 {
     mRequestSender->setProxies(Configuration::instance().proxyParameters(ProxyMode::SNI));
+    mRequestSender->setConnectionReuse(std::chrono::seconds{
+        Configuration::instance().getOptionalIntValue(ConfigurationKey::HTTPCLIENT_KEEP_ALIVE_IDLE_SECONDS, 0)});
 }
 
 PoPPCertificateVerifier::PoPPCertificateVerifier(boost::asio::io_context& context,
@@ -50,7 +50,7 @@ ApplicationHealthAndRegistrationUpdater::ApplicationHealthAndRegistrationUpdater
 
 void ApplicationHealthAndRegistrationUpdater::onStart(void)
 {
-    HealthCheck::update(mServiceContext);
+    mServiceContext.healthCheck().update();
     try
     {
         mRegistration->updateRegistrationBasedOnApplicationHealth(mServiceContext.applicationHealth());
@@ -69,7 +69,7 @@ void ApplicationHealthAndRegistrationUpdater::onStart(void)
 
 void ApplicationHealthAndRegistrationUpdater::executeJob(void)
 {
-    HealthCheck::update(mServiceContext);
+    mServiceContext.healthCheck().update();
     bool registered = false;
     try
     {
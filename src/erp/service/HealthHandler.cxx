@@ -20,7 +20,7 @@ void HealthHandler::handleRequest(BaseSessionContext& baseSessionContext)
     std::optional<model::Health> healthResource;
     try
     {
-        HealthCheck::update(session.serviceContext);
+        session.serviceContext.healthCheck().updateIfOutdated();
         healthResource = session.serviceContext.applicationHealth().model();
     }
     catch (const std::exception& ex)
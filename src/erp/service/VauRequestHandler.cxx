@@ -7,6 +7,7 @@
 
 #include "erp/service/VauRequestHandler.hxx"
 #include "erp/crypto/DtbpPseudonymization.hxx"
+#include "erp/database/AuditEventWriter.hxx"
 #include "erp/database/Database.hxx"
 #include "erp/database/redis/RateLimiter.hxx"
 #include "erp/model/OuterResponseErrorData.hxx"
@@ -17,6 +18,7 @@
 #include "erp/tee/ErpTeeProtocol.hxx"
 #include "erp/tee/InnerTeeRequest.hxx"
 #include "erp/util/RuntimeConfiguration.hxx"
+#include "fhirtools/model/JsonArena.hxx"
 #include "shared/ErpRequirements.hxx"
 #include "shared/crypto/AesGcm.hxx"
 #include "shared/crypto/CMAC.hxx"
@@ -36,12 +38,24 @@
 
 #include <boost/exception/diagnostic_information.hpp>
 #include <pqxx/except>
+#include <optional>
 #include <typeinfo>
 
 namespace
 {
 
-void storeAuditData(PcSessionContext& sessionContext, const JWT& accessToken)
+/// audit data that is written by the AuditEventWriter once the transaction of the request has been committed
+struct PendingAuditData
+{
+    AuditEventWriter::Reservation reservation;
+    model::AuditData auditData;
+};
+
+/**
+ * Stores the audit data in the transaction of the request. If audit events are written asynchronously, only a place
+ * in the queue of the writer is reserved and the data is returned, to be enqueued after the commit.
+ */
+std::optional<PendingAuditData> storeAuditData(PcSessionContext& sessionContext, const JWT& accessToken)
 {
     A_19391_01.start("Use name of caller for audit logging");
     A_19392.start("Use id of caller for audit logging");
@@ -53,9 +67,17 @@ void storeAuditData(PcSessionContext& sessionContext, const JWT& accessToken)
     try
     {
         model::AuditData auditData = sessionContext.auditDataCollector().createData();
+        auto* auditEventWriter = sessionContext.serviceContext.auditEventWriter();
+        if (auditEventWriter != nullptr)
+        {
+            // Written by the background writer, the request only fails if there is no place in the queue.
+            auto reservation = auditEventWriter->reserve();
+            return PendingAuditData{.reservation = std::move(reservation), .auditData = std::move(auditData)};
+        }
         // Store in database
         const auto id = sessionContext.database()->storeAuditEventData(auditData);
         TVLOG(1) << "AuditEvent record with id " << id << " created";
+        return std::nullopt;
     }
     catch(const MissingAuditDataException& exc)
     {
@@ -366,6 +388,14 @@ void VauRequestHandler::handleInnerRequest(PcSessionContext& outerSession,
                                            const std::string& upParam,
                                            std::unique_ptr<InnerTeeRequest> innerTeeRequest)
 {
+    // all FHIR documents of the inner request, including the response, share one memory pool
+    std::shared_ptr<model::JsonArena> jsonArena;
+    if (Configuration::instance().getBoolValue(ConfigurationKey::SERVICE_REQUEST_JSON_ARENA))
+    {
+        jsonArena = std::make_shared<model::JsonArena>();
+    }
+    const model::JsonArena::Scope jsonArenaScope{jsonArena};
+
     std::unique_ptr<ServerRequest> innerServerRequest;
     ServerResponse innerServerResponse;
     // Remove when all endpoints are implemented (or update missing endpoint return values.)
@@ -418,18 +448,29 @@ void VauRequestHandler::handleInnerRequest(PcSessionContext& outerSession,
         // GEMREQ-start A_19439, A_20373, A_20365,A_20163
         A_20163.start("4 - verify JWT");
         A_20365_01.start("Pass the IDP pubkey to the verification method.");
-        try
+        auto& idp = outerSession.serviceContext.idp;
+        const auto idpGeneration = idp.getGeneration();
+        if (idp.verifiedTokenCache().contains(innerServerRequest->getAccessToken(), idpGeneration))
         {
-            innerServerRequest->getAccessToken().verify(getIdpPublicKey(outerSession.serviceContext));
+            // Format, claims and signature of this exact token have been verified before.
+            innerServerRequest->getAccessToken().checkIfExpired();
         }
-        catch (const std::exception& e)
+        else
         {
-            const auto& cert = outerSession.serviceContext.idp.getSecondaryCertificate();
-            if (! cert.has_value())
+            try
             {
-                throw;
+                innerServerRequest->getAccessToken().verify(getIdpPublicKey(outerSession.serviceContext));
             }
-            innerServerRequest->getAccessToken().verify(cert->getPublicKey());
+            catch (const std::exception& e)
+            {
+                const auto& cert = idp.getSecondaryCertificate();
+                if (! cert.has_value())
+                {
+                    throw;
+                }
+                innerServerRequest->getAccessToken().verify(cert->getPublicKey());
+            }
+            idp.verifiedTokenCache().store(innerServerRequest->getAccessToken(), idpGeneration);
         }
         A_20365_01.finish();
         A_20163.finish();
@@ -489,6 +530,12 @@ void VauRequestHandler::handleInnerRequest(PcSessionContext& outerSession,
     }
     // GEMREQ-end A_19439#catchError
     makeResponse(innerServerResponse, innerOperation, innerServerRequest.get(), *innerTeeRequest, outerSession);
+    if (jsonArena)
+    {
+        outerSession.accessLog.keyValue("json_arena_documents", jsonArena->documentCount());
+        outerSession.accessLog.keyValue("json_arena_used_bytes", jsonArena->usedBytes());
+        outerSession.accessLog.keyValue("json_arena_capacity_bytes", jsonArena->capacityBytes());
+    }
 }
 
 void VauRequestHandler::handleInnerRequest(const RequestHandlerManager::MatchingHandler& matchingHandler,
@@ -524,10 +571,10 @@ void VauRequestHandler::handleInnerRequest(const RequestHandlerManager::Matching
         currExc = std::current_exception();
     }
 
-    if (shouldCreateAuditEvent)
-    {
-        storeAuditData(innerSession, innerSession.request.getAccessToken());
-    }
+    // AuditData is not assignable, therefore the optional is initialized directly
+    auto pendingAuditData = shouldCreateAuditEvent
+                                ? storeAuditData(innerSession, innerSession.request.getAccessToken())
+                                : std::nullopt;
 
     A_18936.start("commit transaction");
     auto transaction = innerSession.releaseDatabase();
@@ -538,6 +585,12 @@ void VauRequestHandler::handleInnerRequest(const RequestHandlerManager::Matching
     }
     A_18936.finish();
 
+    if (pendingAuditData)
+    {
+        pendingAuditData->reservation.enqueue(std::move(pendingAuditData->auditData));
+        TVLOG(1) << "AuditEvent record queued";
+    }
+
     // rethrow for error case to assure that error response is sent;
     if (currExc)
     {
@@ -154,6 +154,16 @@ void PostGetPrescriptionsHandler::handleRequest(PcSessionContext& session)
         A_27066.finish();
         A_27067.finish();
 
+        // The filters on the task properties are applied before the prescriptions are parsed, so that only
+        // prescriptions that can be part of the response are decoded.
+        A_27063_01.start("Filter einlösbarer E-Rezepte");
+        A_27589.start("Filter Status - Abfrage nach Liste Rezept-Ids");
+        std::erase_if(euTasksRaw, [&kvnr, &telematikId](const auto& item) {
+            return ! isRedeemable(std::get<model::Task>(item), kvnr, *telematikId);
+        });
+        A_27589.finish();
+        A_27063_01.finish();
+
         A_27064.start("absteigend sortiert nach dem medicationrequest.authored-on Datum");
         auto euTasks = decodeAndSort(euTasksRaw);
         A_27064.finish();
@@ -169,21 +179,12 @@ void PostGetPrescriptionsHandler::handleRequest(PcSessionContext& session)
             }
             A_27063_01.start("Filter einlösbarer E-Rezepte");
             const auto [mvoPeriodStartValid, _] = processMvoPeriodStartValid(session, kbvBundle);
-            if (! task.isEuRedeemableByProperties() || ! task.isEuRedeemableByPatientAuthorization() ||
-                task.kvnr() != kvnr || task.expired() || ! mvoPeriodStartValid)
+            if (! mvoPeriodStartValid)
             {
                 continue;
             }
             A_27063_01.finish();
 
-            A_27589.start("Filter Status - Abfrage nach Liste Rezept-Ids");
-            if (task.status() != model::Task::Status::ready &&
-                (task.status() != model::Task::Status::inprogress || task.owner() != *telematikId))
-            {
-                continue;
-            }
-            A_27589.finish();
-
             ++totalSearchMatches;
             // GEMREQ-start A_27582#prescriptionIdsNotEmpty
             if (! prescriptionIds.empty())
@@ -266,12 +267,26 @@ PostGetPrescriptionsHandler::extractCountParameter(std::vector<std::pair<std::st
     }
 }
 
+bool PostGetPrescriptionsHandler::isRedeemable(const model::Task& task, const model::Kvnr& kvnr,
+                                               const std::string& telematikId)
+{
+    if (! task.isEuRedeemableByProperties() || ! task.isEuRedeemableByPatientAuthorization() ||
+        task.kvnr() != kvnr || task.expired())
+    {
+        return false;
+    }
+    return task.status() == model::Task::Status::ready ||
+           (task.status() == model::Task::Status::inprogress && task.owner() == telematikId);
+}
+
 std::vector<std::tuple<model::Task, model::KbvBundle>>
-PostGetPrescriptionsHandler::decodeAndSort(std::vector<std::tuple<model::Task, model::Binary>>& raw)
+PostGetPrescriptionsHandler::decodeAndSort(std::vector<std::tuple<model::Task, LazyDecoded<model::Binary>>>& raw)
 {
     std::vector<std::tuple<model::Task, model::KbvBundle>> result;
-    for (auto& [task, prescriptionBinary] : raw)
+    result.reserve(raw.size());
+    for (auto& [task, prescription] : raw)
     {
+        const auto& prescriptionBinary = prescription.get();
         const auto cadesBesSignature = SignedPrescription::fromBinNoVerify(std::string{*prescriptionBinary.data()});
         const auto& bundleXml = cadesBesSignature.payload();
         auto kbvBundle = model::KbvBundle::fromXmlNoValidation(bundleXml);
@@ -4,6 +4,7 @@
 
 #ifndef ERP_PROCESSING_CONTEXT_EUPRESCRIPTIONS_GETHANDLER_HXX
 #define ERP_PROCESSING_CONTEXT_EUPRESCRIPTIONS_GETHANDLER_HXX
+#include "erp/database/LazyDecoded.hxx"
 #include "erp/service/task/TaskHandler.hxx"
 
 #include <iosfwd>
@@ -23,8 +24,9 @@ public:
 private:
     static std::optional<size_t>
     extractCountParameter(std::vector<std::pair<std::string, std::string>>& queryParameters);
+    static bool isRedeemable(const model::Task& task, const model::Kvnr& kvnr, const std::string& telematikId);
     static std::vector<std::tuple<model::Task, model::KbvBundle>>
-    decodeAndSort(std::vector<std::tuple<model::Task, model::Binary>>& raw);
+    decodeAndSort(std::vector<std::tuple<model::Task, LazyDecoded<model::Binary>>>& raw);
 };
 
 }// eu_prescriptions
@@ -278,7 +278,9 @@ void ActivateTaskHandler::handleGeneric(PcSessionContext& session, Database::Tas
     A_19025_03.start("2. store the PKCS7 file in database");
     auto* databaseHandle = session.database();
     ErpExpect(taskAndKey.key.has_value(), HttpStatus::InternalServerError, "Missing task key.");
-    databaseHandle->activateTask(task, *taskAndKey.key, healthCareProviderPrescriptionBinary,
+    // keep what the later workflow steps need from the signature, so that they don't have to parse it again
+    const db_model::PrescriptionSignatureMetadata signatureMetadata{cadesBesSignature.getMessageDigest()};
+    databaseHandle->activateTask(task, *taskAndKey.key, healthCareProviderPrescriptionBinary, signatureMetadata,
                                  session.request.getAccessToken());
     A_19025_03.finish();
 
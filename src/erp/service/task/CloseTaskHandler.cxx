@@ -61,7 +61,8 @@ void CloseTaskHandler::handleRequest(PcSessionContext& session)
 
     auto* databaseHandle = session.database();
 
-    auto [taskAndKey, prescription] = databaseHandle->retrieveTaskForUpdateAndPrescription(prescriptionId);
+    auto [taskAndKey, signatureMetadata, prescription] =
+        databaseHandle->retrieveTaskForUpdateAndPrescriptionMetadata(prescriptionId);
     ErpExpect(taskAndKey.has_value(), HttpStatus::NotFound, "Task not found for prescription id");
     auto& task = taskAndKey->task;
     const auto taskStatus = task.status();
@@ -143,15 +144,18 @@ void CloseTaskHandler::handleRequest(PcSessionContext& session)
     A_19233_06.finish();
 
     A_19233_06.start("Add the prescription signature digest");
-    ErpExpect(prescription.has_value() && prescription.value().data().has_value(), ::HttpStatus::InternalServerError,
-              "No matching prescription found.");
-
-    const auto cadesBesSignature = SignedPrescription::fromBinNoVerify(std::string{*prescription->data()});
-    const auto kbvBundle = model::KbvBundle::fromXmlNoValidation(cadesBesSignature.payload());
-    session.fillMvoBdeV2(kbvBundle.getExtension<model::KBVMultiplePrescription>());
+    if (! signatureMetadata.has_value())
+    {
+        // task has been activated before the signature metadata has been stored
+        ErpExpect(prescription.has_value() && prescription.value().data().has_value(),
+                  ::HttpStatus::InternalServerError, "No matching prescription found.");
+        const auto cadesBesSignature = SignedPrescription::fromBinNoVerify(std::string{*prescription->data()});
+        const auto kbvBundle = model::KbvBundle::fromXmlNoValidation(cadesBesSignature.payload());
+        session.fillMvoBdeV2(kbvBundle.getExtension<model::KBVMultiplePrescription>());
+        signatureMetadata.emplace(cadesBesSignature.getMessageDigest());
+    }
 
-    const std::string digest = cadesBesSignature.getMessageDigest();
-    const auto base64Digest = ::Base64::encode(digest);
+    const auto base64Digest = ::Base64::encode(signatureMetadata->getMessageDigest());
     std::optional metaVersionId =
         configuration.getOptionalStringValue(ConfigurationKey::SERVICE_TASK_CLOSE_PRESCRIPTION_DIGEST_VERSION_ID);
     if (metaVersionId && metaVersionId->empty())
@@ -41,7 +41,7 @@ void DispenseTaskHandler::handleRequest(PcSessionContext& session)
 
     auto* databaseHandle = session.database();
 
-    auto [taskAndKey, prescription] = databaseHandle->retrieveTaskForUpdateAndPrescription(prescriptionId);
+    auto taskAndKey = databaseHandle->retrieveTaskForUpdate(prescriptionId);
     ErpExpect(taskAndKey.has_value(), HttpStatus::NotFound, "Task not found for prescription id");
     auto& task = taskAndKey->task;
 
@@ -378,20 +378,34 @@ void GetAllTasksHandler::handleRequestFromInsurant(PcSessionContext& session)
     const model::Kvnr kvnr{*kvnrClaim};
 
     auto arguments = urlArgumentsForTasks();
+    const bool keysetPaging =
+        Configuration::instance().getOptionalBoolValue(ConfigurationKey::SERVICE_TASK_GET_KEYSET_PAGING, false);
+    if (keysetPaging)
+    {
+        arguments->enableKeysetPaging();
+    }
     arguments->parse(session.request, session.serviceContext.getKeyDerivation());
 
     auto roDB = session.serviceContext.readOnlyDatabaseFactory();
     A_19115_01.start("use KVNR to filter tasks");
-    auto resultSet = roDB->retrieveAllTasksForPatient(kvnr, arguments);
+    auto [resultSet, totalSearchMatches, nextSeek] = roDB->retrieveAllTasksForPatientWithTotal(kvnr, arguments);
     A_19115_01.finish();
     // GEMREQ-end A_19115-01
 
     model::Bundle responseBundle(model::BundleType::searchset, ::model::FhirResourceBase::NoProfile);
-    std::size_t totalSearchMatches = responseIsPartOfMultiplePages(arguments->pagingArgument(), resultSet.size())
-                                         ? roDB->countAllTasksForPatient(kvnr, arguments)
-                                         : resultSet.size();
 
-    const auto links = arguments->createBundleLinks(getLinkBase(), "/Task", totalSearchMatches);
+    auto linkMode = UrlArguments::LinkMode::offset;
+    if (arguments->isKeysetPaging())
+    {
+        // Keyset paging only walks forward, there are no prev and last links.
+        linkMode = UrlArguments::LinkMode::keyset;
+        if (nextSeek.has_value())
+        {
+            arguments->setResultSeekPosition(*nextSeek);
+        }
+    }
+
+    const auto links = arguments->createBundleLinks(getLinkBase(), "/Task", totalSearchMatches, linkMode);
     for (const auto& link : links)
     {
         responseBundle.setLink(link.first, link.second);
@@ -607,15 +621,13 @@ model::Bundle GetAllTasksHandler::handleRequestFromPharmacist(PcSessionContext&
     arguments->parse(queryParameters, session.serviceContext.getKeyDerivation());
 
     auto roDB = session.serviceContext.readOnlyDatabaseFactory();
-    auto tasks = roDB->retrieveAllEgkRedeemableTasksWithAccessCode(kvnr, arguments);
+    auto [tasks, totalSearchMatches, nextSeek] =
+        roDB->retrieveAllEgkRedeemableTasksWithAccessCodeAndTotal(kvnr, arguments);
     // GEMREQ-end A_23452-02#retrieveAllTasksForPatient
     A_23452_04.finish();
     A_25209_01.finish();
 
     model::Bundle responseBundle{model::BundleType::searchset, model::FhirResourceBase::NoProfile};
-    std::size_t totalSearchMatches = responseIsPartOfMultiplePages(arguments->pagingArgument(), tasks.size())
-                                         ? roDB->countAllEgkRedeemableTasks(kvnr, arguments)
-                                         : tasks.size();
 
     auto argumentsResp = urlArgumentsForTasks({
         {"pnw", "pnw", SearchParameter::Type::String},
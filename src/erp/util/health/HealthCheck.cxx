@@ -6,6 +6,8 @@
  */
 
 #include "erp/util/health/HealthCheck.hxx"
+#include "erp/database/AuditEventWriter.hxx"
+#include "erp/pc/PcServiceContext.hxx"
 #include "erp/pc/SeedTimer.hxx"
 #include "erp/pc/popp/PoPPCertificateVerifierService.hxx"
 #include "erp/registration/RegistrationInterface.hxx"
@@ -14,11 +16,17 @@
 #include "shared/util/Demangle.hxx"
 #include "shared/util/ExceptionHelper.hxx"
 
+#include <algorithm>
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
 #include <sw/redis++/errors.h>
 
 namespace
 {
 
+/// number of services checked by HealthCheck::update()
+constexpr size_t checkCount = 11;
+
 void setTslDetails(ApplicationHealth::Service service, const TrustStore::HealthData& healthData,
                    ApplicationHealth& applicationHealth)
 {
@@ -33,58 +41,230 @@ void setTslDetails(ApplicationHealth::Service service, const TrustStore::HealthD
 }// namespace
 
 
-void HealthCheck::update (PcServiceContext& context)
+struct HealthCheck::CheckState
+{
+    explicit CheckState(PcServiceContext& context)
+        : context(context)
+    {
+    }
+
+    PcServiceContext& context;
+    /// guards the results written to the ApplicationHealth against the destruction of the HealthCheck
+    std::mutex mutex;
+    /// set by the destructor of HealthCheck, the context must not be accessed any more
+    bool abandoned = false;
+};
+
+
+HealthCheck::HealthCheck(PcServiceContext& context, std::chrono::milliseconds checkTimeout,
+                         std::chrono::steady_clock::duration cacheMaxAge)
+    : mContext(context)
+    , mCheckTimeout(checkTimeout)
+    , mCacheMaxAge(cacheMaxAge)
+    , mCheckState(std::make_shared<CheckState>(context))
+{
+}
+
+
+HealthCheck::HealthCheck(PcServiceContext& context, const Configuration& configuration)
+    : HealthCheck(context,
+                  std::chrono::milliseconds{
+                      configuration.getOptionalIntValue(ConfigurationKey::HEALTH_CHECK_TIMEOUT_MS, 2000)},
+                  std::chrono::seconds{
+                      configuration.getOptionalIntValue(ConfigurationKey::HEALTH_CHECK_CACHE_MAX_AGE_SEC, 5)})
+{
+}
+
+
+HealthCheck::~HealthCheck()
+{
+    // a background update waits at most mCheckTimeout for the checks
+    if (mBackgroundPool)
+    {
+        mBackgroundPool->join();
+    }
+    if (mCheckPool)
+    {
+        mCheckPool->stop();
+        const bool checksRunning = std::ranges::any_of(mRunningChecks, [](const auto& runningCheck) {
+            return runningCheck.second.wait_for(std::chrono::seconds::zero()) != std::future_status::ready;
+        });
+        if (checksRunning)
+        {
+            // The destructor of the pool would join its threads and a hung check would block the shutdown.
+            // Therefore the pool is left behind, its threads end when their check returns.
+            // The checks only hold the shared state, which keeps them from reporting their results from now on.
+            TLOG(WARNING) << "health checks are still running, not waiting for them";
+            {
+                std::lock_guard lock{mCheckState->mutex};
+                mCheckState->abandoned = true;
+            }
+            (void) mCheckPool.release();
+        }
+        else
+        {
+            mCheckPool->join();
+        }
+    }
+}
+
+
+void HealthCheck::update()
 {
-    check(ApplicationHealth::Service::Bna,          context, &checkBna);
-    check(ApplicationHealth::Service::Hsm,          context, &checkHsm);
-    check(ApplicationHealth::Service::Idp,          context, &checkIdp);
-    check(ApplicationHealth::Service::Postgres,     context, &checkPostgres);
+    std::lock_guard updateLock{mUpdateMutex};
+    std::call_once(mPoolsCreated, [this] {
+        // one thread per check, a check is never started again while it is still running
+        mCheckPool = std::make_unique<boost::asio::thread_pool>(checkCount);
+        mBackgroundPool = std::make_unique<boost::asio::thread_pool>(1);
+    });
+
+    std::vector<ApplicationHealth::Service> started;
+    const auto start = [this, &started](ApplicationHealth::Service service, CheckAction checkAction) {
+        if (startCheck(service, checkAction))
+        {
+            started.emplace_back(service);
+        }
+    };
+    start(ApplicationHealth::Service::Bna,          &checkBna);
+    start(ApplicationHealth::Service::Hsm,          &checkHsm);
+    start(ApplicationHealth::Service::Idp,          &checkIdp);
+    start(ApplicationHealth::Service::Postgres,     &checkPostgres);
     if (auto roHost = Configuration::instance().getOptionalStringValue(ConfigurationKey::POSTGRES_RO_HOST);
         roHost && ! roHost->empty())
     {
-        check(ApplicationHealth::Service::PostgresRO, context, &checkPostgresRO);
+        start(ApplicationHealth::Service::PostgresRO, &checkPostgresRO);
     }
     else
     {
-        context.applicationHealth().skip(ApplicationHealth::Service::PostgresRO, "No read-only host configured");
+        mContext.applicationHealth().skip(ApplicationHealth::Service::PostgresRO, "No read-only host configured");
     }
-    check(ApplicationHealth::Service::PrngSeed,     context, &checkSeedTimer);
-    check(ApplicationHealth::Service::TeeToken,     context, &checkTeeTokenUpdater);
-    check(ApplicationHealth::Service::Tsl,          context, &checkTsl);
-    check(ApplicationHealth::Service::CFdSigErp,    context, &checkCFdSigErp);
-    check(ApplicationHealth::Service::PoPPService,  context, &checkPoPPService);
+    start(ApplicationHealth::Service::PrngSeed,     &checkSeedTimer);
+    start(ApplicationHealth::Service::TeeToken,     &checkTeeTokenUpdater);
+    start(ApplicationHealth::Service::Tsl,          &checkTsl);
+    start(ApplicationHealth::Service::CFdSigErp,    &checkCFdSigErp);
+    start(ApplicationHealth::Service::PoPPService,  &checkPoPPService);
 
     if (Configuration::instance().getOptionalBoolValue(ConfigurationKey::DEBUG_DISABLE_DOS_CHECK, false))
     {
-        context.applicationHealth().skip(ApplicationHealth::Service::Redis, "DEBUG_DISABLE_DOS_CHECK=true");
+        mContext.applicationHealth().skip(ApplicationHealth::Service::Redis, "DEBUG_DISABLE_DOS_CHECK=true");
     }
     else
     {
-        check(ApplicationHealth::Service::Redis, context, &checkRedis);
+        start(ApplicationHealth::Service::Redis, &checkRedis);
+    }
+    waitForChecks(started);
+
+    updateDetails();
+
+    std::lock_guard stateLock{mStateMutex};
+    mLastUpdate = std::chrono::steady_clock::now();
+}
+
+
+void HealthCheck::updateIfOutdated()
+{
+    if (mCacheMaxAge <= std::chrono::steady_clock::duration::zero())
+    {
+        update();
+        return;
+    }
+    bool hasCachedResult = false;
+    {
+        std::lock_guard stateLock{mStateMutex};
+        if (mLastUpdate.has_value())
+        {
+            if (mBackgroundUpdateRunning || std::chrono::steady_clock::now() - *mLastUpdate < mCacheMaxAge)
+            {
+                return;
+            }
+            mBackgroundUpdateRunning = true;
+            hasCachedResult = true;
+        }
+    }
+    if (! hasCachedResult)
+    {
+        update();
+        return;
+    }
+    boost::asio::post(*mBackgroundPool, [this] {
+        try
+        {
+            update();
+        }
+        catch (const std::exception& err)
+        {
+            TLOG(WARNING) << "background health check update failed: " << err.what();
+        }
+        std::lock_guard stateLock{mStateMutex};
+        mBackgroundUpdateRunning = false;
+    });
+}
+
+
+std::optional<std::chrono::steady_clock::time_point> HealthCheck::lastUpdate() const
+{
+    std::lock_guard stateLock{mStateMutex};
+    return mLastUpdate;
+}
+
+
+bool HealthCheck::startCheck(ApplicationHealth::Service service, CheckAction checkAction)
+{
+    const auto running = mRunningChecks.find(service);
+    if (running != mRunningChecks.end() &&
+        running->second.wait_for(std::chrono::seconds::zero()) != std::future_status::ready)
+    {
+        mContext.applicationHealth().down(service, "previous health check has not finished yet");
+        return false;
+    }
+    std::packaged_task<void()> task{[state = mCheckState, service, checkAction] {
+        check(service, state, checkAction);
+    }};
+    mRunningChecks.insert_or_assign(service, task.get_future().share());
+    boost::asio::post(*mCheckPool, std::move(task));
+    return true;
+}
+
+
+void HealthCheck::waitForChecks(const std::vector<ApplicationHealth::Service>& services)
+{
+    const auto deadline = std::chrono::steady_clock::now() + mCheckTimeout;
+    for (const auto service : services)
+    {
+        if (mRunningChecks.at(service).wait_until(deadline) != std::future_status::ready)
+        {
+            mContext.applicationHealth().down(
+                service, "health check did not finish within " + std::to_string(mCheckTimeout.count()) + "ms");
+        }
     }
-    context.applicationHealth().setServiceDetails(
+}
+
+
+void HealthCheck::updateDetails()
+{
+    mContext.applicationHealth().setServiceDetails(
         ApplicationHealth::Service::Hsm, ApplicationHealth::ServiceDetail::HsmDevice,
         Configuration::instance().getStringValue(ConfigurationKey::HSM_DEVICE));
 
-    const auto healthDataTsl = context.getTslManager().healthCheckTsl();
-    setTslDetails(ApplicationHealth::Service::Tsl, healthDataTsl, context.applicationHealth());
-    const auto healthDataBna = context.getTslManager().healthCheckBna();
-    setTslDetails(ApplicationHealth::Service::Bna, healthDataBna, context.applicationHealth());
+    const auto healthDataTsl = mContext.getTslManager().healthCheckTsl();
+    setTslDetails(ApplicationHealth::Service::Tsl, healthDataTsl, mContext.applicationHealth());
+    const auto healthDataBna = mContext.getTslManager().healthCheckBna();
+    setTslDetails(ApplicationHealth::Service::Bna, healthDataBna, mContext.applicationHealth());
 
     try
     {
-        context.applicationHealth().setServiceDetails(
+        mContext.applicationHealth().setServiceDetails(
             ApplicationHealth::Service::CFdSigErp, ApplicationHealth::ServiceDetail::CFdSigErpTimestamp,
-            "last success " + context.getCFdSigErpManager().getLastOcspResponseTimestamp());
-        context.applicationHealth().setServiceDetails(
+            "last success " + mContext.getCFdSigErpManager().getLastOcspResponseTimestamp());
+        mContext.applicationHealth().setServiceDetails(
             ApplicationHealth::Service::CFdSigErp, ApplicationHealth::ServiceDetail::CFdSigErpPolicy,
             String::replaceAll(
-                std::string(magic_enum::enum_name(context.getCFdSigErpManager().getCertificateType())),
+                std::string(magic_enum::enum_name(mContext.getCFdSigErpManager().getCertificateType())),
                 "_", "."));
-        context.applicationHealth().setServiceDetails(
+        mContext.applicationHealth().setServiceDetails(
             ApplicationHealth::Service::CFdSigErp, ApplicationHealth::ServiceDetail::CFdSigErpExpiry,
-            context.getCFdSigErpManager().getCertificateNotAfterTimestamp());
-        context.applicationHealth().setPoPPServiceDetails(context.getPoPPService().getHealthData());
+            mContext.getCFdSigErpManager().getCertificateNotAfterTimestamp());
+        mContext.applicationHealth().setPoPPServiceDetails(mContext.getPoPPService().getHealthData());
     }
     catch (const std::exception& err)
     {
@@ -93,8 +273,8 @@ void HealthCheck::update (PcServiceContext& context)
 
     try
     {
-        context.registrationInterface()->updateRegistrationBasedOnApplicationHealth(
-            context.applicationHealth());
+        mContext.registrationInterface()->updateRegistrationBasedOnApplicationHealth(
+            mContext.applicationHealth());
     }
     catch (const std::exception& err)
     {
@@ -148,6 +328,11 @@ void HealthCheck::checkPostgres(PcServiceContext& context)
                                                       ApplicationHealth::ServiceDetail::DBConnectionInfo,
                                                       toString(*connectionInfo));
     }
+    // audit event records that can not be written are kept for retry, the service is down until they are written
+    if (const auto* auditEventWriter = context.auditEventWriter())
+    {
+        auditEventWriter->healthCheck();
+    }
 }
 
 void HealthCheck::checkPostgresRO(PcServiceContext& context)
@@ -193,8 +378,8 @@ void HealthCheck::checkTsl (PcServiceContext& context)
 
 void HealthCheck::check (
     const ApplicationHealth::Service service,
-    PcServiceContext& context,
-    void (* checkAction)(PcServiceContext&))
+    const std::shared_ptr<CheckState>& state,
+    CheckAction checkAction)
 {
     // Try again in case of EAGAIN errors, which are handled with the same exception as ETIMEDOUT and EWOULDBLOCK errors.
     const size_t max_retries = 3;
@@ -203,8 +388,19 @@ void HealthCheck::check (
     {
         try
         {
-            (*checkAction)(context);
-            context.applicationHealth().up(service);
+            {
+                std::lock_guard lock{state->mutex};
+                if (state->abandoned)
+                {
+                    return;
+                }
+            }
+            (*checkAction)(state->context);
+            std::lock_guard lock{state->mutex};
+            if (! state->abandoned)
+            {
+                state->context.applicationHealth().up(service);
+            }
             break;
         }
         catch (const sw::redis::TimeoutError& ex)
@@ -216,7 +412,7 @@ void HealthCheck::check (
         }
         catch (...)
         {
-            handleException(service, context);
+            handleException(service, *state);
         }
     }
 }
@@ -224,13 +420,17 @@ void HealthCheck::check (
 
 void HealthCheck::handleException(
     ApplicationHealth::Service service,
-    PcServiceContext& context)
+    CheckState& state)
 {
     ExceptionHelper::extractInformation(
-        [service, &context]
+        [service, &state]
         (std::string&& details, std::string&& location)
         {
-            context.applicationHealth().down(service, std::move(details) + " at " + std::move(location));
+            std::lock_guard lock{state.mutex};
+            if (! state.abandoned)
+            {
+                state.context.applicationHealth().down(service, std::move(details) + " at " + std::move(location));
+            }
         },
         std::current_exception());
 }
@@ -8,15 +8,64 @@
 #ifndef ERP_PROCESSING_CONTEXT_UTIL_HEALTH_HEALTHCHECK_HXX
 #define ERP_PROCESSING_CONTEXT_UTIL_HEALTH_HEALTHCHECK_HXX
 
-#include "erp/pc/PcServiceContext.hxx"
+#include "shared/util/health/ApplicationHealth.hxx"
 
+#include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
 
+namespace boost::asio
+{
+class thread_pool;
+}
+class Configuration;
+class PcServiceContext;
+
+
+/**
+ * Runs the health checks of the processing context and stores their results in the ApplicationHealth of
+ * the service context.
+ *
+ * The checks of the individual services run concurrently. A check that does not finish within the configured
+ * timeout (ERP_HEALTH_CHECK_TIMEOUT_MS) is reported as down and is not started again before it has finished.
+ * The results are kept for ERP_HEALTH_CHECK_CACHE_MAX_AGE_SEC, see updateIfOutdated().
+ * The destructor does not wait for checks that are still running. Their results are discarded, they do not
+ * access the HealthCheck object and do not write to the ApplicationHealth after the destructor has returned.
+ */
 class HealthCheck
 {
 public:
-    static void update (PcServiceContext& context);
+    HealthCheck(PcServiceContext& context, std::chrono::milliseconds checkTimeout,
+                std::chrono::steady_clock::duration cacheMaxAge);
+    HealthCheck(PcServiceContext& context, const Configuration& configuration);
+    ~HealthCheck();
+
+    /**
+     * Runs all checks and updates the registration. Returns when all checks have finished or timed out.
+     */
+    void update();
+
+    /**
+     * Only the first call waits for update(). Later calls return immediately and, when the last update is older
+     * than the maximum cache age, start an update in the background, unless one is already running.
+     */
+    void updateIfOutdated();
+
+    std::optional<std::chrono::steady_clock::time_point> lastUpdate() const;
+
+    HealthCheck(const HealthCheck&) = delete;
+    HealthCheck& operator=(const HealthCheck&) = delete;
 
 private:
+    using CheckAction = void (*)(PcServiceContext&);
+
+    /// shared with the running checks, which may outlive the HealthCheck object
+    struct CheckState;
+
     static void checkBna             (PcServiceContext& context);
     static void checkHsm             (PcServiceContext& context);
     static void checkCFdSigErp       (PcServiceContext& context);
@@ -31,12 +80,33 @@ private:
 
     static void check (
         const ApplicationHealth::Service service,
-        PcServiceContext& context,
-        void (* checkAction)(PcServiceContext&));
+        const std::shared_ptr<CheckState>& state,
+        CheckAction checkAction);
 
     static void handleException(
         ApplicationHealth::Service service,
-        PcServiceContext& context);
+        CheckState& state);
+
+    /// starts the check on the pool, unless the previous check of the same service is still running
+    bool startCheck(ApplicationHealth::Service service, CheckAction checkAction);
+    void waitForChecks(const std::vector<ApplicationHealth::Service>& services);
+    void updateDetails();
+
+    PcServiceContext& mContext;
+    const std::chrono::milliseconds mCheckTimeout;
+    const std::chrono::steady_clock::duration mCacheMaxAge;
+
+    /// serializes complete updates
+    std::mutex mUpdateMutex;
+    std::shared_ptr<CheckState> mCheckState;
+    std::once_flag mPoolsCreated;
+    std::unique_ptr<boost::asio::thread_pool> mCheckPool;
+    std::unique_ptr<boost::asio::thread_pool> mBackgroundPool;
+    std::map<ApplicationHealth::Service, std::shared_future<void>> mRunningChecks;
+
+    mutable std::mutex mStateMutex;
+    std::optional<std::chrono::steady_clock::time_point> mLastUpdate;
+    bool mBackgroundUpdateRunning = false;
 };
 
 
@@ -8,6 +8,7 @@
 #include "erp/util/search/PagingArgument.hxx"
 
 #include "shared/ErpRequirements.hxx"
+#include "shared/model/ModelException.hxx"
 #include "shared/network/message/HttpStatus.hxx"
 #include "shared/util/Expect.hxx"
 #include "shared/util/String.hxx"
@@ -88,15 +89,97 @@ size_t PagingArgument::getOffset () const
 }
 
 
+PagingArgument::SeekPosition::SeekPosition(const model::Timestamp& initSortValue,
+                                           const model::PrescriptionId& initPrescriptionId)
+    : sortValue(initSortValue)
+    , prescriptionType(initPrescriptionId.type())
+    , prescriptionDatabaseId(initPrescriptionId.toDatabaseId())
+{
+}
+
+
+model::PrescriptionId PagingArgument::SeekPosition::prescriptionId() const
+{
+    return model::PrescriptionId::fromDatabaseId(prescriptionType, prescriptionDatabaseId);
+}
+
+
+void PagingArgument::setSeek (const std::string& seekString)
+{
+    const auto separator = seekString.find('_');
+    ErpExpect(separator != std::string::npos, HttpStatus::BadRequest, "invalid format of __seek");
+    const auto millisecondsString = seekString.substr(0, separator);
+    try
+    {
+        size_t length = 0;
+        const auto millisecondsSinceEpoch = std::stoll(millisecondsString, &length);
+        ErpExpect(length == millisecondsString.size(), HttpStatus::BadRequest,
+                  "trailing characters are not permitted in a numerical argument: __seek");
+        ErpExpect(millisecondsSinceEpoch >= 0, HttpStatus::BadRequest, "__seek can not be negative");
+        mSeek.emplace(
+            model::Timestamp{model::Timestamp::timepoint_t{std::chrono::milliseconds{millisecondsSinceEpoch}}},
+            model::PrescriptionId::fromString(std::string_view{seekString}.substr(separator + 1)));
+    }
+    catch (const std::invalid_argument&)
+    {
+        TVLOG(1) << "invalid numeric format in __seek: " << seekString;
+        ErpFail(HttpStatus::BadRequest, "invalid numeric format in __seek");
+    }
+    catch (const std::out_of_range&)
+    {
+        TVLOG(1) << "__seek value out of range: " << seekString;
+        ErpFail(HttpStatus::BadRequest, "__seek value out of range");
+    }
+    catch (const model::ModelException&)
+    {
+        TVLOG(1) << "__seek value is not a valid position: " << seekString;
+        ErpFail(HttpStatus::BadRequest, "__seek value is not a valid position");
+    }
+}
+
+
+void PagingArgument::setSeek (const SeekPosition& seek)
+{
+    mSeek = seek;
+}
+
+
+const std::optional<PagingArgument::SeekPosition>& PagingArgument::getSeek () const
+{
+    return mSeek;
+}
+
+
+std::string PagingArgument::seekValue (const SeekPosition& seek)
+{
+    return std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+                              seek.sortValue.toChronoTimePoint().time_since_epoch())
+                              .count()) +
+           '_' + seek.prescriptionId().toString();
+}
+
+
+void PagingArgument::setNextSeek (const SeekPosition& lastEntry)
+{
+    mNextSeek = lastEntry;
+}
+
+
+const std::optional<PagingArgument::SeekPosition>& PagingArgument::getNextSeek () const
+{
+    return mNextSeek;
+}
+
+
 bool PagingArgument::isSet () const
 {
-    return mCount != getDefaultCount() || mOffset>0;
+    return mCount != getDefaultCount() || mOffset>0 || mSeek.has_value();
 }
 
 
 bool PagingArgument::hasPreviousPage () const
 {
-    return mOffset > 0;
+    return mOffset > 0 || mSeek.has_value();
 }
 
 
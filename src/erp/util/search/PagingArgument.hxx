@@ -8,6 +8,7 @@
 #ifndef ERP_PROCESSING_CONTEXT_PAGINGARGUMENT_HXX
 #define ERP_PROCESSING_CONTEXT_PAGINGARGUMENT_HXX
 
+#include "shared/model/PrescriptionId.hxx"
 #include "shared/model/Timestamp.hxx"
 
 #include <optional>
@@ -20,9 +21,10 @@
  * Collection of data and functionality around paging of the result of a REST request.
  *
  * The SQL implementation for paging, currently located in UrlArguments, but based on data held in this class,
- * is rather simple. It uses SQL's LIMIT and OFFSET.
- * The alternative keyset paging does not work with complex ORDER clauses (or even simple ones, rather anything that
- * does not sort on the primary id).
+ * uses SQL's LIMIT and OFFSET by default.
+ * Keyset paging is supported for tasks when the result is sorted by a single date parameter. In that case the `__seek`
+ * argument holds the sort key value and the prescription id of the last entry of the previous page and the next page
+ * is selected with a row comparison on both instead of skipping rows with OFFSET.
  */
 class PagingArgument
 {
@@ -30,6 +32,7 @@ public:
     static constexpr std::string_view countKey = "_count";
     static constexpr std::string_view offsetKey = "__offset";
     static constexpr std::string_view idKey = "_id";
+    static constexpr std::string_view seekKey = "__seek";
 
     explicit PagingArgument ();
 
@@ -53,12 +56,46 @@ public:
     size_t getOffset () const;
 
     /**
-     * Return whether either or both of offset and count have non-default values.
+     * Position of keyset paging: the sort key value with millisecond precision and, as tie-breaker for entries
+     * that share the same sort key value, the prescription id of the last entry of the previous page.
+     */
+    class SeekPosition
+    {
+    public:
+        SeekPosition(const model::Timestamp& initSortValue, const model::PrescriptionId& initPrescriptionId);
+        model::PrescriptionId prescriptionId() const;
+
+        model::Timestamp sortValue;
+        // The prescription id is kept in its database representation, because model::PrescriptionId can not be
+        // assigned.
+        model::PrescriptionType prescriptionType;
+        int64_t prescriptionDatabaseId;
+    };
+
+    /**
+     * Value is expected to be `<milliseconds since epoch>_<prescription id>` of the last entry on the previous page,
+     * as created by seekValue().
+     * @throw ErpException if the input can not be interpreted as seek position
+     */
+    void setSeek (const std::string& seekString);
+    void setSeek (const SeekPosition& seek);
+    const std::optional<SeekPosition>& getSeek () const;
+    static std::string seekValue (const SeekPosition& seek);
+
+    /**
+     * Seek position of the last entry of the current page, if there is a next page.
+     * It is used to create the `next` link in keyset mode.
+     */
+    void setNextSeek (const SeekPosition& lastEntry);
+    const std::optional<SeekPosition>& getNextSeek () const;
+
+    /**
+     * Return whether either or both of offset and count have non-default values or a seek position is set.
      */
     bool isSet () const;
     /**
      * Return whether there is a 'prev' page.
-     * That is always the case when offset > 0.
+     * That is always the case when offset > 0 or a seek position is set.
      */
     bool hasPreviousPage () const;
     /**
@@ -78,6 +115,8 @@ private:
     size_t mCount;
     size_t mOffset{0};
     size_t mTotalSearchMatches{0};
+    std::optional<SeekPosition> mSeek;
+    std::optional<SeekPosition> mNextSeek;
     std::optional<std::pair<model::Timestamp, model::Timestamp>> mEntryTimestampRange;
 };
 
@@ -63,6 +63,7 @@ void UrlArguments::parse(const std::vector<std::pair<std::string, std::string>>&
 {
     bool hasOffset{false};
     bool hasId{false};
+    bool hasSeek{false};
     for (const auto& entry : queryParameters)
     {
         ErpExpect( ! entry.first.empty(), HttpStatus::BadRequest, "empty arguments are not permitted");
@@ -79,6 +80,11 @@ void UrlArguments::parse(const std::vector<std::pair<std::string, std::string>>&
             mPagingArgument.setOffset(entry.second);
             hasOffset = true;
         }
+        else if (mKeysetPagingEnabled && entry.first == PagingArgument::seekKey) // "__seek"
+        {
+            mPagingArgument.setSeek(entry.second);
+            hasSeek = true;
+        }
         else if (entry.first == PagingArgument::idKey) // "_id"
         {
             // paging via ids requires us to add hidden search arguments, so they
@@ -112,12 +118,16 @@ void UrlArguments::parse(const std::vector<std::pair<std::string, std::string>>&
         }
     }
     ErpExpect(! (hasOffset && hasId), HttpStatus::BadRequest, "Cannot combine _id and __offset paging arguments");
+    ErpExpect(! (hasSeek && (hasOffset || hasId)), HttpStatus::BadRequest,
+              "Cannot combine __seek with _id or __offset paging arguments");
     A_24438.start("Use default sort key if available and no sort arguments are provided.");
     if (mSortArguments.empty() && mDefaultSortArgument.has_value())
     {
         addSortArguments(std::string{mDefaultSortArgument.value()});
     }
     A_24438.finish();
+    ErpExpect(! hasSeek || keysetSortArgument().has_value(), HttpStatus::BadRequest,
+              "__seek requires sorting by a single date parameter");
 }
 
 
@@ -402,6 +412,9 @@ void UrlArguments::appendLinkPagingArguments(std::ostream& os, const model::Link
         case LinkMode::id:
             appendLinkPagingArgumentsWithId(os, type);
             break;
+        case LinkMode::keyset:
+            appendLinkPagingArgumentsWithSeek(os, type);
+            break;
     }
 }
 
@@ -503,14 +516,60 @@ void UrlArguments::appendLinkPagingArgumentsWithId(std::ostream& os, const model
     }
 }
 
+void UrlArguments::appendLinkPagingArgumentsWithSeek(std::ostream& os, const model::Link::Type type) const
+{
+    switch (type)
+    {
+        case model::Link::Self:
+            if (mPagingArgument.isSet())
+            {
+                appendLinkSeparator(os);
+                os << PagingArgument::countKey << "=" << mPagingArgument.getCount();
+                if (mPagingArgument.getSeek().has_value())
+                {
+                    os << '&' << PagingArgument::seekKey << '='
+                       << PagingArgument::seekValue(*mPagingArgument.getSeek());
+                }
+            }
+            break;
+
+        case model::Link::Next: {
+            ErpExpect(mPagingArgument.getNextSeek().has_value(), HttpStatus::InternalServerError,
+                      "Cannot generate next link without seek position");
+            appendLinkSeparator(os);
+            os << PagingArgument::countKey << "=" << mPagingArgument.getCount() << '&' << PagingArgument::seekKey
+               << '=' << PagingArgument::seekValue(*mPagingArgument.getNextSeek());
+        }
+        break;
+
+        case model::Link::First: {
+            appendLinkSeparator(os);
+            os << PagingArgument::countKey << "=" << mPagingArgument.getCount();
+        }
+        break;
+
+        case model::Link::Prev:
+        case model::Link::Last:
+            // do nothing: Keyset paging only walks forward; the position of the previous or last page is not known
+            // without counting the entries in front of it.
+            break;
+    }
+}
+
 
 std::unordered_map<model::Link::Type, std::string> UrlArguments::createBundleLinks (
     const std::string& linkBase,
     const std::string& pathHead,
-    const std::size_t& totalSearchMatches)
+    const std::size_t& totalSearchMatches,
+    LinkMode linkMode)
 {
     mPagingArgument.setTotalSearchMatches(totalSearchMatches);
-    return createBundleLinks(mPagingArgument.hasNextPage(totalSearchMatches), linkBase, pathHead);
+    if (linkMode == LinkMode::keyset)
+    {
+        // The seek position is only set when further entries follow the page, see setResultSeekPosition().
+        return createBundleLinks(mPagingArgument.getNextSeek().has_value(), linkBase, pathHead, linkMode);
+    }
+    return createBundleLinks(mPagingArgument.hasNextPage(totalSearchMatches), linkBase, pathHead, linkMode);
 }
 
 std::unordered_map<model::Link::Type, std::string>
@@ -521,7 +580,7 @@ UrlArguments::createBundleLinks(bool hasNextPage, const std::string& linkBase, c
     links.emplace(model::Link::Type::Self,
                   linkBase + pathHead + getLinkPathArguments(model::Link::Type::Self, linkMode));
 
-    if (mPagingArgument.hasPreviousPage())
+    if (linkMode != LinkMode::keyset && mPagingArgument.hasPreviousPage())
     {
         links.emplace(model::Link::Type::Prev,
                       linkBase + pathHead + getLinkPathArguments(model::Link::Type::Prev, linkMode));
@@ -560,13 +619,15 @@ std::string UrlArguments::getSqlExpression(const pqxx::connection& connection, c
 {
     std::string queryTail;
 
-    const std::string where = getSqlWhereExpression(connection, indentation);
-    if ( ! where.empty())
+    for (const std::string& where : {getSqlWhereExpression(connection, indentation), getSqlSeekExpression()})
     {
-        if (indentation.empty())
-            queryTail += " AND " + where;
-        else
-            queryTail += "\n" + indentation + "AND " + where;
+        if ( ! where.empty())
+        {
+            if (indentation.empty())
+                queryTail += " AND " + where;
+            else
+                queryTail += "\n" + indentation + "AND " + where;
+        }
     }
 
     const std::string order = getSqlSortExpression();
@@ -629,6 +690,16 @@ std::string UrlArguments::getSqlWhereExpression (const pqxx::connection& connect
 
 std::string UrlArguments::getSqlSortExpression (void) const
 {
+    if (isKeysetPaging())
+    {
+        // The order has to be total and has to match the row comparison in getSqlSeekExpression().
+        // The sort column is used as it is, so that the index on it can provide the order.
+        const auto sortArgument = keysetSortArgument();
+        const std::string direction = sortArgument->order == SortArgument::Order::Increasing ? " ASC" : " DESC";
+        return "ORDER BY " + sortArgument->nameDb + direction + ", prescription_type" + direction +
+               ", prescription_id" + direction;
+    }
+
     std::ostringstream s;
 
     for (const auto& argument : mSortArguments)
@@ -660,6 +731,28 @@ std::string UrlArguments::getSqlPagingExpression (bool oneAdditionalItem) const
 }
 
 
+std::string UrlArguments::getSqlSeekExpression (void) const
+{
+    const auto& seek = mPagingArgument.getSeek();
+    if (! isKeysetPaging() || ! seek.has_value())
+        return "";
+    const auto sortArgument = keysetSortArgument();
+
+    // The seek position is the sort key of the last entry of the previous page and its prescription id. Task dates are
+    // written with millisecond precision, so the sort key of the seek position is exact and entries that share it
+    // are ordered by prescription id. Thus entries are neither repeated nor skipped at page boundaries.
+    // The sort column is compared as it is and the separate bound on it lets the index on the column be used.
+    const bool increasing = sortArgument->order == SortArgument::Order::Increasing;
+    const auto sortValue = seek->sortValue.toXsDateTime();
+    std::ostringstream s;
+    s << "(" << sortArgument->nameDb << (increasing ? " >= '" : " <= '") << sortValue << "' AND ("
+      << sortArgument->nameDb << ", prescription_type, prescription_id) " << (increasing ? ">" : "<") << " ('"
+      << sortValue << "', " << static_cast<int>(seek->prescriptionType) << ", " << seek->prescriptionDatabaseId
+      << "))";
+    return s.str();
+}
+
+
 void UrlArguments::appendComparison(std::ostream& os, const SearchArgument& argument, const pqxx::connection& connection) const
 {
     switch (argument.type)
@@ -975,6 +1068,11 @@ void UrlArguments::disablePagingArgument()
     mPagingArgument_disabled = true;
 }
 
+bool UrlArguments::isPagingArgumentDisabled() const
+{
+    return mPagingArgument_disabled;
+}
+
 std::optional<SearchArgument> UrlArguments::getSearchArgument(const std::string_view& name) const
 {
     for (const auto& item : mSearchArguments)
@@ -996,3 +1094,28 @@ void UrlArguments::setResultDateRange(const model::Timestamp& firstEntry, const
 {
     mPagingArgument.setEntryTimestampRange(firstEntry, lastEntry);
 }
+
+void UrlArguments::setResultSeekPosition(const PagingArgument::SeekPosition& lastEntry)
+{
+    mPagingArgument.setNextSeek(lastEntry);
+}
+
+void UrlArguments::enableKeysetPaging()
+{
+    mKeysetPagingEnabled = true;
+}
+
+bool UrlArguments::isKeysetPaging() const
+{
+    return mKeysetPagingEnabled && ! mPagingArgument_disabled && mPagingArgument.getOffset() == 0 &&
+           keysetSortArgument().has_value();
+}
+
+std::optional<SortArgument> UrlArguments::keysetSortArgument() const
+{
+    if (mSortArguments.size() != 1)
+        return {};
+    if (getParameterType(mSortArguments.front().nameUrl) != SearchParameter::Type::Date)
+        return {};
+    return mSortArguments.front();
+}
@@ -41,10 +41,19 @@ public:
     void parse(const ServerRequest& request, const KeyDerivation& keyDerivation);
     void parse(const std::vector<std::pair<std::string, std::string>>& queryParameters, const KeyDerivation& keyDerivation);
 
+    /**
+     * offset: paging via `__offset`, default for all endpoints that do not support keyset paging.
+     * id:     paging via `_id` of resources with a time based uuid (AuditEvent).
+     * keyset: paging via `__seek`, i.e. with a row comparison on the sort key value and the prescription id of the
+     *         last entry of the previous page. Requires that the result is sorted by a single parameter of type
+     *         SearchParameter::Type::Date. Only tasks are supported. Keyset paging only walks forward, so there are
+     *         no `prev` and `last` links.
+     */
     enum class LinkMode
     {
         offset,
         id,
+        keyset,
     };
 
     /**
@@ -57,7 +66,8 @@ public:
     std::unordered_map<model::Link::Type, std::string> createBundleLinks (
         const std::string& linkBase,
         const std::string& pathHead,
-        const std::size_t& totalSearchMatches);
+        const std::size_t& totalSearchMatches,
+        LinkMode linkMode = LinkMode::offset);
 
     std::unordered_map<model::Link::Type, std::string> createBundleLinks(bool hasNextPage, const std::string& linkBase,
                                                                       const std::string& pathHead,
@@ -65,6 +75,34 @@ public:
 
     void setResultDateRange(const model::Timestamp& firstEntry, const model::Timestamp& lastEntry);
 
+    /**
+     * Set the seek position of the last entry of a page that is followed by further entries. It becomes the
+     * `__seek` value of the `next` link in keyset mode. When it is not set, then there is no `next` link in
+     * keyset mode.
+     */
+    void setResultSeekPosition(const PagingArgument::SeekPosition& lastEntry);
+
+    /**
+     * Return the sort argument that keyset paging is based on, if the current sort arguments permit keyset paging.
+     * That is the case when exactly one sort argument is given and it refers to a parameter of type
+     * SearchParameter::Type::Date.
+     */
+    std::optional<SortArgument> keysetSortArgument() const;
+
+    /**
+     * Accept the `__seek` paging argument in subsequent calls to `parse()`. Without this call `__seek` is ignored
+     * like any other unsupported argument.
+     */
+    void enableKeysetPaging();
+
+    /**
+     * Return whether the current page is selected with keyset paging, i.e. keyset paging is enabled, the sort
+     * arguments permit it and no `__offset` was given.
+     * In that case the SQL expressions order by the truncated sort key, `prescription_type` and `prescription_id`
+     * so that the order is total and matches the row comparison of getSqlSeekExpression().
+     */
+    bool isKeysetPaging() const;
+
     /**
      * Return a string that can be appended to a query that ends in a WHERE clause.
      * Depending on whether search, sort or paging arguments where provided to the `parse()` method, this method
@@ -72,7 +110,7 @@ public:
      * - expressions to the WHERE clause for the search arguments
      * - an ORDER BY clause for the sort arguments
      * - a LIMIT and OFFSET clause for paging arguments.
-     * Note that the later may be subject to change in order to allow for a more performant realisation of paging.
+     * - a comparison on the sort key, when a `__seek` argument was given (keyset paging).
      *
      * If `indentation` is not empty, then a mild form of pretty printing is applied by adding a line break and then
      * the given indentation after individual expressions.
@@ -91,11 +129,19 @@ public:
     std::string getSqlWhereExpression (const pqxx::connection& connection, const std::string& indentation = "") const;
     std::string getSqlSortExpression (void) const;
     std::string getSqlPagingExpression (bool oneAdditionalItem) const;
+    /**
+     * Return the row comparison on the sort key, truncated to milliseconds, `prescription_type` and
+     * `prescription_id` for keyset paging or an empty string if no `__seek` argument was given.
+     * The expression is not part of getSqlWhereExpression() so that the latter can still be used to count
+     * all matches.
+     */
+    std::string getSqlSeekExpression (void) const;
 
     bool hasReverseIncludeAuditEventArgument() const;
 
     const PagingArgument& pagingArgument() const;
     void disablePagingArgument();
+    bool isPagingArgumentDisabled() const;
     [[nodiscard]] std::optional<SearchArgument> getSearchArgument(const std::string_view& name) const;
 
     /**
@@ -112,6 +158,7 @@ private:
     PagingArgument mPagingArgument;
     bool mPagingArgument_disabled = false;
     bool mReverseIncludeAuditEventArgument = false;
+    bool mKeysetPagingEnabled = false;
     std::optional<std::string> mDefaultSortArgument;
     friend class TestUrlArguments;
 
@@ -158,6 +205,7 @@ private:
     void appendLinkPagingArguments (std::ostream& os, const model::Link::Type type, LinkMode linkMode) const;
     void appendLinkPagingArgumentsWithId(std::ostream& os, const model::Link::Type type) const;
     void appendLinkPagingArgumentsWithOffset(std::ostream& os, const model::Link::Type type) const;
+    void appendLinkPagingArgumentsWithSeek(std::ostream& os, const model::Link::Type type) const;
     void appendLinkSeparator (std::ostream& os) const;
 
     std::optional<SearchParameter::Type> getParameterType (const std::string& argumentName) const;
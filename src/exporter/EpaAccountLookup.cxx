@@ -84,7 +84,8 @@ EpaAccount EpaAccountLookup::lookup(const std::string& xRequestId, const model::
                                   .host = host,
                                   .port = port,
                                   .lookupResult = result,
-                                  .failingHosts = failingHosts};
+                                  .failingHosts = failingHosts,
+                                  .consentReused = false};
             case EpaAccount::Code::notFound:
                 break;
             case EpaAccount::Code::unknown:
@@ -98,7 +99,8 @@ EpaAccount EpaAccountLookup::lookup(const std::string& xRequestId, const model::
                       .host = {},
                       .port = 0,
                       .lookupResult = allNotFound ? EpaAccount::Code::notFound : EpaAccount::Code::unknown,
-                      .failingHosts = failingHosts};
+                      .failingHosts = failingHosts,
+                      .consentReused = false};
 }
 
 EpaAccount::Code EpaAccountLookup::checkConsent(const std::string& xRequestId, const model::Kvnr& kvnr,
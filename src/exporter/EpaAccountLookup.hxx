@@ -29,6 +29,8 @@ struct EpaAccount {
     uint16_t port;
     Code lookupResult;
     std::set<std::string> failingHosts;
+    // true if the consent decision of a previous lookup was reused instead of asking the ePA
+    bool consentReused = false;
 };
 
 class IEpaAccountLookup // NOLINT(cppcoreguidelines-special-member-functions)
@@ -18,8 +18,11 @@
 #include "shared/util/Configuration.hxx"
 #include "shared/util/Demangle.hxx"
 #include "shared/util/JsonLog.hxx"
+#include "shared/util/MetricsRegistry.hxx"
 #include "util/RuntimeConfiguration.hxx"
 
+#include <algorithm>
+
 using namespace std::chrono_literals;
 
 template<typename FuncT>
@@ -46,6 +49,8 @@ EventProcessor::EventProcessor(const std::shared_ptr<MedicationExporterServiceCo
           Configuration::instance().getIntValue(ConfigurationKey::MEDICATION_EXPORTER_RETRIES_RESCHEDULE_DELAY_SECONDS))
     , mHealthRecordRelocationWaitMinutes(
           Configuration::instance().getIntValue(ConfigurationKey::MEDICATION_EXPORTER_EPA_CONFLICT_WAIT_MINUTES))
+    , mConsentReuseWindow(Configuration::instance().getIntValue(
+          ConfigurationKey::MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_CONSENT_REUSE_SECONDS))
     , mMaxRetryAttempts(Configuration::instance().getIntValue(
           ConfigurationKey::MEDICATION_EXPORTER_RETRIES_MAXIMUM_BEFORE_DEADLETTER))
     , mXContext(xContextId)
@@ -133,7 +138,10 @@ void EventProcessor::processOne(const model::EventKvnr& kvnr)
                 case EpaAccount::Code::allowed:
                     // Workflow step 4a
                     TVLOG(1) << "account lookup allowed with given kvnr";
-                    checkDeactivateThrottle(epaAccount.host);
+                    if (! epaAccount.consentReused)
+                    {
+                        checkDeactivateThrottle(epaAccount.host);
+                    }
                     processEpaAllowed(kvnr, epaAccount, events);
                     break;
                 case EpaAccount::Code::deny:
@@ -161,7 +169,7 @@ void EventProcessor::processOne(const model::EventKvnr& kvnr)
             // Workflow step 13 - set kvnr to processed
             autocommit([&](auto& db) {
                 A_25941.start("Remove cached prefix, no more events for kvnr");
-                db.finalizeKvnr(kvnr, "");
+                db.finalizeKvnr(kvnr, "", true);
                 A_25941.finish();
             });
             TLOG(WARNING) << "KVNR to process had no events";
@@ -330,7 +338,7 @@ void EventProcessor::processEpaAllowed(const model::EventKvnr& kvnr, EpaAccount&
     // Workflow step 13 - set kvnr to processed
     autocommit([&](auto& db) {
         A_25941.start("Store prefix for reuse.");
-        db.finalizeKvnr(kvnr, epaAccount.host);
+        db.finalizeKvnr(kvnr, epaAccount.host, ! epaAccount.consentReused);
         A_25941.finish();
     });
     jsonLog() << kvnr << KeyValue("event", "KVNR processed");
@@ -350,7 +358,7 @@ void EventProcessor::processEpaDeniedOrNotFound(const model::EventKvnr& kvnr)
     // Workflow step 13 - set kvnr to processed
     autocommit([&](auto& db) {
         A_25941.start("Remove cached prefix for lookup denied / not found");
-        db.finalizeKvnr(kvnr, "");
+        db.finalizeKvnr(kvnr, "", true);
         A_25941.finish();
     });
 }
@@ -441,6 +449,25 @@ EpaAccount EventProcessor::ePaAccountLookup(const model::EventKvnr& kvnr, const
     data.prescriptionId = taskEvent.getPrescriptionId().toString();
     data.hashedKvnr = model::HashedKvnr(taskEvent.getHashedKvnr());
     mEpaAccountLookup.lookupClient().addLogAttribute(data);
+    if (kvnr.isConsentDecisionReusable(mConsentReuseWindow))
+    {
+        const auto prefix = *kvnr.getAssignedEpa() + ".";
+        const auto fqdns = Configuration::instance().epaFQDNs();
+        const auto fqdn = std::ranges::find_if(fqdns, [&prefix](const auto& item) {
+            return item.hostName.starts_with(prefix);
+        });
+        MetricsRegistry::instance().countCacheLookup("epa_consent_decision", fqdn != fqdns.end());
+        if (fqdn != fqdns.end())
+        {
+            TVLOG(1) << "reusing consent decision of " << kvnr.getLastConsentCheck()->toXsDateTime();
+            return EpaAccount{.kvnr = taskEvent.getKvnr(),
+                              .host = fqdn->hostName,
+                              .port = fqdn->port,
+                              .lookupResult = EpaAccount::Code::allowed,
+                              .failingHosts = {},
+                              .consentReused = true};
+        }
+    }
     auto acc = mEpaAccountLookup.lookup(taskEvent.getXRequestId(), taskEvent.getKvnr(),
                                         kvnr.useCachedValues() ? kvnr.getAssignedEpa() : std::nullopt);
     return acc;
@@ -458,6 +485,8 @@ void EventProcessor::scheduleRetryQueue(const model::EventKvnr& kvnr)
 void EventProcessor::scheduleHealthRecordRelocation(const model::EventKvnr& kvnr)
 {
     autocommit([&](auto& db) {
+        // the account is moving to another ePA, a reused consent decision would point to the old one
+        db.resetAssignedEpa(kvnr);
         db.updateProcessingDelay(0, mHealthRecordRelocationWaitMinutes, kvnr);
     });
 }
@@ -71,6 +71,7 @@ private:
     IEpaAccountLookup& mEpaAccountLookup;
     std::chrono::seconds mRetryDelaySeconds;
     std::chrono::minutes mHealthRecordRelocationWaitMinutes;
+    std::chrono::seconds mConsentReuseWindow;
     int mMaxRetryAttempts;
     std::string mXContext{Uuid{}.toString()};
     ScopedLogContext mLogContext;
@@ -1,6 +1,7 @@
 #include "exporter/TRezeptEventProcessor.hxx"
 #include "client/BfArMClient.hxx"
 #include "client/FhirVZDClient.hxx"
+#include "client/VzdSearchCache.hxx"
 #include "exporter/ExporterRequirements.hxx"
 #include "exporter/RunLoopScheduler.hxx"
 #include "exporter/TRezeptTransformer.hxx"
@@ -45,17 +46,20 @@ TRezeptEventProcessor::TRezeptEventProcessor(const std::shared_ptr<MedicationExp
 {
 }
 
-std::optional<model::Bundle> TRezeptEventProcessor::runFhirVzdSearch(const model::TRezeptEvent& event)
+std::shared_ptr<const model::Bundle> TRezeptEventProcessor::runFhirVzdSearch(const model::TRezeptEvent& event)
 {
-    const std::string clientId =
-        Configuration::instance().getStringValue(ConfigurationKey::MEDICATION_EXPORTER_FHIR_VZD_CLIENT_ID);
-    FhirVzdClient fhirVzdClient(clientId, mServiceContext->crlProvider(), event.getXContextId());
-    fhirVzdClient.setEvent(&event);
     try
     {
         ModelExpect(event.getState() != model::TRezeptEvent::State::deadLetterQueue, "TRezeptEvent in invalid state.");
         A_27825.start("Start fhir vzd search with given org id");
-        model::Bundle bundle = fhirVzdClient.performSearch(event.orgTelematikId().id());
+        auto bundle = mServiceContext->vzdSearchCache().lookup(
+            event.orgTelematikId().id(), [this, &event](const std::string& telematikId) {
+                const std::string clientId =
+                    Configuration::instance().getStringValue(ConfigurationKey::MEDICATION_EXPORTER_FHIR_VZD_CLIENT_ID);
+                FhirVzdClient fhirVzdClient(clientId, mServiceContext->crlProvider(), event.getXContextId());
+                fhirVzdClient.setEvent(&event);
+                return fhirVzdClient.performSearch(telematikId);
+            });
         A_27825.finish();
         return bundle;
     }
@@ -292,7 +296,7 @@ TRezeptEventProcessor::ResultType TRezeptEventProcessor::doProcess()
     A_27825.start("Start fhir vzd search");
     const auto vzdSearchBundle = runFhirVzdSearch(eventData);
     A_27825.finish();
-    if (not vzdSearchBundle.has_value())
+    if (vzdSearchBundle == nullptr)
     {
         // Possible error logged (runFhirVzdSearch), retry.
         // NOTE: clarify if DLQ is better option.
@@ -301,7 +305,7 @@ TRezeptEventProcessor::ResultType TRezeptEventProcessor::doProcess()
     }
 
     A_27826_01.start("Create carbon copy");
-    const auto cc = createCarbonCopy(eventData, vzdSearchBundle.value());
+    const auto cc = createCarbonCopy(eventData, *vzdSearchBundle);
     A_27826_01.finish();
 
     A_27828.start("Transfer carbon copy to bfarm");
@@ -66,7 +66,7 @@ public:
 private:
     ResultType doProcess();
 
-    std::optional<model::Bundle> runFhirVzdSearch(const model::TRezeptEvent& event);
+    std::shared_ptr<const model::Bundle> runFhirVzdSearch(const model::TRezeptEvent& event);
     std::optional<model::ErpTPrescriptionCarbonCopy> createCarbonCopy(const model::TRezeptEvent& eventData,
                                                                       const model::Bundle& vzdSearchBundle);
     ResultType sendCarbonCopy(const model::TRezeptEvent& event, const model::ErpTPrescriptionCarbonCopy& cc);
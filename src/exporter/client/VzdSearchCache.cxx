@@ -0,0 +1,158 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "exporter/client/VzdSearchCache.hxx"
+#include "shared/model/Bundle.hxx"
+#include "shared/util/Configuration.hxx"
+#include "shared/util/MetricsRegistry.hxx"
+#include "shared/util/TLog.hxx"
+
+#include <gsl/gsl-lite.hpp>
+
+
+namespace
+{
+    constexpr auto metricsName = "vzd_search";
+}
+
+
+VzdSearchCache::VzdSearchCache(std::chrono::steady_clock::duration timeToLive,
+                               std::chrono::steady_clock::duration negativeTimeToLive, size_t maxEntries)
+    : mTimeToLive(timeToLive)
+    , mNegativeTimeToLive(negativeTimeToLive)
+    , mMaxEntries(maxEntries)
+{
+}
+
+
+std::unique_ptr<VzdSearchCache> VzdSearchCache::fromConfiguration()
+{
+    const auto& configuration = Configuration::instance();
+    return std::make_unique<VzdSearchCache>(
+        std::chrono::seconds{
+            configuration.getIntValue(ConfigurationKey::MEDICATION_EXPORTER_FHIR_VZD_CACHE_TTL_SECONDS)},
+        std::chrono::seconds{
+            configuration.getIntValue(ConfigurationKey::MEDICATION_EXPORTER_FHIR_VZD_CACHE_NEGATIVE_TTL_SECONDS)},
+        gsl::narrow<size_t>(
+            configuration.getIntValue(ConfigurationKey::MEDICATION_EXPORTER_FHIR_VZD_CACHE_MAX_ENTRIES)));
+}
+
+
+std::shared_ptr<const model::Bundle> VzdSearchCache::lookup(const std::string& telematikId,
+                                                            const SearchFunction& search)
+{
+    if (mTimeToLive <= std::chrono::steady_clock::duration::zero())
+    {
+        return std::make_shared<const model::Bundle>(search(telematikId));
+    }
+
+    std::promise<std::shared_ptr<const model::Bundle>> promise;
+    PendingSearch pendingSearch;
+    bool isSearching = false;
+    {
+        std::lock_guard lock(mMutex);
+        const auto candidate = mEntries.find(telematikId);
+        if (candidate != mEntries.end())
+        {
+            if (candidate->second.validUntil > std::chrono::steady_clock::now())
+            {
+                auto bundle = candidate->second.bundle;
+                MetricsRegistry::instance().countCacheLookup(metricsName, true);
+                return bundle;
+            }
+            mEntries.erase(candidate);
+        }
+        const auto pending = mPendingSearches.find(telematikId);
+        if (pending != mPendingSearches.end())
+        {
+            pendingSearch = pending->second;
+        }
+        else
+        {
+            pendingSearch = promise.get_future().share();
+            mPendingSearches.emplace(telematikId, pendingSearch);
+            isSearching = true;
+        }
+    }
+
+    MetricsRegistry::instance().countCacheLookup(metricsName, false);
+    if (! isSearching)
+    {
+        TVLOG(2) << "waiting for pending VZD search";
+        return pendingSearch.get();
+    }
+    return this->search(telematikId, search, promise);
+}
+
+
+void VzdSearchCache::clear()
+{
+    std::lock_guard lock(mMutex);
+    mEntries.clear();
+}
+
+
+size_t VzdSearchCache::size() const
+{
+    std::lock_guard lock(mMutex);
+    return mEntries.size();
+}
+
+
+std::shared_ptr<const model::Bundle> VzdSearchCache::search(
+    const std::string& telematikId, const SearchFunction& search,
+    std::promise<std::shared_ptr<const model::Bundle>>& promise)
+{
+    std::shared_ptr<const model::Bundle> bundle;
+    try
+    {
+        bundle = std::make_shared<const model::Bundle>(search(telematikId));
+    }
+    catch (...)
+    {
+        {
+            std::lock_guard lock(mMutex);
+            mPendingSearches.erase(telematikId);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+    store(telematikId, bundle);
+    promise.set_value(bundle);
+    return bundle;
+}
+
+
+void VzdSearchCache::store(const std::string& telematikId, const std::shared_ptr<const model::Bundle>& bundle)
+{
+    const auto lifetime = bundle->getResourceCount() > 0 ? mTimeToLive : mNegativeTimeToLive;
+    const auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard lock(mMutex);
+    mPendingSearches.erase(telematikId);
+    if (lifetime <= std::chrono::steady_clock::duration::zero())
+    {
+        return;
+    }
+    if (mEntries.size() >= mMaxEntries)
+    {
+        removeExpired(now);
+        if (mEntries.size() >= mMaxEntries)
+        {
+            TVLOG(1) << "VZD search cache is full, clearing it";
+            mEntries.clear();
+        }
+    }
+    mEntries.insert_or_assign(telematikId, StoredEntry{bundle, now + lifetime});
+}
+
+
+void VzdSearchCache::removeExpired(std::chrono::steady_clock::time_point now)
+{
+    std::erase_if(mEntries, [now](const auto& item) {
+        return item.second.validUntil <= now;
+    });
+}
@@ -0,0 +1,88 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace model
+{
+class Bundle;
+}
+
+
+/**
+ * @brief Cache for the results of FHIR VZD searches, keyed by the Telematik-ID of the organization.
+ *
+ * Pharmacies dispense many T-Rezepte, so the same organization is searched for repeatedly. Successful searches
+ * are kept for the configured time to live. A search result without entries (the organization is not listed in
+ * the directory) is kept for the shorter negative time to live, so that a newly registered organization is
+ * found soon. Failed searches are never cached.
+ *
+ * Concurrent lookups of the same Telematik-ID are coalesced: only the first caller performs the search, the
+ * others wait for its result or its exception.
+ *
+ * The class is thread safe.
+ */
+class VzdSearchCache
+{
+public:
+    static constexpr size_t defaultMaxEntries = 10000;
+
+    using SearchFunction = std::function<model::Bundle(const std::string& telematikId)>;
+
+    /**
+     * @param timeToLive            lifetime of a search result with entries, a value of zero disables the cache
+     * @param negativeTimeToLive    lifetime of a search result without entries, a value of zero disables
+     *                              negative caching
+     * @param maxEntries            when this number of entries is reached, expired entries are removed and,
+     *                              if that does not help, the cache is cleared
+     */
+    VzdSearchCache(std::chrono::steady_clock::duration timeToLive,
+                   std::chrono::steady_clock::duration negativeTimeToLive, size_t maxEntries = defaultMaxEntries);
+
+    /**
+     * Create the cache with the settings from the configuration.
+     */
+    static std::unique_ptr<VzdSearchCache> fromConfiguration();
+
+    /**
+     * @brief Return the cached search result for `telematikId` or call `search` to obtain it.
+     *
+     * @throws whatever `search` throws, also for callers whose lookup was coalesced with the failing one
+     */
+    std::shared_ptr<const model::Bundle> lookup(const std::string& telematikId, const SearchFunction& search);
+
+    void clear();
+
+    size_t size() const;
+
+private:
+    struct StoredEntry
+    {
+        std::shared_ptr<const model::Bundle> bundle;
+        std::chrono::steady_clock::time_point validUntil;
+    };
+    using PendingSearch = std::shared_future<std::shared_ptr<const model::Bundle>>;
+
+    std::shared_ptr<const model::Bundle> search(const std::string& telematikId, const SearchFunction& search,
+                                                std::promise<std::shared_ptr<const model::Bundle>>& promise);
+    void store(const std::string& telematikId, const std::shared_ptr<const model::Bundle>& bundle);
+    void removeExpired(std::chrono::steady_clock::time_point now);
+
+    const std::chrono::steady_clock::duration mTimeToLive;
+    const std::chrono::steady_clock::duration mNegativeTimeToLive;
+    const size_t mMaxEntries;
+    mutable std::mutex mMutex;
+    std::map<std::string, StoredEntry> mEntries;
+    std::map<std::string, PendingSearch> mPendingSearches;
+};
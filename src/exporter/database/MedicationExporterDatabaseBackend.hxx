@@ -12,6 +12,7 @@
 #include "exporter/model/TaskEvent.hxx"
 #include "shared/database/DatabaseBackend.hxx"
 
+#include <functional>
 #include <optional>
 #include <vector>
 
@@ -28,7 +29,14 @@ public:
     ~MedicationExporterDatabaseBackend() override = default;
 
     virtual std::optional<model::EventKvnr> processNextKvnr() = 0;
-    virtual std::vector<db_model::TaskEvent> getAllEventsForKvnr(const model::EventKvnr& kvnr) = 0;
+    using TaskEventConsumer = std::function<void(db_model::TaskEvent&&)>;
+
+    /**
+     * Passes the pending events of `kvnr` to `consumer`, ordered by prescription and last modification.
+     * The events are read in pages, so that not all encrypted rows of a KVNR have to be held in memory at once.
+     * All pages are read from the same snapshot of the database.
+     */
+    virtual void forEachEventForKvnr(const model::EventKvnr& kvnr, const TaskEventConsumer& consumer) = 0;
     virtual bool isDeadLetter(const model::EventKvnr& kvnr, const model::PrescriptionId& prescriptionId,
                               model::PrescriptionType prescriptionType) = 0;
     virtual int markDeadLetter(const model::EventKvnr& kvnr, const model::PrescriptionId& prescriptionId,
@@ -37,8 +45,9 @@ public:
     virtual void deleteOneEventForKvnr(const model::EventKvnr& kvnr, model::TaskEvent::id_t id) = 0;
     virtual void deleteAllEventsForKvnr(const model::EventKvnr& kvnr) = 0;
     virtual void updateProcessingDelay(std::int32_t newRetry, std::chrono::seconds delay, const model::EventKvnr& kvnr) = 0;
-    virtual void finalizeKvnr(const model::EventKvnr& kvnr,
-                              const std::string& assignedEpaPrefix) const = 0;
+    virtual void finalizeKvnr(const model::EventKvnr& kvnr, const std::string& assignedEpaPrefix,
+                              bool consentChecked) const = 0;
+    virtual void resetAssignedEpa(const model::EventKvnr& kvnr) = 0;
 
     virtual std::optional<db_model::TaskEvent> processNextTRezeptEvent() = 0;
     virtual void deleteTRezeptEvent(model::TRezeptEvent::id_t eventId) = 0;
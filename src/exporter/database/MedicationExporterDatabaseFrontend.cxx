@@ -71,24 +71,24 @@ std::optional<model::EventKvnr> MedicationExporterDatabaseFrontend::processNextK
 MedicationExporterDatabaseFrontendInterface::taskevents_t
 MedicationExporterDatabaseFrontend::getAllEventsForKvnr(const model::EventKvnr& eventKvnr) const
 {
-    auto dbTaskEventList = mBackend->getAllEventsForKvnr(eventKvnr);
+    // Events are decrypted as they are read and the encrypted rows are not kept. The decrypted events of the KVNR are
+    // still collected, because the event processor needs all of them.
     std::vector<std::unique_ptr<model::TaskEvent>> allTaskEvents;
-    for (const auto& dbTaskEvent : dbTaskEventList)
-    {
+    TaskEventConverter converter(mCodec, mTelematikLookup);
+    mBackend->forEachEventForKvnr(eventKvnr, [&](db_model::TaskEvent&& dbTaskEvent) {
         auto keyForTask = taskKey(dbTaskEvent);
         SafeString keyForMedicationDispense{
             dbTaskEvent.medicationDispenseBundle.has_value() ? medicationDispenseKey(dbTaskEvent) : SafeString{}};
         try
         {
-            allTaskEvents.emplace_back(
-                TaskEventConverter(mCodec, mTelematikLookup).convert(dbTaskEvent, keyForTask, keyForMedicationDispense));
+            allTaskEvents.emplace_back(converter.convert(dbTaskEvent, keyForTask, keyForMedicationDispense));
         }
         catch (ExceptionWrapperBase& ex)
         {
             ex.addContext("prescription_id", dbTaskEvent.prescriptionId.toString());
             throw;
         }
-    }
+    });
     return allTaskEvents;
 }
 
@@ -146,9 +146,14 @@ void MedicationExporterDatabaseFrontend::updateProcessingDelay(std::int32_t newR
 }
 
 void MedicationExporterDatabaseFrontend::finalizeKvnr(const model::EventKvnr& kvnr,
-                                                      const std::string& assignedEpaPrefix) const
+                                                      const std::string& assignedEpaPrefix, bool consentChecked) const
+{
+    mBackend->finalizeKvnr(kvnr, assignedEpaPrefix, consentChecked);
+}
+
+void MedicationExporterDatabaseFrontend::resetAssignedEpa(const model::EventKvnr& kvnr) const
 {
-    mBackend->finalizeKvnr(kvnr, assignedEpaPrefix);
+    mBackend->resetAssignedEpa(kvnr);
 }
 
 SafeString MedicationExporterDatabaseFrontend::taskKey(const db_model::TaskEvent& dbTaskEvent) const
@@ -55,8 +55,10 @@ public:
 
     void updateProcessingDelay(std::int32_t newRetry, std::chrono::seconds delay, const model::EventKvnr& kvnr) const override;
 
-    void finalizeKvnr(const model::EventKvnr& kvnr,
-                      const std::string& assignedEpaPrefix) const override;
+    void finalizeKvnr(const model::EventKvnr& kvnr, const std::string& assignedEpaPrefix,
+                      bool consentChecked) const override;
+
+    void resetAssignedEpa(const model::EventKvnr& kvnr) const override;
 
     std::optional<std::unique_ptr<model::TRezeptEvent>> processNextTRezeptEvent() const override;
     void deleteTRezeptEvent(model::TRezeptEvent::id_t eventId) const override;
@@ -54,6 +54,7 @@ public:
     virtual MedicationExporterDatabaseBackend& getBackend() = 0;
 
     virtual std::optional<model::EventKvnr> processNextKvnr() const = 0;
+    /// Returns all pending events of `eventKvnr`, read from a single snapshot of the database.
     virtual taskevents_t getAllEventsForKvnr(const model::EventKvnr& eventKvnr) const = 0;
     virtual bool isDeadLetter(const model::EventKvnr& kvnr, const model::PrescriptionId& prescriptionId,
                               model::PrescriptionType prescriptionType) const = 0;
@@ -80,8 +81,19 @@ public:
      */
     virtual void updateProcessingDelay(std::int32_t newRetry, std::chrono::seconds delay,
                                        const model::EventKvnr& kvnr) const = 0;
-    virtual void finalizeKvnr(const model::EventKvnr& kvnr,
-                              const std::string& assignedEpaPrefix) const = 0;
+    /**
+     * Mark a KVNR as processed and store the ePA its account was found on.
+     * @param assignedEpaPrefix host name of the ePA, only its first label is stored, empty to remove a stored ePA
+     * @param consentChecked if false, the time of the last consent check is kept, because the consent decision
+     *                       of that check has been reused
+     */
+    virtual void finalizeKvnr(const model::EventKvnr& kvnr, const std::string& assignedEpaPrefix,
+                              bool consentChecked) const = 0;
+    /**
+     * Remove the stored ePA of a KVNR, e.g. after a conflict during a health record relocation.
+     * The next processing of the KVNR will then ask all ePAs for a consent decision.
+     */
+    virtual void resetAssignedEpa(const model::EventKvnr& kvnr) const = 0;
 };
 
 #endif//ERP_PROCESSING_CONTEXT_SRC_EXPORTER_DATABASE_MEDICATIONEXPORTERFRONTENDINTERFACE_HXX
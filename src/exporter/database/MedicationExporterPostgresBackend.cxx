@@ -17,6 +17,7 @@
 #include "shared/util/JsonLog.hxx"
 #include "shared/util/TLog.hxx"
 
+#include <algorithm>
 #include <boost/algorithm/string/replace.hpp>
 #include <pqxx/pqxx>
 
@@ -47,18 +48,23 @@ RETURNING
   kvnr_hashed, EXTRACT(EPOCH FROM last_consent_check), assigned_epa, state, retry_count;
     )");
 
-QUERY(sqlGetAllEventsForKvnr, R"(
+// Events are read in pages of $5 rows. The page key is the sort key of the last row of the previous page,
+// last_modified is returned as text to keep its full precision.
+QUERY(sqlGetEventsForKvnrPage, R"(
 SELECT
   id, prescription_id, prescription_type, task_key_blob_id, salt, kvnr, kvnr_hashed, state, usecase, doctor_identity,
   pharmacy_identity,
   EXTRACT(EPOCH FROM last_modified), EXTRACT(EPOCH FROM authored_on), healthcare_provider_prescription,
-  medication_dispense_blob_id, medication_dispense_salt, medication_dispense_bundle, retry_count
+  medication_dispense_blob_id, medication_dispense_salt, medication_dispense_bundle, retry_count,
+  last_modified::text
 FROM
   erp_event.task_event
 WHERE
   kvnr_hashed = $1::bytea AND state = 'pending'
+  AND ($2::bigint IS NULL OR (prescription_id, last_modified, id) > ($2::bigint, $3::timestamptz, $4::bigint))
 ORDER BY
-  prescription_id ASC, last_modified ASC;
+  prescription_id ASC, last_modified ASC, id ASC
+LIMIT $5;
     )");
 QUERY(sqlCheckDeadletter, R"(
 SELECT
@@ -116,10 +122,18 @@ SET
   retry_count = 0,
   next_export = null,
   assigned_epa = $2,
-  last_consent_check = NOW()
+  last_consent_check = CASE WHEN $3::boolean THEN NOW() ELSE last_consent_check END
 WHERE
   kvnr_hashed = $1::bytea AND state = 'processing';
     )");
+QUERY(sqlResetAssignedEpa, R"(
+UPDATE
+  erp_event.kvnr
+SET
+  assigned_epa = ''
+WHERE
+  kvnr_hashed = $1::bytea;
+    )");
 
 QUERY(sqlHealthCheck, R"(
 SELECT
@@ -211,6 +225,8 @@ thread_local PostgresConnection MedicationExporterPostgresBackend::mConnection{{
 
 MedicationExporterPostgresBackend::MedicationExporterPostgresBackend(TransactionMode mode)
     : CommonPostgresBackend(mConnection, mode)
+    , mEventFetchSize(std::max(
+          Configuration::instance().getIntValue(ConfigurationKey::MEDICATION_EXPORTER_POSTGRES_EVENT_FETCH_SIZE), 1))
 {
 }
 
@@ -281,56 +297,83 @@ std::optional<model::EventKvnr> MedicationExporterPostgresBackend::processNextKv
     return std::nullopt;
 }
 
-std::vector<db_model::TaskEvent>
-MedicationExporterPostgresBackend::getAllEventsForKvnr(const model::EventKvnr& eventKvnr)
+void MedicationExporterPostgresBackend::forEachEventForKvnr(const model::EventKvnr& eventKvnr,
+                                                            const TaskEventConsumer& consumer)
 {
     checkCommonPreconditions();
-    TVLOG(2) << sqlGetAllEventsForKvnr.query;
+    TVLOG(2) << sqlGetEventsForKvnrPage.query;
     const auto timerKeepAlive =
         DurationConsumer::getCurrent().getTimer(DurationCategory::postgres, "getalleventsforkvnr");
 
-    if (not eventKvnr.kvnrHashed().empty())
+    if (eventKvnr.kvnrHashed().empty())
     {
-        const auto results = transaction()->exec(sqlGetAllEventsForKvnr.query, pqxx::params{eventKvnr.kvnrHashed()});
-        TVLOG(2) << "got " << results.size() << " results";
+        return;
+    }
 
-        std::vector<db_model::TaskEvent> models{};
-        TaskEventQueryIndexes idx;
-        for (const auto& res : results)
+    // In autocommit mode every page would be read with its own snapshot and events that are inserted or deleted
+    // between two pages could be missed or read twice. Therefore all pages are read in one read-only transaction
+    // with a single snapshot. In transaction mode the pages are read in the transaction of the caller.
+    const bool autocommit = dynamic_cast<pqxx::nontransaction*>(transaction().get()) != nullptr;
+    if (autocommit)
+    {
+        transaction()->exec("BEGIN TRANSACTION ISOLATION LEVEL REPEATABLE READ READ ONLY");
+    }
+    try
+    {
+        readEventsForKvnrInPages(eventKvnr, consumer);
+    }
+    catch (...)
+    {
+        if (autocommit)
         {
-            Expect(res.size() == idx.total, "Invalid number of fields in result row: " + std::to_string(res.size()));
-            auto prescription_type_opt = magic_enum::enum_cast<model::PrescriptionType>(
-                map<uint8_t, int16_t>(res, idx.prescriptionType, "prescription_type is null"));
-            Expect(prescription_type_opt.has_value(), "could not cast to PrescriptionType");
-
-
-            const auto& prescriptionId = model::PrescriptionId::fromDatabaseId(
-                *prescription_type_opt, map<int64_t>(res, idx.prescriptionId, "prescription_id is null"));
-
-            models.emplace_back(
-                map<db_model::TaskEvent::id_t, model::TaskEvent::id_t>(res, idx.id, "id is null"), prescriptionId,
-                map<std::int16_t, std::int16_t>(res, idx.prescriptionType, "prescription type is null"),
-                map<BlobId, int32_t>(res, idx.keyBlobId, "blob id is null"),
-                map<db_model::Blob, db_model::postgres_bytea>(res, idx.salt, "salt is null"),
-                map<db_model::EncryptedBlob, db_model::postgres_bytea>(res, idx.kvnr, "kvnr is null"),
-                map<db_model::HashedKvnr, db_model::postgres_bytea>(res, idx.kvnrHashed, "kvnr_hashed is null"),
-                map<std::string, std::string>(res, idx.state, "state is null"),
-                map<std::string, std::string>(res, idx.usecase, "use case is null"),
-                map<model::Timestamp, double>(res, idx.lastModified, "last_modified is null"),
-                map<model::Timestamp, double>(res, idx.authoredOn, "authored_on is null"),
-                mapOptional<db_model::EncryptedBlob, db_model::postgres_bytea>(res, idx.healthcareProviderPrescription),
-                mapOptional<BlobId, int32_t>(res, idx.medicationDispenseBundleBlobId),
-                mapOptional<db_model::Blob, db_model::postgres_bytea>(res, idx.medicationDispenseBundleSalt),
-                mapOptional<db_model::EncryptedBlob, db_model::postgres_bytea>(res, idx.medicationDispenseBundle),
-                mapOptional<db_model::EncryptedBlob, db_model::postgres_bytea>(res, idx.doctorIdentity),
-                mapOptional<db_model::EncryptedBlob, db_model::postgres_bytea>(res, idx.pharmacyIdentity),
-                mapDefault<std::int32_t, std::int32_t>(res, idx.retryCount, 0)
-                );
+            try
+            {
+                transaction()->exec("ROLLBACK");
+            }
+            catch (const std::exception& exc)
+            {
+                TLOG(WARNING) << "rollback of read-only transaction failed: " << exc.what();
+            }
         }
-        return models;
+        throw;
     }
+    if (autocommit)
+    {
+        transaction()->exec("COMMIT");
+    }
+}
 
-    return {};
+void MedicationExporterPostgresBackend::readEventsForKvnrInPages(const model::EventKvnr& eventKvnr,
+                                                                const TaskEventConsumer& consumer)
+{
+    const TaskEventQueryIndexes idx;
+    const auto lastModifiedText = gsl::narrow<pqxx::row::size_type>(idx.total);
+    std::optional<std::int64_t> lastPrescriptionId;
+    std::optional<std::string> lastModified;
+    std::optional<db_model::TaskEvent::id_t> lastId;
+    size_t total = 0;
+    for (;;)
+    {
+        const auto results = transaction()->exec(
+            sqlGetEventsForKvnrPage.query,
+            pqxx::params{eventKvnr.kvnrHashed(), lastPrescriptionId, lastModified, lastId, mEventFetchSize});
+        TVLOG(2) << "got " << results.size() << " results";
+        total += results.size();
+        for (const auto& res : results)
+        {
+            Expect(res.size() == idx.total + 1,
+                   "Invalid number of fields in result row: " + std::to_string(res.size()));
+            lastPrescriptionId = map<int64_t>(res, idx.prescriptionId, "prescription_id is null");
+            lastModified = map<std::string>(res, lastModifiedText, "last_modified is null");
+            lastId = map<db_model::TaskEvent::id_t, model::TaskEvent::id_t>(res, idx.id, "id is null");
+            consumer(taskEventFromRow(res));
+        }
+        if (results.size() < gsl::narrow<size_t>(mEventFetchSize))
+        {
+            break;
+        }
+    }
+    TVLOG(2) << "read " << total << " events";
 }
 
 bool MedicationExporterPostgresBackend::isDeadLetter(const model::EventKvnr& kvnr,
@@ -454,7 +497,7 @@ void MedicationExporterPostgresBackend::deleteOneEventForKvnr(const model::Event
 }
 
 void MedicationExporterPostgresBackend::finalizeKvnr(const model::EventKvnr& kvnr,
-                                                     const std::string& assignedEpaPrefix) const
+                                                     const std::string& assignedEpaPrefix, bool consentChecked) const
 {
     checkCommonPreconditions();
     TVLOG(2) << sqlFinalizeKvnr.query;
@@ -467,11 +510,24 @@ void MedicationExporterPostgresBackend::finalizeKvnr(const model::EventKvnr& kvn
 
     const auto parts = String::split(assignedEpaPrefix, '.');
     Expect(not parts.empty(), "Invalid fqdn");
-    const auto results = transaction()->exec(sqlFinalizeKvnr.query, pqxx::params{s, parts[0]});
+    const auto results = transaction()->exec(sqlFinalizeKvnr.query, pqxx::params{s, parts[0], consentChecked});
 
     TVLOG(2) << "got " << results.size() << " results";
 }
 
+void MedicationExporterPostgresBackend::resetAssignedEpa(const model::EventKvnr& kvnr)
+{
+    checkCommonPreconditions();
+    TVLOG(2) << sqlResetAssignedEpa.query;
+    const auto timerKeepAlive =
+        DurationConsumer::getCurrent().getTimer(DurationCategory::postgres, "sqlresetassignedepa");
+
+    Expect(not kvnr.kvnrHashed().empty(), "Kvnr missing");
+
+    const auto results = transaction()->exec(sqlResetAssignedEpa.query, pqxx::params{kvnr.kvnrHashed()});
+    TVLOG(2) << "affected " << results.affected_rows() << " rows";
+}
+
 std::optional<db_model::TaskEvent> MedicationExporterPostgresBackend::processNextTRezeptEvent()
 {
     checkCommonPreconditions();
@@ -489,39 +545,12 @@ std::optional<db_model::TaskEvent> MedicationExporterPostgresBackend::processNex
 
     Expect(results.size() == 1, "A maximum of one result row expected, but got " + std::to_string(results.size()));
 
-    auto res = results.at(0);
-
-    TaskEventQueryIndexes idx;
-
+    const auto res = results.at(0);
+    const TaskEventQueryIndexes idx;
     Expect(res.size() == idx.total, "Invalid number of fields in result row: " + std::to_string(res.size()));
 
-    auto prescription_type_opt = magic_enum::enum_cast<model::PrescriptionType>(
-        map<uint8_t, int16_t>(res, idx.prescriptionType, "prescription_type is null"));
-    Expect(prescription_type_opt.has_value(), "could not cast to PrescriptionType");
-
-    const auto& prescriptionId = model::PrescriptionId::fromDatabaseId(
-        *prescription_type_opt, map<int64_t>(res, idx.prescriptionId, "prescription_id is null"));
-    timerKeepAlive.keyValue(std::string{"prescription_id"}, prescriptionId.toString());
-    db_model::TaskEvent dbModel(
-        map<db_model::TaskEvent::id_t, model::TaskEvent::id_t>(res, idx.id, "id is null"),
-        prescriptionId,
-        map<std::int16_t, std::int16_t>(res, idx.prescriptionType, "prescription type is null"),
-        map<BlobId, int32_t>(res, idx.keyBlobId, "blob id is null"),
-        map<db_model::Blob, db_model::postgres_bytea>(res, idx.salt, "salt is null"),
-        map<db_model::EncryptedBlob, db_model::postgres_bytea>(res, idx.kvnr, "kvnr is null"),
-        map<db_model::HashedKvnr, db_model::postgres_bytea>(res, idx.kvnrHashed, "kvnr_hashed is null"),
-        map<std::string, std::string>(res, idx.state, "state is null"),
-        map<std::string, std::string>(res, idx.usecase, "use case is null"),
-        map<model::Timestamp, double>(res, idx.lastModified, "last_modified is null"),
-        map<model::Timestamp, double>(res, idx.authoredOn, "authored_on is null"),
-        mapOptional<db_model::EncryptedBlob, db_model::postgres_bytea>(res, idx.healthcareProviderPrescription),
-        mapOptional<BlobId, int32_t>(res, idx.medicationDispenseBundleBlobId),
-        mapOptional<db_model::Blob, db_model::postgres_bytea>(res, idx.medicationDispenseBundleSalt),
-        mapOptional<db_model::EncryptedBlob, db_model::postgres_bytea>(res, idx.medicationDispenseBundle),
-        mapOptional<db_model::EncryptedBlob, db_model::postgres_bytea>(res, idx.doctorIdentity),
-        mapOptional<db_model::EncryptedBlob, db_model::postgres_bytea>(res, idx.pharmacyIdentity),
-        mapDefault<std::int32_t, std::int32_t>(res, idx.retryCount, 0));
-
+    auto dbModel = taskEventFromRow(res);
+    timerKeepAlive.keyValue(std::string{"prescription_id"}, dbModel.prescriptionId.toString());
     return dbModel;
 }
 
@@ -580,3 +609,34 @@ int MedicationExporterPostgresBackend::markDeadLetter(const model::TRezeptEvent&
     const auto result = transaction()->exec(sqlMarkDeadletterTRezeptEvent.query, pqxx::params{eventData.getId()});
     return result.affected_rows();
 }
+
+db_model::TaskEvent MedicationExporterPostgresBackend::taskEventFromRow(const pqxx::row& res)
+{
+    const TaskEventQueryIndexes idx;
+    auto prescription_type_opt = magic_enum::enum_cast<model::PrescriptionType>(
+        map<uint8_t, int16_t>(res, idx.prescriptionType, "prescription_type is null"));
+    Expect(prescription_type_opt.has_value(), "could not cast to PrescriptionType");
+
+    const auto& prescriptionId = model::PrescriptionId::fromDatabaseId(
+        *prescription_type_opt, map<int64_t>(res, idx.prescriptionId, "prescription_id is null"));
+
+    return db_model::TaskEvent{
+        map<db_model::TaskEvent::id_t, model::TaskEvent::id_t>(res, idx.id, "id is null"),
+        prescriptionId,
+        map<std::int16_t, std::int16_t>(res, idx.prescriptionType, "prescription type is null"),
+        map<BlobId, int32_t>(res, idx.keyBlobId, "blob id is null"),
+        map<db_model::Blob, db_model::postgres_bytea>(res, idx.salt, "salt is null"),
+        map<db_model::EncryptedBlob, db_model::postgres_bytea>(res, idx.kvnr, "kvnr is null"),
+        map<db_model::HashedKvnr, db_model::postgres_bytea>(res, idx.kvnrHashed, "kvnr_hashed is null"),
+        map<std::string, std::string>(res, idx.state, "state is null"),
+        map<std::string, std::string>(res, idx.usecase, "use case is null"),
+        map<model::Timestamp, double>(res, idx.lastModified, "last_modified is null"),
+        map<model::Timestamp, double>(res, idx.authoredOn, "authored_on is null"),
+        mapOptional<db_model::EncryptedBlob, db_model::postgres_bytea>(res, idx.healthcareProviderPrescription),
+        mapOptional<BlobId, int32_t>(res, idx.medicationDispenseBundleBlobId),
+        mapOptional<db_model::Blob, db_model::postgres_bytea>(res, idx.medicationDispenseBundleSalt),
+        mapOptional<db_model::EncryptedBlob, db_model::postgres_bytea>(res, idx.medicationDispenseBundle),
+        mapOptional<db_model::EncryptedBlob, db_model::postgres_bytea>(res, idx.doctorIdentity),
+        mapOptional<db_model::EncryptedBlob, db_model::postgres_bytea>(res, idx.pharmacyIdentity),
+        mapDefault<std::int32_t, std::int32_t>(res, idx.retryCount, 0)};
+}
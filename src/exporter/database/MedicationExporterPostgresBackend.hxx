@@ -27,7 +27,7 @@ public:
 
     std::optional<model::EventKvnr> processNextKvnr() override;
 
-    std::vector<db_model::TaskEvent> getAllEventsForKvnr(const model::EventKvnr& kvnr) override;
+    void forEachEventForKvnr(const model::EventKvnr& kvnr, const TaskEventConsumer& consumer) override;
 
     void healthCheck() override;
     bool isDeadLetter(const model::EventKvnr& kvnr, const model::PrescriptionId& prescriptionId,
@@ -42,8 +42,10 @@ public:
 
     void updateProcessingDelay(std::int32_t newRetry, std::chrono::seconds delay, const model::EventKvnr& kvnr) override;
 
-    void finalizeKvnr(const model::EventKvnr& kvnr,
-                      const std::string& assignedEpaPrefix) const override;
+    void finalizeKvnr(const model::EventKvnr& kvnr, const std::string& assignedEpaPrefix,
+                      bool consentChecked) const override;
+
+    void resetAssignedEpa(const model::EventKvnr& kvnr) override;
 
     std::optional<db_model::TaskEvent> processNextTRezeptEvent() override;
     void deleteTRezeptEvent(model::TRezeptEvent::id_t eventId) override;
@@ -89,6 +91,11 @@ public:
     static PostgresConnectionParameters defaultConnectParameters();
 
 private:
+    /// Maps a row with the columns described by TaskEventQueryIndexes.
+    db_model::TaskEvent taskEventFromRow(const pqxx::row& res);
+    /// Runs the paged queries of forEachEventForKvnr() in the current transaction.
+    void readEventsForKvnrInPages(const model::EventKvnr& eventKvnr, const TaskEventConsumer& consumer);
+
     /**
      * @brief return value from database field
      *
@@ -182,6 +189,7 @@ private:
         return std::nullopt;
     }
 
+    const int mEventFetchSize;
     thread_local static PostgresConnection mConnection;
 };
 
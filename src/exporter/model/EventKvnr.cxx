@@ -72,6 +72,12 @@ bool EventKvnr::useCachedValues() const
     A_25940.finish();
 }
 
+bool EventKvnr::isConsentDecisionReusable(std::chrono::seconds reuseWindow) const
+{
+    return reuseWindow > std::chrono::seconds::zero() && useCachedValues() &&
+           not isOlderThan<std::chrono::seconds>(getLastConsentCheck().value().toChronoTimePoint(), reuseWindow.count());
+}
+
 JsonLog& operator<<(JsonLog& jsonLog, const EventKvnr& kvnr)
 {
     return jsonLog.keyValue("kvnr", kvnr.getLoggingId());
@@ -39,6 +39,11 @@ public:
     std::int32_t getRetryCount() const;
 
     bool useCachedValues() const;
+    /**
+     * True if the cached values may be used and the last consent check is not older than `reuseWindow`.
+     * In that case the granted consent decision for the assigned ePA can be reused without a new lookup.
+     */
+    bool isConsentDecisionReusable(std::chrono::seconds reuseWindow) const;
 
 private:
     std::basic_string<std::byte> mKvnrHashed;
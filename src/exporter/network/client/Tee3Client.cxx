@@ -23,6 +23,7 @@
 #include "shared/util/Demangle.hxx"
 #include "shared/util/Expect.hxx"
 #include "shared/util/HeaderLog.hxx"
+#include "shared/util/MetricsRegistry.hxx"
 #include "shared/util/Random.hxx"
 #include "shared/util/SharedRequirements.hxx"
 #include "shared/util/Uuid.hxx"
@@ -286,12 +287,15 @@ Tee3Client::~Tee3Client() noexcept = default;
 //NOLINTNEXTLINE[misc-no-recursion]
 boost::asio::awaitable<boost::system::error_code> Tee3Client::handshakeWithAuthorization()
 {
+    const auto start = std::chrono::steady_clock::now();
     auto ec = co_await tee3Handshake();
 
     if (! ec)
     {
         ec = co_await authorize(&mOwingClientsForHost->hsmPool());
     }
+    MetricsRegistry::instance().observeConnectionHandshake("tee3", mHttpsClient.hostname(),
+                                                           std::chrono::steady_clock::now() - start, ! ec.failed());
 
     co_return ec;
 }
@@ -321,6 +325,25 @@ boost::asio::awaitable<void> Tee3Client::ensureConnected()
     }
 }
 
+bool Tee3Client::needsRenewal(std::chrono::steady_clock::time_point renewBefore)
+{
+    return ! mHttpsClient.connected() || needHandshake() || mTee3ContextExpiry <= renewBefore;
+}
+
+
+boost::asio::awaitable<void> Tee3Client::prewarm(std::chrono::steady_clock::time_point renewBefore)
+{
+    if (mHttpsClient.connected() && ! needHandshake() && mTee3ContextExpiry <= renewBefore)
+    {
+        HeaderLog::vlog(1, [&] {
+            return std::ostringstream{} << "tee3 context for " << mHttpsClient.hostname() << " on "
+                                        << mHttpsClient.currentEndpoint() << " is about to expire, renewing it";
+        });
+        closeTeeSession();
+    }
+    co_await ensureConnected();
+}
+
 boost::asio::awaitable<boost::system::error_code> Tee3Client::tryConnectLoop()
 {
     auto availableEndpoints = co_await mOwingClientsForHost->endpoints();
@@ -714,6 +737,7 @@ boost::asio::awaitable<boost::system::error_code> Tee3Client::tee3Handshake()
         });
         // GEMREQ-start A_15549
         mTee3Context = handshake.context();
+        mTee3ContextExpiry = std::chrono::steady_clock::now() + teeContextTimeout;
         mTeeContextRefreshTimer.expires_after(teeContextTimeout);
         mTeeContextRefreshTimer.async_wait([this](const boost::system::error_code& ec) {
             if (! ec)
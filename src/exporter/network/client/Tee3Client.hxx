@@ -57,6 +57,13 @@ public:
 
     [[nodiscard]] boost::asio::awaitable<void> ensureConnected();
 
+    /// @returns true if the client is not connected or its tee context expires before `renewBefore`
+    [[nodiscard]] bool needsRenewal(std::chrono::steady_clock::time_point renewBefore);
+
+    /// connect, and renew the tee context if it expires before `renewBefore`,
+    /// so that the next request does not have to wait for the handshake
+    [[nodiscard]] boost::asio::awaitable<void> prewarm(std::chrono::steady_clock::time_point renewBefore);
+
     [[nodiscard]] boost::asio::awaitable<boost::system::result<Response>>
     sendInner(std::string xRequestId, Request request, BDEMessage& bdeMessage);
 
@@ -115,6 +122,7 @@ private:
     // strand to serialize the access to the tee context
     boost::asio::strand<boost::asio::any_io_executor> mStrand;
     std::shared_ptr<epa::Tee3Context> mTee3Context;
+    std::chrono::steady_clock::time_point mTee3ContextExpiry;
     boost::asio::steady_timer mTeeContextRefreshTimer;
     EpaCertificateService& mCertificateService;
     bool mIsAuthorized = false;
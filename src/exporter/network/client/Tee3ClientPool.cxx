@@ -12,6 +12,7 @@
 #include "fhirtools/util/Gsl.hxx"
 #include "shared/hsm/HsmPool.hxx"
 #include "shared/network/message/Header.hxx"
+#include "shared/util/Configuration.hxx"
 #include "shared/util/Expect.hxx"
 #include "shared/util/Random.hxx"
 
@@ -34,6 +35,10 @@ std::shared_ptr<Tee3ClientPool> Tee3ClientPool::create(boost::asio::io_context&
     {
         instance->setupRefreshEndpointsTimer();
     }
+    if (instance->mMaintenanceInterval > std::chrono::steady_clock::duration::zero())
+    {
+        instance->setupMaintenanceTimer();
+    }
     return instance;
 }
 
@@ -46,6 +51,9 @@ Tee3ClientPool::Tee3ClientPool(boost::asio::io_context& ctx, HsmPool& hsmPool,
     , mTslManager{tslManager}
     , mEndpointsRefreshInterval{endpointRefreshInterval}
     , mRefreshEndpointsTimer{mStrand}
+    , mMaintenanceInterval{std::chrono::seconds{Configuration::instance().getIntValue(
+          ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_MAINTENANCE_INTERVAL_SECONDS)}}
+    , mMaintenanceTimer{mStrand}
 {
 }
 
@@ -106,6 +114,30 @@ void Tee3ClientPool::refreshEndpoints(const std::weak_ptr<Tee3ClientPool>& weakS
     }
 }
 
+void Tee3ClientPool::setupMaintenanceTimer()
+{
+    mMaintenanceTimer.expires_after(mMaintenanceInterval);
+    mMaintenanceTimer.async_wait(std::bind_front(&Tee3ClientPool::maintain, weak_from_this()));
+}
+
+void Tee3ClientPool::maintain(const std::weak_ptr<Tee3ClientPool>& weakSelf, const boost::system::error_code& ec)
+{
+    if (ec.failed())
+    {
+        return;
+    }
+    if (auto self = weakSelf.lock())
+    {
+        Expect3(self->mStrand.running_in_this_thread(), "Tee3ClientPool::maintain: not running on strand",
+                std::logic_error);
+        for (auto& epaHost : self->mTee3Clients | std::views::values)
+        {
+            epaHost->maintain();
+        }
+        self->setupMaintenanceTimer();
+    }
+}
+
 boost::asio::awaitable<boost::system::result<std::unique_ptr<Tee3ClientsForHost>>>
 Tee3ClientPool::setupPool(std::string hostname, std::uint16_t port, size_t connectionCount)
 {
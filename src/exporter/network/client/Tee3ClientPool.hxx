@@ -48,7 +48,7 @@ public:
 
     /**
      * Add a connection pool for the given hostname, it must be called before trying
-     * to acquire any TEE clients.
+     * to acquire any TEE clients. The pool grows up to `connectionCount` TEE clients on demand.
      *
      * This function is not thread-safe.
      */
@@ -61,6 +61,9 @@ private:
     void setupRefreshEndpointsTimer();
     static void refreshEndpoints(const std::weak_ptr<Tee3ClientPool>& weakSelf, const boost::system::error_code& ec);
 
+    void setupMaintenanceTimer();
+    static void maintain(const std::weak_ptr<Tee3ClientPool>& weakSelf, const boost::system::error_code& ec);
+
     boost::asio::awaitable<boost::system::result<std::unique_ptr<Tee3ClientsForHost>>>
     setupPool(std::string hostname, std::uint16_t port, size_t connectionCount);
 
@@ -70,11 +73,14 @@ private:
     TslManager& mTslManager;
     std::chrono::steady_clock::duration mEndpointsRefreshInterval;
     boost::asio::steady_timer mRefreshEndpointsTimer;
+    std::chrono::steady_clock::duration mMaintenanceInterval;
+    boost::asio::steady_timer mMaintenanceTimer;
     // map of hostname -> tee clients, note that it does not make sense
     // to distinguish by port, as they would end up at the same ePA gateway
     std::unordered_map<std::string, std::unique_ptr<Tee3ClientsForHost>> mTee3Clients;
 
     friend class Tee3ClientsForHost;
+    friend class Tee3ClientsForHostTest;
 };
 
 #endif// MEDICATION_EXPORTER_TEE3CLIENTPOOL_HXX
@@ -8,7 +8,9 @@
 #include "Tee3ClientsForHost.hxx"
 #include "Tee3Client.hxx"
 #include "Tee3ClientPool.hxx"
+#include "shared/util/Configuration.hxx"
 #include "shared/util/Expect.hxx"
+#include "shared/util/MetricsRegistry.hxx"
 #include "shared/util/Random.hxx"
 #include "shared/util/String.hxx"
 #include "shared/util/TLog.hxx"
@@ -21,12 +23,23 @@
 #include <boost/asio/deferred.hpp>
 #include <boost/asio/detached.hpp>
 #include <boost/asio/use_future.hpp>
+#include <algorithm>
 #include <ranges>
 #include <unordered_set>
 
 namespace
 {
 constexpr auto asEndpoint = std::views::transform(&Tee3Client::EndpointData::endpoint);
+constexpr auto metricsPoolName = "tee3";
+// weight of a new sample in the moving average of the acquire wait time is 1/averageWaitWeight
+constexpr auto averageWaitWeight = 8;
+
+size_t minConnectionCount(size_t maxConnectionCount)
+{
+    const auto configured =
+        Configuration::instance().getIntValue(ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_MIN_CONNECTIONS);
+    return std::clamp(gsl::narrow<size_t>(std::max(configured, 1)), size_t{1}, std::max(maxConnectionCount, size_t{1}));
+}
 }
 
 
@@ -49,7 +62,14 @@ Tee3ClientsForHost::Tee3ClientsForHost(const gsl::not_null<std::shared_ptr<Tee3C
     , mHostname{std::move(initHostname)}
     , mPort{initPort}
     , mChannel{std::make_unique<Tee3ClientsForHost::Channel>(owningPool->mIoContext)}
-    , mConnectionCount{connectionCount}
+    , mMinConnectionCount{minConnectionCount(connectionCount)}
+    , mMaxConnectionCount{std::max(connectionCount, mMinConnectionCount)}
+    , mIdleTimeout{std::chrono::seconds{Configuration::instance().getIntValue(
+          ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_IDLE_TIMEOUT_SECONDS)}}
+    , mRenewBeforeExpiry{std::chrono::seconds{Configuration::instance().getIntValue(
+          ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_RENEW_BEFORE_EXPIRY_SECONDS)}}
+    , mGrowWaitThreshold{std::chrono::milliseconds{Configuration::instance().getIntValue(
+          ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_GROW_WAIT_MILLISECONDS)}}
 {
 }
 
@@ -57,11 +77,13 @@ boost::asio::awaitable<boost::system::error_code> Tee3ClientsForHost::init()
 {
     auto pool = mOwningPool.lock();
     Expect3(pool, "called init during shutdown.", std::logic_error);
-    for (std::size_t i = 0; i < mConnectionCount; ++i)
+    const auto now = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < mMinConnectionCount; ++i)
     {
-        mAvailableClients.emplace_back(std::make_unique<Tee3Client>(pool->mIoContext, this));
+        mAvailableClients.push_back(AvailableClient{std::make_unique<Tee3Client>(pool->mIoContext, this), now});
         mChannel->async_send(boost::system::error_code{}, consign(boost::asio::detached, pool));
     }
+    mClientCount = mMinConnectionCount;
     auto resolver = Resolver{pool->mIoContext};
 
     auto [ec, endpointResult] = co_await resolver.async_resolve(
@@ -160,19 +182,116 @@ Tee3ClientsForHost::acquireInternal(std::shared_ptr<Tee3ClientPool> pool)
     {
         co_return Tee3ClientPtr{nullptr, Tee3ClientDeleter{pool->weak_from_this()}};
     }
-    if (! mChannel->try_receive([](auto...) {
-        }))
+    const auto waitStart = std::chrono::steady_clock::now();
+    if (! tryTakeToken())
     {
+        if (mClientCount < mMaxConnectionCount)
+        {
+            grow(pool);
+        }
         TVLOG(2) << "waiting for tee client on " << mHostname;
         co_await mChannel->async_receive(bind_executor(pool->mStrand, boost::asio::as_tuple(boost::asio::deferred)));
     }
+    const auto wait = std::chrono::steady_clock::now() - waitStart;
+    MetricsRegistry::instance().observeConnectionPoolWait(metricsPoolName, mHostname, wait);
+    recordWait(wait);
     Expect(! mAvailableClients.empty(), "No tee3 client available");
     auto clientIt = Random::selectRandomElement(mAvailableClients.begin(), mAvailableClients.end());
-    auto tee3Client = Tee3ClientPtr{clientIt->release(), Tee3ClientDeleter{pool->weak_from_this()}};
+    auto tee3Client = Tee3ClientPtr{clientIt->client.release(), Tee3ClientDeleter{pool->weak_from_this()}};
     mAvailableClients.erase(clientIt);
+    if (mAvailableClients.empty() && mClientCount < mMaxConnectionCount && mAverageWait > mGrowWaitThreshold)
+    {
+        // callers have been waiting recently, don't let the next one wait for a new client to be connected
+        grow(pool);
+    }
     co_return tee3Client;
 }
 
+void Tee3ClientsForHost::recordWait(std::chrono::steady_clock::duration wait)
+{
+    mAverageWait += (wait - mAverageWait) / averageWaitWeight;
+}
+
+void Tee3ClientsForHost::grow(const std::shared_ptr<Tee3ClientPool>& pool)
+{
+    ++mClientCount;
+    TLOG(INFO) << "adding tee client for " << mHostname << ", now " << mClientCount << " of at most "
+               << mMaxConnectionCount;
+    Tee3ClientPtr client{new Tee3Client{pool->mIoContext, this}, Tee3ClientDeleter{pool->weak_from_this()}};
+    co_spawn(pool->mIoContext, prewarm(std::move(client), std::chrono::steady_clock::now()),
+             consign(boost::asio::detached, pool));
+}
+
+bool Tee3ClientsForHost::tryTakeToken()
+{
+    return mChannel->try_receive([](auto...) {
+    });
+}
+
+void Tee3ClientsForHost::maintain()
+{
+    auto pool = mOwningPool.lock();
+    Expect3(pool, "called maintain during shutdown.", std::logic_error);
+    Expect3(pool->mStrand.running_in_this_thread(), "not running on strand.", std::logic_error);
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = mAvailableClients.begin(); it != mAvailableClients.end() && mClientCount > mMinConnectionCount;)
+    {
+        if (it->idleSince + mIdleTimeout > now)
+        {
+            ++it;
+            continue;
+        }
+        if (! tryTakeToken())
+        {
+            break;
+        }
+        TLOG(INFO) << "closing idle tee client on " << mHostname << ", now " << mClientCount - 1 << " clients";
+        co_spawn(pool->mIoContext, close(std::move(it->client)), consign(boost::asio::detached, pool));
+        it = mAvailableClients.erase(it);
+        --mClientCount;
+    }
+    const auto renewBefore = now + mRenewBeforeExpiry;
+    for (auto it = mAvailableClients.begin(); it != mAvailableClients.end();)
+    {
+        if (! it->client->needsRenewal(renewBefore))
+        {
+            ++it;
+            continue;
+        }
+        if (! tryTakeToken())
+        {
+            break;
+        }
+        Tee3ClientPtr client{it->client.release(), Tee3ClientDeleter{pool->weak_from_this()}};
+        it = mAvailableClients.erase(it);
+        co_spawn(pool->mIoContext, prewarm(std::move(client), renewBefore), consign(boost::asio::detached, pool));
+    }
+}
+
+boost::asio::awaitable<void> Tee3ClientsForHost::prewarm(Tee3ClientPtr client,
+                                                         std::chrono::steady_clock::time_point renewBefore)
+{
+    try
+    {
+        co_await client->prewarm(renewBefore);
+    }
+    catch (const std::exception& ex)
+    {
+        // the client is returned to the pool anyway, acquire will try to connect it again
+        TVLOG(1) << "pre-warming tee client on " << client->owningClientsForHost()->hostname()
+                 << " failed: " << ex.what();
+    }
+}
+
+boost::asio::awaitable<void> Tee3ClientsForHost::close(std::unique_ptr<Tee3Client> client)
+{
+    if (client->isTlsConnected())
+    {
+        client->closeTeeSession();
+        co_await client->closeTlsSession();
+    }
+}
+
 boost::asio::awaitable<void> Tee3ClientsForHost::release(std::shared_ptr<Tee3ClientPool> pool,
                                                          std::unique_ptr<Tee3Client> instance)
 {
@@ -186,7 +305,7 @@ boost::asio::awaitable<void> Tee3ClientsForHost::release(std::shared_ptr<Tee3Cli
     }
     A_25938.finish();
     Expect3(pool->mStrand.running_in_this_thread(), "not running on strand.", std::logic_error);
-    mAvailableClients.push_back(std::move(instance));
+    mAvailableClients.push_back(AvailableClient{std::move(instance), std::chrono::steady_clock::now()});
     mChannel->async_send(boost::system::error_code{}, consign(boost::asio::detached, pool));
 }
 
@@ -18,6 +18,7 @@
 #include <boost/core/noncopyable.hpp>
 #include <boost/system/error_code.hpp>
 #include <boost/system/result.hpp>
+#include <chrono>
 #include <list>
 #include <memory>
 #include <vector>
@@ -35,6 +36,11 @@ public:
     struct Tee3ClientDeleter;
     using Tee3ClientPtr = std::unique_ptr<Tee3Client, Tee3ClientDeleter>;
 
+    /**
+     * The pool starts with the configured minimum number of clients and grows up to `connectionCount` clients
+     * when callers have to wait for a client. While the average wait exceeds the configured threshold, it also
+     * grows when the last idle client is taken, so that the next caller does not have to wait.
+     */
     Tee3ClientsForHost(const gsl::not_null<std::shared_ptr<Tee3ClientPool>>& owningPool, std::string initHostname,
                        uint16_t initPort, size_t connectionCount);
 
@@ -42,6 +48,13 @@ public:
 
     boost::asio::awaitable<void> refreshEndpoints();
 
+    /**
+     * Close clients above the minimum that have been idle for too long and
+     * connect or renew the remaining idle clients in the background.
+     * Must be called on the strand of the owning pool.
+     */
+    void maintain();
+
     boost::asio::awaitable<Tee3ClientsForHost::Tee3ClientPtr> acquire();
 
     std::string hostname() const;
@@ -57,21 +70,46 @@ public:
     TslManager& tslManager();
 
 private:
+    struct AvailableClient {
+        std::unique_ptr<Tee3Client> client;
+        std::chrono::steady_clock::time_point idleSince;
+    };
+
     boost::asio::awaitable<Tee3ClientsForHost::Tee3ClientPtr> acquireInternal(std::shared_ptr<Tee3ClientPool> pool);
     boost::asio::awaitable<void> release(std::shared_ptr<Tee3ClientPool> pool, std::unique_ptr<Tee3Client> instance);
 
+    /// add a client to the pool, it is connected in the background and made available afterwards
+    void grow(const std::shared_ptr<Tee3ClientPool>& pool);
+    /// take the token of an available client out of the channel without waiting
+    bool tryTakeToken();
+    /// update the moving average of the time callers waited in acquireInternal
+    void recordWait(std::chrono::steady_clock::duration wait);
+    static boost::asio::awaitable<void> prewarm(Tee3ClientPtr client,
+                                                std::chrono::steady_clock::time_point renewBefore);
+    static boost::asio::awaitable<void> close(std::unique_ptr<Tee3Client> client);
+
     void setEndpoints(const Resolver::results_type& endpointResult);
 
     std::weak_ptr<Tee3ClientPool> mOwningPool;
     std::string mHostname;
     uint16_t mPort;
-    std::list<std::unique_ptr<Tee3Client>> mAvailableClients;
+    std::list<AvailableClient> mAvailableClients;
     std::vector<Tee3Client::EndpointData> mEndpoints;
     // for each message in the channel, there is one tee client
     // available. Use a pointer, Channel seems not to be movable
     std::unique_ptr<Channel> mChannel;
     std::optional<std::string> mVauNP{};
-    size_t mConnectionCount;
+    // number of clients owned by this pool, available or in use
+    size_t mClientCount = 0;
+    size_t mMinConnectionCount;
+    size_t mMaxConnectionCount;
+    std::chrono::steady_clock::duration mIdleTimeout;
+    std::chrono::steady_clock::duration mRenewBeforeExpiry;
+    std::chrono::steady_clock::duration mGrowWaitThreshold;
+    // exponential moving average of the acquire wait time, only accessed on the strand of the owning pool
+    std::chrono::steady_clock::duration mAverageWait{};
+
+    friend class Tee3ClientsForHostTest;
 };
 
 struct Tee3ClientsForHost::Tee3ClientDeleter {
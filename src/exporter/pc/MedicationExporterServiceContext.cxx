@@ -7,6 +7,7 @@
 
 #include "exporter/pc/MedicationExporterServiceContext.hxx"
 #include "exporter/admin/PutRuntimeConfigHandler.hxx"
+#include "exporter/client/VzdSearchCache.hxx"
 #include "exporter/network/client/HttpsClientPool.hxx"
 #include "exporter/network/client/Tee3ClientPool.hxx"
 #include "exporter/pc/MedicationExporterFactories.hxx"
@@ -43,6 +44,7 @@ MedicationExporterServiceContext::MedicationExporterServiceContext(boost::asio::
     , mExporterDatabaseFactory(factories.exporterDatabaseFactory)
     , mErpDatabaseFactory(factories.erpDatabaseFactory)
     , mTeeClientPool{Tee3ClientPool::create(ioContext, *mHsmPool, getTslManager(), refreshInterval())}
+    , mVzdSearchCache{VzdSearchCache::fromConfiguration()}
     , mRuntimeConfiguration(std::make_unique<exporter::RuntimeConfiguration>())
 {
     auto requestSender = std::make_shared<UrlRequestSender>(
@@ -53,6 +55,8 @@ MedicationExporterServiceContext::MedicationExporterServiceContext(boost::asio::
     requestSender->setProxies(configuration.proxyParameters(ProxyMode::HTTP));
 
     requestSender->setFollowRedirects(true);
+    requestSender->setConnectionReuse(std::chrono::seconds{
+        configuration.getOptionalIntValue(ConfigurationKey::HTTPCLIENT_KEEP_ALIVE_IDLE_SECONDS, 0)});
     mCrlProvider = std::make_shared<CrlDownloadCache>(std::move(requestSender));
     setupTslRefreshJob(std::chrono::seconds{configuration.getIntValue(ConfigurationKey::TSL_REFRESH_INTERVAL)});
     Expect3(mExporterDatabaseFactory != nullptr,
@@ -151,6 +155,11 @@ std::shared_ptr<HttpsClientPool> MedicationExporterServiceContext::httpsClientPo
     return mHttpsClientPools.at(hostname);
 }
 
+VzdSearchCache& MedicationExporterServiceContext::vzdSearchCache()
+{
+    return *mVzdSearchCache;
+}
+
 std::unique_ptr<exporter::RuntimeConfigurationGetter>
 MedicationExporterServiceContext::getRuntimeConfigurationGetter() const
 {
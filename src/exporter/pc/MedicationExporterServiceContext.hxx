@@ -24,6 +24,7 @@ class CrlProvider;
 class HttpsClientPool;
 class MedicationExporterFactories;
 class Tee3ClientPool;
+class VzdSearchCache;
 enum class TransactionMode : uint8_t;
 
 namespace boost::asio
@@ -58,6 +59,10 @@ public:
     std::shared_ptr<Tee3ClientPool> teeClientPool();
     std::shared_ptr<HttpsClientPool> httpsClientPool(const std::string& hostname);
 
+    /**
+     * cache of FHIR VZD search results, shared by all T-Rezept processors
+     */
+    VzdSearchCache& vzdSearchCache();
 
     std::unique_ptr<exporter::RuntimeConfigurationGetter> getRuntimeConfigurationGetter() const;
     std::unique_ptr<exporter::RuntimeConfigurationSetter> getRuntimeConfigurationSetter() const;
@@ -80,6 +85,7 @@ private:
     exporter::MainDatabaseFrontend::Factory mErpDatabaseFactory;
     std::shared_ptr<Tee3ClientPool> mTeeClientPool;
     std::unordered_map<std::string, std::shared_ptr<HttpsClientPool>> mHttpsClientPools;
+    std::unique_ptr<VzdSearchCache> mVzdSearchCache;
     gsl::not_null<std::shared_ptr<exporter::RuntimeConfiguration>> mRuntimeConfiguration;
     mutable std::mutex mFailingEpasMutex;
     std::set<std::string> mFailingEpas;
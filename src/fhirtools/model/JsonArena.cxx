@@ -0,0 +1,69 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "fhirtools/model/JsonArena.hxx"
+
+#include <utility>
+
+using namespace model;
+
+namespace
+{
+thread_local std::shared_ptr<JsonArena> currentArena;
+}
+
+
+JsonArena::JsonArena(std::size_t chunkSize)
+    : mAllocator(chunkSize)
+{
+}
+
+
+JsonArena::Allocator& JsonArena::allocator()
+{
+    return mAllocator;
+}
+
+
+std::size_t JsonArena::documentCount() const
+{
+    return mDocumentCount;
+}
+
+
+std::size_t JsonArena::usedBytes() const
+{
+    return mAllocator.Size();
+}
+
+
+std::size_t JsonArena::capacityBytes() const
+{
+    return mAllocator.Capacity();
+}
+
+
+std::shared_ptr<JsonArena> JsonArena::forNewDocument()
+{
+    if (currentArena)
+    {
+        ++currentArena->mDocumentCount;
+    }
+    return currentArena;
+}
+
+
+JsonArena::Scope::Scope(std::shared_ptr<JsonArena> arena)
+    : mPrevious(std::exchange(currentArena, std::move(arena)))
+{
+}
+
+
+JsonArena::Scope::~Scope()
+{
+    currentArena = std::move(mPrevious);
+}
@@ -0,0 +1,83 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#ifndef ERP_PROCESSING_CONTEXT_MODEL_JSONARENA_HXX
+#define ERP_PROCESSING_CONTEXT_MODEL_JSONARENA_HXX
+
+#include "fhirtools/model/NumberAsStringParserDocument.hxx"
+
+#include <cstddef>
+#include <memory>
+
+namespace model
+{
+
+/**
+ * Memory pool that is shared by all NumberAsStringParserDocument instances that are created on one thread while a
+ * JsonArena::Scope is active, e.g. while one inner VAU request is processed.
+ *
+ * Without an arena each document allocates its own chunks from the heap. With an arena the documents of one request
+ * share the chunks, values can be copied between them without additional chunk allocations and the memory is returned
+ * in one go when the last document using the arena has been destroyed.
+ *
+ * The documents hold a reference to the arena, therefore a document that outlives the scope keeps the arena alive.
+ * The allocator is not thread safe. Documents created in a scope must only be modified on the thread of the scope
+ * while the scope is active.
+ */
+class JsonArena
+{
+public:
+    using Allocator = rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>;
+
+    explicit JsonArena(std::size_t chunkSize = Allocator::kDefaultChunkCapacity);
+    JsonArena(const JsonArena&) = delete;
+    JsonArena(JsonArena&&) = delete;
+    JsonArena& operator=(const JsonArena&) = delete;
+    JsonArena& operator=(JsonArena&&) = delete;
+    ~JsonArena() = default;
+
+    Allocator& allocator();
+
+    /// number of documents that have been created with this arena
+    std::size_t documentCount() const;
+    /// number of bytes handed out to the documents
+    std::size_t usedBytes() const;
+    /// number of bytes allocated from the heap
+    std::size_t capacityBytes() const;
+
+    /**
+     * Returns the arena of the active scope of the current thread and counts the new document.
+     * Returns nullptr if there is no active scope.
+     */
+    static std::shared_ptr<JsonArena> forNewDocument();
+
+    /**
+     * Makes `arena` the arena of the current thread for the lifetime of the scope. Scopes can be nested; the previous
+     * arena is restored when the scope ends. A nullptr arena disables the use of an arena within the scope.
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(std::shared_ptr<JsonArena> arena);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&) = delete;
+
+    private:
+        std::shared_ptr<JsonArena> mPrevious;
+    };
+
+private:
+    Allocator mAllocator;
+    std::size_t mDocumentCount{0};
+};
+
+}
+
+#endif// ERP_PROCESSING_CONTEXT_MODEL_JSONARENA_HXX
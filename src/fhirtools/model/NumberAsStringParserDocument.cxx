@@ -6,13 +6,15 @@
  */
 
 #include "fhirtools/model/NumberAsStringParserDocument.hxx"
+#include "fhirtools/model/JsonArena.hxx"
 #include "fhirtools/model/NumberAsStringParserWriter.hxx"
 #include "shared/ErpRequirements.hxx"
 #include "shared/util/Base64.hxx"
 #include "shared/util/Expect.hxx"
-#include "shared/util/String.hxx"
 
 #include <rapidjson/ostreamwrapper.h>
+#include <algorithm>
+#include <cctype>
 #include <regex>
 
 #ifdef _WIN32
@@ -22,6 +24,17 @@
 using namespace model;
 namespace rj = rapidjson;
 
+NumberAsStringParserDocument::NumberAsStringParserDocument()
+    : NumberAsStringParserDocument(JsonArena::forNewDocument())
+{
+}
+
+NumberAsStringParserDocument::NumberAsStringParserDocument(std::shared_ptr<JsonArena> arena)
+    : rapidjson::Document(arena ? &arena->allocator() : nullptr)
+    , mArena(std::move(arena))
+{
+}
+
 bool NumberAsStringParserDocument::valueIsObject(const rj::Value& value)
 {
     return value.IsObject();
@@ -151,7 +164,23 @@ std::string_view NumberAsStringParserDocument::getStringValueFromValue(const rj:
     ModelExpect(value->GetStringLength() > 0, "at least prefix character expected");
     ModelExpect(value->GetString()[0] == prefixString || value->GetString()[0] == prefixNumber,
         "string values must start with prefix character");
-    return &value->GetString()[1];
+    return {value->GetString() + 1, value->GetStringLength() - 1};
+}
+
+bool NumberAsStringParserDocument::stringValueEquals(const rj::Value& value, std::string_view str, bool ignoreCase)
+{
+    if (! value.IsString() || value.GetStringLength() != str.size() + 1 || value.GetString()[0] != prefixString)
+    {
+        return false;
+    }
+    const std::string_view unprefixed{value.GetString() + 1, str.size()};
+    if (! ignoreCase)
+    {
+        return unprefixed == str;
+    }
+    return std::ranges::equal(unprefixed, str, [](char lhs, char rhs) {
+        return std::tolower(static_cast<unsigned char>(lhs)) == std::tolower(static_cast<unsigned char>(rhs));
+    });
 }
 
 std::string_view NumberAsStringParserDocument::getStringValueFromPointer(const rj::Pointer& pointer) const
@@ -162,7 +191,7 @@ std::string_view NumberAsStringParserDocument::getStringValueFromPointer(const r
     ModelExpect(value->GetStringLength() > 0, "at least prefix character expected");
     ModelExpect(value->GetString()[0] == prefixString || value->GetString()[0] == prefixNumber,
         "string values must start with prefix character");
-    return &value->GetString()[1];
+    return {value->GetString() + 1, value->GetStringLength() - 1};
 }
 
 void NumberAsStringParserDocument::setKeyValue(rj::Value& object, const rj::Pointer& key, const rj::Value& value)
@@ -290,7 +319,7 @@ std::optional<std::string_view> NumberAsStringParserDocument::getOptionalStringV
             pointerToString(key) + ": string values must start with prefix character");
         ModelExpect(pointerValue->GetString()[0] == prefixString,
             pointerToString(key) + ": entry is not a string");
-        return &pointerValue->GetString()[1];
+        return std::string_view{pointerValue->GetString() + 1, pointerValue->GetStringLength() - 1};
     }
     return {};
 }
@@ -534,16 +563,10 @@ std::optional<std::tuple<const rj::Value*, std::size_t>> NumberAsStringParserDoc
     const auto* array = arrayPointer.Get(*this);
     if (array != nullptr && array->IsArray())
     {
-        // TODO: Class ResourceBase still needs access to the prefixes.
-        // Some helper methods are still missing in class NumberAsStringParserDocument.
-        // See Jira Task : ....
-        std::string prefixedSearchValue = NumberAsStringParserDocument::prefixString + std::string(searchValue);
         for (auto item = array->Begin(), end = array->End(); item != end; ++item)
         {
             const auto* member = searchKey.Get(*item);
-            if (member != nullptr && member->IsString() &&
-                ((!ignoreValueCase && prefixedSearchValue == member->GetString()) ||
-                  (ignoreValueCase && ::String::toLower(prefixedSearchValue) == ::String::toLower(member->GetString()))))
+            if (member != nullptr && stringValueEquals(*member, searchValue, ignoreValueCase))
             {
                 member = resultKeyPointer.Get(*item);
                 ModelExpect(!ret, "duplicate array entry for " + std::string(searchValue));
@@ -588,11 +611,10 @@ const rapidjson::Value* NumberAsStringParserDocument::findMemberInArray(const ra
     const rapidjson::Value* foundItem = nullptr;
     if (array != nullptr && array->IsArray())
     {
-        const std::string prefixedSearchValue = NumberAsStringParserDocument::prefixString + std::string(searchValue);
         for (auto item = array->Begin(), end = array->End(); item != end; ++item)
         {
             const auto* member = searchKey.Get(*item);
-            if (member != nullptr && member->IsString() && prefixedSearchValue == member->GetString())
+            if (member != nullptr && stringValueEquals(*member, searchValue))
             {
                 ModelExpect(!foundItem, "duplicate array entry for " + std::string(searchValue));
                 foundItem = item;
@@ -18,11 +18,13 @@
 #include <rapidjson/pointer.h>
 #include <rapidjson/stringbuffer.h>
 
+#include <memory>
 #include <optional>
 #include <string_view>
 
 namespace model
 {
+class JsonArena;
 class ResourceBase;
 template<class Stream> class NumberAsStringParserWriter;
 
@@ -155,6 +157,13 @@ public:
     [[nodiscard]]
     static std::string_view getStringValueFromValue(const rapidjson::Value* value);
 
+    /**
+     * Returns true if `value` is a string value (not a number) equal to `str`.
+     * The comparison is done on the prefixed value in place, without creating a prefixed copy of `str`.
+     */
+    [[nodiscard]]
+    static bool stringValueEquals(const rapidjson::Value& value, std::string_view str, bool ignoreCase = false);
+
     /**
      * Helper methods removing the string and number prefixes before returning the string value.
      * Instance method as reference to the document is needed.
@@ -284,9 +293,10 @@ public:
     void removeFromArray(const rapidjson::Pointer& pointerToArray, std::size_t index);
     void clearArray(const rapidjson::Pointer& pointerToArray);
 
-    NumberAsStringParserDocument() : rapidjson::Document()
-    {
-    }
+    /// Uses the JsonArena of the current thread, if there is one.
+    NumberAsStringParserDocument();
+    /// Uses `arena` or the document's own allocator if `arena` is nullptr.
+    explicit NumberAsStringParserDocument(std::shared_ptr<JsonArena> arena);
 
     void removeEmptyObjectsAndArrays();
     static void removeEmptyObjectsAndArrays(rapidjson::Value& value);
@@ -297,9 +307,7 @@ public:
      */
     bool String(const Ch* text, size_t length, bool copy)
     {
-        std::string s(text, length);
-        s = prefixString + s;
-        return rapidjson::Document::String(s.data(), static_cast<rapidjson::SizeType>(s.size()), copy);
+        return prefixedString(prefixString, text, length, copy);
     }
 
     /**
@@ -308,11 +316,18 @@ public:
      */
     bool RawNumber(const Ch* text, size_t length, bool copy)
     {
-        std::string s(text, length);
-        s = prefixNumber + s;
-        return rapidjson::Document::String(s.data(), static_cast<rapidjson::SizeType>(s.size()), copy);
+        return prefixedString(prefixNumber, text, length, copy);
     }
 private:
+    bool prefixedString(Ch prefix, const Ch* text, size_t length, bool copy)
+    {
+        std::string s;
+        s.reserve(length + 1);
+        s.push_back(prefix);
+        s.append(text, length);
+        return rapidjson::Document::String(s.data(), static_cast<rapidjson::SizeType>(s.size()), copy);
+    }
+
     [[nodiscard]]
     rapidjson::Value makeValue(Ch prefix, const std::string_view& value);
 
@@ -320,6 +335,9 @@ private:
     static const Ch prefixString{ '$' }; // Inserted to values to mark the values as a string.
     static const Ch prefixNumber{ '#' }; // Inserted to values to mark the values as numbers.
 
+    // keeps the shared allocator alive, must be moved together with the base class
+    std::shared_ptr<JsonArena> mArena;
+
 };
 
 class NumberAsStringParserDocumentConverter
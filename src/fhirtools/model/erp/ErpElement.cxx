@@ -13,6 +13,7 @@
 
 #include <rapidjson/document.h>
 #include <rapidjson/pointer.h>
+#include <string_view>
 #include <utility>
 
 using fhirtools::Element;
@@ -22,6 +23,21 @@ using fhirtools::MutableElement;
 using fhirtools::PrimitiveElement;
 using fhirtools::ProfiledElementTypeInfo;
 
+namespace
+{
+// direct member lookup, avoids building and parsing a rapidjson::Pointer for each sub element
+template<typename ValueT>
+ValueT* findMember(ValueT& object, std::string_view name)
+{
+    if (! object.IsObject())
+    {
+        return nullptr;
+    }
+    const auto member = object.FindMember(rapidjson::StringRef(name.data(), name.size()));
+    return member != object.MemberEnd() ? &member->value : nullptr;
+}
+}
+
 ErpElement::ErpElement(gsl::not_null<const fhirtools::FhirStructureRepositoryBackend*> fhirStructureRepository,
                        std::weak_ptr<const Element> parent, const std::string& elementId, const rapidjson::Value* value,
                        const rapidjson::Value* primitiveTypeObject)
@@ -262,8 +278,6 @@ std::vector<std::shared_ptr<const Element>> ErpElement::subElements(const std::s
         return {shared_from_this()};
     }
     const auto& elementId = definitionPointer().element()->name();
-    rapidjson::Pointer pointer{"/" + name};
-    rapidjson::Pointer primitivePointer{"/_" + name};
 
     auto subPointerList = definitionPointer().subDefinitions(name);
     FPExpect(! subPointerList.empty(),
@@ -272,14 +286,15 @@ std::vector<std::shared_ptr<const Element>> ErpElement::subElements(const std::s
     bool isResource = subPtr.isResource();
     bool isPrimitive =
         subPtr.element()->isRoot() && subPtr.profile()->kind() == FhirStructureDefinition::Kind::primitiveType;
-    const rapidjson::Value* val = pointer.Get(mPrimitiveTypeObject ? *mPrimitiveTypeObject : *mValue);
-    const auto* primitiveVal = isPrimitive && mValue ? primitivePointer.Get(*mValue) : nullptr;
+    const std::string primitiveName = isPrimitive ? "_" + name : std::string{};
+    const rapidjson::Value* val = findMember(mPrimitiveTypeObject ? *mPrimitiveTypeObject : *mValue, name);
+    const auto* primitiveVal = isPrimitive && mValue ? findMember(*mValue, primitiveName) : nullptr;
     rapidjson::Value* valMutable = nullptr;
     rapidjson::Value* primitiveValMutable = nullptr;
     if (mValueMutable || mPrimitiveTypeObjectMutable)
     {
-        valMutable = pointer.Get(mPrimitiveTypeObjectMutable ? *mPrimitiveTypeObjectMutable : *mValueMutable);
-        primitiveValMutable = isPrimitive && mValueMutable ? primitivePointer.Get(*mValueMutable) : nullptr;
+        valMutable = findMember(mPrimitiveTypeObjectMutable ? *mPrimitiveTypeObjectMutable : *mValueMutable, name);
+        primitiveValMutable = isPrimitive && mValueMutable ? findMember(*mValueMutable, primitiveName) : nullptr;
     }
     if (val == nullptr)
     {
@@ -374,11 +389,13 @@ std::shared_ptr<const PrimitiveElement> ErpElement::asPrimitiveElement() const
         case Type::Structured:
             break;
         case Type::Quantity: {
-            const auto* valueElement = rapidjson::Pointer("/value").Get(*mValue);
+            static const rapidjson::Pointer valuePointer{"/value"};
+            static const rapidjson::Pointer unitPointer{"/unit"};
+            const auto* valueElement = valuePointer.Get(*mValue);
             FPExpect(valueElement, "Quantity value not defined");
             const auto value = DocType::getStringValueFromValue(valueElement);
             FPExpect(! value.empty(), "Quantity value not defined");
-            const auto unit = DocType::getOptionalStringValue(*mValue, rapidjson::Pointer("/unit"));
+            const auto unit = DocType::getOptionalStringValue(*mValue, unitPointer);
             return std::make_shared<PrimitiveElement>(
                 repo, type(), QuantityType(fhirtools::DecimalType(value), unit.value_or("")), weak_from_this());
         }
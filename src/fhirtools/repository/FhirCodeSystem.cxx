@@ -242,6 +242,11 @@ bool FhirCodeSystemCodes::synthesized() const
 
 bool FhirCodeSystemCodes::containsCode(std::string_view code) const
 {
+    if (mIndexed)
+    {
+        std::string key{code};
+        return mCodeIndex.contains(mCaseSensitive ? key : boost::to_lower_copy(key));
+    }
     if (mCaseSensitive)
     {
         return end() != std::ranges::find_if(*this, [&code](const auto& c) {
@@ -257,6 +262,17 @@ bool FhirCodeSystemCodes::containsCode(std::string_view code) const
     return false;
 }
 
+void FhirCodeSystemCodes::buildIndex()
+{
+    mCodeIndex.clear();
+    mCodeIndex.reserve(size());
+    for (const auto& code : *this)
+    {
+        mCodeIndex.emplace(mCaseSensitive ? code.code : boost::to_lower_copy(code.code));
+    }
+    mIndexed = true;
+}
+
 
 FhirCodeSystem::Builder::Builder()
     : mCodeSystem(std::make_unique<FhirCodeSystem>())
@@ -13,6 +13,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 namespace fhirtools
@@ -84,6 +85,9 @@ public:
     bool synthesized() const;
 
     [[nodiscard]] bool containsCode(std::string_view code) const;
+    /// builds a hash index used by containsCode() instead of a linear search.
+    /// Must be called again after codes have been added or removed.
+    void buildIndex();
     [[nodiscard]] FhirCodeSystemCodes resolveIsA(const std::string& value, const std::string& property) const;
     [[nodiscard]] FhirCodeSystemCodes resolveIsNotA(const std::string& value, const std::string& property) const;
     [[nodiscard]] FhirCodeSystemCodes resolveEquals(const std::string& value, const std::string& property) const;
@@ -97,6 +101,9 @@ private:
     DefinitionKey mKey;
     bool mCaseSensitive{false};
     bool mSynthesized;
+    // lower case, if not mCaseSensitive
+    std::unordered_set<std::string> mCodeIndex;
+    bool mIndexed{false};
 };
 
 class FhirCodeSystem::Builder
@@ -12,6 +12,7 @@
 #include "views/FhirStructureRepositoryView.hxx"
 
 #include <boost/algorithm/string/case_conv.hpp>
+#include <algorithm>
 
 namespace fhirtools
 {
@@ -120,12 +121,27 @@ DefinitionKey FhirValueSetCodes::key() const
 
 bool FhirValueSetCodes::containsCode(const std::string& code) const
 {
-    return mCodes.contains(Code{.code = code, .caseSensitive = false, .codeSystem = {}});
+    return containsCode(code, {});
 }
 
 bool FhirValueSetCodes::containsCode(const std::string& code, const std::string& codeSystem) const
 {
-    return mCodes.contains(Code{.code = code, .caseSensitive = false, .codeSystem = codeSystem});
+    const auto matchesCodeSystem = [&codeSystem](const CodeIndex::value_type& entry) {
+        return codeSystem.empty() || std::ranges::any_of(entry.second, [&codeSystem](const std::string& system) {
+                   return system.empty() || system == codeSystem;
+               });
+    };
+    if (const auto entry = mCaseSensitiveIndex.find(code);
+        entry != mCaseSensitiveIndex.end() && matchesCodeSystem(*entry))
+    {
+        return true;
+    }
+    if (mCaseInsensitiveIndex.empty())
+    {
+        return false;
+    }
+    const auto entry = mCaseInsensitiveIndex.find(boost::to_lower_copy(code));
+    return entry != mCaseInsensitiveIndex.end() && matchesCodeSystem(*entry);
 }
 
 void FhirValueSetCodes::addError(const std::string& error)
@@ -161,6 +177,7 @@ void FhirValueSetCodes::finalize(const FhirStructureRepositoryView* repo)// NOLI
         addError("ValueSet contains no codes after expansion");
         mCanValidate = false;
     }
+    buildIndex();
     TVLOG(2) << "ValueSet \"" << mValueSet->key() << "\" finalized. Codes: " << mCodes.size()
              << ", canValidate: " << mCanValidate << " Warning(s): " << mValidationWarning;
 }
@@ -233,6 +250,19 @@ void FhirValueSetCodes::finalizeExcludes(const FhirStructureRepositoryView* repo
     }
 }
 
+void FhirValueSetCodes::buildIndex()
+{
+    for (const auto& code : mCodes)
+    {
+        auto& index = code.caseSensitive ? mCaseSensitiveIndex : mCaseInsensitiveIndex;
+        auto& codeSystems = index[code.caseSensitive ? code.code : boost::to_lower_copy(code.code)];
+        if (std::ranges::find(codeSystems, code.codeSystem) == codeSystems.end())
+        {
+            codeSystems.push_back(code.codeSystem);
+        }
+    }
+}
+
 void FhirValueSetCodes::finalizeIncludeFilters(const std::vector<FhirValueSet::Filter>& includeFilters,
                                                const FhirCodeSystemCodes* codes)
 {
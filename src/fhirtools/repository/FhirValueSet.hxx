@@ -17,6 +17,7 @@
 #include <memory>
 #include <optional>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 namespace fhirtools
@@ -137,12 +138,20 @@ private:
     void finalizeExcludeCodes(const std::set<std::string>& codes, bool caseSensitive, const std::string& codeSystemUrl);
     void finalizeExcludeFilters(const std::vector<FhirValueSet::Filter>& excludeFilters,
                                 const FhirCodeSystemCodes* codeSystem);
+    void buildIndex();
+
+    // maps a code to the urls of the CodeSystems it is defined in, an empty url matches all systems
+    using CodeIndex = std::unordered_map<std::string, std::vector<std::string>>;
 
     const FhirValueSet* mValueSet;
     std::string mValidationWarning;
     bool mCanValidate = true;
     bool mHasErrors = false;
     std::set<Code> mCodes;
+    // built at the end of finalize() for containsCode():
+    CodeIndex mCaseSensitiveIndex;
+    // keys are lower case
+    CodeIndex mCaseInsensitiveIndex;
 };
 
 
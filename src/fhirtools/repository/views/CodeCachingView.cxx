@@ -41,7 +41,16 @@ std::shared_ptr<const FhirValueSetCodes> CodeCachingView::findValueSetCodes(cons
 
 void CodeCachingView::baseFindCodes(std::shared_ptr<const FhirCodeSystemCodes>& out, const DefinitionKey& key) const
 {
-    out = baseView().findCodeSystemCodes(key);
+    const auto codes = baseView().findCodeSystemCodes(key);
+    if (! codes)
+    {
+        out = nullptr;
+        return;
+    }
+    // the cached instance is shared by all lookups of this view, so it is worth indexing
+    auto indexed = std::make_shared<FhirCodeSystemCodes>(*codes);
+    indexed->buildIndex();
+    out = std::move(indexed);
 }
 
 void CodeCachingView::baseFindCodes(std::shared_ptr<const FhirValueSetCodes>& out, const DefinitionKey& key) const
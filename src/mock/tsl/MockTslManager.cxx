@@ -111,15 +111,18 @@ std::shared_ptr<TslManager> MockTslManager::createMockTslManager(std::shared_ptr
 void MockTslManager::addOcspCertificateToTrustStore(const Certificate& certificate, TrustStore& trustStore)
 {
     const X509Certificate x509Certificate = X509Certificate::createFromBase64(certificate.toBase64Der());
-    trustStore.mServiceInformationMap.emplace(
-        CertificateId{x509Certificate.getSubject(), x509Certificate.getSubjectKeyIdentifier()},
-        TslParser::ServiceInformation{
-            x509Certificate,
-            "http://uri.etsi.org/TrstSvc/Svctype/Certstatus/OCSP",
-            {"http://ocsp00.gematik.invalid/not-used"},
-            TslParser::AcceptanceHistoryMap{
-                {std::chrono::time_point<std::chrono::system_clock>(std::chrono::milliseconds(1569415137000)), true}},
-            {TslService::oid_fd_sig}});
+    trustStore.update([&x509Certificate](TrustStore::Content& content) {
+        content.serviceInformationMap.emplace(
+            CertificateId{x509Certificate.getSubject(), x509Certificate.getSubjectKeyIdentifier()},
+            TslParser::ServiceInformation{
+                x509Certificate,
+                "http://uri.etsi.org/TrstSvc/Svctype/Certstatus/OCSP",
+                {"http://ocsp00.gematik.invalid/not-used"},
+                TslParser::AcceptanceHistoryMap{
+                    {std::chrono::time_point<std::chrono::system_clock>(std::chrono::milliseconds(1569415137000)),
+                     true}},
+                {TslService::oid_fd_sig}});
+    });
 }
 
 void MockTslManager::addCaCertificateToTrustStore(const Certificate& certificate, TslManager& tslManager,
@@ -148,17 +151,19 @@ void MockTslManager::addCaCertificateToTrustStore(const Certificate& certificate
                        : TslService::oid_fd_sig}
              : TslParser::ExtensionOidList{});
 
-    trustStore->mServiceInformationMap.emplace(
-        CertificateId{x509Certificate.getSubject(),
-                      customSubjectKeyIdentifier.has_value()
-                          ? *customSubjectKeyIdentifier
-                          : x509Certificate.getSubjectKeyIdentifier()},
-        TslParser::ServiceInformation{
-            x509Certificate,
-            "http://uri.etsi.org/TrstSvc/Svctype/CA/QC",
-            {"http://ocsp-testref.tsl.telematik-test/ocsp"},
-            TslParser::AcceptanceHistoryMap{{
-                std::chrono::time_point<std::chrono::system_clock>(std::chrono::milliseconds(1569415137000)),
-                true}},
-            extensionOidList});
+    trustStore->update([&](TrustStore::Content& content) {
+        content.serviceInformationMap.emplace(
+            CertificateId{x509Certificate.getSubject(),
+                          customSubjectKeyIdentifier.has_value()
+                              ? *customSubjectKeyIdentifier
+                              : x509Certificate.getSubjectKeyIdentifier()},
+            TslParser::ServiceInformation{
+                x509Certificate,
+                "http://uri.etsi.org/TrstSvc/Svctype/CA/QC",
+                {"http://ocsp-testref.tsl.telematik-test/ocsp"},
+                TslParser::AcceptanceHistoryMap{{
+                    std::chrono::time_point<std::chrono::system_clock>(std::chrono::milliseconds(1569415137000)),
+                    true}},
+                std::move(extensionOidList)});
+    });
 }
@@ -10,6 +10,7 @@
 #include "shared/deprecated/TerminationHandler.hxx"
 #include "shared/erp-serverinfo.hxx"
 #include "shared/hsm/production/HsmProductionFactory.hxx"
+#include "shared/util/AsyncLogWriter.hxx"
 #include "shared/util/CrashHandler.hxx"
 #include "shared/util/TLog.hxx"
 #include "shared/validation/JsonValidator.hxx"
@@ -69,6 +70,7 @@ int Application::MainFn(const int argc, const char* argv[], const std::string& n
         {
             TLOG(ERROR) << "Unexpected exception: " << boost::current_exception_diagnostic_information();
         }
+    AsyncLogWriter::instance().stop();
 
     TLOG(INFO) << "exiting " << name << " with exit code " << exitCode;
 
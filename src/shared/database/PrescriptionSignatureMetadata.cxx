@@ -0,0 +1,67 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/database/PrescriptionSignatureMetadata.hxx"
+#include "shared/util/Base64.hxx"
+#include "shared/util/Expect.hxx"
+
+#include <rapidjson/document.h>
+#include <rapidjson/writer.h>
+
+namespace db_model
+{
+
+namespace
+{
+constexpr int currentVersion = 1;
+}
+
+PrescriptionSignatureMetadata::PrescriptionSignatureMetadata(std::string messageDigest)
+    : mMessageDigest(std::move(messageDigest))
+{
+}
+
+std::string PrescriptionSignatureMetadata::getJson() const
+{
+    rapidjson::Document d;
+    d.SetObject();
+    d.AddMember("version", currentVersion, d.GetAllocator());
+    d.AddMember("digest", rapidjson::Value(Base64::encode(mMessageDigest), d.GetAllocator()), d.GetAllocator());
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    d.Accept(writer);
+
+    return buffer.GetString();
+}
+
+PrescriptionSignatureMetadata PrescriptionSignatureMetadata::fromJson(const std::string& json)
+{
+    rapidjson::Document doc;
+    doc.Parse(json);
+    Expect3(! doc.HasParseError() && doc.IsObject(), "invalid JSON representation of prescription metadata",
+            Exception);
+    const auto version = doc.FindMember("version");
+    Expect3(version != doc.MemberEnd() && version->value.IsInt() && version->value.GetInt() == currentVersion,
+            "unsupported version of prescription metadata", Exception);
+    const auto digest = doc.FindMember("digest");
+    Expect3(digest != doc.MemberEnd() && digest->value.IsString(), "digest missing in prescription metadata",
+            Exception);
+    return PrescriptionSignatureMetadata{Base64::decodeToString(digest->value.GetString())};
+}
+
+const std::string& PrescriptionSignatureMetadata::getMessageDigest() const
+{
+    return mMessageDigest;
+}
+
+PrescriptionSignatureMetadata::Exception::Exception(const std::string& what)
+    : std::runtime_error(what)
+{
+}
+
+}// namespace db_model
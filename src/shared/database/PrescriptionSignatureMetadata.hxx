@@ -0,0 +1,47 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#ifndef ERP_PROCESSING_CONTEXT_SHARED_DATABASE_PRESCRIPTIONSIGNATUREMETADATA_HXX
+#define ERP_PROCESSING_CONTEXT_SHARED_DATABASE_PRESCRIPTIONSIGNATUREMETADATA_HXX
+
+#include <stdexcept>
+#include <string>
+
+namespace db_model
+{
+
+/**
+ * Data extracted from the signed prescription (QES) during $activate.
+ *
+ * It is stored encrypted next to the prescription so that later workflow steps like $close can
+ * use it without decoding and parsing the CMS container and the KBV bundle again.
+ */
+class PrescriptionSignatureMetadata
+{
+public:
+    explicit PrescriptionSignatureMetadata(std::string messageDigest);
+
+    std::string getJson() const;
+    static PrescriptionSignatureMetadata fromJson(const std::string& json);
+
+    /// raw (not base64 encoded) value of the message digest attribute of the signature
+    const std::string& getMessageDigest() const;
+
+    class Exception : public std::runtime_error
+    {
+    public:
+        explicit Exception(const std::string& what);
+    };
+
+private:
+    std::string mMessageDigest;
+};
+
+}// namespace db_model
+
+
+#endif// ERP_PROCESSING_CONTEXT_SHARED_DATABASE_PRESCRIPTIONSIGNATUREMETADATA_HXX
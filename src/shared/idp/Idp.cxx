@@ -11,6 +11,22 @@
 #include "shared/util/TLog.hxx"
 
 
+namespace
+{
+bool isSameCertificate(const std::optional<Certificate>& current, const Certificate& other)
+{
+    return current.has_value() && current->toBinaryDer() == other.toBinaryDer();
+}
+}
+
+
+Idp::Idp()
+    : mVerifiedTokenCache(std::chrono::seconds{
+          Configuration::instance().getIntValue(ConfigurationKey::IDP_VERIFIED_TOKEN_CACHE_MAX_AGE_SECONDS)})
+{
+}
+
+
 Certificate Idp::getCertificate() const
 {
     std::lock_guard lock(mMutex);
@@ -25,6 +41,10 @@ void Idp::setCertificate(Certificate&& idpCertificate)
 {
     std::lock_guard lock(mMutex);
 
+    if (! isSameCertificate(mSignerCertificate, idpCertificate))
+    {
+        ++mGeneration;
+    }
     mSignerCertificate.emplace(std::move(idpCertificate));
     mLastUpdate = std::chrono::system_clock::now();
 }
@@ -33,6 +53,10 @@ void Idp::setCertificate(Certificate&& idpCertificate)
 void Idp::resetCertificate(void)
 {
     std::lock_guard lock(mMutex);
+    if (mSignerCertificate.has_value())
+    {
+        ++mGeneration;
+    }
     mSignerCertificate.reset();
 }
 
@@ -41,6 +65,10 @@ void Idp::setSecondaryCertificate(Certificate secondaryCertificate)
 {
     const std::scoped_lock lock(mMutex);
 
+    if (! isSameCertificate(mSecondaryCertificate, secondaryCertificate))
+    {
+        ++mGeneration;
+    }
     mSecondaryCertificate.emplace(std::move(secondaryCertificate));
 }
 
@@ -55,10 +83,26 @@ std::optional<Certificate> Idp::getSecondaryCertificate() const
 void Idp::resetSecondaryCertificate()
 {
     const std::scoped_lock lock(mMutex);
+    if (mSecondaryCertificate.has_value())
+    {
+        ++mGeneration;
+    }
     mSecondaryCertificate.reset();
 }
 
 
+uint64_t Idp::getGeneration() const
+{
+    return mGeneration.load();
+}
+
+
+VerifiedTokenCache& Idp::verifiedTokenCache()
+{
+    return mVerifiedTokenCache;
+}
+
+
 bool Idp::isHealthy() const
 {
     try
@@ -9,7 +9,10 @@
 #define ERP_PROCESSING_CONTEXT_IDP_HXX
 
 #include "shared/crypto/Certificate.hxx"
+#include "shared/idp/VerifiedTokenCache.hxx"
 
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <optional>
 
@@ -20,6 +23,8 @@
 class Idp
 {
 public:
+    Idp();
+
     Certificate getCertificate() const;
 
     void setCertificate (Certificate&& idpCertificate);
@@ -33,11 +38,21 @@ public:
     bool isHealthy() const;
     void healthCheck() const;
 
+    /**
+     * Increased whenever the primary or the secondary certificate changes. Used to invalidate the
+     * verified access tokens.
+     */
+    uint64_t getGeneration() const;
+
+    VerifiedTokenCache& verifiedTokenCache();
+
 private:
     mutable std::mutex mMutex;
     std::optional<Certificate> mSignerCertificate;
     std::optional<Certificate> mSecondaryCertificate;
     std::chrono::system_clock::time_point mLastUpdate;
+    std::atomic<uint64_t> mGeneration{0};
+    VerifiedTokenCache mVerifiedTokenCache;
 };
 
 
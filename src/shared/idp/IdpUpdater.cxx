@@ -140,6 +140,9 @@ IdpUpdater::IdpUpdater (
                                                             static_cast<uint16_t>(Configuration::instance().getIntValue(
                                                                 ConfigurationKey::HTTPCLIENT_CONNECT_TIMEOUT_SECONDS)),
                                                             mResolveTimeout);
+        // the discovery document and the signer certificate are requested one after the other from the same host
+        mRequestSender->setConnectionReuse(std::chrono::seconds{
+            Configuration::instance().getOptionalIntValue(ConfigurationKey::HTTPCLIENT_KEEP_ALIVE_IDLE_SECONDS, 0)});
     }
 
     // Extract hostname and path from the update URL.
@@ -0,0 +1,111 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/idp/VerifiedTokenCache.hxx"
+#include "shared/crypto/Jwt.hxx"
+#include "shared/util/Hash.hxx"
+#include "shared/util/MetricsRegistry.hxx"
+#include "shared/util/TLog.hxx"
+
+#include <algorithm>
+
+
+namespace
+{
+    constexpr auto metricsName = "verified_access_token";
+}
+
+
+VerifiedTokenCache::VerifiedTokenCache(std::chrono::system_clock::duration maxAge, size_t maxEntries)
+    : mMaxAge(maxAge)
+    , mMaxEntries(maxEntries)
+{
+}
+
+
+bool VerifiedTokenCache::contains(const JWT& token, uint64_t idpGeneration)
+{
+    if (mMaxAge <= std::chrono::system_clock::duration::zero())
+    {
+        return false;
+    }
+
+    const auto key = Hash::sha256(token.serialize());
+    const auto now = std::chrono::system_clock::now();
+
+    bool result = false;
+    {
+        std::lock_guard lock(mMutex);
+        const auto candidate = mEntries.find(key);
+        if (candidate != mEntries.end())
+        {
+            if (candidate->second.idpGeneration == idpGeneration && candidate->second.validUntil > now)
+            {
+                result = true;
+            }
+            else
+            {
+                mEntries.erase(candidate);
+            }
+        }
+    }
+
+    MetricsRegistry::instance().countCacheLookup(metricsName, result);
+    return result;
+}
+
+
+void VerifiedTokenCache::store(const JWT& token, uint64_t idpGeneration)
+{
+    const auto exp = token.intForClaim(JWT::expClaim);
+    if (mMaxAge <= std::chrono::system_clock::duration::zero() || ! exp.has_value())
+    {
+        return;
+    }
+    const auto now = std::chrono::system_clock::now();
+    const auto validUntil = std::min(now + mMaxAge, std::chrono::system_clock::time_point{std::chrono::seconds{*exp}});
+    if (validUntil <= now)
+    {
+        return;
+    }
+
+    auto key = Hash::sha256(token.serialize());
+
+    std::lock_guard lock(mMutex);
+    if (mEntries.size() >= mMaxEntries)
+    {
+        removeExpired(now);
+        if (mEntries.size() >= mMaxEntries)
+        {
+            TVLOG(1) << "verified access token cache is full, clearing it";
+            mEntries.clear();
+        }
+    }
+    mEntries.insert_or_assign(std::move(key), StoredEntry{idpGeneration, validUntil});
+}
+
+
+void VerifiedTokenCache::clear()
+{
+    std::lock_guard lock(mMutex);
+    mEntries.clear();
+}
+
+
+size_t VerifiedTokenCache::size() const
+{
+    std::lock_guard lock(mMutex);
+    return mEntries.size();
+}
+
+
+void VerifiedTokenCache::removeExpired(std::chrono::system_clock::time_point now)
+{
+    std::erase_if(mEntries, [now](const auto& item) {
+        return item.second.validUntil <= now;
+    });
+}
@@ -0,0 +1,68 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#ifndef ERP_PROCESSING_CONTEXT_IDP_VERIFIEDTOKENCACHE_HXX
+#define ERP_PROCESSING_CONTEXT_IDP_VERIFIEDTOKENCACHE_HXX
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class JWT;
+
+/**
+ * Cache of access tokens whose signature has been verified successfully with the IDP certificate.
+ *
+ * Entries are keyed by the SHA-256 hash of the complete compact serialization of the token, so that a hit
+ * means that exactly the same header, payload and signature have been verified before. An entry is only used as
+ * long as the certificate generation of the Idp is the same as at the time of the verification and the entry has
+ * not expired. The lifetime of an entry is bounded by the configured maximum age and the exp claim of the token.
+ *
+ * Failed verifications are never cached. The time based checks of the token are not covered by the cache and
+ * must be done for each use.
+ *
+ * The class is thread safe.
+ */
+class VerifiedTokenCache
+{
+public:
+    static constexpr size_t defaultMaxEntries = 10000;
+
+    /**
+     * @param maxAge        upper bound for the lifetime of an entry, a value of zero disables the cache
+     * @param maxEntries    when this number of entries is reached, expired entries are removed and,
+     *                      if that does not help, the cache is cleared
+     */
+    explicit VerifiedTokenCache(std::chrono::system_clock::duration maxAge, size_t maxEntries = defaultMaxEntries);
+
+    bool contains(const JWT& token, uint64_t idpGeneration);
+
+    void store(const JWT& token, uint64_t idpGeneration);
+
+    void clear();
+
+    size_t size() const;
+
+private:
+    struct StoredEntry
+    {
+        uint64_t idpGeneration;
+        std::chrono::system_clock::time_point validUntil;
+    };
+
+    void removeExpired(std::chrono::system_clock::time_point now);
+
+    const std::chrono::system_clock::duration mMaxAge;
+    const size_t mMaxEntries;
+    mutable std::mutex mMutex;
+    std::unordered_map<std::string, StoredEntry> mEntries;
+};
+
+
+#endif// ERP_PROCESSING_CONTEXT_IDP_VERIFIEDTOKENCACHE_HXX
@@ -130,17 +130,20 @@ template<typename TResource>
 // NOLINTNEXTLINE(bugprone-exception-escape)
 std::vector<TResource> BundleBase<DerivedBundle>::getResourcesByType(const std::string_view type) const
 {
+    static const rapidjson::Pointer entryPointer("/entry");
+    static const rapidjson::Pointer resourceTypePointer("/resource/resourceType");
+    static const rapidjson::Pointer resourcePointer("/resource");
     std::vector<TResource> resources;
 
-    const auto* entries = this->getValue(rapidjson::Pointer("/entry"));
+    const auto* entries = this->getValue(entryPointer);
     ModelExpect(entries && entries->IsArray(), "entry array not present in Bundle");
     for (auto entry = entries->Begin(), end = entries->End(); entry != end; ++entry)
     {
-        const auto* resourceType = rapidjson::Pointer("/resource/resourceType").Get(*entry);
+        const auto* resourceType = resourceTypePointer.Get(*entry);
         ModelExpect(resourceType, "Missing resourceType in Bundle entry");
         if (NumberAsStringParserDocument::getStringValueFromValue(resourceType) == type)
         {
-            const auto* resource = rapidjson::Pointer("/resource").Get(*entry);
+            const auto* resource = resourcePointer.Get(*entry);
             NumberAsStringParserDocument doc;
             doc.CopyFrom(*resource, doc.GetAllocator());
             resources.emplace_back(std::move(TResource::fromJson(doc)));
@@ -71,7 +71,8 @@ class RapidjsonNumberAsStringParserDocument
 public:
     model::NumberAsStringParserDocument& instance(void)
     {
-        static model::NumberAsStringParserDocument instance;
+        // static documents must not use the JsonArena of the request that happens to create them
+        static model::NumberAsStringParserDocument instance{std::shared_ptr<model::JsonArena>{}};
         return instance;
     }
 
@@ -47,6 +47,20 @@ ClientResponse ClientBase<StreamClass>::send (const ClientRequest& clientRequest
 }
 
 
+template<class StreamClass>
+void ClientBase<StreamClass>::establish()
+{
+    mImplementation->establish();
+}
+
+
+template<class StreamClass>
+bool ClientBase<StreamClass>::isEstablished() const
+{
+    return mImplementation->isEstablished();
+}
+
+
 template<class StreamClass>
 bool ClientBase<StreamClass>::hasLastTlsSessionBeenResumed () const
 {
@@ -33,6 +33,16 @@ public:
      */
     ClientResponse send (const ClientRequest& clientRequest) override;
 
+    /**
+     * Connect to the server, if not already connected. Otherwise the connection is established by the next send.
+     */
+    void establish();
+
+    /**
+     * Whether the connection is open. The connection is closed after a response without keep-alive.
+     */
+    bool isEstablished() const;
+
     bool hasLastTlsSessionBeenResumed () const;
 
     void inheritTlsSessionTicketFrom (const ClientBase<StreamClass>& client);
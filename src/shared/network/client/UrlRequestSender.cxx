@@ -12,11 +12,257 @@
 #include "shared/util/ExceptionHelper.hxx"
 #include "fhirtools/util/Gsl.hxx"
 #include "shared/util/Expect.hxx"
+#include "shared/util/MetricsRegistry.hxx"
 #include "shared/util/UrlHelper.hxx"
 
 #include <fmt/format.h>
+#include <algorithm>
+#include <deque>
+#include <mutex>
 #include <ranges>
 #include <set>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+
+
+namespace
+{
+constexpr auto connectionPoolName = "url_request_sender";
+constexpr auto connectionCacheName = "http_connection";
+// Closed HTTPS connections are kept this long so that their TLS session ticket can be used to resume the
+// next connection to the same host.
+constexpr auto sessionTicketLifetime = std::chrono::minutes{5};
+
+bool isConnectionError(const boost::system::error_code& ec)
+{
+    return boost::asio::ssl::error::stream_truncated == ec || boost::asio::error::connection_reset == ec ||
+           boost::asio::error::not_connected == ec || boost::beast::http::error::end_of_stream == ec ||
+           boost::asio::error::connection_refused == ec || boost::asio::error::host_unreachable == ec;
+}
+
+// A pooled connection that the server has closed while it was idle fails on the first write or read.
+// Only used to decide whether a request on a reused connection is retried on a new one.
+bool isStaleConnectionError(const boost::system::error_code& ec)
+{
+    return isConnectionError(ec) || boost::asio::error::broken_pipe == ec || boost::asio::error::eof == ec;
+}
+
+std::string connectionKey(const ConnectionParameters& params, const boost::asio::ip::tcp::endpoint* ep)
+{
+    const auto& tls = params.tlsParameters;
+    return fmt::format("{}|{}:{}|{}|{}|{}", tls.has_value() ? "https" : "http", params.hostname, params.port,
+                       ep != nullptr ? fmt::format("{}:{}", ep->address().to_string(), ep->port()) : "",
+                       tls.has_value() ? tls->forcedCiphers.value_or("") : "",
+                       tls.has_value() && tls->trustCertificateCn);
+}
+
+template<class Action>
+void observeHandshake(const std::string& host, Action&& action)
+{
+    const auto start = std::chrono::steady_clock::now();
+    bool success = false;
+    auto observe = gsl::finally([&host, &start, &success] {
+        MetricsRegistry::instance().observeConnectionHandshake(connectionPoolName, host,
+                                                               std::chrono::steady_clock::now() - start, success);
+    });
+    std::forward<Action>(action)();
+    success = true;
+}
+
+template<class Client>
+std::unique_ptr<Client> connect(const ConnectionParameters& params, const boost::asio::ip::tcp::endpoint* ep,
+                                const Client* previous)
+{
+    std::unique_ptr<Client> client;
+    observeHandshake(params.hostname, [&] {
+        client = ep != nullptr ? std::make_unique<Client>(*ep, params) : std::make_unique<Client>(params);
+        if constexpr (std::is_same_v<Client, HttpsClient>)
+        {
+            if (previous != nullptr)
+            {
+                client->inheritTlsSessionTicketFrom(*previous);
+            }
+        }
+        client->establish();
+    });
+    return client;
+}
+}
+
+
+/**
+ * Idle connections of a UrlRequestSender, grouped by host, port, endpoint and TLS options.
+ *
+ * Connections are handed out newest first. Connections that have been idle for longer than the configured time
+ * are closed when the group is accessed the next time. Closed HTTPS connections stay in the pool for up to
+ * `sessionTicketLifetime` so that they can be re-established with an abbreviated TLS handshake.
+ * Closing is never done while the mutex is held.
+ */
+class UrlRequestSender::ConnectionPool
+{
+public:
+    ConnectionPool(std::chrono::steady_clock::duration maxIdleTime, size_t maxIdleConnectionsPerHost)
+        : mMaxIdleTime{maxIdleTime}
+        , mMaxIdleConnectionsPerHost{std::max<size_t>(maxIdleConnectionsPerHost, 1)}
+    {
+    }
+
+    ~ConnectionPool()
+    {
+        clear();
+    }
+
+    template<class Client>
+    std::unique_ptr<Client> take(const std::string& key)
+    {
+        std::vector<Evicted> evicted;
+        std::unique_ptr<Client> result;
+        {
+            std::lock_guard lock{mMutex};
+            auto idle = mIdleConnections.find(key);
+            if (idle == mIdleConnections.end())
+            {
+                return {};
+            }
+            evict(idle->second, std::chrono::steady_clock::now(), evicted);
+            if (! idle->second.empty())
+            {
+                result = std::move(std::get<std::unique_ptr<Client>>(idle->second.back().connection));
+                idle->second.pop_back();
+            }
+        }
+        closeEvicted(key, std::move(evicted));
+        return result;
+    }
+
+    template<class Client>
+    void put(const std::string& key, std::unique_ptr<Client> client)
+    {
+        if constexpr (std::is_same_v<Client, HttpClient>)
+        {
+            // a plain TCP connection that has been closed after the response can not be used again
+            if (! client->isEstablished())
+            {
+                return;
+            }
+        }
+        std::vector<Evicted> evicted;
+        {
+            std::lock_guard lock{mMutex};
+            auto& idle = mIdleConnections[key];
+            evict(idle, std::chrono::steady_clock::now(), evicted);
+            if (idle.size() >= mMaxIdleConnectionsPerHost)
+            {
+                evicted.emplace_back(Evicted{std::move(idle.front()), false});
+                idle.pop_front();
+            }
+            idle.emplace_back(Idle{std::move(client), std::chrono::steady_clock::now()});
+        }
+        closeEvicted(key, std::move(evicted));
+    }
+
+    void clear()
+    {
+        std::unordered_map<std::string, std::deque<Idle>> idleConnections;
+        {
+            std::lock_guard lock{mMutex};
+            idleConnections.swap(mIdleConnections);
+        }
+        for (auto& idle : idleConnections | std::views::values)
+        {
+            for (auto& item : idle)
+            {
+                close(item.connection);
+            }
+        }
+    }
+
+private:
+    using Connection = std::variant<std::unique_ptr<HttpsClient>, std::unique_ptr<HttpClient>>;
+    struct Idle {
+        Connection connection;
+        std::chrono::steady_clock::time_point idleSince;
+    };
+    struct Evicted {
+        Idle item;
+        bool keepTicket;
+    };
+
+    static bool isEstablished(const Connection& connection)
+    {
+        return std::visit(
+            [](const auto& client) {
+                return client->isEstablished();
+            },
+            connection);
+    }
+
+    static void close(Connection& connection)
+    {
+        std::visit(
+            [](auto& client) {
+                try
+                {
+                    client->close();
+                }
+                catch (const std::exception& e)
+                {
+                    TVLOG(1) << "closing idle connection failed: " << e.what();
+                }
+            },
+            connection);
+    }
+
+    void evict(std::deque<Idle>& idle, std::chrono::steady_clock::time_point now, std::vector<Evicted>& evicted) const
+    {
+        for (auto item = idle.begin(); item != idle.end();)
+        {
+            const auto idleTime = now - item->idleSince;
+            if (idleTime <= mMaxIdleTime)
+            {
+                ++item;
+                continue;
+            }
+            const bool keepTicket = std::holds_alternative<std::unique_ptr<HttpsClient>>(item->connection) &&
+                                    idleTime <= sessionTicketLifetime;
+            if (keepTicket && ! isEstablished(item->connection))
+            {
+                ++item;
+                continue;
+            }
+            evicted.emplace_back(Evicted{std::move(*item), keepTicket});
+            item = idle.erase(item);
+        }
+    }
+
+    void closeEvicted(const std::string& key, std::vector<Evicted> evicted)
+    {
+        if (evicted.empty())
+        {
+            return;
+        }
+        for (auto& entry : evicted)
+        {
+            // HTTPS connections are shut down gracefully, otherwise the TLS session is not resumable
+            close(entry.item.connection);
+        }
+        std::lock_guard lock{mMutex};
+        auto& idle = mIdleConnections[key];
+        for (auto& entry : evicted | std::views::reverse)
+        {
+            if (entry.keepTicket && idle.size() < mMaxIdleConnectionsPerHost)
+            {
+                idle.emplace_front(std::move(entry.item));
+            }
+        }
+    }
+
+    const std::chrono::steady_clock::duration mMaxIdleTime;
+    const size_t mMaxIdleConnectionsPerHost;
+    std::mutex mMutex;
+    std::unordered_map<std::string, std::deque<Idle>> mIdleConnections;
+};
 
 
 UrlRequestSender::UrlRequestSender(std::string rootCertificates, const uint16_t connectionTimeoutSeconds,
@@ -41,9 +287,17 @@ UrlRequestSender::UrlRequestSender(TlsCertificateVerifier certificateVerifier,
 }
 
 
+UrlRequestSender::~UrlRequestSender() = default;
+
+
 void UrlRequestSender::setTlsCertificateVerifier(TlsCertificateVerifier certificateVerifier)
 {
     mTlsCertificateVerifier = std::move(certificateVerifier);
+    if (mConnectionPool)
+    {
+        // pooled connections have been verified with the previous verifier
+        mConnectionPool->clear();
+    }
 }
 
 
@@ -59,6 +313,20 @@ void UrlRequestSender::setAdditionalHeaders(Header::keyValueMap_t&& additionalHe
 }
 
 
+void UrlRequestSender::setConnectionReuse(std::chrono::steady_clock::duration maxIdleTime,
+                                          size_t maxIdleConnectionsPerHost)
+{
+    if (maxIdleTime > std::chrono::steady_clock::duration::zero())
+    {
+        mConnectionPool = std::make_unique<ConnectionPool>(maxIdleTime, maxIdleConnectionsPerHost);
+    }
+    else
+    {
+        mConnectionPool.reset();
+    }
+}
+
+
 ClientResponse UrlRequestSender::send(
     const std::string& url,
     const HttpMethod method,
@@ -199,7 +467,7 @@ ClientResponse UrlRequestSender::doSend(
     httpHeaders.emplace(Header::UserAgent, "erp-processing-context");
     httpHeaders.emplace(Header::Accept, "*/*");
     httpHeaders.emplace(Header::Host, fmt::format("{}:{}", url.mHost, url.mPort));
-    httpHeaders.emplace(Header::Connection, Header::ConnectionClose);
+    httpHeaders.emplace(Header::Connection, mConnectionPool ? Header::ConnectionKeepAlive : Header::ConnectionClose);
 
     httpHeaders.insert(
         std::make_move_iterator(mAdditionalHeaders.begin()),
@@ -210,7 +478,12 @@ ClientResponse UrlRequestSender::doSend(
                                        std::move(httpHeaders), HttpStatus::Unknown),
                                 body);
 
-    auto sendHttpReq = [&request, &connectionParameters]<typename Client>(const boost::asio::ip::tcp::endpoint* ep) {
+    auto sendHttpReq = [this, &request, &connectionParameters]<typename Client>(
+                           const boost::asio::ip::tcp::endpoint* ep) {
+        if (mConnectionPool)
+        {
+            return sendWithPool<Client>(connectionKey(connectionParameters, ep), connectionParameters, request, ep);
+        }
         if (ep != nullptr)
         {
             return Client(*ep, connectionParameters).send(request);
@@ -248,9 +521,7 @@ ClientResponse UrlRequestSender::doSend(
         {
             // in case of of networking errors, try the next proxy
             auto ec = e.code();
-            if (boost::asio::ssl::error::stream_truncated == ec || boost::asio::error::connection_reset == ec ||
-                boost::asio::error::not_connected == ec || boost::beast::http::error::end_of_stream == ec ||
-                boost::asio::error::connection_refused == ec || boost::asio::error::host_unreachable == ec)
+            if (isConnectionError(ec))
             {
                 LOG(INFO) << "request to proxy " << proxy.ip << ":" << proxy.port << " failed with " << ec.message();
                 continue;
@@ -261,6 +532,47 @@ ClientResponse UrlRequestSender::doSend(
     Fail("No proxy available to take request");
 }
 
+template<class Client>
+ClientResponse UrlRequestSender::sendWithPool(const std::string& poolKey,
+                                              const ConnectionParameters& connectionParameters,
+                                              const ClientRequest& request,
+                                              const boost::asio::ip::tcp::endpoint* ep) const
+{
+    auto client = mConnectionPool->take<Client>(poolKey);
+    MetricsRegistry::instance().countCacheLookup(connectionCacheName, client != nullptr);
+    if (client)
+    {
+        try
+        {
+            if (! client->isEstablished())
+            {
+                // an HTTPS connection that has been closed, the TLS session is resumed
+                observeHandshake(connectionParameters.hostname, [&client] {
+                    client->establish();
+                });
+            }
+            auto response = client->send(request);
+            mConnectionPool->put(poolKey, std::move(client));
+            return response;
+        }
+        catch (const boost::system::system_error& e)
+        {
+            // the server may have closed the idle connection in the meantime
+            if (! isStaleConnectionError(e.code()))
+            {
+                throw;
+            }
+            TVLOG(1) << "reused connection to " << connectionParameters.hostname << " failed with "
+                     << e.code().message() << ", retrying with a new connection";
+        }
+    }
+    auto newClient = connect<Client>(connectionParameters, ep, client.get());
+    auto response = newClient->send(request);
+    mConnectionPool->put(poolKey, std::move(newClient));
+    return response;
+}
+
+
 bool UrlRequestSender::followsRedirects() const
 {
     return mFollowRedirects;
@@ -270,4 +582,8 @@ bool UrlRequestSender::followsRedirects() const
 void UrlRequestSender::setProxies(std::vector<ProxyParameters> proxies)
 {
     mProxies = std::move(proxies);
+    if (mConnectionPool)
+    {
+        mConnectionPool->clear();
+    }
 }
@@ -15,7 +15,10 @@
 #include "shared/util/UrlHelper.hxx"
 
 #include <boost/asio/ip/tcp.hpp>
+#include <chrono>
+#include <memory>
 
+class ClientRequest;
 class HttpClient;
 class HttpsClient;
 
@@ -27,7 +30,7 @@ public:
                               std::chrono::milliseconds resolveTimeout);
     explicit UrlRequestSender(TlsCertificateVerifier certificateVerifier, std::chrono::milliseconds connectionTimeout,
                               std::chrono::milliseconds resolveTimeout);
-    virtual ~UrlRequestSender() = default;
+    virtual ~UrlRequestSender();
 
     /**
      * Send the given body to the URL and return the received response.
@@ -73,6 +76,14 @@ public:
 
     void setAdditionalHeaders(Header::keyValueMap_t&& additionalHeaders);
 
+    /**
+     * Keep connections open after a request and reuse them for later requests to the same host.
+     * Connections that have been idle for longer than `maxIdleTime` are closed. For HTTPS connections the
+     * TLS session ticket is kept so that a connection that had to be re-established can be resumed.
+     * A `maxIdleTime` of zero disables the reuse, which is the default.
+     */
+    void setConnectionReuse(std::chrono::steady_clock::duration maxIdleTime, size_t maxIdleConnectionsPerHost = 4);
+
 protected:
     virtual ClientResponse doSend(const std::string& url, HttpMethod method, const std::string& body,
                                   const std::string& contentType = std::string(),
@@ -86,6 +97,12 @@ protected:
     bool followsRedirects() const;
 
 private:
+    class ConnectionPool;
+
+    template<class Client>
+    ClientResponse sendWithPool(const std::string& poolKey, const ConnectionParameters& connectionParameters,
+                                const ClientRequest& request, const boost::asio::ip::tcp::endpoint* ep) const;
+
     TlsCertificateVerifier mTlsCertificateVerifier;
     std::chrono::milliseconds mConnectionTimeout;
     std::chrono::milliseconds mResolveTimeout;
@@ -93,6 +110,7 @@ private:
     std::vector<ProxyParameters> mProxies;
     bool mFollowRedirects;
     Header::keyValueMap_t mAdditionalHeaders;
+    std::unique_ptr<ConnectionPool> mConnectionPool;
 };
 
 
@@ -94,6 +94,20 @@ ClientResponse ClientImpl<StreamClass>::send (const ClientRequest& clientRequest
 }
 
 
+template<class StreamClass>
+void ClientImpl<StreamClass>::establish()
+{
+    mSessionContainer.establish();
+}
+
+
+template<class StreamClass>
+bool ClientImpl<StreamClass>::isEstablished() const
+{
+    return mSessionContainer.isEstablished();
+}
+
+
 template<class StreamClass>
 bool ClientImpl<StreamClass>::hasLastTlsSessionBeenResumed () const
 {
@@ -38,6 +38,10 @@ public:
 
     ClientResponse send (const ClientRequest& clientRequest);
 
+    void establish();
+
+    bool isEstablished() const;
+
     bool hasLastTlsSessionBeenResumed () const;
 
     void inheritTlsSessionTicketFrom (const ClientImpl<StreamClass>& client);
@@ -47,6 +47,8 @@ public:
         }
     };
 
+    bool isEstablished() const { return mIsEstablished; }
+
     bool hasBeenResumed() const { return mTlsSession.hasBeenResumed(); }
 
     void inheritTicketFrom (const SessionContainer<SslStream>& container)
@@ -89,13 +91,19 @@ public:
 
     TcpStream& getStream() { return mTcpStream; };
     void establish() {};
+    // the stream is connected on construction and can not be reconnected after teardown
+    bool isEstablished() const { return mIsOpen; }
     bool hasBeenResumed() const { return false; }
     void inheritTicketFrom (const SessionContainer<TcpStream>&)
     {
         throw ExceptionWrapper<std::runtime_error>::create({__FILE__, __LINE__}, "The functionality is not supported.");
     }
 
-    void teardown() { mTcpStream.shutdown(); }
+    void teardown()
+    {
+        mIsOpen = false;
+        mTcpStream.shutdown();
+    }
 
     std::optional<boost::asio::ip::tcp::endpoint> currentEndpoint() const
     {
@@ -104,6 +112,7 @@ public:
 
 private:
     TcpStream mTcpStream;
+    bool mIsOpen{true};
 };
 
 
@@ -160,7 +160,7 @@ TlsSession::TlsSession(const ConnectionParameters& params)
       // GEMREQ-end GS-A_5542
       // GEMREQ-end A_27858
       mSslStream{},
-      mTicket{},
+      mTicket{std::make_unique<TlsSessionTicketImpl>(mSslStream)},
       mCertificateVerifier{params.tlsParameters.value().certificateVerifier},
       mTrustCn{params.tlsParameters.value().trustCertificateCn}
 {
@@ -203,8 +203,9 @@ void TlsSession::establish()
         try
         {
             // GEMREQ-start A_21269#ticketUse
+            // the ticket refers to mSslStream and survives the re-creation of the stream, so that a
+            // reconnect of this session can be resumed
             mSslStream = SslStream::create(mIoContext, mSslContext);
-            mTicket = std::make_unique<TlsSessionTicketImpl>(mSslStream);
 
             configureSession(resolverResults);
 
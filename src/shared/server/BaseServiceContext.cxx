@@ -9,6 +9,7 @@
 #include "shared/ErpRequirements.hxx"
 #include "shared/enrolment/EnrolmentServer.hxx"
 #include "shared/hsm/VsdmKeyCache.hxx"
+#include "shared/tsl/OcspRefreshJob.hxx"
 #include "shared/tsl/TslRefreshJob.hxx"
 #include "shared/util/Configuration.hxx"
 
@@ -33,6 +34,10 @@ BaseServiceContext::BaseServiceContext(const BaseFactories& factories)
 
 BaseServiceContext::~BaseServiceContext()
 {
+    if (mOcspRefreshJob != nullptr)
+    {
+        mOcspRefreshJob->shutdown();
+    }
     if (mTslRefreshJob != nullptr)
     {
         mTslRefreshJob->shutdown();
@@ -110,6 +115,14 @@ void BaseServiceContext::setupTslRefreshJob(std::chrono::seconds tslRefreshInter
     mTslRefreshJob = std::make_unique<TslRefreshJob>(*mTslManager, tslRefreshInterval);
     mTslRefreshJob->start();
     GS_A_4899.finish();
+
+    const std::chrono::seconds ocspRefreshInterval{
+        Configuration::instance().getOptionalIntValue(ConfigurationKey::TSL_OCSP_REFRESH_INTERVAL, 0)};
+    if (ocspRefreshInterval > std::chrono::seconds::zero())
+    {
+        mOcspRefreshJob = std::make_unique<OcspRefreshJob>(*mTslManager, ocspRefreshInterval);
+        mOcspRefreshJob->start();
+    }
 }
 
 std::shared_ptr<CrlProvider> BaseServiceContext::crlProvider()
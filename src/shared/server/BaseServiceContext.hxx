@@ -24,6 +24,7 @@ class BaseServiceContext;
 class RequestHandlerManager;
 class VsdmKeyBlobDatabase;
 class XmlValidator;
+class OcspRefreshJob;
 class TslRefreshJob;
 
 
@@ -110,6 +111,7 @@ private:
      */
     std::shared_ptr<TslManager> mTslManager;
     std::unique_ptr<TslRefreshJob> mTslRefreshJob;
+    std::unique_ptr<OcspRefreshJob> mOcspRefreshJob;
 };
 
 
@@ -0,0 +1,150 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/tsl/OcspCache.hxx"
+#include "shared/util/MetricsRegistry.hxx"
+#include "shared/util/TLog.hxx"
+
+#include <functional>
+
+
+namespace
+{
+    constexpr auto metricsName = "ocsp";
+}
+
+
+OcspCache::OcspCache(double refreshThreshold)
+    : mRefreshThreshold(refreshThreshold)
+    , mShards{}
+{
+}
+
+
+void OcspCache::store(const std::string& fingerprint, OcspResponse response)
+{
+    auto& shard = shardFor(fingerprint);
+    std::lock_guard lock(shard.mutex);
+    auto& entry = shard.entries[fingerprint];
+    entry.response = std::move(response);
+}
+
+
+void OcspCache::setRefreshContext(const std::string& fingerprint, const RefreshContext& context)
+{
+    auto& shard = shardFor(fingerprint);
+    std::lock_guard lock(shard.mutex);
+    const auto entry = shard.entries.find(fingerprint);
+    if (entry != shard.entries.end() && ! entry->second.refreshContext.has_value())
+    {
+        entry->second.refreshContext = context;
+    }
+}
+
+
+std::optional<OcspResponse> OcspCache::lookup(const std::string& fingerprint)
+{
+    const auto now = std::chrono::system_clock::now();
+    std::optional<OcspResponse> result;
+    {
+        auto& shard = shardFor(fingerprint);
+        std::lock_guard lock(shard.mutex);
+        const auto entry = shard.entries.find(fingerprint);
+        if (entry != shard.entries.end())
+        {
+            if (isExpired(entry->second.response, now))
+            {
+                shard.entries.erase(entry);
+            }
+            else
+            {
+                if (isDueForRefresh(entry->second.response, now))
+                {
+                    TVLOG(2) << "Returning OCSP response that is due for refresh";
+                }
+                result = entry->second.response;
+            }
+        }
+    }
+
+    MetricsRegistry::instance().countCacheLookup(metricsName, result.has_value());
+    return result;
+}
+
+
+void OcspCache::erase(const std::string& fingerprint)
+{
+    auto& shard = shardFor(fingerprint);
+    std::lock_guard lock(shard.mutex);
+    shard.entries.erase(fingerprint);
+}
+
+
+void OcspCache::removeExpired()
+{
+    const auto now = std::chrono::system_clock::now();
+    for (auto& shard : mShards)
+    {
+        std::lock_guard lock(shard.mutex);
+        std::erase_if(shard.entries, [now](const auto& item) {
+            return isExpired(item.second.response, now);
+        });
+    }
+}
+
+
+std::vector<OcspCache::RefreshCandidate> OcspCache::getRefreshCandidates() const
+{
+    const auto now = std::chrono::system_clock::now();
+    std::vector<RefreshCandidate> candidates;
+    for (const auto& shard : mShards)
+    {
+        std::lock_guard lock(shard.mutex);
+        for (const auto& [fingerprint, entry] : shard.entries)
+        {
+            if (entry.refreshContext.has_value() && ! isExpired(entry.response, now) &&
+                isDueForRefresh(entry.response, now))
+            {
+                candidates.emplace_back(
+                    RefreshCandidate{fingerprint, *entry.refreshContext, entry.response.gracePeriod});
+            }
+        }
+    }
+    return candidates;
+}
+
+
+size_t OcspCache::size() const
+{
+    size_t result = 0;
+    for (const auto& shard : mShards)
+    {
+        std::lock_guard lock(shard.mutex);
+        result += shard.entries.size();
+    }
+    return result;
+}
+
+
+OcspCache::Shard& OcspCache::shardFor(const std::string& fingerprint)
+{
+    return mShards[std::hash<std::string>{}(fingerprint) % shardCount];
+}
+
+
+bool OcspCache::isExpired(const OcspResponse& response, std::chrono::system_clock::time_point now)
+{
+    return (now - response.producedAt) > response.gracePeriod;
+}
+
+
+bool OcspCache::isDueForRefresh(const OcspResponse& response, std::chrono::system_clock::time_point now) const
+{
+    const auto refreshAfter = std::chrono::duration_cast<std::chrono::system_clock::duration>(
+        response.gracePeriod * mRefreshThreshold);
+    return (now - response.producedAt) >= refreshAfter;
+}
@@ -0,0 +1,108 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#ifndef ERP_PROCESSING_CONTEXT_SRC_SHARED_TSL_OCSPCACHE_HXX
+#define ERP_PROCESSING_CONTEXT_SRC_SHARED_TSL_OCSPCACHE_HXX
+
+#include "shared/tsl/OcspResponse.hxx"
+#include "shared/tsl/X509Certificate.hxx"
+#include "shared/util/CertificateType.hxx"
+
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Cache of OCSP responses keyed by the SHA-256 fingerprint of the checked certificate.
+ *
+ * The cache is split into shards with their own lock, so that lookups for different certificates do not block
+ * each other and are independent of the lock of the trust store. Responses are usable as long as they are not older
+ * than their grace period (A_15873). Expired entries are removed lazily on access and by removeExpired().
+ *
+ * Responses that have used up a part of their grace period are still returned by lookup(), but are reported by
+ * getRefreshCandidates() so that a background job can request a fresh response before the cached one expires.
+ * The refresh needs the information that was used for the original OCSP request, it is attached to an entry with
+ * setRefreshContext(). Entries without such a context are never refreshed.
+ *
+ * The class is thread safe.
+ */
+class OcspCache
+{
+public:
+    static constexpr size_t shardCount = 16;
+    /// Part of the grace period after which an entry is reported for refresh.
+    static constexpr double defaultRefreshThreshold = 0.75;
+
+    struct RefreshContext
+    {
+        X509Certificate certificate;
+        CertificateType certificateType;
+        X509Certificate issuerCertificate;
+    };
+
+    struct RefreshCandidate
+    {
+        std::string fingerprint;
+        RefreshContext context;
+        std::chrono::system_clock::duration gracePeriod;
+    };
+
+    explicit OcspCache(double refreshThreshold = defaultRefreshThreshold);
+
+    /**
+     * Stores the response, an already attached refresh context is kept.
+     */
+    void store(const std::string& fingerprint, OcspResponse response);
+
+    /**
+     * Attaches the refresh context to an existing entry, does nothing if there is no entry for the fingerprint.
+     */
+    void setRefreshContext(const std::string& fingerprint, const RefreshContext& context);
+
+    /**
+     * Returns the cached response, if any, that is still within its grace period.
+     */
+    std::optional<OcspResponse> lookup(const std::string& fingerprint);
+
+    void erase(const std::string& fingerprint);
+
+    void removeExpired();
+
+    /**
+     * Returns the entries with refresh context that have used up the refresh threshold of their grace period.
+     */
+    std::vector<RefreshCandidate> getRefreshCandidates() const;
+
+    size_t size() const;
+
+private:
+    struct Entry
+    {
+        OcspResponse response;
+        std::optional<RefreshContext> refreshContext;
+    };
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+    };
+
+    Shard& shardFor(const std::string& fingerprint);
+    static bool isExpired(const OcspResponse& response, std::chrono::system_clock::time_point now);
+    bool isDueForRefresh(const OcspResponse& response, std::chrono::system_clock::time_point now) const;
+
+    const double mRefreshThreshold;
+    std::array<Shard, shardCount> mShards;
+};
+
+
+#endif
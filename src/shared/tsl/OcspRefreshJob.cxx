@@ -0,0 +1,50 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/tsl/OcspRefreshJob.hxx"
+
+#include "shared/util/TLog.hxx"
+
+
+OcspRefreshJob::OcspRefreshJob(
+    TslManager& tslManager,
+    const std::chrono::steady_clock::duration interval)
+        : TimerJobBase("OcspRefreshJob", interval)
+        , mTslManager(tslManager)
+{
+}
+
+
+void OcspRefreshJob::onStart()
+{
+}
+
+
+void OcspRefreshJob::executeJob()
+{
+    // a failed refresh is not critical, the cached response stays usable until the end of its grace period
+    // and afterwards the OCSP request is sent on demand again
+    try
+    {
+        TVLOG(1) << "Executing OCSP refresh job";
+        mTslManager.refreshOcspResponses();
+    }
+    catch(const std::exception& e)
+    {
+        TLOG(ERROR) << "Can not refresh OCSP responses, unexpected exception: " << e.what();
+    }
+    catch(...)
+    {
+        TLOG(ERROR) << "Can not refresh OCSP responses, unknown exception";
+        throw;
+    }
+}
+
+
+void OcspRefreshJob::onFinish()
+{
+}
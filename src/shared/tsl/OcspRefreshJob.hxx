@@ -0,0 +1,35 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#ifndef ERP_PROCESSING_CONTEXT_SRC_SHARED_TSL_OCSPREFRESHJOB_HXX
+#define ERP_PROCESSING_CONTEXT_SRC_SHARED_TSL_OCSPREFRESHJOB_HXX
+
+#include "shared/tsl/TslManager.hxx"
+#include "shared/deprecated/TimerJobBase.hxx"
+
+/**
+ * This implementation refreshes cached OCSP responses before they expire in standalone thread with specified interval,
+ * so that OCSP requests are not sent on the request path for certificates that are in regular use.
+ */
+class OcspRefreshJob : public TimerJobBase
+{
+public:
+    OcspRefreshJob(TslManager& tslManager,
+                   const std::chrono::steady_clock::duration interval);
+    ~OcspRefreshJob() noexcept override = default;
+
+protected:
+    void onStart(void) override;
+    void executeJob(void) override;
+    void onFinish(void) override;
+
+private:
+    TslManager& mTslManager;
+};
+
+
+#endif
@@ -12,6 +12,9 @@
 #include "shared/util/Configuration.hxx"
 #include "shared/util/Expect.hxx"
 #include "shared/util/FileHelper.hxx"
+#include "shared/util/TLog.hxx"
+
+#include <map>
 
 
 namespace
@@ -129,22 +132,85 @@ namespace
 }
 
 
+class TrustStore::X509StoreCache
+{
+public:
+    /// a TSL usually leads to very few different sets of accepted services, the limit guards against surprises
+    static constexpr size_t maxEntries = 64;
+
+    X509Store get(const TslParser::ServiceInformationMap& serviceInformationMap,
+                  const std::optional<X509Certificate>& certificate)
+    {
+        // The map is not changed while the cache is in use, therefore the iteration order is stable
+        // and the acceptance of each service in that order identifies the set of trusted CAs.
+        std::vector<bool> accepted;
+        accepted.reserve(serviceInformationMap.size());
+        for (const auto& [id, serviceInformation] : serviceInformationMap)
+        {
+            (void)id;
+            accepted.push_back(isServiceAcceptable(serviceInformation.serviceAcceptanceHistory, certificate));
+        }
+
+        std::lock_guard lock(mMutex);
+        const auto candidate = mStores.find(accepted);
+        if (candidate != mStores.end())
+        {
+            return candidate->second;
+        }
+
+        std::vector<X509Certificate> trustedCertificates;
+        auto acceptedIterator = accepted.begin();
+        for (const auto& [id, serviceInformation] : serviceInformationMap)
+        {
+            (void)id;
+            if (*acceptedIterator++)
+            {
+                trustedCertificates.emplace_back(serviceInformation.certificate);
+            }
+        }
+        if (mStores.size() >= maxEntries)
+        {
+            TVLOG(1) << "X509 store cache is full, clearing it";
+            mStores.clear();
+        }
+        TVLOG(1) << "building X509 store with " << trustedCertificates.size() << " trusted certificates";
+        return mStores.emplace(std::move(accepted), X509Store(std::move(trustedCertificates))).first->second;
+    }
+
+private:
+    std::mutex mMutex;
+    std::map<std::vector<bool>, X509Store> mStores;
+};
+
+
+std::shared_ptr<TrustStore::X509StoreCache> TrustStore::makeX509StoreCache()
+{
+    return std::make_shared<X509StoreCache>();
+}
+
+
 TrustStore::TrustStore (const TslMode mode, std::vector<std::string> initialTslUrls)
-    : mMutex{}
+    : mUpdateMutex{}
     , mMode(mode)
-    , mTslHashValue{}
-    , mId{}
-    , mSequenceNumber{}
-    , mNextUpdate{}
-    , mLastUpdateCheck{}
-    , mUpdateUrls(std::move(initialTslUrls))
-    , mBnaServiceInformation{}
-    , mServiceInformationMap{}
+    , mContent{std::make_shared<const Content>(
+          Content{.updateUrls = std::move(initialTslUrls), .x509StoreCache = makeX509StoreCache()})}
     , mOcspCache{}
 {
 }
 
 
+std::shared_ptr<const TrustStore::Content> TrustStore::content() const
+{
+    return mContent.load();
+}
+
+
+void TrustStore::publish(std::shared_ptr<const Content> content)
+{
+    mContent.store(std::move(content));
+}
+
+
 TslMode TrustStore::getTslMode() const
 {
     return mMode;
@@ -152,13 +218,13 @@ TslMode TrustStore::getTslMode() const
 
 TrustStore::HealthData TrustStore::getHealthData() const
 {
-    std::lock_guard guard(mMutex);
-    return {.hasTsl = mTslStored,
-            .outdated = std::chrono::system_clock::now() >= mNextUpdate,
-            .hash = mTslHashValue,
-            .nextUpdate = mNextUpdate,
-            .id = mId,
-            .sequenceNumber = mSequenceNumber};
+    const auto current = content();
+    return {.hasTsl = current->tslStored,
+            .outdated = std::chrono::system_clock::now() >= current->nextUpdate,
+            .hash = current->tslHashValue,
+            .nextUpdate = current->nextUpdate,
+            .id = current->id,
+            .sequenceNumber = current->sequenceNumber};
 }
 
 
@@ -194,25 +260,23 @@ std::vector<X509Certificate> TrustStore::getTslSignerCas() const
 
 std::optional<std::string> TrustStore::getTslHashValue() const
 {
-    std::lock_guard guard(mMutex);
-    return mTslHashValue;
+    return content()->tslHashValue;
 }
 
 
 bool TrustStore::hasTsl() const
 {
-    std::lock_guard guard(mMutex);
-    return mTslStored;
+    return content()->tslStored;
 }
 
 
 std::optional<TrustStore::CaInfo> TrustStore::lookupCaCertificate (
     const X509Certificate& certificate) const
 {
-    std::lock_guard guard(mMutex);
+    const auto current = content();
 
-    auto it = mServiceInformationMap.find({certificate.getIssuer(), certificate.getAuthorityKeyIdentifier()});
-    if (it != mServiceInformationMap.end()
+    auto it = current->serviceInformationMap.find({certificate.getIssuer(), certificate.getAuthorityKeyIdentifier()});
+    if (it != current->serviceInformationMap.end()
         && certificate.getAuthorityKeyIdentifier() == it->second.certificate.getSubjectKeyIdentifier())
     {
         return TrustStore::CaInfo{it->second.certificate,
@@ -226,11 +290,11 @@ std::optional<TrustStore::CaInfo> TrustStore::lookupCaCertificate (
 
 bool TrustStore::hasCaCertificateWithSubject(const std::string& subjectDn) const
 {
-    std::lock_guard guard(mMutex);
+    const auto current = content();
 
     // this implementation is only used in error-handling scenarios,
     // and thus O(n) complexity looks to be OK
-    for (const auto& [id, data] : mServiceInformationMap) // NOLINT(readability-use-anyofallof)
+    for (const auto& [id, data] : current->serviceInformationMap) // NOLINT(readability-use-anyofallof)
     {
         (void)data;
         if (id.subject == subjectDn)
@@ -243,23 +307,14 @@ bool TrustStore::hasCaCertificateWithSubject(const std::string& subjectDn) const
 
 X509Store TrustStore::getX509Store(const std::optional<X509Certificate>& certificate) const
 {
-    std::lock_guard guard(mMutex);
+    const auto current = content();
 
-    if (mServiceInformationMap.empty())
+    if (current->serviceInformationMap.empty())
     {
         return X509Store();
     }
 
-    std::vector<X509Certificate> trustedCertificates;
-    for (const auto& [subject, serviceInformation] : mServiceInformationMap)
-    {
-        (void)subject;
-        if (isServiceAcceptable(serviceInformation.serviceAcceptanceHistory, certificate))
-        {
-            trustedCertificates.emplace_back(serviceInformation.certificate);
-        }
-    }
-    return X509Store(std::move(trustedCertificates));
+    return current->x509StoreCache->get(current->serviceInformationMap, certificate);
 }
 
 
@@ -268,111 +323,129 @@ X509Store TrustStore::getX509Store(const std::optional<X509Certificate>& certifi
 // GEMREQ-start A_17732
 void TrustStore::refillFromTsl(TslParser& tslParser)
 {
-    std::lock_guard guard(mMutex);
-
-    mId = tslParser.getId();
-    mSequenceNumber = tslParser.getSequenceNumber();
-    mNextUpdate = tslParser.getNextUpdate();
-    mUpdateUrls = tslParser.getUpdateUrls();
-    mBnaServiceInformation = tslParser.getBnaServiceInformation();
-    mServiceInformationMap = tslParser.getServiceInformationMap();
-
-    if (mMode == TslMode::TSL && !checkNewTslSignerCaIdList(tslParser, mServiceInformationMap))
+    // the new content is built without blocking the readers of the current one
+    auto next = std::make_shared<Content>();
+    next->tslHashValue = tslParser.getSha256();
+    next->id = tslParser.getId();
+    next->sequenceNumber = tslParser.getSequenceNumber();
+    next->nextUpdate = tslParser.getNextUpdate();
+    next->updateUrls = tslParser.getUpdateUrls();
+    next->bnaServiceInformation = tslParser.getBnaServiceInformation();
+    next->serviceInformationMap = tslParser.getServiceInformationMap();
+
+    if (mMode == TslMode::TSL && !checkNewTslSignerCaIdList(tslParser, next->serviceInformationMap))
     {
         // the problematic CAs related to TUC_PKI_013 should be removed
         for (const CertificateId& id : tslParser.getNewTslSignerCaIdList())
         {
-            mServiceInformationMap.erase(id);
+            next->serviceInformationMap.erase(id);
         }
     }
+    next->tslStored = true;
+    next->x509StoreCache = makeX509StoreCache();
 
-    mTslStored = true;
+    std::lock_guard lock(mUpdateMutex);
+    next->generation = content()->generation + 1;
+    publish(std::move(next));
 }
 // GEMREQ-end A_17732
 
 
 void TrustStore::setTslHashValue (const std::optional<std::string>& tslHashValue)
 {
-    std::lock_guard guard(mMutex);
-    mTslHashValue = tslHashValue;
+    update([&tslHashValue](Content& next) {
+        next.tslHashValue = tslHashValue;
+    });
 }
 
 
 std::optional<std::string> TrustStore::getIdOfTslInUse() const
 {
-    std::lock_guard guard(mMutex);
-    return mId;
+    return content()->id;
 }
 
 
 std::string TrustStore::getSequenceNumberOfTslInUse() const
 {
-    std::lock_guard guard(mMutex);
-    return mSequenceNumber;
+    return content()->sequenceNumber;
+}
+
+
+uint64_t TrustStore::getGeneration() const
+{
+    return content()->generation;
+}
+
+
+std::optional<uint64_t> TrustStore::getValidGeneration() const
+{
+    const auto current = content();
+    if (! current->tslStored || current->nextUpdate <= std::chrono::system_clock::now())
+    {
+        return std::nullopt;
+    }
+    return current->generation;
 }
 
 
 std::chrono::system_clock::time_point TrustStore::getNextUpdate() const
 {
-    std::lock_guard guard(mMutex);
-    return mNextUpdate;
+    return content()->nextUpdate;
 }
 
 
 std::vector<std::string> TrustStore::getUpdateUrls() const
 {
-    std::lock_guard guard(mMutex);
-    return mUpdateUrls;
+    return content()->updateUrls;
 }
 
 
 void TrustStore::setUpdateUrls(const std::vector<std::string>& updateUrls)
 {
-    std::lock_guard guard(mMutex);
-    mUpdateUrls = updateUrls;
+    update([&updateUrls](Content& next) {
+        next.updateUrls = updateUrls;
+    });
 }
 
 
 std::vector<std::string> TrustStore::getBnaUrls() const
 {
-    std::lock_guard guard(mMutex);
-    return mBnaServiceInformation.supplyPointList;
+    return content()->bnaServiceInformation.supplyPointList;
 }
 
 
 std::vector<X509Certificate> TrustStore::getBnaSignerCertificates() const
 {
-    std::lock_guard guard(mMutex);
-    return mBnaServiceInformation.signerCertificateList;
+    return content()->bnaServiceInformation.signerCertificateList;
 }
 
 
 std::unordered_map<std::string, std::string> TrustStore::getBnaOcspMapping() const
 {
-    std::lock_guard guard(mMutex);
-    return mBnaServiceInformation.ocspMapping;
+    return content()->bnaServiceInformation.ocspMapping;
 }
 
 
 void TrustStore::setBnaOcspMapping(std::unordered_map<std::string, std::string> ocspMapping)
 {
-    std::lock_guard guard(mMutex);
-    mBnaServiceInformation.ocspMapping = std::move(ocspMapping);
+    update([&ocspMapping](Content& next) {
+        next.bnaServiceInformation.ocspMapping = std::move(ocspMapping);
+    });
 }
 
 
 void TrustStore::distrustCertificates ()
 {
-    std::lock_guard guard(mMutex);
-
-    mServiceInformationMap.clear();
-    mBnaServiceInformation = {};
+    update([](Content& next) {
+        next.serviceInformationMap.clear();
+        next.bnaServiceInformation = {};
+        ++next.generation;
+    });
 }
 
 
 bool TrustStore::isTslTooOld () const
 {
-    std::lock_guard guard(mMutex);
     return getNextUpdate() <= std::chrono::system_clock::now();
 }
 
@@ -380,51 +453,26 @@ bool TrustStore::isTslTooOld () const
 void TrustStore::setCacheOcspData (const std::string& fingerprint, OcspResponse ocspCacheData)
 {
     ocspCacheData.fromCache = true;
-    std::lock_guard guard(mMutex);
-    mOcspCache.insert_or_assign(fingerprint, std::move(ocspCacheData));
+    mOcspCache.store(fingerprint, std::move(ocspCacheData));
 }
 
 
 void TrustStore::cleanCachedOcspData(const std::string& fingerprint)
 {
-     std::lock_guard guard(mMutex);
-
-    cleanupOcspCache();
     mOcspCache.erase(fingerprint);
 }
 
 
 std::optional<OcspResponse> TrustStore::getCachedOcspData (const std::string& fingerprint)
 {
-    std::lock_guard guard(mMutex);
-
-    cleanupOcspCache();
-
-    auto it = mOcspCache.find(fingerprint);
-    if (it != mOcspCache.end())
-    {
-        return it->second;
-    }
-
-    return {};
+    // entries older than their grace period are not returned (A_15873)
+    return mOcspCache.lookup(fingerprint);
 }
 
 
-void TrustStore::cleanupOcspCache ()
+OcspCache& TrustStore::getOcspCache()
 {
-    std::lock_guard guard(mMutex);
-
-    using namespace std::chrono;
-    const system_clock::time_point now = system_clock::now();
-
-    for (auto it = mOcspCache.begin(), ite = mOcspCache.end(); it != ite;)
-    {
-        const bool olderThanGracePeriod = ((now - it->second.producedAt) > it->second.gracePeriod);
-        if (olderThanGracePeriod)
-            it = mOcspCache.erase(it);
-        else
-            ++it;
-    }
+    return mOcspCache;
 }
 
 
@@ -439,10 +487,11 @@ bool TrustStore::isOcspResponderInTsl (
 bool TrustStore::isCertificateInTsl (
     const X509Certificate& certificate) const
 {
-    std::lock_guard guard(mMutex);
+    const auto current = content();
 
-    const auto it = mServiceInformationMap.find({certificate.getSubject(), certificate.getSubjectKeyIdentifier()});
-    return it != mServiceInformationMap.end() && it->second.certificate == certificate;
+    const auto it =
+        current->serviceInformationMap.find({certificate.getSubject(), certificate.getSubjectKeyIdentifier()});
+    return it != current->serviceInformationMap.end() && it->second.certificate == certificate;
 }
 
 
@@ -450,19 +499,21 @@ bool TrustStore::certificateHasTypeIdentifier (
     const X509Certificate& certificate,
     const std::string& typeIdentifier) const
 {
-    std::lock_guard guard(mMutex);
+    const auto current = content();
 
-    const auto it = mServiceInformationMap.find({certificate.getSubject(), certificate.getSubjectKeyIdentifier()});
-    return (it != mServiceInformationMap.end() && it->second.serviceIdentifier == typeIdentifier);
+    const auto it =
+        current->serviceInformationMap.find({certificate.getSubject(), certificate.getSubjectKeyIdentifier()});
+    return (it != current->serviceInformationMap.end() && it->second.serviceIdentifier == typeIdentifier);
 }
 
 
 std::optional<std::string> TrustStore::primaryOcspServiceUrlForCertificate(const X509Certificate& certificate)
 {
-    std::lock_guard guard(mMutex);
+    const auto current = content();
 
-    const auto itr = mServiceInformationMap.find({certificate.getSubject(), certificate.getSubjectKeyIdentifier()});
-    if (mServiceInformationMap.cend() != itr && !itr->second.serviceSupplyPointList.empty())
+    const auto itr =
+        current->serviceInformationMap.find({certificate.getSubject(), certificate.getSubjectKeyIdentifier()});
+    if (current->serviceInformationMap.cend() != itr && !itr->second.serviceSupplyPointList.empty())
     {
         return itr->second.serviceSupplyPointList.front();
     }
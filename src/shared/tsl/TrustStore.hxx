@@ -9,6 +9,7 @@
 #define ERP_PROCESSING_CONTEXT_TSL_TRUSTSTORE_HXX
 
 #include <boost/core/noncopyable.hpp>
+#include <atomic>
 #include <chrono>
 #include <map>
 #include <memory>
@@ -17,6 +18,7 @@
 #include <string>
 #include <vector>
 
+#include "shared/tsl/OcspCache.hxx"
 #include "shared/tsl/OcspResponse.hxx"
 #include "shared/tsl/TslMode.hxx"
 #include "shared/tsl/TslParser.hxx"
@@ -25,6 +27,14 @@
 #include "shared/crypto/OpenSsl.hxx"
 
 
+/**
+ * Trusted CA certificates and related data from the last TSL or BNetzA-VL.
+ *
+ * The content is immutable once published. A refresh builds the new content completely beside the current
+ * one and publishes it with an atomic pointer swap, so readers never wait for a refresh and always see the
+ * data of a single TSL. Writers are serialized among each other.
+ * The OCSP cache is not part of the published content and is carried over to the new content.
+ */
 class TrustStore
     : private boost::noncopyable
 {
@@ -63,7 +73,8 @@ public:
     /**
      * Refills the trust store from a TslParser.
      *
-     * Will remove all stored CA certificates from the store.
+     * Will remove all stored CA certificates from the store. The hash value of the TSL is taken over from the
+     * parser and published together with the certificates.
      */
     void refillFromTsl(TslParser& tslParser);
 
@@ -84,6 +95,9 @@ public:
      * Depending from certificate starting validity date the set of trusted CAs could differ.
      *
      * If the trust store is not initialized the X509 trust store is just empty.
+     *
+     * The stores are built once per set of trusted CAs of the published content and shared by all callers
+     * until the next update of the certificates.
      */
     X509Store getX509Store(const std::optional<X509Certificate>& certificate) const;
 
@@ -95,6 +109,19 @@ public:
 
     std::string getSequenceNumberOfTslInUse() const;
 
+    /**
+     * Returns a number that changes whenever the set of trusted CA certificates changes,
+     * i.e. with each refill from a TSL and when the certificates are distrusted.
+     * Results that depend on the trusted CAs can be cached together with the generation.
+     */
+    uint64_t getGeneration() const;
+
+    /**
+     * Returns the generation if a TSL is stored and it is not too old, otherwise nullopt.
+     * Both are read from the same published content.
+     */
+    std::optional<uint64_t> getValidGeneration() const;
+
     std::chrono::system_clock::time_point getNextUpdate() const;
 
     /**
@@ -149,6 +176,11 @@ public:
      */
     std::optional<OcspResponse> getCachedOcspData (const std::string& fingerprint);
 
+    /**
+     * Returns the OCSP response cache, it is guarded by own locks and not by the trust store mutex.
+     */
+    OcspCache& getOcspCache();
+
 
     /**
      * get OCSP service endpoint uri for a certificate CA.
@@ -158,37 +190,61 @@ public:
     std::optional<std::string> primaryOcspServiceUrlForCertificate(const X509Certificate& certificate);
 
 private:
-    mutable std::recursive_mutex mMutex;
+    /// X509 stores built from the service information map of one content, keyed by the accepted services
+    class X509StoreCache;
 
-    const TslMode mMode;
+    struct Content
+    {
+        bool tslStored{false};
+        std::optional<std::string> tslHashValue;
+        std::optional<std::string> id;
+        std::string sequenceNumber;
+        uint64_t generation{0};
+        std::chrono::system_clock::time_point nextUpdate;
+        std::vector<std::string> updateUrls;
 
-    bool mTslStored{false};
-    std::optional<std::string> mTslHashValue;
-    std::optional<std::string> mId;
-    std::string mSequenceNumber;
-    std::chrono::system_clock::time_point mNextUpdate;
-    std::chrono::system_clock::time_point mLastUpdateCheck;
-    std::vector<std::string> mUpdateUrls;
+        /// BNetzA-VL ServiceInformation from original TSL
+        TslParser::BnaServiceInformation bnaServiceInformation;
 
-    /// BNetzA-VL ServiceInformation from original TSL
-    TslParser::BnaServiceInformation mBnaServiceInformation;
+        /// {subjectDN, subjectKeyIdentifier} -> TSL service information
+        TslParser::ServiceInformationMap serviceInformationMap;
 
-    /// {subjectDN, subjectKeyIdentifier} -> TSL service information
-    TslParser::ServiceInformationMap mServiceInformationMap;
+        /// shared by copies of the content and replaced whenever serviceInformationMap changes
+        std::shared_ptr<X509StoreCache> x509StoreCache;
+    };
 
-    /// fingerprint -> OcspCacheData
-    std::map<std::string, OcspResponse> mOcspCache;
+    /**
+     * Returns the currently published content, it stays valid and unchanged while it is held.
+     */
+    std::shared_ptr<const Content> content() const;
 
     /**
-     * Removes cached OcspService results if they are older than 4 hours. (A_15873)
+     * Copies the current content, lets `modify` change the copy and publishes it.
+     * The copy gets a new X509 store cache, as `modify` may change the trusted CAs.
      */
-    void cleanupOcspCache ();
+    template<class Modify>
+    void update(Modify&& modify);
+
+    static std::shared_ptr<X509StoreCache> makeX509StoreCache();
+
+    void publish(std::shared_ptr<const Content> content);
+
+    /// serializes the writers, readers do not lock
+    std::mutex mUpdateMutex;
+
+    const TslMode mMode;
+
+    std::atomic<std::shared_ptr<const Content>> mContent;
+
+    /// fingerprint -> OcspCacheData
+    OcspCache mOcspCache;
 
     // Make private methods available to gtest.
 #ifdef FRIEND_TEST
 
     FRIEND_TEST(TrustStoreTest, TrustStoreInitallyIsEmpty);
     FRIEND_TEST(TrustStoreTest, DISABLED_MultipleNewCATslXmlIsParsedCorrectly);
+    FRIEND_TEST(TrustStoreTest, publishedContentIsNotChanged);
     FRIEND_TEST(TslServiceTest, providedTsl);
     FRIEND_TEST(TslServiceTest, verifyCertificateRevokedCAFailing);
     FRIEND_TEST(TslServiceTest, verifyCertificateValidThenRevokedCASuccess);
@@ -207,4 +263,15 @@ private:
 #endif
 };
 
+
+template<class Modify>
+void TrustStore::update(Modify&& modify)
+{
+    std::lock_guard lock(mUpdateMutex);
+    auto next = std::make_shared<Content>(*content());
+    std::forward<Modify>(modify)(*next);
+    next->x509StoreCache = makeX509StoreCache();
+    publish(std::move(next));
+}
+
 #endif
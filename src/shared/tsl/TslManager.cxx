@@ -16,6 +16,7 @@
 #include "shared/util/Configuration.hxx"
 #include "shared/util/Expect.hxx"
 #include "shared/util/FileHelper.hxx"
+#include "shared/util/MetricsRegistry.hxx"
 
 #if WITH_HSM_MOCK > 0
 #include "mock/tsl/MockTslManager.hxx"
@@ -29,6 +30,13 @@ namespace
     }
 
 
+    std::chrono::system_clock::duration getVerifiedCertificateCacheMaxAge()
+    {
+        return std::chrono::seconds{Configuration::instance().getOptionalIntValue(
+            ConfigurationKey::TSL_VERIFIED_CERTIFICATE_CACHE_MAX_AGE, 0)};
+    }
+
+
     [[noreturn]]
     void handleException(std::exception_ptr exception,
                          const char* logPrefix,
@@ -112,6 +120,8 @@ std::shared_ptr<TslManager> TslManager::setupTslManager(const std::shared_ptr<Xm
                 Configuration::instance().getIntValue(ConfigurationKey::HTTPCLIENT_CONNECT_TIMEOUT_SECONDS)},
             std::chrono::milliseconds{
                 Configuration::instance().getIntValue(ConfigurationKey::HTTPCLIENT_RESOLVE_TIMEOUT_MILLISECONDS)});
+        requestSender->setConnectionReuse(std::chrono::seconds{
+            Configuration::instance().getOptionalIntValue(ConfigurationKey::HTTPCLIENT_KEEP_ALIVE_IDLE_SECONDS, 0)});
         return std::make_shared<TslManager>(std::move(requestSender), xmlValidator);
     }
     catch (const TslError& e)
@@ -137,6 +147,7 @@ TslManager::TslManager(
     , mBnaTrustStore(std::make_unique<TrustStore>(TslMode::BNA))
     , mUpdateHookMutex()
     , mPostUpdateHooks(initialPostUpdateHooks)
+    , mVerifiedCertificateCache(getVerifiedCertificateCacheMaxAge())
 {
     try
     {
@@ -166,6 +177,7 @@ TslManager::TslManager(
     , mBnaTrustStore(std::move(bnaTrustStore))
     , mUpdateHookMutex()
     , mPostUpdateHooks(initialPostUpdateHooks)
+    , mVerifiedCertificateCache(getVerifiedCertificateCacheMaxAge())
 {
     // this is a protected constructor that is only intended to be used for testing purposes
     try
@@ -230,7 +242,8 @@ void TslManager::verifyCertificate(const TslMode tslMode,
             typeRestrictions,
             *mRequestSender,
             getTrustStore(tslMode),
-            ocspCheckDescriptor);
+            ocspCheckDescriptor,
+            &mVerifiedCertificateCache);
     }
     catch(const TslError& e)
     {
@@ -302,6 +315,31 @@ void TslManager::updateTrustStoresOnDemand()
 }
 
 
+void TslManager::refreshOcspResponses()
+{
+    for (const auto tslMode : {TslMode::TSL, TslMode::BNA})
+    {
+        auto& trustStore = getTrustStore(tslMode);
+        trustStore.getOcspCache().removeExpired();
+        for (const auto& candidate : trustStore.getOcspCache().getRefreshCandidates())
+        {
+            bool success = false;
+            try
+            {
+                TslService::refreshOcspResponse(candidate.context, *mRequestSender, trustStore, candidate.gracePeriod);
+                success = true;
+            }
+            catch (const std::exception& e)
+            {
+                TLOG(WARNING) << "Can not refresh OCSP response for certificate " << candidate.fingerprint << ": "
+                              << e.what();
+            }
+            MetricsRegistry::instance().countCacheRefresh("ocsp", success);
+        }
+    }
+}
+
+
 size_t TslManager::addPostUpdateHook (const PostUpdateHook& postUpdateHook)
 {
     std::lock_guard lock (mUpdateHookMutex);
@@ -320,6 +358,12 @@ void TslManager::disablePostUpdateHook(const size_t hookId)
 }
 
 
+std::optional<uint64_t> TslManager::getValidTrustStoreGeneration(const TslMode tslMode)
+{
+    return getTrustStore(tslMode).getValidGeneration();
+}
+
+
 TrustStore::HealthData TslManager::healthCheckTsl() const
 {
     return mTslTrustStore->getHealthData();
@@ -393,6 +437,8 @@ TslService::UpdateResult TslManager::internalUpdate(const bool onlyOutdated)
 
     if (updateResult == TslService::UpdateResult::Updated)
     {
+        // entries of an older trust store generation are not used anyway, drop them early
+        mVerifiedCertificateCache.clear();
         notifyPostUpdateHooks();
     }
 
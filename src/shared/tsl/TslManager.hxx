@@ -14,6 +14,7 @@
 #include "shared/tsl/TrustStore.hxx"
 #include "shared/tsl/TslMode.hxx"
 #include "shared/tsl/TslService.hxx"
+#include "shared/tsl/VerifiedCertificateCache.hxx"
 #include "shared/validation/XmlValidator.hxx"
 
 class X509Store;
@@ -63,6 +64,7 @@ public:
      * This implementation checks whether the current tsl information is up to date,
      * downloads the new version of tsl file if necessary and validates it,
      * and does verification including OCSP-Validation of the provided certificate.
+     * Successful chain validations are cached per trust store generation, the OCSP check is done on each call.
      *
      * @param tslMode                   specifies which trust store should be provided TSL or BNetzA-VL
      * @param certificate               the certificate to check
@@ -99,6 +101,14 @@ public:
      */
     virtual void updateTrustStoresOnDemand();
 
+    /**
+     * Requests new OCSP responses for cached responses that are close to the end of their grace period
+     * and removes expired responses from the caches. Until a refreshed response is received, the cached
+     * one is used as long as it is within its grace period.
+     * Failures are logged and do not influence the cached responses.
+     */
+    virtual void refreshOcspResponses();
+
     /**
      * Adds a callback that is called after a successful TSL update.
      * The order of called callbacks is not guarantied.
@@ -124,6 +134,14 @@ public:
      */
     void disablePostUpdateHook(const size_t hookId);
 
+    /**
+     * Returns the generation of the specified trust store, see TrustStore::getGeneration(),
+     * or std::nullopt if it has no TSL or its TSL is too old.
+     * A result obtained with a trust store generation can be reused without a new TSL validity check
+     * as long as this method returns the same generation.
+     */
+    std::optional<uint64_t> getValidTrustStoreGeneration(const TslMode tslMode);
+
     virtual TrustStore::HealthData healthCheckTsl() const;
     virtual TrustStore::HealthData healthCheckBna() const;
 
@@ -152,6 +170,8 @@ private:
     std::mutex mUpdateHookMutex; // Named mutex because at the moment it is used only to guard the mPostUpdateHook.
     std::vector<PostUpdateHook> mPostUpdateHooks;
 
+    VerifiedCertificateCache mVerifiedCertificateCache;
+
 #ifdef FRIEND_TEST
 
     friend class TslTestHelper;
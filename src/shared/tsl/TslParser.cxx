@@ -18,13 +18,16 @@
 #include "shared/util/String.hxx"
 #include "shared/validation/XmlValidator.hxx"
 #include "shared/xml/XmlDocument.hxx"
+#include "fhirtools/util/Gsl.hxx"
 #include "fhirtools/util/XmlHelper.hxx"
 
 #include <libxml/tree.h>
+#include <libxml/xmlreader.h>
 #include <libxml/xpath.h>
 #include <libxml/xpathInternals.h>
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <mutex>// for call_once
 #include <sstream>
 #include <stdexcept>
@@ -861,6 +864,61 @@ TslParser::TslParser(const std::string& tslXml, const TslMode tslMode, const Xml
 }
 
 
+std::optional<TslParser::Identity> TslParser::peekIdentity(const std::string& tslXml)
+{
+    static constexpr std::string_view tslNamespace = "http://uri.etsi.org/02231/v2#";
+    std::unique_ptr<xmlTextReader, decltype(&xmlFreeTextReader)> reader{
+        xmlReaderForMemory(tslXml.data(), gsl::narrow<int>(tslXml.size()), nullptr, nullptr,
+                           XML_PARSE_NONET | XML_PARSE_NOERROR | XML_PARSE_NOWARNING),
+        &xmlFreeTextReader};
+    if (reader == nullptr)
+    {
+        return std::nullopt;
+    }
+    const auto isElement = [&reader](std::string_view localName) {
+        const auto* nodeLocalName = xmlTextReaderConstLocalName(reader.get());
+        const auto* nodeNamespace = xmlTextReaderConstNamespaceUri(reader.get());
+        return nodeLocalName != nullptr && nodeNamespace != nullptr &&
+               XmlStringView{nodeLocalName} == localName && XmlStringView{nodeNamespace} == tslNamespace;
+    };
+
+    Identity identity;
+    bool isRoot = true;
+    while (xmlTextReaderRead(reader.get()) == 1)
+    {
+        if (xmlTextReaderNodeType(reader.get()) != XML_READER_TYPE_ELEMENT)
+        {
+            continue;
+        }
+        if (isRoot)
+        {
+            if (! isElement("TrustServiceStatusList"))
+            {
+                return std::nullopt;
+            }
+            std::unique_ptr<xmlChar, void (*)(void*)> id{
+                xmlTextReaderGetAttribute(reader.get(), reinterpret_cast<const xmlChar*>("Id")), xmlFree};
+            if (id != nullptr)
+            {
+                identity.id.emplace(XmlStringView{id.get()});
+            }
+            isRoot = false;
+        }
+        else if (isElement("TSLSequenceNumber"))
+        {
+            std::unique_ptr<xmlChar, void (*)(void*)> text{xmlTextReaderReadString(reader.get()), xmlFree};
+            if (text == nullptr)
+            {
+                return std::nullopt;
+            }
+            identity.sequenceNumber = String::trim(std::string{XmlStringView{text.get()}});
+            return identity;
+        }
+    }
+    return std::nullopt;
+}
+
+
 const std::optional<std::string>& TslParser::getId() const
 {
     return mId;
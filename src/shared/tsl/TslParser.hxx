@@ -69,6 +69,21 @@ public:
 
     using ServiceInformationMap = std::unordered_map<CertificateId, ServiceInformation>;
 
+    class Identity
+    {
+    public:
+        std::optional<std::string> id;
+        std::string sequenceNumber;
+    };
+
+    /**
+     * Reads the id and the sequence number of a TSL with a streaming parser that stops at the sequence number.
+     * Neither the schema nor the signature are checked, therefore the result must only be used to skip
+     * the processing of a TSL that is already in use.
+     * Returns nullopt if the values can not be found.
+     */
+    static std::optional<Identity> peekIdentity(const std::string& tslXml);
+
     const std::optional<std::string>& getId() const;
 
     const std::string& getSequenceNumber() const;
@@ -15,6 +15,7 @@
 #include "shared/tsl/OcspUrl.hxx"
 #include "shared/tsl/TrustStore.hxx"
 #include "shared/tsl/TslParser.hxx"
+#include "shared/tsl/VerifiedCertificateCache.hxx"
 #include "shared/tsl/X509Certificate.hxx"
 #include "shared/tsl/error/TslError.hxx"
 #include "shared/util/Configuration.hxx"
@@ -721,6 +722,9 @@ namespace
             OcspService::getCurrentResponse(certificate, requestSender, ocspUrl, trustStore,
                                             hashExtensionMustBeValidated(certificateType), ocspCheckDescriptor);
         ocspResponse.checkStatus(trustStore, ocspCheckDescriptor. timeSettings.referenceTimePoint);
+        // allow the cached response to be refreshed in the background before it expires
+        trustStore.getOcspCache().setRefreshContext(certificate.getSha256FingerprintHex(),
+                                                    {certificate, certificateType, issueCertificate});
         return ocspResponse;
     }
     // GEMREQ-end A_22141#checkOcspStatusOfCertificate, A_20159-04#checkOcspStatusOfCertificate
@@ -982,6 +986,12 @@ TslService::refreshTslIfNecessary(
             TLOG(WARNING) << "Downloaded " << magic_enum::enum_name(trustStore.getTslMode())
                           << " has wrong hash. Expected: " << newHash.value_or("") << ", calculated: " << contentHash;
         }
+        if (trustStore.hasTsl() && trustStore.getTslHashValue() == contentHash)
+        {
+            TLOG(INFO) << "Downloaded " << magic_enum::enum_name(trustStore.getTslMode())
+                       << " is identical to the one in use, skipping its processing";
+            return std::nullopt;
+        }
 
         return attemptTslParsing(tslContent, xmlValidator, trustStore, expectedSignerCertificates);
     }
@@ -998,7 +1008,28 @@ TslService::attemptTslParsing (const std::string& tslXml,
                                TrustStore& trustStore,
                                const std::vector<X509Certificate>& expectedSignerCertificates = {})
 {
+    if (trustStore.hasTsl())
+    {
+        // Parsing, schema validation and signature verification of a multi megabyte TSL are expensive,
+        // a TSL with the id and sequence number of the one in use would be discarded below anyway.
+        const auto identity = TslParser::peekIdentity(tslXml);
+        if (identity.has_value() && identity->sequenceNumber == trustStore.getSequenceNumberOfTslInUse() &&
+            (trustStore.getTslMode() != TslMode::TSL || identity->id == trustStore.getIdOfTslInUse()))
+        {
+            TLOG(INFO) << "Downloaded " << magic_enum::enum_name(trustStore.getTslMode()) << " with sequence number "
+                       << identity->sequenceNumber << " is already in use, skipping its processing";
+            return std::nullopt;
+        }
+    }
+
+    const auto parseStart = std::chrono::steady_clock::now();
     TslParser tslParser{tslXml, trustStore.getTslMode(), xmlValidator};
+    TLOG(INFO) << "Parsed " << magic_enum::enum_name(trustStore.getTslMode()) << " with sequence number "
+               << tslParser.getSequenceNumber() << " (" << tslXml.size() << " bytes, "
+               << tslParser.getServiceInformationMap().size() << " services) in "
+               << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - parseStart)
+                      .count()
+               << "ms";
 
     checkSignerCertificate(tslParser.getSignerCertificate(),
                            trustStore,
@@ -1080,8 +1111,8 @@ TslService::UpdateResult TslService::triggerTslUpdateIfNecessary(
                         trustStore); // old trust store is provided here for cached data
                 }
 
+                // the hash value is published together with the new content of the trust store
                 refreshTrustStore(returnedTslParser, trustStore);
-                trustStore.setTslHashValue(returnedTslParser->getSha256());
                 updateResult = UpdateResult::Updated;
             }
         }
@@ -1200,14 +1231,44 @@ TslService::checkCertificate(
     const std::unordered_set<CertificateType>& typeRestrictions,
     const UrlRequestSender& requestSender,
     TrustStore& trustStore,
-    const OcspCheckDescriptor& ocspCheckDescriptor)
+    const OcspCheckDescriptor& ocspCheckDescriptor,
+    VerifiedCertificateCache* verifiedCertificateCache)
 {
     CertificateType certificateType; // NOLINT(cppcoreguidelines-init-variables)
     X509Certificate issuerCertificate;
+    std::optional<VerifiedCertificateCache::Entry> verifiedCertificate;
+    if (verifiedCertificateCache != nullptr)
+    {
+        verifiedCertificate = verifiedCertificateCache->lookup(certificate, trustStore);
+    }
     try
     {
-        std::tie(certificateType, issuerCertificate) =
-            checkCertificateWithoutOcspCheck(certificate, typeRestrictions, trustStore);
+        if (verifiedCertificate.has_value())
+        {
+            // The chain has been validated with the same trust store generation, only the checks that
+            // depend on the call or on the current time are repeated.
+            certificateType = verifiedCertificate->certificateType;
+            issuerCertificate = verifiedCertificate->issuerCertificate;
+            TslExpect(typeRestrictions.empty() || typeRestrictions.contains(certificateType),
+                      "Certificate of unexpected type " + to_string(certificateType) + " provided.",
+                      TslErrorCode::CERT_TYPE_MISMATCH);
+            TslExpect6(certificate.checkValidityPeriod(),
+                       "The certificate must be valid.",
+                       TslErrorCode::CERTIFICATE_NOT_VALID_TIME,
+                       trustStore.getTslMode(),
+                       trustStore.getIdOfTslInUse(),
+                       trustStore.getSequenceNumberOfTslInUse());
+        }
+        else
+        {
+            std::tie(certificateType, issuerCertificate) =
+                checkCertificateWithoutOcspCheck(certificate, typeRestrictions, trustStore);
+            if (verifiedCertificateCache != nullptr)
+            {
+                verifiedCertificateCache->store(certificate, trustStore, {certificateType, issuerCertificate},
+                                                ocspCheckDescriptor.timeSettings.gracePeriod);
+            }
+        }
     }
     catch(const std::exception&)
     {
@@ -1225,3 +1286,41 @@ TslService::checkCertificate(
         ocspCheckDescriptor);
 }
 // GEMREQ-end A_22141#checkCertificate, A_20159-04#checkCertificate
+
+
+void TslService::refreshOcspResponse(
+    const OcspCache::RefreshContext& refreshContext,
+    const UrlRequestSender& requestSender,
+    TrustStore& trustStore,
+    std::chrono::system_clock::duration gracePeriod)
+{
+    const OcspCheckDescriptor ocspCheckDescriptor{
+        .mode = OcspCheckDescriptor::FORCE_OCSP_REQUEST_STRICT,
+        .timeSettings = {.referenceTimePoint = std::nullopt, .gracePeriod = gracePeriod},
+        .providedOcspResponse = {}};
+    // a successfully validated response is stored in the cache by the OCSP service
+    try
+    {
+        checkOcspStatusOfCertificate(refreshContext.certificate,
+                                     refreshContext.certificateType,
+                                     refreshContext.issuerCertificate,
+                                     requestSender,
+                                     trustStore,
+                                     ocspCheckDescriptor);
+    }
+    catch (const TslError& error)
+    {
+        // The OCSP responder no longer reports the certificate as good. An unknown status is not cached and a
+        // revoked one would keep the refresh context, so the previously cached good response is removed to make
+        // sure the next validation asks the OCSP responder again. Other errors, e.g. network problems,
+        // keep the cached response until its grace period is used up.
+        const auto& errorData = error.getErrorData();
+        if (std::ranges::any_of(errorData, [](const auto& data) {
+                return data.errorCode == TslErrorCode::CERT_REVOKED || data.errorCode == TslErrorCode::CERT_UNKNOWN;
+            }))
+        {
+            trustStore.cleanCachedOcspData(refreshContext.certificate.getSha256FingerprintHex());
+        }
+        throw;
+    }
+}
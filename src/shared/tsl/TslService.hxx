@@ -11,10 +11,12 @@
 #include "shared/crypto/OpenSslHelper.hxx"
 #include "shared/model/Timestamp.hxx"
 #include "shared/network/client/UrlRequestSender.hxx"
+#include "shared/tsl/OcspCache.hxx"
 #include "shared/tsl/OcspCheckDescriptor.hxx"
 #include "shared/tsl/X509Certificate.hxx"
 #include "shared/util/CertificateType.hxx"
 
+#include <chrono>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -29,6 +31,8 @@ class TslParser;
 
 class TrustStore;
 
+class VerifiedCertificateCache;
+
 class X509Certificate;
 
 class XmlValidator;
@@ -89,6 +93,9 @@ public:
      * @param trustStore                where to look for the certificate; may be updated
      *                                  during this call
      * @param ocspCheckDescriptor       describes the OCSP check approach to use
+     * @param verifiedCertificateCache  if provided, a cached chain validation result is used instead of
+     *                                  validating the certificate chain again and a successful
+     *                                  validation is stored there. The OCSP check is done in any case.
      *
      * @throws TslError                 in case of problems
      * @return OCSP-Response used to verify Certificate-Status
@@ -98,7 +105,26 @@ public:
         const std::unordered_set<CertificateType>& typeRestrictions,
         const UrlRequestSender& requestSender,
         TrustStore& trustStore,
-        const OcspCheckDescriptor& ocspCheckDescriptor);
+        const OcspCheckDescriptor& ocspCheckDescriptor,
+        VerifiedCertificateCache* verifiedCertificateCache = nullptr);
+
+    /**
+     * Sends a new OCSP request for a certificate that has already been checked and stores the received
+     * response in the OCSP cache of the trust store. Used to refresh cached responses before they expire.
+     * If the certificate is reported as revoked or unknown, the cached response is removed.
+     *
+     * @param refreshContext            the certificate, its type and issuer as used for the original check
+     * @param requestSender             used to send the OCSP status request
+     * @param trustStore                the trust store that holds the cached response
+     * @param gracePeriod               the OCSP grace period of the cached response
+     *
+     * @throws TslError                 in case of problems
+     */
+    static void refreshOcspResponse(
+        const OcspCache::RefreshContext& refreshContext,
+        const UrlRequestSender& requestSender,
+        TrustStore& trustStore,
+        std::chrono::system_clock::duration gracePeriod);
 
 
     /**
@@ -203,6 +229,8 @@ private:
     FRIEND_TEST(TslServiceTest, DownloadedNewHashValueIsNotEmpty);
     FRIEND_TEST(TslServiceTest, EmptyTruststoreIsUpdatedOnBoxEnv);
     FRIEND_TEST(TslServiceTest, DISABLED_EmptyTruststoreIsUpdatedOnDevEnv);
+    FRIEND_TEST(TslServiceTest, refreshSkipsTslIdenticalToTheOneInUse);
+    FRIEND_TEST(TslServiceTest, parsingSkipsTslWithIdAndSequenceNumberInUse);
     FRIEND_TEST(EnvironmentHealthCheckTests, InitialTslUpdate);
     FRIEND_TEST(EnvironmentHealthCheckTests, OcspRequestForInsurantCertificate);
     FRIEND_TEST(ConfigurableLoadTests, InitialTslUpdate);
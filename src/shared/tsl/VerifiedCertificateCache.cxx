@@ -0,0 +1,109 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/tsl/VerifiedCertificateCache.hxx"
+#include "shared/tsl/TrustStore.hxx"
+#include "shared/util/MetricsRegistry.hxx"
+#include "shared/util/TLog.hxx"
+
+#include <algorithm>
+
+
+namespace
+{
+    constexpr auto metricsName = "verified_certificate";
+}
+
+
+VerifiedCertificateCache::VerifiedCertificateCache(std::chrono::system_clock::duration maxAge, size_t maxEntries)
+    : mMaxAge(maxAge)
+    , mMaxEntries(maxEntries)
+{
+}
+
+
+std::optional<VerifiedCertificateCache::Entry>
+VerifiedCertificateCache::lookup(const X509Certificate& certificate, const TrustStore& trustStore)
+{
+    if (mMaxAge <= std::chrono::system_clock::duration::zero())
+    {
+        return std::nullopt;
+    }
+
+    const auto key = std::make_tuple(trustStore.getTslMode(), certificate.getSha256FingerprintHex());
+    const auto generation = trustStore.getGeneration();
+    const auto now = std::chrono::system_clock::now();
+
+    std::optional<Entry> result;
+    {
+        std::lock_guard lock(mMutex);
+        const auto candidate = mEntries.find(key);
+        if (candidate != mEntries.end())
+        {
+            if (candidate->second.trustStoreGeneration == generation && candidate->second.validUntil > now)
+            {
+                result = candidate->second.entry;
+            }
+            else
+            {
+                mEntries.erase(candidate);
+            }
+        }
+    }
+
+    MetricsRegistry::instance().countCacheLookup(metricsName, result.has_value());
+    return result;
+}
+
+
+void VerifiedCertificateCache::store(const X509Certificate& certificate, const TrustStore& trustStore, Entry entry,
+                                     std::chrono::system_clock::duration gracePeriod)
+{
+    const auto lifetime = std::min(mMaxAge, gracePeriod);
+    if (lifetime <= std::chrono::system_clock::duration::zero())
+    {
+        return;
+    }
+
+    auto key = std::make_tuple(trustStore.getTslMode(), certificate.getSha256FingerprintHex());
+    const auto generation = trustStore.getGeneration();
+    const auto now = std::chrono::system_clock::now();
+
+    std::lock_guard lock(mMutex);
+    if (mEntries.size() >= mMaxEntries)
+    {
+        removeExpired(now);
+        if (mEntries.size() >= mMaxEntries)
+        {
+            TVLOG(1) << "verified certificate cache is full, clearing it";
+            mEntries.clear();
+        }
+    }
+    mEntries.insert_or_assign(std::move(key), StoredEntry{std::move(entry), generation, now + lifetime});
+}
+
+
+void VerifiedCertificateCache::clear()
+{
+    std::lock_guard lock(mMutex);
+    mEntries.clear();
+}
+
+
+size_t VerifiedCertificateCache::size() const
+{
+    std::lock_guard lock(mMutex);
+    return mEntries.size();
+}
+
+
+void VerifiedCertificateCache::removeExpired(std::chrono::system_clock::time_point now)
+{
+    std::erase_if(mEntries, [now](const auto& item) {
+        return item.second.validUntil <= now;
+    });
+}
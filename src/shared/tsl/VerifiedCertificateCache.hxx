@@ -0,0 +1,82 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#ifndef ERP_PROCESSING_CONTEXT_SRC_SHARED_TSL_VERIFIEDCERTIFICATECACHE_HXX
+#define ERP_PROCESSING_CONTEXT_SRC_SHARED_TSL_VERIFIEDCERTIFICATECACHE_HXX
+
+#include "shared/tsl/TslMode.hxx"
+#include "shared/tsl/X509Certificate.hxx"
+#include "shared/util/CertificateType.hxx"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+
+class TrustStore;
+
+/**
+ * Cache of successful chain validations of end entity certificates, i.e. the part of the certificate check
+ * that does not depend on the OCSP status.
+ *
+ * Entries are keyed by the SHA-256 fingerprint of the certificate and the TSL mode. An entry is only used as long
+ * as the generation of the trust store is the same as at the time of the validation and the entry has not expired.
+ * The lifetime of an entry is bounded by the configured maximum age and the OCSP grace period of the check that
+ * created it.
+ *
+ * Failed validations are never cached. The OCSP check is not covered by the cache and must be done for each use.
+ *
+ * The class is thread safe.
+ */
+class VerifiedCertificateCache
+{
+public:
+    static constexpr size_t defaultMaxEntries = 10000;
+
+    struct Entry
+    {
+        CertificateType certificateType;
+        X509Certificate issuerCertificate;
+    };
+
+    /**
+     * @param maxAge        upper bound for the lifetime of an entry, a value of zero disables the cache
+     * @param maxEntries    when this number of entries is reached, expired entries are removed and,
+     *                      if that does not help, the cache is cleared
+     */
+    explicit VerifiedCertificateCache(std::chrono::system_clock::duration maxAge,
+                                      size_t maxEntries = defaultMaxEntries);
+
+    std::optional<Entry> lookup(const X509Certificate& certificate, const TrustStore& trustStore);
+
+    void store(const X509Certificate& certificate, const TrustStore& trustStore, Entry entry,
+               std::chrono::system_clock::duration gracePeriod);
+
+    void clear();
+
+    size_t size() const;
+
+private:
+    struct StoredEntry
+    {
+        Entry entry;
+        uint64_t trustStoreGeneration;
+        std::chrono::system_clock::time_point validUntil;
+    };
+
+    void removeExpired(std::chrono::system_clock::time_point now);
+
+    const std::chrono::system_clock::duration mMaxAge;
+    const size_t mMaxEntries;
+    mutable std::mutex mMutex;
+    std::map<std::tuple<TslMode, std::string>, StoredEntry> mEntries;
+};
+
+
+#endif
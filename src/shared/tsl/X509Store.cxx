@@ -19,19 +19,22 @@ X509Store::X509Store()
 
 X509Store::X509Store(std::vector<X509Certificate> certificates)
     : mX509Store(X509_STORE_new(), X509_STORE_free)
-    , mStoredCertificates(std::move(certificates))
+    , mStoredCertificates(std::make_shared<const std::vector<X509Certificate>>(std::move(certificates)))
 {
     Expect(mX509Store != nullptr, "can not create X509_STORE object");
-    for (X509Certificate& certificate : mStoredCertificates)
+    for (const X509Certificate& certificate : *mStoredCertificates)
     {
-        Expect(1 == X509_STORE_add_cert(mX509Store.get(), certificate.getX509Ptr()),
+        // X509_STORE_add_cert only increments the reference count of the certificate
+        Expect(1 == X509_STORE_add_cert(mX509Store.get(),
+                                        const_cast<X509*>(certificate.getX509ConstPtr())),// NOLINT(cppcoreguidelines-pro-type-const-cast)
                "can not add certificate to X509_STORE");
     }
 }
 
 const std::vector<X509Certificate>& X509Store::getStoredCertificates() const
 {
-    return mStoredCertificates;
+    static const std::vector<X509Certificate> noCertificates;
+    return mStoredCertificates != nullptr ? *mStoredCertificates : noCertificates;
 }
 
 X509_STORE* X509Store::getStore() const
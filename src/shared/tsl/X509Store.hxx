@@ -12,6 +12,12 @@
 
 #include <memory>
 
+/**
+ * An X509_STORE with trusted certificates.
+ *
+ * The store and the certificates are shared between copies, the store must therefore not be modified
+ * after construction. Settings of a verification are made in its X509_STORE_CTX instead.
+ */
 class X509Store
 {
 public:
@@ -39,7 +45,7 @@ public:
 private:
     using X509StorePtr = std::shared_ptr<X509_STORE>;
     X509StorePtr mX509Store;
-    std::vector<X509Certificate> mStoredCertificates;
+    std::shared_ptr<const std::vector<X509Certificate>> mStoredCertificates;
 };
 
 
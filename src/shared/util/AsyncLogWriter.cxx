@@ -0,0 +1,291 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/util/AsyncLogWriter.hxx"
+#include "shared/util/MetricsRegistry.hxx"
+#include "shared/util/TLog.hxx"
+
+#include <algorithm>
+
+
+struct AsyncLogRecord
+{
+    google::LogSeverity severity{google::GLOG_INFO};
+    const char* file{nullptr};
+    int line{0};
+    std::string text;
+};
+
+/**
+ * Single-producer/single-consumer ring buffer. The producer is the thread that owns the buffer, the consumer is the
+ * writer thread.
+ */
+class AsyncLogRingBuffer
+{
+public:
+    explicit AsyncLogRingBuffer(size_t capacity)
+        : mRecords(std::max<size_t>(capacity, 1))
+    {
+    }
+
+    bool push(AsyncLogRecord&& record)
+    {
+        const auto tail = mTail.load(std::memory_order_relaxed);
+        if (tail - mHead.load(std::memory_order_acquire) >= mRecords.size())
+        {
+            return false;
+        }
+        mRecords[tail % mRecords.size()] = std::move(record);
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    void drain(std::vector<AsyncLogRecord>& records)
+    {
+        const auto head = mHead.load(std::memory_order_relaxed);
+        const auto tail = mTail.load(std::memory_order_acquire);
+        for (auto index = head; index != tail; ++index)
+        {
+            records.emplace_back(std::move(mRecords[index % mRecords.size()]));
+        }
+        mHead.store(tail, std::memory_order_release);
+    }
+
+    /// Marks the begin and end of a write by the owning thread, see AsyncLogWriter::write and AsyncLogWriter::stop.
+    void setWriting(bool writing)
+    {
+        mWriting.store(writing, std::memory_order_seq_cst);
+    }
+
+    bool isWriting() const
+    {
+        return mWriting.load(std::memory_order_seq_cst);
+    }
+
+    bool empty() const
+    {
+        return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire);
+    }
+
+    /// called when the owning thread ends, the buffer is removed once it has been drained
+    void release()
+    {
+        mReleased.store(true, std::memory_order_release);
+    }
+
+    bool isReleased() const
+    {
+        return mReleased.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<AsyncLogRecord> mRecords;
+    alignas(64) std::atomic<uint64_t> mHead{0};
+    alignas(64) std::atomic<uint64_t> mTail{0};
+    std::atomic_bool mReleased{false};
+    std::atomic_bool mWriting{false};
+};
+
+
+namespace
+{
+struct ThreadRingBufferHolder {
+    ThreadRingBufferHolder() = default;
+    ThreadRingBufferHolder(const ThreadRingBufferHolder&) = delete;
+    ThreadRingBufferHolder& operator=(const ThreadRingBufferHolder&) = delete;
+    ~ThreadRingBufferHolder()
+    {
+        if (ringBuffer)
+        {
+            ringBuffer->release();
+        }
+    }
+    std::shared_ptr<AsyncLogRingBuffer> ringBuffer;
+};
+thread_local ThreadRingBufferHolder threadRingBufferHolder;
+
+void writeRecord(const AsyncLogRecord& record)
+{
+    google::LogMessage logMessage{record.file, record.line, record.severity};
+    logMessage.stream() << record.text;
+}
+}
+
+
+AsyncLogWriter& AsyncLogWriter::instance()
+{
+    static AsyncLogWriter theInstance;
+    return theInstance;
+}
+
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    stop();
+}
+
+
+void AsyncLogWriter::start(size_t capacityPerThread)
+{
+    std::lock_guard lock{mMutex};
+    if (mWriterThread.joinable())
+    {
+        return;
+    }
+    mCapacityPerThread = capacityPerThread;
+    mStopRequested = false;
+    mWriterThread = std::thread{[this] {
+        run();
+    }};
+    mRunning.store(true, std::memory_order_release);
+}
+
+
+void AsyncLogWriter::stop()
+{
+    std::thread writerThread;
+    {
+        std::lock_guard lock{mMutex};
+        if (! mWriterThread.joinable())
+        {
+            return;
+        }
+        // new records are written synchronously from now on
+        mRunning.store(false, std::memory_order_seq_cst);
+        mStopRequested = true;
+        writerThread = std::move(mWriterThread);
+    }
+    mWakeUp.notify_all();
+    writerThread.join();
+    waitForActiveWrites();
+    // records that have been added while the writer thread was finishing
+    writePending();
+}
+
+
+bool AsyncLogWriter::isRunning() const
+{
+    return mRunning.load(std::memory_order_acquire);
+}
+
+
+void AsyncLogWriter::write(google::LogSeverity severity, const char* file, int line, std::string&& text)
+{
+    AsyncLogRecord record{.severity = severity, .file = file, .line = line, .text = std::move(text)};
+    if (! isRunning())
+    {
+        writeRecord(record);
+        return;
+    }
+    auto& ringBuffer = threadRingBuffer();
+    // The writing flag and mRunning are both accessed sequentially consistent: either the running state is still
+    // seen here and stop() waits for the flag to be cleared before the final drain, or stop() has already cleared
+    // mRunning and the record is written synchronously. Without it a record pushed after the final drain would
+    // never be written.
+    ringBuffer.setWriting(true);
+    if (! mRunning.load(std::memory_order_seq_cst))
+    {
+        ringBuffer.setWriting(false);
+        writeRecord(record);
+        return;
+    }
+    if (! ringBuffer.push(std::move(record)))
+    {
+        mDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+    }
+    ringBuffer.setWriting(false);
+}
+
+
+uint64_t AsyncLogWriter::droppedRecords() const
+{
+    return mDroppedRecords.load(std::memory_order_relaxed);
+}
+
+
+AsyncLogRingBuffer& AsyncLogWriter::threadRingBuffer()
+{
+    auto& ringBuffer = threadRingBufferHolder.ringBuffer;
+    if (! ringBuffer)
+    {
+        std::lock_guard lock{mMutex};
+        ringBuffer = std::make_shared<AsyncLogRingBuffer>(mCapacityPerThread);
+        mRingBuffers.emplace_back(ringBuffer);
+    }
+    return *ringBuffer;
+}
+
+
+void AsyncLogWriter::run()
+{
+    ThreadNames::instance().setCurrentThreadName("async-log-writer");
+    std::unique_lock lock{mMutex};
+    while (! mStopRequested)
+    {
+        mWakeUp.wait_for(lock, flushInterval, [this] {
+            return mStopRequested;
+        });
+        lock.unlock();
+        writePending();
+        lock.lock();
+    }
+}
+
+
+void AsyncLogWriter::waitForActiveWrites()
+{
+    std::vector<std::shared_ptr<AsyncLogRingBuffer>> ringBuffers;
+    {
+        std::lock_guard lock{mMutex};
+        ringBuffers = mRingBuffers;
+    }
+    for (const auto& ringBuffer : ringBuffers)
+    {
+        while (ringBuffer->isWriting())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+
+void AsyncLogWriter::writePending()
+{
+    std::vector<std::shared_ptr<AsyncLogRingBuffer>> ringBuffers;
+    {
+        std::lock_guard lock{mMutex};
+        // buffers of threads that have ended are removed once they are drained; a released buffer receives no more
+        // records, so it has to be checked before emptiness
+        std::erase_if(mRingBuffers, [](const auto& ringBuffer) {
+            return ringBuffer->isReleased() && ringBuffer->empty();
+        });
+        ringBuffers = mRingBuffers;
+    }
+    std::vector<AsyncLogRecord> batch;
+    for (const auto& ringBuffer : ringBuffers)
+    {
+        ringBuffer->drain(batch);
+    }
+    for (const auto& record : batch)
+    {
+        writeRecord(record);
+    }
+    reportDroppedRecords();
+}
+
+
+void AsyncLogWriter::reportDroppedRecords()
+{
+    const auto droppedRecords = mDroppedRecords.load(std::memory_order_relaxed);
+    if (droppedRecords > mReportedDroppedRecords)
+    {
+        const auto newlyDropped = droppedRecords - mReportedDroppedRecords;
+        mReportedDroppedRecords = droppedRecords;
+        TLOG(WARNING) << "asynchronous log writer dropped " << newlyDropped << " records, buffer was full";
+        MetricsRegistry::instance().countDroppedLogRecords(newlyDropped);
+    }
+}
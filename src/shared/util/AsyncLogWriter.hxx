@@ -0,0 +1,86 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#ifndef ERP_PROCESSING_CONTEXT_UTIL_ASYNCLOGWRITER_HXX
+#define ERP_PROCESSING_CONTEXT_UTIL_ASYNCLOGWRITER_HXX
+
+#include "shared/util/GLog.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class AsyncLogRingBuffer;
+
+/**
+ * Hands log records to a dedicated writer thread, so that request threads do not wait for the glog mutex and the
+ * write to the log file.
+ *
+ * Every thread that writes records gets its own fixed size single-producer/single-consumer ring buffer, adding a
+ * record is lock free. The writer thread wakes up every `flushInterval` and writes the records of all buffers as one
+ * batch. If the buffer of a thread is full, the record is dropped. Dropped records are counted, reported as a warning
+ * and in the `log_records_dropped_total` metric.
+ *
+ * As long as the writer is not started, and after it has been stopped, records are written synchronously. Records that
+ * are added concurrently to stop() are either written synchronously or by the final drain of stop(), none are lost.
+ * The writer is enabled with ERP_LOG_ASYNC, see GLogConfiguration.
+ */
+class AsyncLogWriter
+{
+public:
+    static constexpr size_t defaultCapacityPerThread = 4096;
+    static constexpr std::chrono::milliseconds flushInterval{10};
+
+    static AsyncLogWriter& instance();
+
+    ~AsyncLogWriter();
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter(AsyncLogWriter&&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(AsyncLogWriter&&) = delete;
+
+    /// Starts the writer thread. Buffers that already exist keep their capacity.
+    void start(size_t capacityPerThread = defaultCapacityPerThread);
+
+    /// Writes all pending records and stops the writer thread.
+    void stop();
+
+    bool isRunning() const;
+
+    /// @p file must be a string literal or otherwise outlive the writer, usually __FILE__
+    void write(google::LogSeverity severity, const char* file, int line, std::string&& text);
+
+    uint64_t droppedRecords() const;
+
+private:
+    AsyncLogWriter() = default;
+
+    AsyncLogRingBuffer& threadRingBuffer();
+    void run();
+    void waitForActiveWrites();
+    void writePending();
+    void reportDroppedRecords();
+
+    std::atomic_bool mRunning{false};
+    std::atomic<uint64_t> mDroppedRecords{0};
+    uint64_t mReportedDroppedRecords{0};
+    size_t mCapacityPerThread{defaultCapacityPerThread};
+
+    std::mutex mMutex;
+    std::condition_variable mWakeUp;
+    bool mStopRequested{false};
+    std::vector<std::shared_ptr<AsyncLogRingBuffer>> mRingBuffers;
+    std::thread mWriterThread;
+};
+
+#endif// ERP_PROCESSING_CONTEXT_UTIL_ASYNCLOGWRITER_HXX
@@ -20,6 +20,7 @@
 #include "shared/util/String.hxx"
 #include "shared/validation/XmlValidator.hxx"
 
+#include <algorithm>
 #include <charconv>
 #include <regex>
 #include <stdexcept>
@@ -264,6 +265,16 @@ namespace {
             std::string(key.jsonPath));
     }
 
+    ExceptionWrapper<InvalidConfigurationException> createNotAnIntegerException(const KeyData key,
+                                                                                const std::string& value,
+                                                                                const FileNameAndLineNumber& location)
+    {
+        return ExceptionWrapper<InvalidConfigurationException>::create(location,
+            std::string("Configuration: can not convert '") + value + "' to integer",
+            std::string(key.environmentVariable),
+            std::string(key.jsonPath));
+    }
+
     uint16_t determineServerPort()
     {
         const auto portStr = Environment::get(ConfigurationBase::ServerPortEnvVar);
@@ -290,8 +301,20 @@ ConfigurationBase::ConfigurationBase (const std::vector<KeyData>& allKeyNames)
            std::string("Environment variable \"") + ServerHostEnvVar + "\" must be set.");
     mServerHost = serverHost.value();
 
+    for (const auto& keyNames : allKeyNames)
+    {
+        if (keyNames.index != KeyData::noIndex)
+        {
+            mSnapshotKeys.emplace_back(keyNames);
+            mSnapshotSize = std::max(mSnapshotSize, keyNames.index + 1);
+        }
+    }
+
     if (! mDocument.IsObject())
+    {
+        publishSnapshot();
         return;
+    }
 
     const auto* pathPrefix = "";
 
@@ -312,6 +335,8 @@ ConfigurationBase::ConfigurationBase (const std::vector<KeyData>& allKeyNames)
 
     lookupKey("", std::string{MedicationExporter::fhirResourceViews});
     lookupKey("", std::string{MedicationExporter::kbvSchluesseltabellen});
+
+    publishSnapshot();
 }
 
 const std::string& ConfigurationBase::serverHost() const
@@ -336,6 +361,71 @@ bool ConfigurationBase::lookupKey(const std::string& pathPrefix, const std::stri
     return false;
 }
 
+const ConfigurationSnapshot& ConfigurationBase::currentSnapshot() const
+{
+    const auto* snapshot = mCurrentSnapshot.load(std::memory_order_acquire);
+    if (snapshot->environmentGeneration() != Environment::generation())
+    {
+        return publishSnapshot();
+    }
+    return *snapshot;
+}
+
+const ConfigurationSnapshot& ConfigurationBase::publishSnapshot() const
+{
+    std::lock_guard lock{mSnapshotsMutex};
+    // another thread may have published an up-to-date snapshot while this one was waiting for the lock
+    const auto* current = mCurrentSnapshot.load(std::memory_order_acquire);
+    if (current != nullptr && current->environmentGeneration() == Environment::generation())
+    {
+        return *current;
+    }
+    const auto& snapshot = *mSnapshots.emplace_back(createSnapshot());
+    mCurrentSnapshot.store(&snapshot, std::memory_order_release);
+    // the current snapshot plus the replaced ones that are retained
+    while (mSnapshots.size() > retainedSnapshots + 1)
+    {
+        mSnapshots.pop_front();
+    }
+    return snapshot;
+}
+
+std::unique_ptr<const ConfigurationSnapshot> ConfigurationBase::createSnapshot() const
+{
+    // Read the generation first, so that modifications during the creation lead to another snapshot.
+    const auto generation = Environment::generation();
+    std::vector<ConfigurationSnapshot::Value> values(mSnapshotSize);
+    for (const auto& key : mSnapshotKeys)
+    {
+        values[key.index] = resolveSnapshotValue(key);
+    }
+    return std::make_unique<const ConfigurationSnapshot>(generation, std::move(values));
+}
+
+ConfigurationSnapshot::Value ConfigurationBase::resolveSnapshotValue(const KeyData& key) const
+{
+    if ((key.flags & KeyData::credential) != 0)
+    {
+        return {};
+    }
+    auto value = Environment::get(std::string{key.environmentVariable});
+    if (value)
+    {
+        return ConfigurationSnapshot::makeValue(std::move(value));
+    }
+    const auto* jsonValue = getJsonValue(key);
+    if (! jsonValue || jsonValue->IsNull())
+    {
+        return ConfigurationSnapshot::makeValue(std::nullopt);
+    }
+    if (jsonValue->IsString())
+    {
+        return ConfigurationSnapshot::makeValue(jsonValue->GetString());
+    }
+    // arrays and objects are read with dedicated getters, wrong usage is reported when the value is accessed
+    return {};
+}
+
 // -----------------------------------------------------------------------------------------------------
 
 OpsConfigKeyNames::OpsConfigKeyNames()
@@ -355,6 +445,7 @@ OpsConfigKeyNames::OpsConfigKeyNames()
     {ConfigurationKey::IDP_UPDATE_INTERVAL_MINUTES                    , {"ERP_IDP_UPDATE_INTERVAL_MINUTES"                    , "/erp/idp/updateIntervalMinutes", Flags::categoryFunctionalStatic, "Update interval for IDP Configuration/Certificate, when the IDP health is up"}},
     {ConfigurationKey::IDP_NO_VALID_CERTIFICATE_UPDATE_INTERVAL_SECONDS, {"ERP_IDP_NO_VALID_CERTIFICATE_UPDATE_INTERVAL_SECONDS", "/erp/idp/noValidCertificateUpdateIntervalSeconds", Flags::categoryFunctionalStatic, "Update interval for IDP Certificate, when the IDP health is down"}},
     {ConfigurationKey::IDP_SECONDARY_CERTIFICATE                      , {"ERP_IDP_SECONDARY_CERTIFICATE"                      , "/erp/idp/secondaryCertificate", Flags::categoryFunctionalStatic, "Secondary IDP certificate in case the validation using the certificate from well-known endpoint fails."}},
+    {ConfigurationKey::IDP_VERIFIED_TOKEN_CACHE_MAX_AGE_SECONDS       , {"ERP_IDP_VERIFIED_TOKEN_CACHE_MAX_AGE_SECONDS"       , "/erp/idp/verifiedTokenCacheMaxAgeSeconds", Flags::categoryFunctionalStatic, "Maximum time for which a successfully verified access token signature is reused, 0 disables the cache"}},
     {ConfigurationKey::OCSP_C_FD_SIG_ERP_GRACE_PERIOD                 , {"ERP_OCSP_C_FD_SIG_ERP_GRACE_PERIOD"                 , "/erp/ocsp/gracePeriodCFdSigErp", Flags::categoryFunctionalStatic, "OCSP grace period in seconds for OCSP-response of C.FD.OSIG-eRP signer certificate"}},
     {ConfigurationKey::OCSP_SMC_B_OSIG_GRACE_PERIOD                   , {"ERP_OCSP_SMC_B_OSIG_GRACE_PERIOD"                   , "/erp/ocsp/gracePeriodSmcBOsig", Flags::categoryFunctionalStatic, "OCSP Grace period in seconds for OCSP-response of SMC-B certificate from CAdES-BES packet provided in ChargeItem-Post/-Put request"}},
     {ConfigurationKey::OCSP_NON_QES_GRACE_PERIOD                      , {"ERP_OCSP_NON_QES_GRACE_PERIOD"                      , "/erp/ocsp/gracePeriodNonQes", Flags::categoryFunctionalStatic, "OCSP Grace period in seconds for OCSP-response of non-QES Certificates. According to A_20158 for IDP Certificate"}},
@@ -372,6 +463,11 @@ OpsConfigKeyNames::OpsConfigKeyNames()
     {ConfigurationKey::SERVICE_TASK_CLOSE_PRESCRIPTION_DIGEST_VERSION_ID,{"ERP_SERVICE_TASK_CLOSE_PRESCRIPTION_DIGEST_VERSION_ID", "/erp/service/task/close/prescriptionDigestMetaVersionId", Flags::categoryFunctional, "Value for Meta.versionId in Prescription-Digest Binary-Resource. If not provided, the field will not be included."}},
     {ConfigurationKey::SERVICE_TASK_GET_ENFORCE_HCV_CHECK             , {"ERP_SERVICE_TASK_GET_ENFORCE_HCV_CHECK"             , "/erp/service/task/get/enforceHcvCheck", Flags::categoryFunctional, "Enforce hcv check for pnv2"}},
     {ConfigurationKey::SERVICE_TASK_GET_RATE_LIMIT                    , {"ERP_SERVICE_TASK_GET_RATE_LIMIT"                    , "/erp/service/task/get/rateLimit", Flags::categoryFunctional, "Max. calls for a telematik ID within a day"}},
+    {ConfigurationKey::SERVICE_TASK_GET_KEYSET_PAGING                 , {"ERP_SERVICE_TASK_GET_KEYSET_PAGING"                 , "/erp/service/task/get/keysetPaging", Flags::categoryFunctional, "Use keyset paging (__seek) instead of __offset for GET /Task of insurants when sorted by a single date. Keyset paging only walks forward, bundles have no prev and last links"}},
+    {ConfigurationKey::SERVICE_AUDIT_EVENT_ASYNC_WRITE                , {"ERP_SERVICE_AUDIT_EVENT_ASYNC_WRITE"                , "/erp/service/auditEvent/asyncWrite", Flags::categoryFunctionalStatic, "Write audit events on a background thread after the request transaction has been committed. Queued audit events are lost if the process crashes"}},
+    {ConfigurationKey::SERVICE_AUDIT_EVENT_QUEUE_SIZE                 , {"ERP_SERVICE_AUDIT_EVENT_QUEUE_SIZE"                 , "/erp/service/auditEvent/queueSize", Flags::categoryFunctionalStatic, "Maximum number of audit events waiting to be written; requests fail when the queue is full"}},
+    {ConfigurationKey::SERVICE_AUDIT_EVENT_BATCH_SIZE                 , {"ERP_SERVICE_AUDIT_EVENT_BATCH_SIZE"                 , "/erp/service/auditEvent/batchSize", Flags::categoryFunctionalStatic, "Maximum number of audit events written in one transaction"}},
+    {ConfigurationKey::SERVICE_REQUEST_JSON_ARENA                     , {"ERP_SERVICE_REQUEST_JSON_ARENA"                     , "/erp/service/requestJsonArena", Flags::categoryFunctionalStatic, "Let all FHIR JSON documents of an inner request share one memory pool that is released at the end of the request"}},
     {ConfigurationKey::SERVICE_COMMUNICATION_MAX_MESSAGES             , {"ERP_SERVICE_COMMUNICATION_MAX_MESSAGES"             , "/erp/service/communication/maxMessageCount", Flags::categoryFunctional, "Maximum number of communication messages per task and representative"}},
     {ConfigurationKey::SERVICE_COMMUNICATION_PAYLOAD_V1_VALID_UNTIL   , {"ERP_SERVICE_COMMUNICATION_PAYLOAD_V1_VALID_UNTIL"   , "/erp/service/communication/payloadV1ValidUntil", Flags::categoryFunctional, "Last day of Communication Payload V1 validity"}},
     {ConfigurationKey::SERVICE_COMMUNICATION_PAYLOAD_V3_VALID_FROM    , {"ERP_SERVICE_COMMUNICATION_PAYLOAD_V3_VALID_FROM"    , "/erp/service/communication/payloadV3ValidFrom", Flags::categoryFunctional, "First day of Communication Payload V3 validity"}},
@@ -411,14 +507,20 @@ OpsConfigKeyNames::OpsConfigKeyNames()
     {ConfigurationKey::POSTGRES_RO_KEEPALIVES_COUNT                   , {"ERP_POSTGRES_RO_KEEPALIVES_COUNT"                   , "/erp/postgres/readOnly/keepalivesCount", Flags::categoryEnvironment, "Controls the number of TCP keepalives that can be lost before the client's connection to the read pnly Postgres server is considered dead. A value of zero uses the system default; defaults to value from main"}},
     {ConfigurationKey::POSTGRES_RO_TARGET_SESSION_ATTRS               , {"ERP_POSTGRES_RO_TARGET_SESSION_ATTRS"               , "/erp/postgres/readOnly/targetSessionAttrs", Flags::categoryEnvironment, "If this parameter is set to read-write, only a connection in which read-write transactions are accepted by default is considered acceptable. The query SHOW transaction_read_only will be sent upon any successful connection; if it returns on, the connection will be closed. If multiple hosts were specified in the connection string, any remaining servers will be tried just as if the connection attempt had failed. The default value of this parameter, any, regards all connections as acceptable. Defaults to value from main"}},
     {ConfigurationKey::POSTGRES_RO_CONNECTION_MAX_AGE_MINUTES         , {"ERP_POSTGRES_RO_CONNECTION_MAX_AGE_MINUTES"         , "/erp/postgres/readOnly/connectionMaxAgeMinutes", Flags::categoryEnvironment, "After this time the database connections to the read only Postgres server will be closed and re-opened. Defaults to value from main"}},
+    {ConfigurationKey::POSTGRES_DECODE_THREAD_COUNT                   , {"ERP_POSTGRES_DECODE_THREAD_COUNT"                   , "/erp/postgres/decodeThreadCount", Flags::categoryEnvironment, "Number of threads that help to decrypt and parse the rows of large database results, 0 decodes all rows on the request thread"}},
+    {ConfigurationKey::POSTGRES_DECODE_PARALLEL_THRESHOLD             , {"ERP_POSTGRES_DECODE_PARALLEL_THRESHOLD"             , "/erp/postgres/decodeParallelThreshold", Flags::categoryEnvironment, "Minimum number of rows of a database result before its rows are decoded in parallel"}},
     {ConfigurationKey::PUBLIC_E_PRESCRIPTION_SERVICE_URL              , {"ERP_E_PRESCRIPTION_SERVICE_URL"                     , "/erp/publicEPrescriptionServiceUrl", Flags::categoryEnvironment, "Used as basis for links in outgoing resources, e.g. fullUrl"}},
     {ConfigurationKey::REGISTRATION_HEARTBEAT_INTERVAL_SEC            , {"ERP_REGISTRATION_HEARTBEAT_INTERVAL_SEC"            , "/erp/registration/heartbeatIntervalSec", Flags::categoryEnvironment, "interval for the regular health check and registration status update."}},
+    {ConfigurationKey::HEALTH_CHECK_TIMEOUT_MS                        , {"ERP_HEALTH_CHECK_TIMEOUT_MS"                        , "/erp/healthCheck/timeoutMs", Flags::categoryEnvironment, "maximum time in milliseconds to wait for the health check of a single service before it is reported as down."}},
+    {ConfigurationKey::HEALTH_CHECK_CACHE_MAX_AGE_SEC                 , {"ERP_HEALTH_CHECK_CACHE_MAX_AGE_SEC"                 , "/erp/healthCheck/cacheMaxAgeSec", Flags::categoryEnvironment, "maximum age of the health check results returned by /health, older results are refreshed in the background. 0 runs the checks for every request."}},
     {ConfigurationKey::TSL_TI_OCSP_PROXY_URL                          , {"ERP_TSL_TI_OCSP_PROXY_URL"                          , "/erp/tsl/tiOcspProxyUrl", Flags::categoryEnvironment, "Special handling for G0 QES certificates for which no mapping exists in the TSL. In this case a special TI OCSP proxy should be used."}},
     {ConfigurationKey::TSL_INITIAL_DOWNLOAD_URL                       , {"ERP_TSL_INITIAL_DOWNLOAD_URL"                       , "/erp/tsl/initialDownloadUrl", Flags::categoryEnvironment, "The URL to download initial TSL from."}},
     {ConfigurationKey::TSL_INITIAL_CA_DER_PATH                        , {"ERP_TSL_INITIAL_CA_DER_PATH"                        , "/erp/tsl/initialCaDerPath", Flags::categoryEnvironment, "Path to the TSL-Signer CA."}},
     {ConfigurationKey::TSL_INITIAL_CA_DER_PATH_NEW                    , {"ERP_TSL_INITIAL_CA_DER_PATH_NEW"                    , "/erp/tsl/initialCaDerPathNew", Flags::categoryEnvironment, "Path to the additional TSL-Signer CA. It could be used when TSL-Signer CA is being changed to support both old and new TSL-Signer CA."}},
     {ConfigurationKey::TSL_INITIAL_CA_DER_PATH_NEW_START              , {"ERP_TSL_INITIAL_CA_DER_PATH_NEW_START"              , "/erp/tsl/initialCaDerPathStart", Flags::categoryEnvironment, "The timestamp in FHIR DateTime format https://www.hl7.org/fhir/datatypes.html#dateTime to use the additional TSL-Signer CA from. Using this variable the additional TSL-Signer CA can be configured before it is active."}},
     {ConfigurationKey::TSL_REFRESH_INTERVAL                           , {"ERP_TSL_REFRESH_INTERVAL"                           , "/erp/tsl/refreshInterval", Flags::categoryFunctional, "How often the TSL update should be tried."}},
+    {ConfigurationKey::TSL_VERIFIED_CERTIFICATE_CACHE_MAX_AGE         , {"ERP_TSL_VERIFIED_CERTIFICATE_CACHE_MAX_AGE"         , "/erp/tsl/verifiedCertificateCacheMaxAge", Flags::categoryFunctional, "Maximum age in seconds of a cached certificate chain validation. The OCSP grace period of the check limits it further. 0 disables the cache."}},
+    {ConfigurationKey::TSL_OCSP_REFRESH_INTERVAL                      , {"ERP_TSL_OCSP_REFRESH_INTERVAL"                      , "/erp/tsl/ocspRefreshInterval", Flags::categoryFunctional, "Interval in seconds for refreshing cached OCSP responses before the end of their grace period. 0 disables the refresh."}},
     {ConfigurationKey::TSL_DOWNLOAD_CIPHERS                           , {"ERP_TSL_DOWNLOAD_CIPHERS"                           , "/erp/tsl/downloadCiphers", Flags::categoryFunctionalStatic, "Specifies ciphers to be used for TSL download if set."}},
     {ConfigurationKey::JSON_META_SCHEMA                               , {"ERP_JSON_META_SCHEMA"                               , "/erp/json-meta-schema", Flags::categoryFunctionalStatic, "Path to JSON meta-schema for json schema validation"}},
     {ConfigurationKey::JSON_SCHEMA                                    , {"ERP_JSON_SCHEMA"                                    , "/erp/json-schema", Flags::categoryFunctionalStatic|Flags::array, "List of JSON schemas"}},
@@ -473,6 +575,7 @@ OpsConfigKeyNames::OpsConfigKeyNames()
     {ConfigurationKey::ZSTD_DICTIONARY_DIR                            , {"ERP_ZSTD_DICTIONARY_DIR"                            , "/erp/compression/zstd/dictionary-dir", Flags::categoryFunctionalStatic, "Path to the compression dictionary for database compression."}},
     {ConfigurationKey::HTTPCLIENT_CONNECT_TIMEOUT_SECONDS             , {"ERP_HTTPCLIENT_CONNECT_TIMEOUT_SECONDS"             , "/erp/httpClientConnectTimeoutSeconds", Flags::categoryEnvironment, "Connection timeout for outgoing tcp connections"}},
     {ConfigurationKey::HTTPCLIENT_RESOLVE_TIMEOUT_MILLISECONDS        , {"ERP_HTTPCLIENT_RESOLVE_TIMEOUT_MILLISECONDS"        , "/erp/httpClientResolveTimeoutMilliseconds", Flags::categoryEnvironment, "Timeout of DNS resolve requests in ms"}},
+    {ConfigurationKey::HTTPCLIENT_KEEP_ALIVE_IDLE_SECONDS             , {"ERP_HTTPCLIENT_KEEP_ALIVE_IDLE_SECONDS"             , "/erp/httpClientKeepAliveIdleSeconds", Flags::categoryEnvironment, "Time in seconds an idle outgoing connection to the TSL, OCSP, PoPP, IDP update and CRL download services is kept open for reuse, 0 disables connection reuse"}},
     {ConfigurationKey::ADMIN_SERVER_INTERFACE                         , {"ERP_ADMIN_SERVER_INTERFACE"                         , "/erp/admin/server/interface", Flags::categoryEnvironment, "The network interface for the admin server binds to"}},
     {ConfigurationKey::ADMIN_SERVER_PORT                              , {"ERP_ADMIN_SERVER_PORT"                              , "/erp/admin/server/port", Flags::categoryEnvironment, "The port for the admin server."}},
     {ConfigurationKey::ADMIN_DEFAULT_SHUTDOWN_DELAY_SECONDS           , {"ERP_ADMIN_DEFAULT_SHUTDOWN_DELAY_SECONDS"           , "/erp/admin/defaultShutdownDelaySeconds", Flags::categoryEnvironment, "Default delay for shutdown commands, if no delay is given in request parameter"}},
@@ -504,6 +607,7 @@ OpsConfigKeyNames::OpsConfigKeyNames()
     {ConfigurationKey::MEDICATION_EXPORTER_POSTGRES_KEEPALIVES_COUNT                      , {"ERP_MEDICATION_EXPORTER_POSTGRES_KEEPALIVES_COUNT"                      , "/erp-medication-exporter/postgres/keepalivesCount", Flags::categoryEnvironment, "Controls the number of TCP keepalives that can be lost before the client's connection to the server is considered dead. A value of zero uses the system default"}},
     {ConfigurationKey::MEDICATION_EXPORTER_POSTGRES_TARGET_SESSION_ATTRS                  , {"ERP_MEDICATION_EXPORTER_POSTGRES_TARGET_SESSION_ATTRS"                  , "/erp-medication-exporter/postgres/targetSessionAttrs", Flags::categoryEnvironment, "If this parameter is set to read-write, only a connection in which read-write transactions are accepted by default is considered acceptable. The query SHOW transaction_read_only will be sent upon any successful connection; if it returns on, the connection will be closed. If multiple hosts were specified in the connection string, any remaining servers will be tried just as if the connection attempt had failed. The default value of this parameter, any, regards all connections as acceptable."}},
     {ConfigurationKey::MEDICATION_EXPORTER_POSTGRES_CONNECTION_MAX_AGE_MINUTES            , {"ERP_MEDICATION_EXPORTER_POSTGRES_CONNECTION_MAX_AGE_MINUTES"            , "/erp-medication-exporter/postgres/connectionMaxAgeMinutes", Flags::categoryEnvironment, "After this time the database connections will be closed and re-opened."}},
+    {ConfigurationKey::MEDICATION_EXPORTER_POSTGRES_EVENT_FETCH_SIZE                      , {"ERP_MEDICATION_EXPORTER_POSTGRES_EVENT_FETCH_SIZE"                      , "/erp-medication-exporter/postgres/eventFetchSize", Flags::categoryFunctionalStatic, "Number of task events read from the database per query when processing a KVNR."}},
 
     {ConfigurationKey::MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_CONNECT_TIMEOUT_SECONDS      , {"ERP_MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_CONNECT_TIMEOUT_SECONDS"      , "/erp-medication-exporter/epa-account-lookup/connectTimeoutSeconds", Flags::categoryEnvironment, "HTTPs Client configuration"}},
     {ConfigurationKey::MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_DNS_REFRESH_INTERVAL         , {"ERP_MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_DNS_REFRESH_INTERVAL"         , "/erp-medication-exporter/epa-account-lookup/dnsRefreshInterval", Flags::categoryEnvironment, "DNS refresh interval for ePAs [HH:MM:SS]"}},
@@ -513,6 +617,7 @@ OpsConfigKeyNames::OpsConfigKeyNames()
     {ConfigurationKey::MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_EPA_AS_FQDN                  , {"ERP_MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_EPA_AS_FQDN"                  , "/erp-medication-exporter/epa-account-lookup/epaAsFqdn", Flags::categoryEnvironment|Flags::array, "List of EPA FQDN adresses and TEE connection count (default 8) in the format <host>`:`<port>[`+`<connections>] separated by semicolon"}},
     {ConfigurationKey::MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_POOL_SIZE_PER_FQDN           , {"ERP_MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_POOL_SIZE_PER_FQDN"           , "/erp-medication-exporter/epa-account-lookup/poolSizePerFqdn", Flags::categoryEnvironment, "Number of connections per ePA FQDN"}},
     {ConfigurationKey::MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_THROTTLE_SECONDS             , {"ERP_MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_THROTTLE_SECONDS"             , "/erp-medication-exporter/epa-account-lookup/throttleSeconds", Flags::categoryEnvironment, "Throttling value when at least one EPA is reporting errors, e.g. http-500"}},
+    {ConfigurationKey::MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_CONSENT_REUSE_SECONDS         , {"ERP_MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_CONSENT_REUSE_SECONDS"         , "/erp-medication-exporter/epa-account-lookup/consentReuseSeconds", Flags::categoryEnvironment, "Seconds during which a granted consent decision and the assigned ePA of a KVNR are reused without a new lookup, 0 disables the reuse"}},
     {ConfigurationKey::MEDICATION_EXPORTER_EPA_CONFLICT_WAIT_MINUTES                       , {"MEDICATION_EXPORTER_EPA_CONFLICT_WAIT_MINUTES"                           , "/erp-medication-exporter/epa-conflict/epaConflictWaitMinutes", Flags::categoryEnvironment, "Minutes to wait before retry after EPA conflicts HTTP 409"}},
     {ConfigurationKey::MEDICATION_EXPORTER_RETRIES_MAXIMUM_BEFORE_DEADLETTER               , {"MEDICATION_EXPORTER_RETRIES_MAXIMUM_BEFORE_DEADLETTER"                   , "/erp-medication-exporter/retries/maximumRetriesBeforeDeadletter", Flags::categoryEnvironment, "Maximum retry attempts before moving task events to Deadlettter queue"}},
     {ConfigurationKey::MEDICATION_EXPORTER_RETRIES_RESCHEDULE_DELAY_SECONDS                , {"MEDICATION_EXPORTER_RETRIES_RESCHEDULE_DELAY_SECONDS"                    , "/erp-medication-exporter/retries/rescheduleDelaySeconds", Flags::categoryEnvironment, "Seconds to delay next processing of KVNR after moving events to Deadletter queue"}},
@@ -537,6 +642,11 @@ OpsConfigKeyNames::OpsConfigKeyNames()
     {ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_RETRIES_PER_ADDRESS                             , {"MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_RETRIES_PER_ADDRESS",                "/erp-medication-exporter/vau-https-client/retriesPerAddress", Flags::categoryEnvironment, "Maximum connect attempts per address"}},
     {ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_RESOLVE_TIMEOUT_MILLISECONDS                    , {"MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_RESOLVE_TIMEOUT_MILLISECONDS",       "/erp-medication-exporter/vau-https-client/resolveTimeoutMilliseconds", Flags::categoryEnvironment, "Timeout for resolving DNS entries."}},
     {ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_STICKY                                          , {"MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_STICKY"                            , "/erp-medication-exporter/vau-https-client/sticky", Flags::categoryEnvironment, "Use the same client for all current events for the same KVNR"}},
+    {ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_MIN_CONNECTIONS                                 , {"MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_MIN_CONNECTIONS"                   , "/erp-medication-exporter/vau-https-client/minConnections", Flags::categoryEnvironment, "Number of connections per ePA host that are kept open and pre-warmed, at most the configured tee connections."}},
+    {ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_IDLE_TIMEOUT_SECONDS                            , {"MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_IDLE_TIMEOUT_SECONDS"              , "/erp-medication-exporter/vau-https-client/idleTimeoutSeconds", Flags::categoryEnvironment, "Connections above the minimum are closed after being unused for this time."}},
+    {ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_MAINTENANCE_INTERVAL_SECONDS                    , {"MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_MAINTENANCE_INTERVAL_SECONDS"      , "/erp-medication-exporter/vau-https-client/maintenanceIntervalSeconds", Flags::categoryEnvironment, "Interval for closing idle connections and pre-warming connections, 0 disables it."}},
+    {ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_RENEW_BEFORE_EXPIRY_SECONDS                     , {"MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_RENEW_BEFORE_EXPIRY_SECONDS"       , "/erp-medication-exporter/vau-https-client/renewBeforeExpirySeconds", Flags::categoryEnvironment, "Idle connections renew their VAU channel when it expires within this time."}},
+    {ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_GROW_WAIT_MILLISECONDS                          , {"MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_GROW_WAIT_MILLISECONDS"            , "/erp-medication-exporter/vau-https-client/growWaitMilliseconds", Flags::categoryEnvironment, "When the average time callers wait for a connection exceeds this value, a connection is added as soon as the last idle one is taken."}},
     {ConfigurationKey::MEDICATION_EXPORTER_OCSP_EPA_GRACE_PERIOD                                            , {"MEDICATION_EXPORTER_OCSP_EPA_GRACE_PERIOD"                              , "/erp-medication-exporter/ocsp/gracePeriodEpa", Flags::categoryFunctionalStatic, "OCSP-Grace period in seconds for OCSP-response of ePA Servier Certificate"}},
     {ConfigurationKey::MEDICATION_EXPORTER_SERNO2TID_PATH                                                   , {"MEDICATION_EXPORTER_SERNO2TID_PATH"                                     , "/erp-medication-exporter/serno2tid/path", Flags::categoryEnvironment, "Mapping file path to lookup TID by S/N"}},
     {ConfigurationKey::MEDICATION_EXPORTER_SERNO2TID_HASH                                                   , {"MEDICATION_EXPORTER_SERNO2TID_HASH"                                     , "/erp-medication-exporter/serno2tid/hash", Flags::categoryEnvironment, "Hash value do validate mapping file"}},
@@ -547,6 +657,9 @@ OpsConfigKeyNames::OpsConfigKeyNames()
     {ConfigurationKey::MEDICATION_EXPORTER_FHIR_VZD_CLIENT_TOKEN_PORT, {"ERP_MEDICATION_EXPORTER_FHIR_VZD_CLIENT_TOKEN_PORT", "/erp-medication-exporter/fhir-vzd-client/tokenPort", Flags::categoryEnvironment, "Port of the auth token url"}},
     {ConfigurationKey::MEDICATION_EXPORTER_FHIR_VZD_CLIENT_API_URL,    {"ERP_MEDICATION_EXPORTER_FHIR_VZD_CLIENT_API_URL",    "/erp-medication-exporter/fhir-vzd-client/apiUrl",    Flags::categoryEnvironment, "Api url"}},
     {ConfigurationKey::MEDICATION_EXPORTER_FHIR_VZD_CLIENT_API_PORT,   {"ERP_MEDICATION_EXPORTER_FHIR_VZD_CLIENT_API_PORT",   "/erp-medication-exporter/fhir-vzd-client/apiPort",   Flags::categoryEnvironment, "Api port"}},
+    {ConfigurationKey::MEDICATION_EXPORTER_FHIR_VZD_CACHE_TTL_SECONDS,          {"ERP_MEDICATION_EXPORTER_FHIR_VZD_CACHE_TTL_SECONDS",          "/erp-medication-exporter/fhir-vzd-cache/ttlSeconds",         Flags::categoryFunctionalStatic, "Lifetime of cached VZD search results, 0 disables the cache"}},
+    {ConfigurationKey::MEDICATION_EXPORTER_FHIR_VZD_CACHE_NEGATIVE_TTL_SECONDS, {"ERP_MEDICATION_EXPORTER_FHIR_VZD_CACHE_NEGATIVE_TTL_SECONDS", "/erp-medication-exporter/fhir-vzd-cache/negativeTtlSeconds", Flags::categoryFunctionalStatic, "Lifetime of cached VZD search results without entries, 0 disables negative caching"}},
+    {ConfigurationKey::MEDICATION_EXPORTER_FHIR_VZD_CACHE_MAX_ENTRIES,          {"ERP_MEDICATION_EXPORTER_FHIR_VZD_CACHE_MAX_ENTRIES",          "/erp-medication-exporter/fhir-vzd-cache/maxEntries",         Flags::categoryFunctionalStatic, "Maximum number of cached VZD search results"}},
 
     {ConfigurationKey::MEDICATION_EXPORTER_BFARM_CLIENT_SECRET,                  {"ERP_MEDICATION_EXPORTER_BFARM_CLIENT_SECRET",           "/erp-medication-exporter/bfarm-client/secret",                Flags::categoryEnvironment, "BfArM client secret"}},
     {ConfigurationKey::MEDICATION_EXPORTER_BFARM_CLIENT_ID,                      {"ERP_MEDICATION_EXPORTER_BFARM_CLIENT_ID",               "/erp-medication-exporter/bfarm-client/id",                    Flags::categoryEnvironment, "BfArM client id"}},
@@ -590,25 +703,23 @@ DevConfigKeyNames::DevConfigKeyNames()
 
 std::optional<int> ConfigurationBase::getIntValueInternal(KeyData key) const
 {
-    const auto value = getStringValueInternal(key);
-    if (value.has_value())
+    if (const auto* cached = currentSnapshot().find(key.index))
     {
-        try
+        if (cached->string.has_value() && ! cached->asInt.has_value())
         {
-            size_t pos = 0;
-            auto asInt = stoi(value.value(), &pos);
-            if (pos == value->size())
-            {
-                return asInt;
-            }
+            throw createNotAnIntegerException(key, *cached->string, {__FILE__, __LINE__});
         }
-        catch(const std::logic_error&) //NOLINT(bugprone-empty-catch)
+        return cached->asInt;
+    }
+    const auto value = getStringValueInternal(key);
+    if (value.has_value())
+    {
+        const auto asInt = ConfigurationSnapshot::toInt(value.value());
+        if (asInt.has_value())
         {
+            return asInt;
         }
-        throw ExceptionWrapper<InvalidConfigurationException>::create({__FILE__, __LINE__},
-            std::string("Configuration: can not convert '") + value.value() + "' to integer",
-            std::string(key.environmentVariable),
-            std::string(key.jsonPath));
+        throw createNotAnIntegerException(key, value.value(), {__FILE__, __LINE__});
     }
     else
         return {};
@@ -616,6 +727,10 @@ std::optional<int> ConfigurationBase::getIntValueInternal(KeyData key) const
 
 std::optional<bool> ConfigurationBase::getBoolValueInternal(KeyData key) const
 {
+    if (const auto* cached = currentSnapshot().find(key.index))
+    {
+        return cached->string.has_value() ? std::make_optional(cached->asBool) : std::nullopt;
+    }
     const auto value = getStringValueInternal(key);
     if (value.has_value())
         return String::toBool(value.value());
@@ -808,6 +923,11 @@ std::vector<std::string> ConfigurationBase::getOptionalArrayFromJson(KeyData key
 
 std::optional<std::string> ConfigurationBase::getStringValueInternal (KeyData key) const
 {
+    if (const auto* cached = currentSnapshot().find(key.index))
+    {
+        return cached->string;
+    }
+
     const auto& value = Environment::get(std::string{key.environmentVariable});
     if (value)
         return value;
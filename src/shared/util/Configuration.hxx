@@ -13,6 +13,7 @@
 #include "shared/ErpConstants.hxx"
 #include "shared/model/ProfileType.hxx"
 #include "shared/network/client/ProxyParameters.hxx"
+#include "shared/util/ConfigurationSnapshot.hxx"
 #include "shared/util/Environment.hxx"
 #include "shared/util/ExceptionWrapper.hxx"
 #include "shared/util/SafeString.hxx"
@@ -20,9 +21,14 @@
 
 #include <magic_enum/magic_enum.hpp>
 #include <rapidjson/document.h>
+#include <atomic>
+#include <deque>
 #include <filesystem>
+#include <limits>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
@@ -59,6 +65,7 @@ enum class ConfigurationKey
     IDP_UPDATE_INTERVAL_MINUTES,
     IDP_NO_VALID_CERTIFICATE_UPDATE_INTERVAL_SECONDS,
     IDP_SECONDARY_CERTIFICATE,
+    IDP_VERIFIED_TOKEN_CACHE_MAX_AGE_SECONDS,
     JSON_META_SCHEMA,
     JSON_SCHEMA,
     OCSP_C_FD_SIG_ERP_GRACE_PERIOD,
@@ -78,6 +85,11 @@ enum class ConfigurationKey
     SERVICE_TASK_CLOSE_PRESCRIPTION_DIGEST_VERSION_ID,
     SERVICE_TASK_GET_ENFORCE_HCV_CHECK,
     SERVICE_TASK_GET_RATE_LIMIT,
+    SERVICE_TASK_GET_KEYSET_PAGING,
+    SERVICE_AUDIT_EVENT_ASYNC_WRITE,
+    SERVICE_AUDIT_EVENT_QUEUE_SIZE,
+    SERVICE_AUDIT_EVENT_BATCH_SIZE,
+    SERVICE_REQUEST_JSON_ARENA,
     SERVICE_COMMUNICATION_MAX_MESSAGES,
     SERVICE_COMMUNICATION_PAYLOAD_V1_VALID_UNTIL,
     SERVICE_COMMUNICATION_PAYLOAD_V3_VALID_FROM,
@@ -117,14 +129,20 @@ enum class ConfigurationKey
     POSTGRES_RO_KEEPALIVES_COUNT,
     POSTGRES_RO_TARGET_SESSION_ATTRS,
     POSTGRES_RO_CONNECTION_MAX_AGE_MINUTES,
+    POSTGRES_DECODE_THREAD_COUNT,
+    POSTGRES_DECODE_PARALLEL_THRESHOLD,
     PUBLIC_E_PRESCRIPTION_SERVICE_URL,
     REGISTRATION_HEARTBEAT_INTERVAL_SEC,
+    HEALTH_CHECK_TIMEOUT_MS,
+    HEALTH_CHECK_CACHE_MAX_AGE_SEC,
     TSL_TI_OCSP_PROXY_URL,
     TSL_INITIAL_DOWNLOAD_URL,
     TSL_INITIAL_CA_DER_PATH,
     TSL_INITIAL_CA_DER_PATH_NEW,
     TSL_INITIAL_CA_DER_PATH_NEW_START,
     TSL_REFRESH_INTERVAL,
+    TSL_VERIFIED_CERTIFICATE_CACHE_MAX_AGE,
+    TSL_OCSP_REFRESH_INTERVAL,
     TSL_DOWNLOAD_CIPHERS,
     XML_SCHEMA_MISC,
     FHIR_STRUCTURE_DEFINITIONS,
@@ -157,6 +175,7 @@ enum class ConfigurationKey
     ZSTD_DICTIONARY_DIR,
     HTTPCLIENT_CONNECT_TIMEOUT_SECONDS,
     HTTPCLIENT_RESOLVE_TIMEOUT_MILLISECONDS,
+    HTTPCLIENT_KEEP_ALIVE_IDLE_SECONDS,
     HTTPS_PROXIES,
     HTTP_PROXIES,
 
@@ -222,6 +241,7 @@ enum class ConfigurationKey
     MEDICATION_EXPORTER_POSTGRES_KEEPALIVES_COUNT,
     MEDICATION_EXPORTER_POSTGRES_TARGET_SESSION_ATTRS,
     MEDICATION_EXPORTER_POSTGRES_CONNECTION_MAX_AGE_MINUTES,
+    MEDICATION_EXPORTER_POSTGRES_EVENT_FETCH_SIZE,
 
     MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_CONNECT_TIMEOUT_SECONDS,
     MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_DNS_REFRESH_INTERVAL,
@@ -231,6 +251,7 @@ enum class ConfigurationKey
     MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_EPA_AS_FQDN,
     MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_POOL_SIZE_PER_FQDN,
     MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_THROTTLE_SECONDS,
+    MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_CONSENT_REUSE_SECONDS,
     MEDICATION_EXPORTER_EPA_CONFLICT_WAIT_MINUTES,
     MEDICATION_EXPORTER_RETRIES_MAXIMUM_BEFORE_DEADLETTER,
     MEDICATION_EXPORTER_RETRIES_RESCHEDULE_DELAY_SECONDS,
@@ -254,6 +275,11 @@ enum class ConfigurationKey
     MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_RETRIES_PER_ADDRESS,
     MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_RESOLVE_TIMEOUT_MILLISECONDS,
     MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_STICKY,
+    MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_MIN_CONNECTIONS,
+    MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_IDLE_TIMEOUT_SECONDS,
+    MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_MAINTENANCE_INTERVAL_SECONDS,
+    MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_RENEW_BEFORE_EXPIRY_SECONDS,
+    MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_GROW_WAIT_MILLISECONDS,
     MEDICATION_EXPORTER_OCSP_EPA_GRACE_PERIOD,
 
     MEDICATION_EXPORTER_SERNO2TID_PATH,
@@ -265,6 +291,9 @@ enum class ConfigurationKey
     MEDICATION_EXPORTER_FHIR_VZD_CLIENT_TOKEN_PORT,
     MEDICATION_EXPORTER_FHIR_VZD_CLIENT_API_URL,
     MEDICATION_EXPORTER_FHIR_VZD_CLIENT_API_PORT,
+    MEDICATION_EXPORTER_FHIR_VZD_CACHE_TTL_SECONDS,
+    MEDICATION_EXPORTER_FHIR_VZD_CACHE_NEGATIVE_TTL_SECONDS,
+    MEDICATION_EXPORTER_FHIR_VZD_CACHE_MAX_ENTRIES,
 
     MEDICATION_EXPORTER_BFARM_CLIENT_SECRET,
     MEDICATION_EXPORTER_BFARM_CLIENT_ID,
@@ -310,6 +339,11 @@ struct KeyData
     };
     int flags = none;
     std::string_view description;
+    /// Numeric value of the configuration key, used to address the value in the ConfigurationSnapshot.
+    /// Stays `noIndex` for json paths that are not backed by a configuration key.
+    size_t index = noIndex;
+
+    static constexpr size_t noIndex = std::numeric_limits<size_t>::max();
 };
 
 /**
@@ -402,14 +436,31 @@ protected:
     [[nodiscard]] std::list<std::pair<std::string, fhirtools::FhirVersion>>
     resourceList(const std::string& jsonPath) const;
 
+    /// Returns the snapshot of all key values. A new snapshot is created when the environment has been modified
+    /// since the current one was created. The returned snapshot stays valid until retainedSnapshots newer snapshots
+    /// have been published, so it must only be used for the lookup at hand and not be stored.
+    const ConfigurationSnapshot& currentSnapshot() const;
 
 private:
     bool lookupKey(const std::string& pathPrefix, const std::string& jsonKey);
+    const ConfigurationSnapshot& publishSnapshot() const;
+    std::unique_ptr<const ConfigurationSnapshot> createSnapshot() const;
+    ConfigurationSnapshot::Value resolveSnapshotValue(const KeyData& key) const;
 
     rapidjson::Document mDocument;
     std::map<std::string, const rapidjson::Value*> mValuesByKey;
     std::string mServerHost;
     uint16_t mServerPort;
+    std::vector<KeyData> mSnapshotKeys;
+    size_t mSnapshotSize = 0;
+    // Readers only load the pointer to the current snapshot. Replaced snapshots are kept in mSnapshots, as they may
+    // still be in use by other threads, but only the last retainedSnapshots of them. Older ones are released, a
+    // reader would have to stay within a single lookup while that many environment modifications happen.
+    // New snapshots are only created after the environment has been modified, which happens at startup and in tests.
+    static constexpr size_t retainedSnapshots = 16;
+    mutable std::atomic<const ConfigurationSnapshot*> mCurrentSnapshot{nullptr};
+    mutable std::mutex mSnapshotsMutex;
+    mutable std::deque<std::unique_ptr<const ConfigurationSnapshot>> mSnapshots;
 };
 
 namespace config
@@ -562,19 +613,6 @@ requires std::is_enum_v<EnumT>
     return *asEnum;
 }
 
-template<typename TKeyValueContainer>
-std::vector<typename TKeyValueContainer::mapped_type> getAllValues(const TKeyValueContainer& keyValueContainer)
-{
-    std::vector<typename TKeyValueContainer::mapped_type> allValues;
-    allValues.reserve(keyValueContainer.size());
-    for(const auto& [key, value] : keyValueContainer)
-    {
-        allValues.emplace_back(value);
-    }
-    return allValues;
-}
-
-
 /**
  * A provider template of KeyData objects for all keys in TConfigurationKey.
  */
@@ -590,11 +628,17 @@ public:
             throw ExceptionWrapper<std::runtime_error>::create(
                 {__FILE__, __LINE__}, "unknown configuration key: " + std::string(magic_enum::enum_name(key)));
         }
-        return entry->second;
+        return withIndex(entry->first, entry->second);
     }
     std::vector<KeyData> allStrings() const
     {
-        return getAllValues(mNamesByKey);
+        std::vector<KeyData> allValues;
+        allValues.reserve(mNamesByKey.size());
+        for (const auto& [key, keyData] : mNamesByKey)
+        {
+            allValues.emplace_back(withIndex(key, keyData));
+        }
+        return allValues;
     }
     bool contains(KeyType key) const
     {
@@ -617,6 +661,13 @@ public:
 
 protected:
     std::map<KeyType, KeyData> mNamesByKey;
+
+private:
+    static KeyData withIndex(KeyType key, KeyData keyData)
+    {
+        keyData.index = static_cast<size_t>(key);
+        return keyData;
+    }
 };
 
 // contains all keys needed for operational, but no development or test related keys
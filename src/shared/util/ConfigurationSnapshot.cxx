@@ -0,0 +1,60 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/util/ConfigurationSnapshot.hxx"
+#include "shared/util/String.hxx"
+
+#include <stdexcept>
+
+
+ConfigurationSnapshot::Value ConfigurationSnapshot::makeValue(std::optional<std::string> string)
+{
+    Value value{.resolved = true, .string = std::move(string)};
+    if (value.string.has_value())
+    {
+        value.asInt = toInt(*value.string);
+        value.asBool = String::toBool(*value.string);
+    }
+    return value;
+}
+
+std::optional<int> ConfigurationSnapshot::toInt(const std::string& string)
+{
+    try
+    {
+        size_t pos = 0;
+        auto asInt = std::stoi(string, &pos);
+        if (pos == string.size())
+        {
+            return asInt;
+        }
+    }
+    catch (const std::logic_error&)//NOLINT(bugprone-empty-catch)
+    {
+    }
+    return std::nullopt;
+}
+
+ConfigurationSnapshot::ConfigurationSnapshot(uint64_t environmentGeneration, std::vector<Value> values)
+    : mEnvironmentGeneration{environmentGeneration}
+    , mValues{std::move(values)}
+{
+}
+
+uint64_t ConfigurationSnapshot::environmentGeneration() const
+{
+    return mEnvironmentGeneration;
+}
+
+const ConfigurationSnapshot::Value* ConfigurationSnapshot::find(size_t index) const
+{
+    if (index >= mValues.size() || ! mValues[index].resolved)
+    {
+        return nullptr;
+    }
+    return &mValues[index];
+}
@@ -0,0 +1,53 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#ifndef ERP_PROCESSING_CONTEXT_UTIL_CONFIGURATIONSNAPSHOT_HXX
+#define ERP_PROCESSING_CONTEXT_UTIL_CONFIGURATIONSNAPSHOT_HXX
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * Immutable set of configuration values, resolved once from environment and configuration file and addressed by the
+ * numeric value of the configuration key, so that reading a value neither calls getenv nor looks up a json path.
+ * Integer and boolean conversions are done when the snapshot is created.
+ *
+ * A snapshot belongs to the Environment::generation() that was current when it was created. ConfigurationBase
+ * replaces it with a new one when the environment has changed since.
+ */
+class ConfigurationSnapshot
+{
+public:
+    struct Value
+    {
+        /// false if the value is not held by the snapshot and has to be read the slow way, e.g. for credentials,
+        /// which are not kept in plain std::string, or for json values that are not strings.
+        bool resolved = false;
+        std::optional<std::string> string;
+        /// set if `string` is a valid integer
+        std::optional<int> asInt;
+        bool asBool = false;
+    };
+
+    static Value makeValue(std::optional<std::string> string);
+    static std::optional<int> toInt(const std::string& string);
+
+    ConfigurationSnapshot(uint64_t environmentGeneration, std::vector<Value> values);
+
+    uint64_t environmentGeneration() const;
+
+    /// @returns the value at `index` or nullptr if the value is not resolved by this snapshot
+    const Value* find(size_t index) const;
+
+private:
+    uint64_t mEnvironmentGeneration;
+    std::vector<Value> mValues;
+};
+
+#endif// ERP_PROCESSING_CONTEXT_UTIL_CONFIGURATIONSNAPSHOT_HXX
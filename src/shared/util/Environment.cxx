@@ -10,8 +10,14 @@
 #include "shared/util/String.hxx"
 #include "shared/util/TLog.hxx"
 
+#include <atomic>
 #include <set>
 
+namespace
+{
+std::atomic<uint64_t> environmentGeneration{0};
+}
+
 std::optional<std::string> Environment::get (const std::string& variableName)
 {
     const char* value = getCharacterPointer(variableName);
@@ -39,6 +45,7 @@ void Environment::set (const std::string& variableName, const std::string& value
 #else
     setenv(variableName.c_str(), value.c_str(), true); //NOLINT(concurrency-mt-unsafe)
 #endif
+    environmentGeneration.fetch_add(1, std::memory_order_release);
 }
 
 
@@ -49,6 +56,13 @@ void Environment::unset (const std::string& variableName)
 #else
     unsetenv(variableName.c_str());//NOLINT(concurrency-mt-unsafe)
 #endif
+    environmentGeneration.fetch_add(1, std::memory_order_release);
+}
+
+
+uint64_t Environment::generation()
+{
+    return environmentGeneration.load(std::memory_order_acquire);
 }
 
 
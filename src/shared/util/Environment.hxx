@@ -8,6 +8,7 @@
 #ifndef ERP_PROCESSING_CONTEXT_UTIL_ENVIRONMENT_HXX
 #define ERP_PROCESSING_CONTEXT_UTIL_ENVIRONMENT_HXX
 
+#include <cstdint>
 #include <optional>
 #include <string>
 
@@ -34,6 +35,12 @@ public:
      */
     static void unset (const std::string& variableName);
 
+    /**
+     * Counter that is incremented by every call to `set` or `unset`. Allows caches of values that have been read from
+     * the environment, like the configuration snapshot, to detect that they have to be rebuilt.
+     */
+    static uint64_t generation();
+
     static std::string getString(const char* envConfigName, const std::string_view& defaultValue);
     static int getInt(const char* envConfigName, const int defaultValue);
     static bool getBool(const char* envConfigName, const bool defaultValue);
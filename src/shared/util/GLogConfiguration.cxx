@@ -6,9 +6,11 @@
  */
 
 #include "shared/util/GLogConfiguration.hxx"
+#include "shared/util/AsyncLogWriter.hxx"
 #include "shared/util/Environment.hxx"
 #include "shared/util/TLog.hxx"
 
+#include <algorithm>
 #include <iomanip>
 #include <chrono>
 
@@ -21,6 +23,14 @@ void GLogConfiguration::initLogging(const char* argv0)
     const int vLogMaxValue = Environment::getInt("ERP_VLOG_MAX_VALUE", 1);
 
     initLogging(argv0, logToStderr, stderrThreshold > 0, getLogLevelInt(minLogLevelString), logDir, vLogMaxValue);
+
+    if (Environment::getBool("ERP_LOG_ASYNC", false))
+    {
+        const int bufferSize =
+            Environment::getInt("ERP_LOG_ASYNC_BUFFER_SIZE", static_cast<int>(AsyncLogWriter::defaultCapacityPerThread));
+        AsyncLogWriter::instance().start(static_cast<size_t>(std::max(bufferSize, 1)));
+        TLOG(INFO) << "asynchronous JSON logging enabled, buffer size per thread: " << bufferSize;
+    }
 }
 
 
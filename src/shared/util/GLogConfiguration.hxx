@@ -24,6 +24,9 @@ public:
      * ERP_MIN_LOG_LEVEL - minimal log level: INFO, WARNING, ERROR, FATAL
      * ERP_LOG_DIR - log directory
      * ERP_VLOG_MAX_VALUE - show the logs for the v-value and below
+     * ERP_LOG_ASYNC - write JSON logs (access log, operator messages) on a separate thread, see AsyncLogWriter
+     * ERP_LOG_ASYNC_BUFFER_SIZE - number of records buffered per thread when ERP_LOG_ASYNC is set, further records
+     *                             are dropped
      * ERP_VLOG_CONFIG - (not yet activated)
      *                   Per-module verbose level. The argument has to contain a comma-separated
      *                   list of <module name>=<log level>. <module name> is a glob pattern
@@ -7,6 +7,7 @@
 
 #include "fhirtools/model/NumberAsStringParserDocument.hxx"
 #include "fhirtools/model/NumberAsStringParserWriter.hxx"
+#include "shared/util/AsyncLogWriter.hxx"
 #include "shared/util/Configuration.hxx"
 #include "shared/util/JsonLog.hxx"
 #include "shared/util/String.hxx"
@@ -46,27 +47,39 @@ JsonLog::~JsonLog()
 }
 
 
-JsonLog::LogReceiver JsonLog::makeErrorLogReceiver()
+namespace
+{
+/// Same output as TLOG, but the record is written by the AsyncLogWriter, if it is running.
+JsonLog::LogReceiver makeLogReceiver(google::LogSeverity severity)
 {
-    return [](const std::string& message) {
-        TLOG(ERROR) << message;
+    return [severity](std::string&& message) {
+        if (severity < FLAGS_minloglevel)
+        {
+            return;
+        }
+        auto text = ThreadNames::instance().getCurrentThreadName();
+        text.append("/").append(tlogContext.value_or("")).append(": ").append(message);
+        AsyncLogWriter::instance().write(severity, __FILE__, __LINE__, std::move(text));
     };
 }
+}
+
+
+JsonLog::LogReceiver JsonLog::makeErrorLogReceiver()
+{
+    return makeLogReceiver(google::GLOG_ERROR);
+}
 
 
 JsonLog::LogReceiver JsonLog::makeWarningLogReceiver()
 {
-    return [](const std::string& message) {
-        TLOG(WARNING) << message;
-    };
+    return makeLogReceiver(google::GLOG_WARNING);
 }
 
 
 JsonLog::LogReceiver JsonLog::makeInfoLogReceiver()
 {
-    return [](const std::string& message) {
-        TLOG(INFO) << message;
-    };
+    return makeLogReceiver(google::GLOG_INFO);
 }
 
 
@@ -66,7 +66,8 @@ enum class LogId : uint32_t
  * Also used for access logs.
  *
  * This class follows a builder pattern where the constructor creates a new object and its destructor will serialize the
- * JSON message and write it out. The actual logging is still done with the help of GLog.
+ * JSON message and write it out. The actual logging is still done with the help of GLog, on the AsyncLogWriter thread
+ * if that is enabled.
  */
 class JsonLog
 {
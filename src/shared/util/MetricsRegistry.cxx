@@ -6,6 +6,7 @@
 #include "shared/util/TLog.hxx"
 
 #include <magic_enum/magic_enum.hpp>
+#include <prometheus/counter.h>
 #include <prometheus/histogram.h>
 #include <prometheus/registry.h>
 #include <prometheus/text_serializer.h>
@@ -35,20 +36,115 @@ void MetricsRegistry::count(const std::chrono::steady_clock::duration& duration,
     }
 }
 
+void MetricsRegistry::countCacheLookup(const std::string& cache, bool hit)
+{
+    try
+    {
+        mCacheLookupCounter->Add({{"cache", cache}, {"result", hit ? "hit" : "miss"}}).Increment();
+    }
+    catch (const std::exception& ex)
+    {
+        TLOG(WARNING) << "exception during recording of cache lookup " << cache << ": " << ex.what();
+    }
+}
+
+void MetricsRegistry::countCacheRefresh(const std::string& cache, bool success)
+{
+    try
+    {
+        mCacheRefreshCounter->Add({{"cache", cache}, {"result", success ? "success" : "failure"}}).Increment();
+    }
+    catch (const std::exception& ex)
+    {
+        TLOG(WARNING) << "exception during recording of cache refresh " << cache << ": " << ex.what();
+    }
+}
+
+void MetricsRegistry::countDroppedLogRecords(uint64_t count)
+{
+    try
+    {
+        mDroppedLogRecordsCounter->Add({}).Increment(static_cast<double>(count));
+    }
+    catch (const std::exception& ex)
+    {
+        TLOG(WARNING) << "exception during recording of dropped log records: " << ex.what();
+    }
+}
+
+void MetricsRegistry::observeConnectionPoolWait(const std::string& pool, const std::string& host,
+                                                const std::chrono::steady_clock::duration& duration)
+{
+    static const std::vector<double> bucketBoundaries{1 / 1000.0, 10 / 1000.0, 100 / 1000.0, 500 / 1000.0, 1, 5};
+    try
+    {
+        mConnectionPoolWaitHistogram->Add({{"pool", pool}, {"host", host}}, bucketBoundaries)
+            .Observe(std::chrono::duration<double>(duration).count());
+    }
+    catch (const std::exception& ex)
+    {
+        TLOG(WARNING) << "exception during recording of connection pool wait " << pool << ": " << ex.what();
+    }
+}
+
+void MetricsRegistry::observeConnectionHandshake(const std::string& pool, const std::string& host,
+                                                 const std::chrono::steady_clock::duration& duration, bool success)
+{
+    static const std::vector<double> bucketBoundaries{50 / 1000.0, 100 / 1000.0, 250 / 1000.0, 500 / 1000.0, 1, 5};
+    try
+    {
+        mConnectionHandshakeHistogram
+            ->Add({{"pool", pool}, {"host", host}, {"result", success ? "success" : "failure"}}, bucketBoundaries)
+            .Observe(std::chrono::duration<double>(duration).count());
+    }
+    catch (const std::exception& ex)
+    {
+        TLOG(WARNING) << "exception during recording of connection handshake " << pool << ": " << ex.what();
+    }
+}
+
 std::string MetricsRegistry::serialize() const
 {
-    return prometheus::TextSerializer{}.Serialize(mHistogram->Collect());
+    auto families = mHistogram->Collect();
+    for (const auto* histogram : {mConnectionPoolWaitHistogram.get(), mConnectionHandshakeHistogram.get()})
+    {
+        auto histogramFamilies = histogram->Collect();
+        families.insert(families.end(), std::make_move_iterator(histogramFamilies.begin()),
+                        std::make_move_iterator(histogramFamilies.end()));
+    }
+    for (const auto* counter : {mCacheLookupCounter.get(), mCacheRefreshCounter.get(), mDroppedLogRecordsCounter.get()})
+    {
+        auto counterFamilies = counter->Collect();
+        families.insert(families.end(), std::make_move_iterator(counterFamilies.begin()),
+                        std::make_move_iterator(counterFamilies.end()));
+    }
+    return prometheus::TextSerializer{}.Serialize(families);
 }
 
 void MetricsRegistry::clear()
 {
     mPrometheusRegistry->Remove(*mHistogram);
+    mPrometheusRegistry->Remove(*mCacheLookupCounter);
+    mPrometheusRegistry->Remove(*mCacheRefreshCounter);
+    mPrometheusRegistry->Remove(*mDroppedLogRecordsCounter);
+    mPrometheusRegistry->Remove(*mConnectionPoolWaitHistogram);
+    mPrometheusRegistry->Remove(*mConnectionHandshakeHistogram);
     mHistogram = buildHistogram();
+    mCacheLookupCounter = buildCacheLookupCounter();
+    mCacheRefreshCounter = buildCacheRefreshCounter();
+    mDroppedLogRecordsCounter = buildDroppedLogRecordsCounter();
+    mConnectionPoolWaitHistogram = buildConnectionPoolWaitHistogram();
+    mConnectionHandshakeHistogram = buildConnectionHandshakeHistogram();
 }
 
 MetricsRegistry::MetricsRegistry()
     : mPrometheusRegistry(std::make_unique<prometheus::Registry>(prometheus::Registry::InsertBehavior::Throw))
     , mHistogram(buildHistogram())
+    , mCacheLookupCounter(buildCacheLookupCounter())
+    , mCacheRefreshCounter(buildCacheRefreshCounter())
+    , mDroppedLogRecordsCounter(buildDroppedLogRecordsCounter())
+    , mConnectionPoolWaitHistogram(buildConnectionPoolWaitHistogram())
+    , mConnectionHandshakeHistogram(buildConnectionHandshakeHistogram())
 {
 }
 
@@ -59,3 +155,43 @@ prometheus::Family<prometheus::Histogram>* MetricsRegistry::buildHistogram()
                 .Help("Backend call duration in seconds")
                 .Register(*mPrometheusRegistry);
 }
+
+prometheus::Family<prometheus::Counter>* MetricsRegistry::buildCacheLookupCounter()
+{
+    return &prometheus::BuildCounter()
+                .Name("cache_lookups_total")
+                .Help("Lookups in in-memory caches by result")
+                .Register(*mPrometheusRegistry);
+}
+
+prometheus::Family<prometheus::Counter>* MetricsRegistry::buildCacheRefreshCounter()
+{
+    return &prometheus::BuildCounter()
+                .Name("cache_refreshes_total")
+                .Help("Background refreshes of in-memory cache entries by result")
+                .Register(*mPrometheusRegistry);
+}
+
+prometheus::Family<prometheus::Counter>* MetricsRegistry::buildDroppedLogRecordsCounter()
+{
+    return &prometheus::BuildCounter()
+                .Name("log_records_dropped_total")
+                .Help("Log records dropped by the asynchronous log writer because a buffer was full")
+                .Register(*mPrometheusRegistry);
+}
+
+prometheus::Family<prometheus::Histogram>* MetricsRegistry::buildConnectionPoolWaitHistogram()
+{
+    return &prometheus::BuildHistogram()
+                .Name("connection_pool_wait_seconds")
+                .Help("Time spent waiting for a pooled connection in seconds")
+                .Register(*mPrometheusRegistry);
+}
+
+prometheus::Family<prometheus::Histogram>* MetricsRegistry::buildConnectionHandshakeHistogram()
+{
+    return &prometheus::BuildHistogram()
+                .Name("connection_handshake_seconds")
+                .Help("Duration of connection handshakes of pooled connections in seconds")
+                .Register(*mPrometheusRegistry);
+}
@@ -10,9 +10,11 @@
 #include <gsl/gsl-lite.hpp>
 #include <prometheus/family.h>
 #include <chrono>
+#include <cstdint>
 
 namespace prometheus
 {
+class Counter;
 class Histogram;
 class Registry;
 }
@@ -28,6 +30,23 @@ public:
     void count(const std::chrono::steady_clock::duration& duration, DurationCategory category,
                const std::string& metric);
 
+    // counts a lookup in the in-memory cache with the given name as hit or miss.
+    void countCacheLookup(const std::string& cache, bool hit);
+
+    // counts a background refresh of an entry in the in-memory cache with the given name as success or failure.
+    void countCacheRefresh(const std::string& cache, bool success);
+
+    // counts log records that have been dropped by the asynchronous log writer because a buffer was full.
+    void countDroppedLogRecords(uint64_t count);
+
+    // observes the time a caller had to wait for a connection of the given pool to the given host.
+    void observeConnectionPoolWait(const std::string& pool, const std::string& host,
+                                   const std::chrono::steady_clock::duration& duration);
+
+    // observes the duration of a connection handshake of the given pool to the given host.
+    void observeConnectionHandshake(const std::string& pool, const std::string& host,
+                                    const std::chrono::steady_clock::duration& duration, bool success);
+
     std::string serialize() const;
 
     void clear();
@@ -35,7 +54,17 @@ public:
 private:
     explicit MetricsRegistry();
     prometheus::Family<prometheus::Histogram>* buildHistogram();
+    prometheus::Family<prometheus::Counter>* buildCacheLookupCounter();
+    prometheus::Family<prometheus::Counter>* buildCacheRefreshCounter();
+    prometheus::Family<prometheus::Counter>* buildDroppedLogRecordsCounter();
+    prometheus::Family<prometheus::Histogram>* buildConnectionPoolWaitHistogram();
+    prometheus::Family<prometheus::Histogram>* buildConnectionHandshakeHistogram();
 
     gsl::not_null<std::unique_ptr<prometheus::Registry>> mPrometheusRegistry;
     gsl::not_null<prometheus::Family<prometheus::Histogram>*> mHistogram;
+    gsl::not_null<prometheus::Family<prometheus::Counter>*> mCacheLookupCounter;
+    gsl::not_null<prometheus::Family<prometheus::Counter>*> mCacheRefreshCounter;
+    gsl::not_null<prometheus::Family<prometheus::Counter>*> mDroppedLogRecordsCounter;
+    gsl::not_null<prometheus::Family<prometheus::Histogram>*> mConnectionPoolWaitHistogram;
+    gsl::not_null<prometheus::Family<prometheus::Histogram>*> mConnectionHandshakeHistogram;
 };
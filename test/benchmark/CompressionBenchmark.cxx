@@ -0,0 +1,58 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/compression/ZStd.hxx"
+#include "shared/model/KbvBundle.hxx"
+#include "shared/util/Configuration.hxx"
+#include "test/util/ResourceTemplates.hxx"
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+const ZStd& zstd()
+{
+    static const ZStd instance{Configuration::instance().getStringValue(ConfigurationKey::ZSTD_DICTIONARY_DIR)};
+    return instance;
+}
+
+std::string samplePayload(Compression::DictionaryUse dictionaryUse)
+{
+    const auto xml = ResourceTemplates::kbvBundleXml();
+    if (dictionaryUse == Compression::DictionaryUse::Default_xml)
+    {
+        return xml;
+    }
+    return model::KbvBundle::fromXmlNoValidation(xml).serializeToJsonString();
+}
+
+void BM_ZStdCompress(benchmark::State& state, Compression::DictionaryUse dictionaryUse)
+{
+    const auto plain = samplePayload(dictionaryUse);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(zstd().compress(plain, dictionaryUse));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(plain.size()));
+}
+BENCHMARK_CAPTURE(BM_ZStdCompress, KbvBundleXml, Compression::DictionaryUse::Default_xml);
+BENCHMARK_CAPTURE(BM_ZStdCompress, KbvBundleJson, Compression::DictionaryUse::Default_json);
+
+void BM_ZStdDecompress(benchmark::State& state, Compression::DictionaryUse dictionaryUse)
+{
+    const auto plain = samplePayload(dictionaryUse);
+    const auto compressed = zstd().compress(plain, dictionaryUse);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(zstd().decompress(compressed));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(plain.size()));
+}
+BENCHMARK_CAPTURE(BM_ZStdDecompress, KbvBundleXml, Compression::DictionaryUse::Default_xml);
+BENCHMARK_CAPTURE(BM_ZStdDecompress, KbvBundleJson, Compression::DictionaryUse::Default_json);
+}
@@ -0,0 +1,45 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/util/Configuration.hxx"
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+// Configuration values are read on every request by all server threads, so reads are measured concurrently.
+void BM_ConfigurationGetIntValue(benchmark::State& state)
+{
+    const auto& configuration = Configuration::instance();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(configuration.getIntValue(ConfigurationKey::SERVER_THREAD_COUNT));
+    }
+}
+BENCHMARK(BM_ConfigurationGetIntValue)->Threads(1)->Threads(4)->Threads(16);
+
+void BM_ConfigurationGetBoolValue(benchmark::State& state)
+{
+    const auto& configuration = Configuration::instance();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(configuration.getBoolValue(ConfigurationKey::FEATURE_TREZEPT));
+    }
+}
+BENCHMARK(BM_ConfigurationGetBoolValue)->Threads(1)->Threads(4)->Threads(16);
+
+void BM_ConfigurationGetStringValue(benchmark::State& state)
+{
+    const auto& configuration = Configuration::instance();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(configuration.getStringValue(ConfigurationKey::ZSTD_DICTIONARY_DIR));
+    }
+}
+BENCHMARK(BM_ConfigurationGetStringValue)->Threads(1)->Threads(4)->Threads(16);
+}
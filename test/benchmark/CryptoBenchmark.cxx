@@ -0,0 +1,72 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "mock/crypto/MockCryptography.hxx"
+#include "shared/crypto/AesGcm.hxx"
+#include "shared/crypto/Jwt.hxx"
+#include "shared/crypto/SecureRandomGenerator.hxx"
+#include "test/util/JwtBuilder.hxx"
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+
+namespace
+{
+// Payload sizes from a small VAU request up to a large bundle response.
+constexpr int64_t minPayloadSize = 1024;
+constexpr int64_t maxPayloadSize = 1024 * 1024;
+
+void BM_AesGcm128Encrypt(benchmark::State& state)
+{
+    const std::string plaintext(static_cast<size_t>(state.range(0)), 'x');
+    const auto key = SecureRandomGenerator::generate(AesGcm128::KeyLength);
+    const auto iv = SecureRandomGenerator::generate(AesGcm128::IvLength);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(AesGcm128::encrypt(plaintext, key, iv));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AesGcm128Encrypt)->RangeMultiplier(8)->Range(minPayloadSize, maxPayloadSize);
+
+void BM_AesGcm128Decrypt(benchmark::State& state)
+{
+    const std::string plaintext(static_cast<size_t>(state.range(0)), 'x');
+    const auto key = SecureRandomGenerator::generate(AesGcm128::KeyLength);
+    const auto iv = SecureRandomGenerator::generate(AesGcm128::IvLength);
+    const auto encrypted = AesGcm128::encrypt(plaintext, key, iv);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            AesGcm128::decrypt(encrypted.ciphertext, key, iv, encrypted.authenticationTag));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AesGcm128Decrypt)->RangeMultiplier(8)->Range(minPayloadSize, maxPayloadSize);
+
+void BM_JwtVerify(benchmark::State& state)
+{
+    const auto jwt = JwtBuilder::testBuilder().makeJwtVersicherter("X234567891");
+    const auto publicKey = MockCryptography::getIdpPublicKey();
+    for (auto _ : state)
+    {
+        jwt.verify(publicKey);
+    }
+}
+BENCHMARK(BM_JwtVerify);
+
+void BM_JwtParse(benchmark::State& state)
+{
+    const auto serialized = JwtBuilder::testBuilder().makeJwtVersicherter("X234567891").serialize();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(JWT{serialized});
+    }
+}
+BENCHMARK(BM_JwtParse);
+}
@@ -0,0 +1,121 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "fhirtools/model/NumberAsStringParserDocument.hxx"
+#include "fhirtools/repository/FhirStructureRepository.hxx"
+#include "fhirtools/repository/FhirValueSet.hxx"
+#include "fhirtools/repository/views/CodeCachingView.hxx"
+#include "fhirtools/validator/ValidationResult.hxx"
+#include "shared/fhir/Fhir.hxx"
+#include "shared/model/KbvBundle.hxx"
+#include "test/util/ResourceTemplates.hxx"
+
+#include <benchmark/benchmark.h>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <rapidjson/stream.h>
+#include <ranges>
+
+
+namespace
+{
+void BM_NumberAsStringParserDocumentParse(benchmark::State& state)
+{
+    const auto json = model::KbvBundle::fromXmlNoValidation(ResourceTemplates::kbvBundleXml()).serializeToJsonString();
+    for (auto _ : state)
+    {
+        model::NumberAsStringParserDocument document;
+        rapidjson::StringStream stream{json.data()};
+        document.ParseStream<rapidjson::kParseNumbersAsStringsFlag, rapidjson::CustomUtf8>(stream);
+        benchmark::DoNotOptimize(document.HasParseError());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_NumberAsStringParserDocumentParse);
+
+void BM_FhirConverterXmlToJson(benchmark::State& state)
+{
+    const auto xml = ResourceTemplates::kbvBundleXml();
+    const auto& converter = Fhir::instance().converter();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(converter.xmlStringToJson(xml));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(xml.size()));
+}
+BENCHMARK(BM_FhirConverterXmlToJson);
+
+void BM_FhirPathValidatorKbvBundle(benchmark::State& state, const char* medicationTemplatePrefix)
+{
+    const auto kbvVersion = ResourceTemplates::Versions::KBV_ERP_current();
+    const auto bundle = model::KbvBundle::fromXmlNoValidation(ResourceTemplates::kbvBundleXml(
+        {.kbvVersion = kbvVersion,
+         .medicationOptions = {.version = kbvVersion, .templatePrefix = medicationTemplatePrefix}}));
+    const auto view = bundle.getValidationView();
+    const auto options = Fhir::instance().defaultValidatorOptions(
+        bundle.getProfile(), bundle.getValidationReferenceTimestamp().value_or(model::Timestamp::now()));
+    for (auto _ : state)
+    {
+        const auto results = bundle.genericValidate(bundle.getProfile(), options, view);
+        if (results.highestSeverity() >= fhirtools::Severity::error)
+        {
+            state.SkipWithError("validation of sample bundle failed");
+            break;
+        }
+    }
+}
+BENCHMARK_CAPTURE(BM_FhirPathValidatorKbvBundle, Pzn, ResourceTemplates::MedicationOptions::PZN);
+BENCHMARK_CAPTURE(BM_FhirPathValidatorKbvBundle, Compounding, ResourceTemplates::MedicationOptions::COMPOUNDING);
+BENCHMARK_CAPTURE(BM_FhirPathValidatorKbvBundle, Ingredient, ResourceTemplates::MedicationOptions::INGREDIENT);
+
+// binding checks on large key tables (PZN, ATC, ICD) are done for every coded element during validation
+std::shared_ptr<const fhirtools::FhirValueSetCodes> largestValueSet()
+{
+    const auto& backend = Fhir::instance().backend();
+    const auto view = fhirtools::CodeCachingView::create("benchmark", backend.defaultView());
+    std::shared_ptr<const fhirtools::FhirValueSetCodes> largest;
+    for (const auto& key : backend.valueSetsByKey() | std::views::keys)
+    {
+        try
+        {
+            auto codes = view->findValueSetCodes(key);
+            if (codes && (! largest || codes->getCodes().size() > largest->getCodes().size()))
+            {
+                largest = std::move(codes);
+            }
+        }
+        catch (const std::exception&)
+        {
+            // value sets that can not be expanded in the default view are not relevant here
+        }
+    }
+    return largest;
+}
+
+void BM_ValueSetContainsCode(benchmark::State& state, bool upperCase)
+{
+    const auto valueSet = largestValueSet();
+    if (! valueSet || valueSet->getCodes().empty())
+    {
+        state.SkipWithError("no value set with codes found");
+        return;
+    }
+    std::vector<std::string> codes;
+    for (const auto& code : valueSet->getCodes())
+    {
+        codes.emplace_back(upperCase ? boost::to_upper_copy(code.code) : code.code);
+    }
+    size_t index = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(valueSet->containsCode(codes[index]));
+        index = (index + 1) % codes.size();
+    }
+    state.SetLabel(to_string(valueSet->key()) + " (" + std::to_string(codes.size()) + " codes)");
+}
+BENCHMARK_CAPTURE(BM_ValueSetContainsCode, Exact, false);
+BENCHMARK_CAPTURE(BM_ValueSetContainsCode, UpperCase, true);
+}
@@ -0,0 +1,64 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/crypto/CadesBesSignature.hxx"
+#include "shared/crypto/Certificate.hxx"
+#include "shared/crypto/EllipticCurveUtils.hxx"
+#include "shared/util/SafeString.hxx"
+#include "test/erp/pc/CFdSigErpTestHelper.hxx"
+#include "test/util/CertificateDirLoader.h"
+#include "test/util/ResourceTemplates.hxx"
+#include "test/util/TestConfiguration.hxx"
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+std::string signedKbvBundle()
+{
+    const auto privateKey =
+        EllipticCurveUtils::pemToPrivatePublicKeyPair(SafeString{CFdSigErpTestHelper::cFdSigErpPrivateKey()});
+    const auto certificate = Certificate::fromPem(CFdSigErpTestHelper::cFdSigErp());
+    return CadesBesSignature{certificate, privateKey, ResourceTemplates::kbvBundleXml()}.getBase64();
+}
+
+void BM_CadesBesSignatureParse(benchmark::State& state)
+{
+    const auto base64 = signedKbvBundle();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(CadesBesSignature{base64}.payload().size());
+    }
+}
+BENCHMARK(BM_CadesBesSignatureParse);
+
+void BM_CadesBesSignatureVerify(benchmark::State& state)
+{
+    const auto base64 = signedKbvBundle();
+    const auto trustedCertificates = CertificateDirLoader::loadDir(TestConfiguration::instance().getOptionalStringValue(
+        TestConfigurationKey::TEST_CADESBES_TRUSTED_CERT_DIR, "test/cadesBesSignature/certificates"));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(CadesBesSignature{trustedCertificates, base64}.payload().size());
+    }
+}
+BENCHMARK(BM_CadesBesSignatureVerify);
+
+void BM_CadesBesSignatureCreate(benchmark::State& state)
+{
+    const auto privateKey =
+        EllipticCurveUtils::pemToPrivatePublicKeyPair(SafeString{CFdSigErpTestHelper::cFdSigErpPrivateKey()});
+    const auto certificate = Certificate::fromPem(CFdSigErpTestHelper::cFdSigErp());
+    const auto payload = ResourceTemplates::kbvBundleXml();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(CadesBesSignature{certificate, privateKey, payload}.getBase64());
+    }
+}
+BENCHMARK(BM_CadesBesSignatureCreate);
+}
@@ -0,0 +1,36 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/fhir/Fhir.hxx"
+#include "shared/util/Environment.hxx"
+#include "shared/util/GLogConfiguration.hxx"
+
+#include <benchmark/benchmark.h>
+#include <span>
+
+
+int main(int argc, char** argv)
+{
+    if (!Environment::get("ERP_VLOG_MAX_VALUE"))
+    {
+        Environment::set("ERP_VLOG_MAX_VALUE", "0");
+    }
+    auto args = std::span(argv, size_t(argc));
+    GLogConfiguration::initLogging(args[0]);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return EXIT_FAILURE;
+    }
+    // Load the structure definitions up front, so that they are not part of the first measured iterations.
+    Fhir::init<ConfigurationBase::ERP>(Fhir::Init::now);
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return EXIT_SUCCESS;
+}
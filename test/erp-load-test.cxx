@@ -0,0 +1,167 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/fhir/Fhir.hxx"
+#include "shared/util/Environment.hxx"
+#include "shared/util/Expect.hxx"
+#include "shared/util/FileHelper.hxx"
+#include "shared/util/GLogConfiguration.hxx"
+#include "test/load-test/LoadGenerator.hxx"
+#include "test/util/StaticData.hxx"
+#include "workflow-test/HttpsTestClient.hxx"
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <span>
+#include <string_view>
+
+
+namespace
+{
+struct ShowHelp : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+template<typename T>
+T parseNumber(std::string_view option, std::string_view value)
+{
+    T result{};
+    const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+    Expect3(ec == std::errc{} && ptr == value.data() + value.size(),
+            "invalid value for " + std::string{option} + ": " + std::string{value}, ShowHelp);
+    return result;
+}
+
+void usage(std::string_view program)
+{
+    std::cerr << "usage: " << program << " [options]\n"
+              << "\n"
+              << "Sends a mix of VAU requests to the server configured by ERP_SERVER_HOST and ERP_SERVER_PORT\n"
+              << "(same as erp-integration-test) and reports throughput and latency percentiles per operation.\n"
+              << "The server is expected to run with HSM and TSL mocks, e.g. with ERP_DEBUG_ENABLE_HSM_MOCK=true\n"
+              << "and ERP_DEBUG_ENABLE_MOCK_TSL_MANAGER=true, against a local Postgres and Redis.\n"
+              << "\n"
+              << "options:\n"
+              << "  --concurrency <n>    number of workers, each with its own connection (default: 4)\n"
+              << "  --duration <s>       duration of the run in seconds (default: 60)\n"
+              << "  --mode closed|open   closed loop: next scenario starts when the previous has finished,\n"
+              << "                       open loop: scenarios start at a fixed rate (default: closed)\n"
+              << "  --rate <n>           scenarios per second in open-loop mode (default: 10)\n"
+              << "  --think-time <ms>    pause between scenarios in closed-loop mode (default: 0)\n"
+              << "  --mix <mix>          weighted scenarios: lifecycle, communication, chargeItem, getTasks\n"
+              << "                       (default: lifecycle=1), e.g. lifecycle=5,getTasks=3,communication=1\n"
+              << "  --json <file>        additionally write the results as JSON\n";
+}
+}
+
+
+int main(int argc, char** argv)
+{
+    auto args = std::span(argv, size_t(argc));
+    try
+    {
+        Environment::set("ERP_VLOG_MAX_VALUE", "0");
+        GLogConfiguration::initLogging(args[0]);
+
+        LoadGenerator::Options options;
+        std::optional<std::string> jsonFile;
+        for (size_t i = 1; i < args.size(); ++i)
+        {
+            const std::string_view option{args[i]};
+            if (option == "--help" || option == "-h")
+            {
+                throw ShowHelp{""};
+            }
+            Expect3(i + 1 < args.size(), "missing value for " + std::string{option}, ShowHelp);
+            const std::string_view value{args[++i]};
+            if (option == "--concurrency")
+            {
+                options.concurrency = parseNumber<size_t>(option, value);
+            }
+            else if (option == "--duration")
+            {
+                options.duration = std::chrono::seconds{parseNumber<int64_t>(option, value)};
+            }
+            else if (option == "--mode")
+            {
+                Expect3(value == "closed" || value == "open", "invalid mode: " + std::string{value}, ShowHelp);
+                options.mode = value == "open" ? LoadGenerator::Mode::open : LoadGenerator::Mode::closed;
+            }
+            else if (option == "--rate")
+            {
+                try
+                {
+                    options.rate = std::stod(std::string{value});
+                }
+                catch (const std::exception&)
+                {
+                    throw ShowHelp{"invalid value for --rate: " + std::string{value}};
+                }
+            }
+            else if (option == "--think-time")
+            {
+                options.thinkTime = std::chrono::milliseconds{parseNumber<int64_t>(option, value)};
+            }
+            else if (option == "--mix")
+            {
+                try
+                {
+                    options.mix = LoadGenerator::parseMix(value);
+                }
+                catch (const std::invalid_argument& e)
+                {
+                    throw ShowHelp{e.what()};
+                }
+            }
+            else if (option == "--json")
+            {
+                jsonFile.emplace(value);
+            }
+            else
+            {
+                throw ShowHelp{"unknown option: " + std::string{option}};
+            }
+        }
+
+        TestClient::setFactory(&HttpsTestClient::factory);
+        Fhir::init<ConfigurationBase::ERP>(Fhir::Init::now);
+        //  Preload to avoid that the first requests of the workers include the loading time
+        StaticData::getJsonValidator();
+        StaticData::getXmlValidator();
+
+        LoadGenerator loadGenerator{options};
+        const auto start = std::chrono::steady_clock::now();
+        const auto statistics = loadGenerator.run();
+        const auto wallTime = std::chrono::steady_clock::now() - start;
+
+        const auto summaries = statistics.summarize(wallTime);
+        LoadTestStatistics::printReport(std::cout, summaries, wallTime);
+        if (jsonFile)
+        {
+            FileHelper::writeFile(*jsonFile, LoadTestStatistics::toJson(summaries, wallTime));
+        }
+        const bool hasErrors = std::ranges::any_of(summaries, [](const auto& summary) {
+            return summary.errors > 0;
+        });
+        return hasErrors ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+    catch (const ShowHelp& showHelp)
+    {
+        if (showHelp.what()[0] != '\0')
+        {
+            std::cerr << showHelp.what() << "\n\n";
+        }
+        usage(args[0]);
+        return EXIT_FAILURE;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "load test failed: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
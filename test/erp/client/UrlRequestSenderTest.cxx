@@ -303,3 +303,43 @@ TEST_F(UrlRequestSenderTest, proxySniIsUsedAndOriginalHostInHeader)
     EXPECT_EQ(handlerPtr->receivedPath, "/test_path");
     proxyServer->shutDown();
 }
+
+
+TEST_F(UrlRequestSenderTest, connectionReuse)
+{
+    const auto& config = Configuration::instance();
+    const auto port = gsl::narrow<uint16_t>(config.serverPort() + 12);
+    auto handlerOwner = std::make_unique<ProxyVerifyingHandler>();
+    const ProxyVerifyingHandler* handlerPtr = handlerOwner.get();
+
+    RequestHandlerManager handlerManager;
+    handlerManager.onPostDo("/test_path", std::move(handlerOwner));
+    auto server = std::make_unique<HttpsServer>(HOST_IP, port, std::move(handlerManager), getServiceContext());
+    server->serve(1, "keepAliveServer");
+    UrlRequestSender urlRequestSender(
+        TlsCertificateVerifierNoVerificationImplementation::withVerificationDisabledForTesting(),
+        std::chrono::seconds(5), Constants::resolveTimeout);
+    urlRequestSender.setConnectionReuse(std::chrono::seconds{30});
+    const std::string url = fmt::format("https://127.0.0.1:{}/test_path", port);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        const auto response = urlRequestSender.send(url, HttpMethod::POST, EXPECTED_BODY);
+        EXPECT_EQ(response.getHeader().status(), HttpStatus::OK);
+        EXPECT_EQ(handlerPtr->receivedBody, EXPECTED_BODY);
+    }
+
+    // idle connections are closed and re-established with the kept TLS session
+    urlRequestSender.setConnectionReuse(std::chrono::milliseconds{1});
+    for (int i = 0; i < 2; ++i)
+    {
+        const auto response = urlRequestSender.send(url, HttpMethod::POST, EXPECTED_BODY);
+        EXPECT_EQ(response.getHeader().status(), HttpStatus::OK);
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    // a failed reconnect of a pooled connection is reported to the caller
+    server->shutDown();
+    server.reset();
+    EXPECT_ANY_THROW(urlRequestSender.send(url, HttpMethod::POST, EXPECTED_BODY));
+}
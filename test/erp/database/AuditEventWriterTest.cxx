@@ -0,0 +1,194 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "erp/database/AuditEventWriter.hxx"
+#include "erp/database/Database.hxx"
+#include "erp/pc/PcServiceContext.hxx"
+#include "test/util/ErpMacros.hxx"
+#include "test/util/StaticData.hxx"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <latch>
+#include <thread>
+
+
+class AuditEventWriterTest : public ::testing::Test
+{
+protected:
+    static model::AuditData auditData(model::AuditEventId eventId)
+    {
+        return model::AuditData{eventId,
+                                model::AuditMetaData{"Apotheke Am Grünen Baum", "3-SMC-B-Testkarte-883110000116873",
+                                                     std::nullopt},
+                                model::AuditEvent::Action::read,
+                                model::AuditEvent::AgentType::human,
+                                kvnr,
+                                4711,
+                                std::nullopt,
+                                std::nullopt};
+    }
+
+    size_t storedAuditEvents()
+    {
+        auto database = serviceContext.databaseFactory();
+        const auto auditEvents = database->retrieveAuditEventData(kvnr, {}, {}, {});
+        database->commitTransaction();
+        return auditEvents.size();
+    }
+
+    static inline const model::Kvnr kvnr{"X000000012"};
+    PcServiceContext serviceContext = StaticData::makePcServiceContext();
+};
+
+
+TEST_F(AuditEventWriterTest, queuedRecordsAreWrittenOnStop)
+{
+    const auto storedBefore = storedAuditEvents();
+    AuditEventWriter writer{[this] {
+                                return serviceContext.databaseFactory();
+                            },
+                            100, 2};
+    writer.start();
+    writer.enqueue(auditData(model::AuditEventId::GET_Task));
+    writer.enqueue(auditData(model::AuditEventId::GET_Task_id_insurant));
+    writer.enqueue(auditData(model::AuditEventId::GET_MedicationDispense));
+    writer.stop();
+
+    EXPECT_EQ(writer.queueSize(), 0);
+    EXPECT_EQ(writer.writtenRecords(), 3);
+    EXPECT_EQ(writer.droppedRecords(), 0);
+    EXPECT_EQ(storedAuditEvents(), storedBefore + 3);
+}
+
+
+TEST_F(AuditEventWriterTest, fullQueueRejectsRecords)
+{
+    std::latch writing{1};
+    std::latch proceed{1};
+    AuditEventWriter writer{[&] {
+                                if (! writing.try_wait())
+                                {
+                                    writing.count_down();
+                                }
+                                proceed.wait();
+                                return serviceContext.databaseFactory();
+                            },
+                            1, 1};
+    writer.start();
+    writer.enqueue(auditData(model::AuditEventId::GET_Task));
+    // the first record has been taken from the queue by the writer, which is now blocked
+    writing.wait();
+    writer.enqueue(auditData(model::AuditEventId::GET_Task));
+    EXPECT_ERP_EXCEPTION(writer.enqueue(auditData(model::AuditEventId::GET_Task)), HttpStatus::ServiceUnavailable);
+    proceed.count_down();
+    writer.stop();
+
+    EXPECT_EQ(writer.writtenRecords(), 2);
+}
+
+
+TEST_F(AuditEventWriterTest, stoppedWriterRejectsRecords)
+{
+    AuditEventWriter writer{[this] {
+                                return serviceContext.databaseFactory();
+                            },
+                            100, 10};
+    EXPECT_ERP_EXCEPTION(writer.enqueue(auditData(model::AuditEventId::GET_Task)), HttpStatus::ServiceUnavailable);
+}
+
+
+TEST_F(AuditEventWriterTest, failingRecordsAreDropped)
+{
+    // records are only dropped if they still fail when the writer is stopped
+    AuditEventWriter writer{[]() -> std::unique_ptr<Database> {
+                                throw std::runtime_error("database not available");
+                            },
+                            100, 10};
+    writer.start();
+    writer.enqueue(auditData(model::AuditEventId::GET_Task));
+    writer.enqueue(auditData(model::AuditEventId::GET_Task));
+    writer.stop();
+
+    EXPECT_EQ(writer.writtenRecords(), 0);
+    EXPECT_EQ(writer.droppedRecords(), 2);
+}
+
+
+TEST_F(AuditEventWriterTest, failingRecordsAreKeptForRetry)
+{
+    const auto storedBefore = storedAuditEvents();
+    std::atomic_bool failing{true};
+    AuditEventWriter writer{[&]() -> std::unique_ptr<Database> {
+                                if (failing)
+                                {
+                                    throw std::runtime_error("database not available");
+                                }
+                                return serviceContext.databaseFactory();
+                            },
+                            100, 10};
+    writer.start();
+    EXPECT_NO_THROW(writer.healthCheck());
+    writer.enqueue(auditData(model::AuditEventId::GET_Task));
+    writer.enqueue(auditData(model::AuditEventId::GET_Task_id_insurant));
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while ((writer.failedRecords() == 0 || writer.queueSize() == 0) && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    ASSERT_EQ(writer.failedRecords(), 2);
+    EXPECT_THROW(writer.healthCheck(), std::runtime_error);
+    EXPECT_EQ(writer.queueSize(), 2);
+
+    failing = false;
+    writer.stop();
+
+    EXPECT_EQ(writer.writtenRecords(), 2);
+    EXPECT_EQ(writer.droppedRecords(), 0);
+    EXPECT_EQ(writer.failedRecords(), 0);
+    EXPECT_NO_THROW(writer.healthCheck());
+    EXPECT_EQ(storedAuditEvents(), storedBefore + 2);
+}
+
+
+TEST_F(AuditEventWriterTest, reservationCountsAgainstCapacity)
+{
+    AuditEventWriter writer{[this] {
+                                return serviceContext.databaseFactory();
+                            },
+                            1, 1};
+    writer.start();
+    {
+        auto reservation = writer.reserve();
+        EXPECT_ERP_EXCEPTION(writer.reserve(), HttpStatus::ServiceUnavailable);
+    }
+    // the unused reservation has been released
+    auto reservation = writer.reserve();
+    reservation.enqueue(auditData(model::AuditEventId::GET_Task));
+    writer.stop();
+
+    EXPECT_EQ(writer.writtenRecords(), 1);
+}
+
+
+TEST_F(AuditEventWriterTest, reservationOfStoppedWriterIsWrittenSynchronously)
+{
+    const auto storedBefore = storedAuditEvents();
+    AuditEventWriter writer{[this] {
+                                return serviceContext.databaseFactory();
+                            },
+                            100, 10};
+    writer.start();
+    auto reservation = writer.reserve();
+    writer.stop();
+    reservation.enqueue(auditData(model::AuditEventId::GET_Task));
+
+    EXPECT_EQ(writer.queueSize(), 0);
+    EXPECT_EQ(writer.writtenRecords(), 1);
+    EXPECT_EQ(storedAuditEvents(), storedBefore + 1);
+}
@@ -20,6 +20,7 @@
 #include "shared/model/Binary.hxx"
 #include "shared/model/MedicationDispense.hxx"
 #include "shared/model/MedicationDispenseBundle.hxx"
+#include "shared/util/Expect.hxx"
 #include "test/erp/database/PostgresDatabaseTestFixture.hxx"
 #include "test/util/JsonTestUtils.hxx"
 #include "test/util/ResourceManager.hxx"
@@ -62,7 +63,11 @@ protected:
         task.setPrescriptionId(prescriptionId);
         task.updateLastMedicationDispense();
         task.setIsPkv(isPkv);
-        db.activateTask(task, model::Binary{binId, binData}, JwtBuilder::testBuilder().makeJwtArzt());
+        const auto taskKey = db.retrieveTaskForUpdate(prescriptionId)->key;
+        Expect(taskKey.has_value(), "missing task key");
+        db.activateTask(task, *taskKey, model::Binary{binId, binData},
+                        db_model::PrescriptionSignatureMetadata{"digest"},
+                        JwtBuilder::testBuilder().makeJwtArzt());
         auto erxReceipt =
             model::ErxReceipt::fromJsonNoValidation(ResourceManager::instance().getStringResource(erxBundleResource));
         std::vector<model::MedicationDispense> medicationDispenses;
@@ -158,6 +163,7 @@ TEST_P(DatabaseEncryptionTestP, TableViewTask)
             eu_redeemable_patient,
             eu_redeemable,
             is_pkv,
+            prescription_metadata,
             COUNT
         };
     };
@@ -278,6 +284,12 @@ TEST_P(DatabaseEncryptionTestP, TableViewTask)
     //     not encrypted
     // 27: is_pkv
     //     not encrypted
+    // 28: prescription_metadata
+    db_model::EncryptedBlob encryptedPrescriptionMetadata{
+        row[col::prescription_metadata].as<db_model::postgres_bytea>()};
+    SafeString decryptedPrescriptionMetadata;
+    ASSERT_NO_THROW(decryptedPrescriptionMetadata = getDBCodec().decode(encryptedPrescriptionMetadata, taskKey));
+    EXPECT_EQ(decryptedPrescriptionMetadata, SafeString{R"({"version":1,"digest":"ZGlnZXN0"})"});
     A_19688.finish();
 }
 
@@ -6,6 +6,7 @@
 
 #include "erp/database/ErpDatabaseModel.hxx"
 #include "shared/database/AccessTokenIdentity.hxx"
+#include "shared/database/PrescriptionSignatureMetadata.hxx"
 #include "test/util/JwtBuilder.hxx"
 
 #include <gtest/gtest.h>
@@ -78,3 +79,23 @@ TEST_F(ErpDatabaseModelTest, AccessToken_InvalidJson)
         EXPECT_STREQ(exc.what(), expectedString);
     }
 }
+
+
+TEST_F(ErpDatabaseModelTest, PrescriptionSignatureMetadata_roundTrip)
+{
+    const std::string digest{"\x00\x01\xfe\xff digest", 11};
+    const db_model::PrescriptionSignatureMetadata metadata{digest};
+    const auto restored = db_model::PrescriptionSignatureMetadata::fromJson(metadata.getJson());
+    EXPECT_EQ(restored.getMessageDigest(), digest);
+}
+
+
+TEST_F(ErpDatabaseModelTest, PrescriptionSignatureMetadata_InvalidJson)
+{
+    EXPECT_THROW(db_model::PrescriptionSignatureMetadata::fromJson("{"),
+                 db_model::PrescriptionSignatureMetadata::Exception);
+    EXPECT_THROW(db_model::PrescriptionSignatureMetadata::fromJson(R"({"digest": "AAE="})"),
+                 db_model::PrescriptionSignatureMetadata::Exception);
+    EXPECT_THROW(db_model::PrescriptionSignatureMetadata::fromJson(R"({"version": 1})"),
+                 db_model::PrescriptionSignatureMetadata::Exception);
+}
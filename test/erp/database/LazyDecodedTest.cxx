@@ -0,0 +1,70 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "erp/database/LazyDecoded.hxx"
+#include "shared/model/Binary.hxx"
+#include "shared/model/ModelException.hxx"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+
+TEST(LazyDecodedTest, parsedOnFirstAccess)
+{
+    const model::Binary binary{"bin-id", "ZGF0YQ=="};
+    const LazyDecoded<model::Binary> lazy{SafeString{binary.serializeToJsonString()}};
+    EXPECT_FALSE(lazy.isParsed());
+
+    ASSERT_TRUE(lazy.get().data().has_value());
+    EXPECT_EQ(*lazy.get().data(), "ZGF0YQ==");
+    EXPECT_TRUE(lazy.isParsed());
+    EXPECT_EQ(&lazy.get(), &lazy.get());
+}
+
+
+TEST(LazyDecodedTest, alreadyParsed)
+{
+    LazyDecoded<model::Binary> lazy{model::Binary{"bin-id", "ZGF0YQ=="}};
+    EXPECT_TRUE(lazy.isParsed());
+    EXPECT_EQ(lazy.get().getId(), "bin-id");
+}
+
+
+TEST(LazyDecodedTest, invalidJson)
+{
+    const LazyDecoded<model::Binary> lazy{SafeString{"{no json"}};
+    EXPECT_THROW((void) lazy.get(), model::ModelException);
+    EXPECT_FALSE(lazy.isParsed());
+}
+
+
+TEST(LazyDecodedTest, decryptedOnFirstAccess)
+{
+    const model::Binary binary{"bin-id", "ZGF0YQ=="};
+    size_t decryptCalls = 0;
+    const LazyDecoded<model::Binary> lazy{[&binary, &decryptCalls] {
+        ++decryptCalls;
+        return SafeString{binary.serializeToJsonString()};
+    }};
+    EXPECT_FALSE(lazy.isParsed());
+    EXPECT_EQ(decryptCalls, 0);
+
+    EXPECT_EQ(lazy.get().getId(), "bin-id");
+    EXPECT_EQ(lazy.get().getId(), "bin-id");
+    EXPECT_EQ(decryptCalls, 1);
+    EXPECT_TRUE(lazy.isParsed());
+}
+
+
+TEST(LazyDecodedTest, decryptionFails)
+{
+    const LazyDecoded<model::Binary> lazy{[]() -> SafeString {
+        throw std::runtime_error("decryption failed");
+    }};
+    EXPECT_THROW((void) lazy.get(), std::runtime_error);
+    EXPECT_FALSE(lazy.isParsed());
+}
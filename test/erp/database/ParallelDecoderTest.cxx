@@ -0,0 +1,117 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "erp/database/ParallelDecoder.hxx"
+#include "shared/util/TLog.hxx"
+
+#include <gtest/gtest.h>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+
+TEST(ParallelDecoderTest, resultsKeepRowOrder)
+{
+    const ParallelDecoder decoder{3, 2};
+    std::vector<int> rows(101);
+    std::iota(rows.begin(), rows.end(), 0);
+
+    const auto results = decoder.transform(rows, [](int row) {
+        return std::to_string(row);
+    });
+
+    ASSERT_EQ(results.size(), rows.size());
+    for (size_t index = 0; index < rows.size(); ++index)
+    {
+        EXPECT_EQ(results[index], std::to_string(rows[index]));
+    }
+}
+
+
+TEST(ParallelDecoderTest, smallResultsAreDecodedInline)
+{
+    const ParallelDecoder decoder{3, 16};
+    const std::vector<int> rows(15, 1);
+    const auto callingThread = std::this_thread::get_id();
+
+    const auto results = decoder.transform(rows, [](int) {
+        return std::this_thread::get_id();
+    });
+
+    ASSERT_EQ(results.size(), rows.size());
+    for (const auto& threadId : results)
+    {
+        EXPECT_EQ(threadId, callingThread);
+    }
+}
+
+
+TEST(ParallelDecoderTest, largeResultsUseHelperThreads)
+{
+    const ParallelDecoder decoder{2, 4};
+    const std::vector<int> rows(30, 1);
+    const auto callingThread = std::this_thread::get_id();
+
+    const auto results = decoder.transform(rows, [](int) {
+        return std::this_thread::get_id();
+    });
+
+    ASSERT_EQ(results.size(), rows.size());
+    // The first chunk is always processed by the calling thread, the last one by a helper thread.
+    EXPECT_EQ(results.front(), callingThread);
+    EXPECT_NE(results.back(), callingThread);
+}
+
+
+TEST(ParallelDecoderTest, logContextIsPropagated)
+{
+    const ParallelDecoder decoder{2, 4};
+    const std::vector<int> rows(30, 1);
+    const ScopedLogContext scopedLogContext{"request-id"};
+
+    const auto results = decoder.transform(rows, [](int) {
+        return tlogContext;
+    });
+
+    ASSERT_EQ(results.size(), rows.size());
+    for (const auto& logContext : results)
+    {
+        EXPECT_EQ(logContext, "request-id");
+    }
+}
+
+
+TEST(ParallelDecoderTest, exceptionsArePropagated)
+{
+    const ParallelDecoder decoder{2, 4};
+    std::vector<int> rows(30);
+    std::iota(rows.begin(), rows.end(), 0);
+
+    EXPECT_THROW((void) decoder.transform(rows,
+                                         [](int row) {
+                                             if (row == 29)
+                                             {
+                                                 throw std::runtime_error("decoding failed");
+                                             }
+                                             return row;
+                                         }),
+                 std::runtime_error);
+}
+
+
+TEST(ParallelDecoderTest, withoutHelperThreads)
+{
+    const ParallelDecoder decoder{0, 0};
+    const std::vector<int> rows{1, 2, 3};
+
+    const auto results = decoder.transform(rows, [](int row) {
+        return row * 2;
+    });
+
+    EXPECT_EQ(results, (std::vector<int>{2, 4, 6}));
+}
@@ -131,6 +131,23 @@ public:
         return search;
     }
 
+    UrlArguments keysetPaging(bool reverse, size_t perPage,
+                              const std::optional<PagingArgument::SeekPosition>& seek = std::nullopt)
+    {
+        auto search = UrlArguments({{"authored-on", "authored_on", SearchParameter::Type::Date}});
+        search.enableKeysetPaging();
+        auto request = ServerRequest(Header());
+        std::vector<std::pair<std::string, std::string>> queryParameters{
+            {"_sort", reverse ? "-authored-on" : "authored-on"}, {"_count", std::to_string(perPage)}};
+        if (seek.has_value())
+        {
+            queryParameters.emplace_back("__seek", PagingArgument::seekValue(*seek));
+        }
+        request.setQueryParameters(queryParameters);
+        search.parse(request, getKeyDerivation());
+        return search;
+    }
+
     void setupTasks(size_t nTasks, const model::Kvnr& kvnr, std::vector<model::Task>& outTasks,
                     model::PrescriptionType prescriptionType = std::get<model::PrescriptionType>(GetParam()))
     {
@@ -430,6 +447,67 @@ TEST_P(PostgresDatabaseTaskTest, retrieveHealthCareProviderPrescription)
     ASSERT_EQ(std::string(healthCareProviderPrescription.value().data().value()), "HealthCareProviderPrescription");
 }
 
+TEST_P(PostgresDatabaseTaskTest, retrievePrescriptionMetadata)
+{
+    if (!usePostgres())
+    {
+        GTEST_SKIP();
+    }
+
+    std::vector<model::PrescriptionId> ids;
+    for (size_t i = 0; i < 2; ++i)
+    {
+        model::Task task(prescriptionType(), "access_code");
+        task.setPrescriptionId(database().storeTask(task));
+        database().commitTransaction();
+        task.setKvnr(model::Kvnr{std::string{"X123456788"}});
+        task.setAcceptDate(model::Timestamp::now());
+        task.setExpiryDate(model::Timestamp::now());
+        task.setIsPkv(isPkv());
+        const model::Binary prescription{Uuid().toString(), "HealthCareProviderPrescription"};
+        if (i == 0)
+        {
+            const auto taskAndKey = database().retrieveTaskForUpdate(task.prescriptionId());
+            ASSERT_TRUE(taskAndKey.has_value() && taskAndKey->key.has_value());
+            database().activateTask(task, *taskAndKey->key, prescription,
+                                    db_model::PrescriptionSignatureMetadata{"digest"},
+                                    mJwtBuilder.makeJwtArzt());
+        }
+        else
+        {
+            database().activateTask(task, prescription, mJwtBuilder.makeJwtArzt());
+        }
+        database().commitTransaction();
+        ids.emplace_back(task.prescriptionId());
+    }
+
+    {
+        const auto [task, metadata, prescription] = database().retrieveTaskForUpdateAndPrescriptionMetadata(ids[0]);
+        database().commitTransaction();
+        ASSERT_TRUE(task.has_value());
+        ASSERT_TRUE(metadata.has_value());
+        EXPECT_EQ(metadata->getMessageDigest(), "digest");
+        EXPECT_FALSE(prescription.has_value());
+    }
+    {
+        // the prescription column is not selected
+        const auto dbTask = database().getBackend().retrieveTaskForUpdateAndPrescriptionMetadata(ids[0]);
+        database().commitTransaction();
+        ASSERT_TRUE(dbTask.has_value());
+        EXPECT_TRUE(dbTask->prescriptionMetadata.has_value());
+        EXPECT_FALSE(dbTask->healthcareProviderPrescription.has_value());
+    }
+    {
+        // activated without metadata, the prescription is provided instead
+        const auto [task, metadata, prescription] = database().retrieveTaskForUpdateAndPrescriptionMetadata(ids[1]);
+        database().commitTransaction();
+        ASSERT_TRUE(task.has_value());
+        EXPECT_FALSE(metadata.has_value());
+        ASSERT_TRUE(prescription.has_value());
+        EXPECT_EQ(std::string(prescription->data().value()), "HealthCareProviderPrescription");
+    }
+}
+
 // GEMREQ-start A_19115-01
 TEST_P(PostgresDatabaseTaskTest, retrieveAllTasksForPatient)//NOLINT(readability-function-cognitive-complexity)
 {
@@ -1171,6 +1249,71 @@ TEST_P(PostgresDatabaseTaskTest, SearchTasksPaging)//NOLINT(readability-function
     cleanKvnr(kvnr1, taskTableName());
 }
 
+TEST_P(PostgresDatabaseTaskTest, SearchTasksKeysetPagingWithEqualTimestamps)//NOLINT(readability-function-cognitive-complexity)
+{
+    if (!usePostgres())
+    {
+        GTEST_SKIP();
+    }
+
+    const auto kvnr1 = model::Kvnr{"X012341234"};
+
+    cleanKvnr(kvnr1, taskTableName(model::PrescriptionType::apothekenpflichigeArzneimittel));
+    cleanKvnr(kvnr1, taskTableName(model::PrescriptionType::direkteZuweisung));
+
+    std::vector<model::Task> tasks;
+
+    setupTasks(3, kvnr1, tasks, model::PrescriptionType::apothekenpflichigeArzneimittel);
+    setupTasks(2, kvnr1, tasks, model::PrescriptionType::direkteZuweisung);
+
+    {
+        // The first four tasks share the same millisecond, partly with different sub-millisecond parts, and
+        // straddle the page boundaries with two entries per page.
+        const std::array<std::string, 5> authoredOn{
+            "2023-02-15T00:00:00.123456+00:00", "2023-02-15T00:00:00.123+00:00", "2023-02-15T00:00:00.123999+00:00",
+            "2023-02-15T00:00:00.123456+00:00", "2023-02-15T00:00:01+00:00"};
+        auto&& txn = createTransaction();
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            const auto& id = tasks[i].prescriptionId();
+            txn.exec("UPDATE " + taskTableName(id.type()) + " SET authored_on = '" + authoredOn.at(i) +
+                     "' WHERE prescription_id = " + std::to_string(id.toDatabaseId()));
+        }
+        txn.commit();
+    }
+
+    for (const bool reverse : {false, true})
+    {
+        std::vector<std::string> ids;
+        std::optional<PagingArgument::SeekPosition> seek;
+        size_t pages = 0;
+        do
+        {
+            auto [page, total, nextSeek] =
+                database().retrieveAllTasksForPatientWithTotal(kvnr1, keysetPaging(reverse, 2, seek));
+            ++pages;
+            EXPECT_EQ(total, 5);
+            EXPECT_LE(page.size(), 2);
+            for (const auto& task : page)
+            {
+                ids.emplace_back(task.prescriptionId().toString());
+            }
+            // There is no next page behind the last entry.
+            EXPECT_EQ(nextSeek.has_value(), ids.size() < tasks.size());
+            seek = nextSeek;
+        } while (seek.has_value() && pages < 5);
+
+        EXPECT_EQ(pages, 3);
+        ASSERT_EQ(ids.size(), tasks.size());
+        EXPECT_EQ(std::set<std::string>(ids.begin(), ids.end()).size(), tasks.size());
+        EXPECT_EQ(reverse ? ids.front() : ids.back(), tasks.back().prescriptionId().toString());
+    }
+    database().commitTransaction();
+
+    cleanKvnr(kvnr1, taskTableName(model::PrescriptionType::apothekenpflichigeArzneimittel));
+    cleanKvnr(kvnr1, taskTableName(model::PrescriptionType::direkteZuweisung));
+}
+
 TEST_P(PostgresDatabaseTaskTest, createAndReadAuditEventData)//NOLINT(readability-function-cognitive-complexity)
 {
     if (!usePostgres())
@@ -95,3 +95,26 @@ TEST_F(IdpTest, setSecondaryCertificate)
     idp.resetSecondaryCertificate();
     ASSERT_FALSE(idp.getSecondaryCertificate().has_value());
 }
+
+
+TEST_F(IdpTest, generationChangesWithCertificate)
+{
+    Idp idp;
+    const auto initial = idp.getGeneration();
+    const auto certificate = Certificate::createSelfSignedCertificateMock(MockCryptography::getEciesPrivateKey());
+
+    idp.setCertificate(Certificate{certificate});
+    const auto afterSet = idp.getGeneration();
+    EXPECT_NE(afterSet, initial);
+
+    // an unchanged certificate keeps the verified access tokens
+    idp.setCertificate(Certificate{certificate});
+    EXPECT_EQ(idp.getGeneration(), afterSet);
+
+    idp.setSecondaryCertificate(Certificate::createSelfSignedCertificateMock(MockCryptography::getIdpPrivateKey()));
+    EXPECT_NE(idp.getGeneration(), afterSet);
+
+    const auto beforeReset = idp.getGeneration();
+    idp.resetCertificate();
+    EXPECT_NE(idp.getGeneration(), beforeReset);
+}
@@ -0,0 +1,76 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/idp/VerifiedTokenCache.hxx"
+#include "shared/crypto/Jwt.hxx"
+#include "test/util/JwtBuilder.hxx"
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+
+TEST(VerifiedTokenCacheTest, verifiedTokenIsFound)
+{
+    VerifiedTokenCache cache{1h};
+    const auto token = JwtBuilder::testBuilder().makeJwtArzt();
+    const auto otherToken = JwtBuilder::testBuilder().makeJwtApotheke();
+
+    EXPECT_FALSE(cache.contains(token, 1));
+    cache.store(token, 1);
+    EXPECT_TRUE(cache.contains(token, 1));
+    EXPECT_FALSE(cache.contains(otherToken, 1));
+    EXPECT_EQ(cache.size(), 1);
+}
+
+
+TEST(VerifiedTokenCacheTest, newIdpGenerationInvalidatesEntries)
+{
+    VerifiedTokenCache cache{1h};
+    const auto token = JwtBuilder::testBuilder().makeJwtArzt();
+
+    cache.store(token, 1);
+    EXPECT_FALSE(cache.contains(token, 2));
+    // the outdated entry has been removed
+    EXPECT_EQ(cache.size(), 0);
+}
+
+
+TEST(VerifiedTokenCacheTest, expiredTokensAreNotStored)
+{
+    VerifiedTokenCache cache{1h};
+    JwtBuilder::JwtClaimsOptions options;
+    options.exp = "1585336999";
+    const auto token = JwtBuilder::testBuilder().makeJwt(options);
+
+    cache.store(token, 1);
+    EXPECT_FALSE(cache.contains(token, 1));
+    EXPECT_EQ(cache.size(), 0);
+}
+
+
+TEST(VerifiedTokenCacheTest, disabledCache)
+{
+    VerifiedTokenCache cache{0s};
+    const auto token = JwtBuilder::testBuilder().makeJwtArzt();
+
+    cache.store(token, 1);
+    EXPECT_FALSE(cache.contains(token, 1));
+    EXPECT_EQ(cache.size(), 0);
+}
+
+
+TEST(VerifiedTokenCacheTest, fullCacheIsCleared)
+{
+    VerifiedTokenCache cache{1h, 2};
+
+    cache.store(JwtBuilder::testBuilder().makeJwtArzt(), 1);
+    cache.store(JwtBuilder::testBuilder().makeJwtApotheke(), 1);
+    EXPECT_EQ(cache.size(), 2);
+    cache.store(JwtBuilder::testBuilder().makeJwtKostentraeger(), 1);
+    EXPECT_EQ(cache.size(), 1);
+}
@@ -0,0 +1,68 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "fhirtools/model/JsonArena.hxx"
+
+#include <gtest/gtest.h>
+#include <optional>
+
+using model::JsonArena;
+using model::NumberAsStringParserDocument;
+
+
+TEST(JsonArenaTest, documentsInScopeShareTheArena)
+{
+    auto arena = std::make_shared<JsonArena>();
+    {
+        const JsonArena::Scope scope{arena};
+        auto first = NumberAsStringParserDocument::fromJson(R"({"resourceType":"Task","id":"160.000.000.000.001.01"})");
+        NumberAsStringParserDocument second;
+        second.CopyFrom(first, second.GetAllocator());
+        EXPECT_EQ(&first.GetAllocator(), &arena->allocator());
+        EXPECT_EQ(&second.GetAllocator(), &arena->allocator());
+        EXPECT_EQ(second.serializeToJsonString(), R"({"resourceType":"Task","id":"160.000.000.000.001.01"})");
+    }
+    EXPECT_EQ(arena->documentCount(), 2);
+    EXPECT_GT(arena->usedBytes(), 0);
+    EXPECT_GE(arena->capacityBytes(), arena->usedBytes());
+
+    NumberAsStringParserDocument outsideScope;
+    EXPECT_NE(&outsideScope.GetAllocator(), &arena->allocator());
+    EXPECT_EQ(arena->documentCount(), 2);
+}
+
+
+TEST(JsonArenaTest, documentsKeepTheArenaAlive)
+{
+    auto arena = std::make_shared<JsonArena>();
+    std::weak_ptr<JsonArena> weakArena = arena;
+    std::optional<NumberAsStringParserDocument> document;
+    {
+        const JsonArena::Scope scope{std::move(arena)};
+        auto parsed = NumberAsStringParserDocument::fromJson(R"({"value":1.0})");
+        document.emplace(std::move(parsed));
+    }
+    EXPECT_FALSE(weakArena.expired());
+    EXPECT_EQ(document->serializeToJsonString(), R"({"value":1.0})");
+    document.reset();
+    EXPECT_TRUE(weakArena.expired());
+}
+
+
+TEST(JsonArenaTest, nestedScopes)
+{
+    auto outer = std::make_shared<JsonArena>();
+    const JsonArena::Scope outerScope{outer};
+    {
+        const JsonArena::Scope withoutArena{nullptr};
+        NumberAsStringParserDocument document;
+        EXPECT_NE(&document.GetAllocator(), &outer->allocator());
+    }
+    NumberAsStringParserDocument document;
+    EXPECT_EQ(&document.GetAllocator(), &outer->allocator());
+    EXPECT_EQ(outer->documentCount(), 1);
+}
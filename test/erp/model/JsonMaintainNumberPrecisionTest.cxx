@@ -624,6 +624,20 @@ TEST(JsonMaintainNumberPrecisionTest, makeString)
               R"({"aString":"some test string","trailingSpace":"Space-> ","leadingSpace":" <-Space"})");
 }
 
+TEST(JsonMaintainNumberPrecisionTest, stringValueEquals)//NOLINT(readability-function-cognitive-complexity)
+{
+    model::NumberAsStringParserDocument doc;
+    const auto str = doc.makeString("Composition");
+    EXPECT_TRUE(NumberAsStringParserDocument::stringValueEquals(str, "Composition"));
+    EXPECT_FALSE(NumberAsStringParserDocument::stringValueEquals(str, "composition"));
+    EXPECT_TRUE(NumberAsStringParserDocument::stringValueEquals(str, "composition", true));
+    EXPECT_FALSE(NumberAsStringParserDocument::stringValueEquals(str, "Compositio"));
+    EXPECT_FALSE(NumberAsStringParserDocument::stringValueEquals(str, ""));
+    const auto number = doc.makeNumber("12");
+    EXPECT_FALSE(NumberAsStringParserDocument::stringValueEquals(number, "12"));
+    EXPECT_FALSE(NumberAsStringParserDocument::stringValueEquals(doc.makeBool(true), "true"));
+}
+
 TEST(JsonMaintainNumberPrecisionTest, validNumbers)//NOLINT(readability-function-cognitive-complexity)
 {
     model::NumberAsStringParserDocument doc;
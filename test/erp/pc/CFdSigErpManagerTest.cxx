@@ -6,6 +6,8 @@
  */
 
 #include "erp/pc/CFdSigErpManager.hxx"
+#include "shared/tsl/OcspHelper.hxx"
+#include "shared/tsl/TrustStore.hxx"
 #include "shared/tsl/error/TslError.hxx"
 #include "shared/util/Configuration.hxx"
 #include "test/erp/pc/CFdSigErpTestHelper.hxx"
@@ -179,6 +181,67 @@ TEST_F(CFdSigErpManagerTest, tslManagerSet_success)//NOLINT(readability-function
 }
 
 
+TEST_F(CFdSigErpManagerTest, ocspResponseServedFromSnapshot)
+{
+    PcServiceContext context{StaticData::makePcServiceContext()};
+    std::shared_ptr<CountingUrlRequestSenderMock> requestSender =
+        CFdSigErpTestHelper::createRequestSender<CountingUrlRequestSenderMock>();
+
+    auto cert = Certificate::fromPem(CFdSigErpTestHelper::cFdSigErp());
+    auto certCA = Certificate::fromPem(CFdSigErpTestHelper::cFdSigErpSigner());
+    const std::string ocspUrl(CFdSigErpTestHelper::cFsSigErpOcspUrl());
+    std::shared_ptr<TslManager> tslManager = TslTestHelper::createTslManager<TslManager>(
+        requestSender, {}, {{ocspUrl, {{cert, certCA, MockOcsp::CertificateOcspTestMode::SUCCESS}}}});
+
+    CFdSigErpManager cFdSigErpManager(Configuration::instance(), *tslManager, context.getHsmPool());
+    ASSERT_EQ(requestSender->getCounter(ocspUrl), 1);
+
+    const auto first = cFdSigErpManager.getOcspResponseData(false);
+    const auto second = cFdSigErpManager.getOcspResponseData(false);
+    EXPECT_TRUE(first.fromCache);
+    EXPECT_EQ(first.response, second.response);
+    EXPECT_EQ(first.producedAt, second.producedAt);
+    auto ocspResponse = cFdSigErpManager.getOcspResponse();
+    ASSERT_NE(ocspResponse, nullptr);
+    EXPECT_EQ(OcspHelper::ocspResponseToString(*ocspResponse), first.response);
+    EXPECT_EQ(requestSender->getCounter(ocspUrl), 1);
+
+    // a forced request replaces the snapshot
+    const auto forced = cFdSigErpManager.getOcspResponseData(true);
+    EXPECT_FALSE(forced.fromCache);
+    EXPECT_EQ(requestSender->getCounter(ocspUrl), 2);
+    EXPECT_EQ(cFdSigErpManager.getOcspResponseData(false).producedAt, forced.producedAt);
+}
+
+
+TEST_F(CFdSigErpManagerTest, ocspSnapshotNotUsedAfterDistrust)
+{
+    PcServiceContext context{StaticData::makePcServiceContext()};
+    std::shared_ptr<CountingUrlRequestSenderMock> requestSender =
+        CFdSigErpTestHelper::createRequestSender<CountingUrlRequestSenderMock>();
+
+    auto cert = Certificate::fromPem(CFdSigErpTestHelper::cFdSigErp());
+    auto certCA = Certificate::fromPem(CFdSigErpTestHelper::cFdSigErpSigner());
+    const std::string ocspUrl(CFdSigErpTestHelper::cFsSigErpOcspUrl());
+    auto tslTrustStore =
+        std::make_unique<TrustStore>(TslMode::TSL, std::vector<std::string>{TslTestHelper::tslDownloadUrl});
+    TrustStore& trustStore = *tslTrustStore;
+    std::shared_ptr<TslManager> tslManager = TslTestHelper::createTslManager<TslManager>(
+        requestSender, {}, {{ocspUrl, {{cert, certCA, MockOcsp::CertificateOcspTestMode::SUCCESS}}}}, std::nullopt,
+        std::move(tslTrustStore));
+
+    CFdSigErpManager cFdSigErpManager(Configuration::instance(), *tslManager, context.getHsmPool());
+    ASSERT_NO_THROW(cFdSigErpManager.getOcspResponseData(false));
+    ASSERT_NE(cFdSigErpManager.getOcspResponse(), nullptr);
+
+    // without trusted CAs the certificate can not be validated any more, the snapshot must not hide that
+    trustStore.distrustCertificates();
+    EXPECT_THROW(cFdSigErpManager.getOcspResponseData(false), TslError);
+    EXPECT_THROW((void)cFdSigErpManager.getOcspResponse(), TslError);
+    EXPECT_THROW((void)cFdSigErpManager.getCertificate(), TslError);
+}
+
+
 TEST_F(CFdSigErpManagerTest, timerUpdate_success)
 {
     EnvironmentVariableGuard ocspGracePeriodGuard("ERP_C_FD_SIG_ERP_VALIDATION_INTERVAL", "1");
@@ -176,9 +176,10 @@ public:
 
         mTrustStore = TslTestHelper::createTslTrustStore();
 
-        auto iterator = mTrustStore->mServiceInformationMap.find(
+        const auto trustStoreContent = mTrustStore->content();
+        auto iterator = trustStoreContent->serviceInformationMap.find(
             {certificate.getIssuer(), certificate.getAuthorityKeyIdentifier()});
-        EXPECT_NE(mTrustStore->mServiceInformationMap.end(), iterator);
+        EXPECT_NE(trustStoreContent->serviceInformationMap.end(), iterator);
 
         std::map<std::string, const std::vector<MockOcsp::CertificatePair>> ocspResponderKnownCertificateCaPairs = {
             {"http://ocsp-testref.tsl.telematik-test/ocsp",
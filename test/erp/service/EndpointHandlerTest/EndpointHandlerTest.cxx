@@ -42,6 +42,7 @@
 #include "test/erp/service/EndpointHandlerTest/EndpointHandlerTestFixture.hxx"
 #include "test/mock/MockDatabase.hxx"
 #include "test/util/CertificateDirLoader.h"
+#include "test/util/EnvironmentVariableGuard.hxx"
 #include "test/util/ErpMacros.hxx"
 #include "test/util/JsonTestUtils.hxx"
 #include "test/util/JwtBuilder.hxx"
@@ -50,6 +51,7 @@
 #include "test/util/TestUtils.hxx"
 
 #include <gtest/gtest.h>
+#include <set>
 #include <variant>
 
 namespace fs = std::filesystem;
@@ -628,6 +630,72 @@ TEST_F(EndpointHandlerTest, GetAllTasksErp6560)//NOLINT(readability-function-cog
     }
 }
 
+TEST_F(EndpointHandlerTest, GetAllTasksErp6560_KeysetPaging)//NOLINT(readability-function-cognitive-complexity)
+{
+    // keyset paging is enabled in the production configuration
+    EnvironmentVariableGuard keysetPaging{"ERP_SERVICE_TASK_GET_KEYSET_PAGING", "true"};
+    GetAllTasksHandler handler({});
+    const auto jwt = JwtBuilder::testBuilder().makeJwtVersicherter("X123456788");
+
+    {
+        Header requestHeader{HttpMethod::GET, "/Task/", 0, {}, HttpStatus::Unknown};
+        ServerRequest serverRequest{std::move(requestHeader)};
+        ServerResponse serverResponse;
+        AccessLog accessLog;
+        SessionContext sessionContext{mServiceContext, serverRequest, serverResponse, accessLog};
+        for (int i = 0; i < 110; ++i)
+        {
+            addTaskToDatabase(sessionContext, model::Task::Status::ready, "access-code", "X123456788");
+        }
+    }
+
+    const std::string linkBase = "https://gematik.erppre.de:443/Task?_sort=authored-on&_count=50";
+    std::vector<std::pair<std::string, std::string>> queryParameters;
+    std::set<std::string> ids;
+    for (const size_t expectedCount : std::initializer_list<size_t>{50, 50, 13})
+    {
+        Header requestHeader{HttpMethod::GET, "/Task/", 0, {}, HttpStatus::Unknown};
+        ServerRequest serverRequest{std::move(requestHeader)};
+        serverRequest.setQueryParameters(queryParameters);
+        serverRequest.setAccessToken(JWT{jwt});
+        ServerResponse serverResponse;
+        AccessLog accessLog;
+        SessionContext sessionContext{mServiceContext, serverRequest, serverResponse, accessLog};
+        ASSERT_NO_THROW(handler.preHandleRequestHook(sessionContext));
+        ASSERT_NO_THROW(handler.handleRequest(sessionContext));
+        ASSERT_EQ(serverResponse.getHeader().status(), HttpStatus::OK);
+
+        rapidjson::Document document;
+        ASSERT_NO_THROW(document.Parse(canonicalJson(serverResponse.getBody())));
+        ASSERT_NO_THROW(StaticData::getJsonValidator()->validate(document, SchemaType::fhir));
+        auto bundle =
+            model::Bundle::fromJson(model::NumberAsStringParserDocumentConverter::convertToNumbersAsStrings(document));
+        ASSERT_EQ(bundle.getResourceCount(), expectedCount);
+        EXPECT_EQ(bundle.getTotalSearchMatches(), 110 + 3);
+        for (const auto& task : bundle.getResourcesByType<model::Task>("Task"))
+        {
+            EXPECT_TRUE(ids.emplace(task.prescriptionId().toString()).second);
+        }
+
+        // keyset paging only walks forward, there are neither prev nor last links
+        ASSERT_TRUE(bundle.getLink(model::Link::Self).has_value());
+        EXPECT_FALSE(bundle.getLink(model::Link::Prev).has_value());
+        EXPECT_FALSE(bundle.getLink(model::Link::Last).has_value());
+        const auto next = bundle.getLink(model::Link::Next);
+        if (expectedCount < 50)
+        {
+            EXPECT_FALSE(next.has_value());
+            break;
+        }
+        ASSERT_TRUE(next.has_value());
+        const std::string nextLink{*next};
+        ASSERT_TRUE(nextLink.starts_with(linkBase + "&__seek=")) << nextLink;
+        queryParameters = {{"_count", "50"}, {"__seek", nextLink.substr(linkBase.size() + 8)}};
+    }
+    EXPECT_EQ(ids.size(), 110 + 3);
+}
+
+
 TEST_F(EndpointHandlerTest, CreateTask)//NOLINT(readability-function-cognitive-complexity)
 {
     CreateTaskHandler handler({});
@@ -1837,6 +1905,87 @@ TEST_F(EndpointHandlerTest, GetAllTasks_DefaultSort_Success)
 }
 
 
+
+TEST_F(EndpointHandlerTest, GetAllTasks_KeysetPagingWithEqualTimestamps)//NOLINT(readability-function-cognitive-complexity)
+{
+    EnvironmentVariableGuard keysetPaging{"ERP_SERVICE_TASK_GET_KEYSET_PAGING", "true"};
+    GetAllTasksHandler handler({});
+    const auto jwt = JwtBuilder::testBuilder().makeJwtVersicherter("X123456788");
+
+    std::set<std::string> expectedIds;
+    {
+        Header requestHeader{HttpMethod::GET, "/Task", 0, {}, HttpStatus::Unknown};
+        ServerRequest serverRequest{std::move(requestHeader)};
+        ServerResponse serverResponse;
+        AccessLog accessLog;
+        SessionContext sessionContext{mServiceContext, serverRequest, serverResponse, accessLog};
+        // Five tasks share the same last modified timestamp, i.e. they straddle page boundaries with two entries
+        // per page. The default set adds three tasks with other timestamps.
+        const auto lastUpdate = model::Timestamp::fromXsDateTime("2024-06-19T13:00:00.123+01:00");
+        for (int i = 0; i < 5; ++i)
+        {
+            const auto task =
+                addTaskToDatabase(sessionContext, model::Task::Status::ready, "access-code", "X123456788", lastUpdate);
+            expectedIds.emplace(task.prescriptionId().toString());
+        }
+    }
+
+    for (const std::string sort : {"modified", "-modified"})
+    {
+        std::set<std::string> ids;
+        std::optional<std::string> seek;
+        size_t pages = 0;
+        do
+        {
+            Header requestHeader{HttpMethod::GET, "/Task", 0, {}, HttpStatus::Unknown};
+            ServerRequest serverRequest{std::move(requestHeader)};
+            std::vector<std::pair<std::string, std::string>> queryParameters{{"_sort", sort}, {"_count", "2"}};
+            if (seek.has_value())
+            {
+                queryParameters.emplace_back("__seek", *seek);
+            }
+            serverRequest.setQueryParameters(queryParameters);
+            serverRequest.setAccessToken(JWT{jwt});
+            ServerResponse serverResponse;
+            AccessLog accessLog;
+            SessionContext sessionContext{mServiceContext, serverRequest, serverResponse, accessLog};
+            ASSERT_NO_THROW(handler.preHandleRequestHook(sessionContext));
+            ASSERT_NO_THROW(handler.handleRequest(sessionContext));
+            ASSERT_EQ(serverResponse.getHeader().status(), HttpStatus::OK);
+            ++pages;
+
+            rapidjson::Document document;
+            ASSERT_NO_THROW(document.Parse(canonicalJson(serverResponse.getBody())));
+            auto bundle = model::Bundle::fromJson(
+                model::NumberAsStringParserDocumentConverter::convertToNumbersAsStrings(document));
+            EXPECT_EQ(bundle.getTotalSearchMatches(), 5 + 3);
+            for (const auto& task : bundle.getResourcesByType<model::Task>("Task"))
+            {
+                EXPECT_TRUE(ids.emplace(task.prescriptionId().toString()).second)
+                    << "repeated on page " << pages << ": " << task.prescriptionId().toString();
+            }
+            // Keyset paging only walks forward.
+            EXPECT_FALSE(bundle.getLink(model::Link::Prev).has_value());
+            EXPECT_FALSE(bundle.getLink(model::Link::Last).has_value());
+
+            seek.reset();
+            if (const auto next = bundle.getLink(model::Link::Next); next.has_value())
+            {
+                const auto position = next->find("__seek=");
+                ASSERT_NE(position, std::string_view::npos) << *next;
+                seek = std::string{next->substr(position + 7, next->find('&', position) - position - 7)};
+            }
+        } while (seek.has_value() && pages < 10);
+
+        EXPECT_EQ(pages, 4) << sort;
+        EXPECT_EQ(ids.size(), 5 + 3) << sort;
+        for (const auto& id : expectedIds)
+        {
+            EXPECT_TRUE(ids.contains(id)) << sort << ": " << id;
+        }
+    }
+}
+
 TEST_F(EndpointHandlerTest, GetAllAuditEvents_DefaultSort)
 {
     const std::string gematikVersionStr{ResourceTemplates::Versions::GEM_ERP_current().renderVersion()};
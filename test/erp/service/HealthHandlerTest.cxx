@@ -10,6 +10,7 @@
 #include "erp/pc/SeedTimer.hxx"
 #include "erp/registration/RegistrationManager.hxx"
 #include "erp/server/context/SessionContext.hxx"
+#include "erp/util/health/HealthCheck.hxx"
 #include "mock/hsm/HsmMockClient.hxx"
 #include "mock/hsm/HsmMockFactory.hxx"
 #include "mock/tsl/MockOcsp.hxx"
@@ -38,6 +39,7 @@
 #include "test/util/StaticData.hxx"
 
 #include <gtest/gtest.h>// should be first or FRIEND_TEST would not work
+#include <atomic>
 
 using namespace std::chrono_literals;
 
@@ -98,12 +100,23 @@ public:
     using SeedTimerHandler::SeedTimerHandler;
     void healthCheck() const override
     {
+        if (slow)
+            std::this_thread::sleep_for(500ms);
+        while (blocked)
+            std::this_thread::sleep_for(10ms);
         if (fail)
             throw std::runtime_error("SEEDTIMER FAILURE");
+        ++finished;
     }
     static bool fail;
+    static bool slow;
+    static std::atomic_bool blocked;
+    static std::atomic_int finished;
 };
 bool HealthHandlerTestSeedTimerMock::fail = false;
+bool HealthHandlerTestSeedTimerMock::slow = false;
+std::atomic_bool HealthHandlerTestSeedTimerMock::blocked = false;
+std::atomic_int HealthHandlerTestSeedTimerMock::finished = 0;
 
 
 class HealthHandlerTestTeeTokenUpdater : public TeeTokenUpdater
@@ -200,6 +213,7 @@ public:
     void TearDown() override
     {
         HealthHandlerTestTslManager::failOcspRetrieval = false;
+        HealthHandlerTestSeedTimerMock::blocked = false;
     }
 
     void createServiceContext()
@@ -592,6 +606,104 @@ TEST_F(HealthHandlerTest, SeedTimerDown)//NOLINT(readability-function-cognitive-
     EXPECT_FALSE(mContext->serviceContext.registrationInterface()->registered());
 }
 
+TEST_F(HealthHandlerTest, SeedTimerTimeout)
+{
+    HealthCheck healthCheck{*mServiceContext, 100ms, 5s};
+    HealthHandlerTestSeedTimerMock::slow = true;
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_NO_THROW(healthCheck.update());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 500ms);
+    HealthHandlerTestSeedTimerMock::slow = false;
+
+    rapidjson::Document healthDocument;
+    healthDocument.Parse(mServiceContext->applicationHealth().model().serializeToJsonString());
+    verifyRootCause(healthDocument, seedTimerRootCausePointer, "did not finish within 100ms");
+    EXPECT_FALSE(mServiceContext->applicationHealth().isUp(ApplicationHealth::Service::PrngSeed));
+    EXPECT_TRUE(mServiceContext->applicationHealth().isUp(ApplicationHealth::Service::Postgres));
+}
+
+TEST_F(HealthHandlerTest, previousCheckNotFinished)
+{
+    auto healthCheck = std::make_unique<HealthCheck>(*mServiceContext, 100ms, 0s);
+    HealthHandlerTestSeedTimerMock::blocked = true;
+    const auto finished = HealthHandlerTestSeedTimerMock::finished.load();
+    ASSERT_NO_THROW(healthCheck->update());
+
+    // the hung check of the first update is still running and is not started again
+    ASSERT_NO_THROW(healthCheck->update());
+    rapidjson::Document healthDocument;
+    healthDocument.Parse(mServiceContext->applicationHealth().model().serializeToJsonString());
+    verifyRootCause(healthDocument, seedTimerRootCausePointer, "previous health check has not finished yet");
+    EXPECT_FALSE(mServiceContext->applicationHealth().isUp(ApplicationHealth::Service::PrngSeed));
+
+    // the destructor does not wait for the running check
+    const auto start = std::chrono::steady_clock::now();
+    healthCheck.reset();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 400ms);
+
+    // the check that has been left behind returns after the destruction and must not report its result
+    HealthHandlerTestSeedTimerMock::blocked = false;
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (HealthHandlerTestSeedTimerMock::finished == finished && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(10ms);
+    }
+    ASSERT_GT(HealthHandlerTestSeedTimerMock::finished, finished);
+    std::this_thread::sleep_for(50ms);
+    EXPECT_FALSE(mServiceContext->applicationHealth().isUp(ApplicationHealth::Service::PrngSeed));
+}
+
+TEST_F(HealthHandlerTest, backgroundUpdate)
+{
+    HealthCheck healthCheck{*mServiceContext, 2s, 50ms};
+    // the first call waits for the update
+    ASSERT_NO_THROW(healthCheck.updateIfOutdated());
+    const auto firstUpdate = healthCheck.lastUpdate();
+    ASSERT_TRUE(firstUpdate.has_value());
+    EXPECT_TRUE(mServiceContext->applicationHealth().isUp(ApplicationHealth::Service::Postgres));
+
+    std::this_thread::sleep_for(100ms);
+    HealthHandlerTestMockDatabase::fail = true;
+    HealthHandlerTestSeedTimerMock::slow = true;
+    // the outdated result is returned and the update runs in the background
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_NO_THROW(healthCheck.updateIfOutdated());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 250ms);
+    EXPECT_EQ(healthCheck.lastUpdate(), firstUpdate);
+    // no second update is started while the first one is running
+    start = std::chrono::steady_clock::now();
+    ASSERT_NO_THROW(healthCheck.updateIfOutdated());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 250ms);
+
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (healthCheck.lastUpdate() == firstUpdate && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(10ms);
+    }
+    HealthHandlerTestMockDatabase::fail = false;
+    HealthHandlerTestSeedTimerMock::slow = false;
+    EXPECT_NE(healthCheck.lastUpdate(), firstUpdate);
+    EXPECT_FALSE(mServiceContext->applicationHealth().isUp(ApplicationHealth::Service::Postgres));
+    EXPECT_TRUE(mServiceContext->applicationHealth().isUp(ApplicationHealth::Service::PrngSeed));
+}
+
+TEST_F(HealthHandlerTest, cachedResult)
+{
+    ASSERT_NO_THROW(handleRequest());
+    const auto firstUpdate = mServiceContext->healthCheck().lastUpdate();
+    ASSERT_TRUE(firstUpdate.has_value());
+
+    // the second request is answered from the cache and does not run the checks
+    HealthHandlerTestMockDatabase::fail = true;
+    ASSERT_NO_THROW(handleRequest());
+    HealthHandlerTestMockDatabase::fail = false;
+    EXPECT_EQ(mServiceContext->healthCheck().lastUpdate(), firstUpdate);
+
+    rapidjson::Document healthDocument;
+    healthDocument.Parse(mContext->response.getBody());
+    EXPECT_EQ(std::string(postgresStatusPointer.Get(healthDocument)->GetString()), std::string(model::Health::up));
+}
+
 TEST_F(HealthHandlerTest, TeeTokenUpdaterDown)//NOLINT(readability-function-cognitive-complexity)
 {
     HealthHandlerTestTeeTokenUpdaterFactory::fail = true;
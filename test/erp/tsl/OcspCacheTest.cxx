@@ -0,0 +1,109 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/tsl/OcspCache.hxx"
+#include "test/util/ResourceManager.hxx"
+
+#include <gtest/gtest.h>
+
+
+class OcspCacheTest : public testing::Test
+{
+public:
+    static OcspResponse response(std::chrono::system_clock::duration age, std::chrono::system_clock::duration gracePeriod)
+    {
+        const auto now = std::chrono::system_clock::now();
+        return OcspResponse{
+            .status = {.certificateStatus = CertificateStatus::good, .revocationTime = {}},
+            .gracePeriod = gracePeriod,
+            .producedAt = now - age,
+            .receivedAt = now,
+            .fromCache = true,
+            .response = {},
+        };
+    }
+
+    static OcspCache::RefreshContext refreshContext()
+    {
+        const auto certificate = X509Certificate::createFromPem(ResourceManager::instance().getStringResource(
+            "test/generated_pki/sub_ca1_ec/certificates/revoked_ec/revoked_ec_cert.pem"));
+        const auto issuer = X509Certificate::createFromPem(
+            ResourceManager::instance().getStringResource("test/generated_pki/sub_ca1_ec/ca.pem"));
+        return {certificate, CertificateType::C_FD_SIG, issuer};
+    }
+};
+
+
+TEST_F(OcspCacheTest, lookup)
+{
+    using namespace std::chrono_literals;
+    OcspCache cache;
+    EXPECT_FALSE(cache.lookup("a").has_value());
+
+    cache.store("a", response(1min, 1h));
+    cache.store("b", response(2h, 1h));
+    EXPECT_EQ(cache.size(), 2);
+
+    ASSERT_TRUE(cache.lookup("a").has_value());
+    EXPECT_EQ(cache.lookup("a")->status.certificateStatus, CertificateStatus::good);
+    // older than grace period
+    EXPECT_FALSE(cache.lookup("b").has_value());
+    EXPECT_EQ(cache.size(), 1);
+
+    cache.erase("a");
+    EXPECT_FALSE(cache.lookup("a").has_value());
+    EXPECT_EQ(cache.size(), 0);
+}
+
+
+TEST_F(OcspCacheTest, removeExpired)
+{
+    using namespace std::chrono_literals;
+    OcspCache cache;
+    for (int i = 0; i < 100; ++i)
+    {
+        cache.store("valid" + std::to_string(i), response(1min, 1h));
+        cache.store("expired" + std::to_string(i), response(2h, 1h));
+    }
+    EXPECT_EQ(cache.size(), 200);
+    cache.removeExpired();
+    EXPECT_EQ(cache.size(), 100);
+}
+
+
+TEST_F(OcspCacheTest, refreshCandidates)
+{
+    using namespace std::chrono_literals;
+    OcspCache cache{0.5};
+    cache.store("fresh", response(10min, 1h));
+    cache.store("due", response(40min, 1h));
+    cache.store("dueWithoutContext", response(40min, 1h));
+    cache.store("expired", response(2h, 1h));
+
+    // the context is only attached to existing entries
+    cache.setRefreshContext("unknown", refreshContext());
+    EXPECT_EQ(cache.size(), 4);
+
+    cache.setRefreshContext("fresh", refreshContext());
+    cache.setRefreshContext("due", refreshContext());
+    cache.setRefreshContext("expired", refreshContext());
+
+    const auto candidates = cache.getRefreshCandidates();
+    ASSERT_EQ(candidates.size(), 1);
+    EXPECT_EQ(candidates[0].fingerprint, "due");
+    EXPECT_EQ(candidates[0].gracePeriod, std::chrono::system_clock::duration{1h});
+    EXPECT_EQ(candidates[0].context.certificateType, CertificateType::C_FD_SIG);
+
+    // stale while revalidate: the response due for refresh is still returned
+    EXPECT_TRUE(cache.lookup("due").has_value());
+
+    // a refreshed response keeps the context but is no longer due
+    cache.store("due", response(0min, 1h));
+    EXPECT_TRUE(cache.getRefreshCandidates().empty());
+    cache.store("due", response(45min, 1h));
+    EXPECT_EQ(cache.getRefreshCandidates().size(), 1);
+}
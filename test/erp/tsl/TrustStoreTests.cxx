@@ -10,6 +10,7 @@
 #include "shared/tsl/TrustStore.hxx"
 #include "shared/tsl/TslParser.hxx"
 #include "shared/util/FileHelper.hxx"
+#include "test/erp/tsl/TslTestHelper.hxx"
 #include "test/util/EnvironmentVariableGuard.hxx"
 #include "test/util/ResourceManager.hxx"
 #include "test/util/StaticData.hxx"
@@ -81,3 +82,39 @@ TEST(TrustStoreTest, TrustStoreTslSignerCaHandlingNewStartPastSet)
     ASSERT_EQ("C=DE, ST=Berlin, L=Berlin, O=Example Inc., OU=IT, CN=Example Inc. Sub CA EC 1", tslCas[0].getSubject());
     ASSERT_EQ("C=DE, ST=Berlin, L=Berlin, O=Example Inc., OU=IT, CN=TSL signer", tslCas[1].getSubject());
 }
+
+
+TEST(TrustStoreTest, publishedContentIsNotChanged)
+{
+    auto trustStore = TslTestHelper::createTslTrustStore();
+    const auto previous = trustStore->content();
+    ASSERT_TRUE(previous->tslStored);
+    ASSERT_FALSE(previous->serviceInformationMap.empty());
+    // the hash value is published together with the certificates of the TSL
+    ASSERT_TRUE(previous->tslHashValue.has_value());
+
+    trustStore->distrustCertificates();
+
+    // a reader holding the previous content is not affected by the update
+    EXPECT_FALSE(previous->serviceInformationMap.empty());
+    EXPECT_TRUE(trustStore->content()->serviceInformationMap.empty());
+    EXPECT_EQ(trustStore->getGeneration(), previous->generation + 1);
+    EXPECT_EQ(trustStore->getTslHashValue(), previous->tslHashValue);
+    EXPECT_EQ(trustStore->getIdOfTslInUse(), previous->id);
+}
+
+
+TEST(TrustStoreTest, x509StoreIsSharedUntilUpdate)
+{
+    auto trustStore = TslTestHelper::createTslTrustStore();
+    const auto store = trustStore->getX509Store(std::nullopt);
+    ASSERT_NE(nullptr, store.getStore());
+    ASSERT_FALSE(store.getStoredCertificates().empty());
+    EXPECT_EQ(trustStore->getX509Store(std::nullopt).getStore(), store.getStore());
+
+    trustStore->distrustCertificates();
+
+    EXPECT_EQ(nullptr, trustStore->getX509Store(std::nullopt).getStore());
+    // a store that is still in use is not affected by the update
+    EXPECT_FALSE(store.getStoredCertificates().empty());
+}
@@ -1232,6 +1232,62 @@ TEST_F(TslManagerTest, fromCacheFlag)//NOLINT(readability-function-cognitive-com
 }
 
 
+TEST_F(TslManagerTest, refreshOcspResponseRemovesGoodResponse)//NOLINT(readability-function-cognitive-complexity)
+{
+    const Certificate certificate = getCert(sub_ca1_ec, qes_cert1_ec);
+    X509Certificate x509Certificate = X509Certificate::createFromBase64(certificate.toBase64Der());
+    const Certificate certificateCA = getCACert(sub_ca1_ec);
+    X509Certificate x509CertificateCA = X509Certificate::createFromBase64(certificateCA.toBase64Der());
+    const auto fingerprint = x509Certificate.getSha256FingerprintHex();
+    const std::chrono::seconds gracePeriod{842000};
+
+    const std::string tslContent = resourceManager.getStringResource("test/generated_pki/tsl/TSL_valid.xml");
+    const std::string bnaContent = resourceManager.getStringResource("test/generated_pki/tsl/BNA_EC_valid.xml");
+
+    for (const auto testMode : {std::optional{MockOcsp::CertificateOcspTestMode::REVOKED},
+                                std::optional<MockOcsp::CertificateOcspTestMode>{}})
+    {
+        auto requestSender = std::make_shared<UrlRequestSenderMock>(std::unordered_map<std::string, std::string>{
+            {TslTestHelper::shaDownloadUrl, sha256HexRN(tslContent)},
+            {TslTestHelper::tslDownloadUrl, tslContent},
+            {"https://download-testref.bnetzavl.telematik-test:443/BNA-TSL.xml", bnaContent},
+            {"https://download-testref.bnetzavl.telematik-test:443/BNA-TSL.sha2", sha256HexRN(bnaContent)},
+        });
+        TslTestHelper::setOcspUslRequestHandlerTslSigner(*requestSender);
+
+        std::shared_ptr<TslManager> manager = TslTestHelper::createTslManager<TslManager>(
+            requestSender, {}, {{ocspUrl, {{certificate, certificateCA, MockOcsp::CertificateOcspTestMode::SUCCESS}}}});
+        auto& trustStore = manager->getTrustStore(TslMode::BNA);
+
+        ASSERT_NO_THROW(manager->getCertificateOcspResponse(
+            TslMode::BNA, x509Certificate, {CertificateType::C_HP_QES},
+            {OcspCheckDescriptor::OcspCheckMode::FORCE_OCSP_REQUEST_ALLOW_CACHE, {std::nullopt, gracePeriod}, {}}));
+        const auto cachedResponse = trustStore.getCachedOcspData(fingerprint);
+        ASSERT_TRUE(cachedResponse.has_value());
+        ASSERT_EQ(cachedResponse->status.certificateStatus, CertificateStatus::good);
+
+        // the OCSP responder now reports the certificate as revoked or does not know it any more
+        std::vector<MockOcsp::CertificatePair> knownCertificates;
+        if (testMode.has_value())
+        {
+            knownCertificates.emplace_back(MockOcsp::CertificatePair{certificate, certificateCA, *testMode});
+        }
+        TslTestHelper::setOcspUrlRequestHandler(*requestSender, ocspUrl, knownCertificates);
+
+        EXPECT_TSL_ERROR_THROW(
+            TslService::refreshOcspResponse({x509Certificate, CertificateType::C_HP_QES, x509CertificateCA},
+                                            *requestSender, trustStore, gracePeriod),
+            {testMode.has_value() ? TslErrorCode::CERT_REVOKED : TslErrorCode::CERT_UNKNOWN},
+            HttpStatus::BadRequest);
+
+        // the good response must not be used any more
+        const auto refreshedResponse = trustStore.getCachedOcspData(fingerprint);
+        EXPECT_FALSE(refreshedResponse.has_value());
+        EXPECT_TRUE(trustStore.getOcspCache().getRefreshCandidates().empty());
+    }
+}
+
+
 TEST_F(TslManagerTest, permitOutdatedProducedAt)//NOLINT(readability-function-cognitive-complexity)
 {
     const Certificate certificate = getCert(sub_ca1_ec, qes_cert1_ec);
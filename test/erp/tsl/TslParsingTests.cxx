@@ -122,6 +122,19 @@ TEST_F(TslParsingTests, TslXmlIsCompletelyValidAndParsedCorrectly)//NOLINT(reada
 }
 
 
+TEST_F(TslParsingTests, peekIdentity)
+{
+    const auto identity = TslParser::peekIdentity(
+        ResourceManager::instance().getStringResource("test/generated_pki/tsl/TSL_parserTest.xml"));
+    ASSERT_TRUE(identity.has_value());
+    EXPECT_EQ(identity->id, TslParsingExpectations::expectedId);
+    EXPECT_EQ(identity->sequenceNumber, TslParsingExpectations::expectedSequenceNumber);
+
+    EXPECT_FALSE(TslParser::peekIdentity("").has_value());
+    EXPECT_FALSE(TslParser::peekIdentity("<tag></tag>").has_value());
+}
+
+
 TEST_F(TslParsingTests, WansimTslXmlIsParsedCorrectly)
 {
     // Just use an outdated TSL.xml to test parsing
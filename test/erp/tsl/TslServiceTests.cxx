@@ -12,9 +12,12 @@
 #include "shared/tsl/OcspHelper.hxx"
 #include "shared/tsl/OcspService.hxx"
 #include "shared/tsl/TrustStore.hxx"
+#include "shared/tsl/TslParser.hxx"
 #include "shared/tsl/TslService.hxx"
 #include "shared/tsl/error/TslError.hxx"
 #include "shared/util/FileHelper.hxx"
+#include "shared/util/Hash.hxx"
+#include "shared/util/String.hxx"
 #include "test/erp/tsl/TslTestHelper.hxx"
 #include "mock/tsl/MockOcsp.hxx"
 #include "mock/tsl/UrlRequestSenderMock.hxx"
@@ -71,7 +74,7 @@ TEST_F(TslServiceTest, providedTsl)
         {"http://staging.ocsp.d-trust.net", "http://ocsp.bdr.tsp-hba.telematik-test"}
     };
 
-    EXPECT_FALSE(mTrustStore->mServiceInformationMap.empty());
+    EXPECT_FALSE(mTrustStore->content()->serviceInformationMap.empty());
     EXPECT_EQ(expectedBnaOcspMapping, mTrustStore->getBnaOcspMapping());
 }
 
@@ -81,13 +84,16 @@ TEST_F(TslServiceTest, verifyCertificateRevokedCAFailing)//NOLINT(readability-fu
     UrlRequestSenderMock requestSender({});
     X509Certificate certificate = X509Certificate::createFromAsnBytes({ reinterpret_cast<const unsigned char*>(userCertificate.data()), userCertificate.size() });
 
-    auto iterator = mTrustStore->mServiceInformationMap.find(
-        {certificate.getIssuer(), certificate.getAuthorityKeyIdentifier()});
-    ASSERT_NE(mTrustStore->mServiceInformationMap.end(), iterator);
-    iterator->second.serviceAcceptanceHistory = {
-        {date::sys_days{date::June/1/2020}, true},
-        {date::sys_days{date::June/9/2020}, false}
-    };
+    const CertificateId caId{certificate.getIssuer(), certificate.getAuthorityKeyIdentifier()};
+    ASSERT_TRUE(mTrustStore->content()->serviceInformationMap.contains(caId));
+    mTrustStore->update([&caId](TrustStore::Content& content) {
+        content.serviceInformationMap.at(caId).serviceAcceptanceHistory = {
+            {date::sys_days{date::June/1/2020}, true},
+            {date::sys_days{date::June/9/2020}, false}
+        };
+    });
+    const auto trustStoreContent = mTrustStore->content();
+    const auto iterator = trustStoreContent->serviceInformationMap.find(caId);
 
     TslTestHelper::setOcspUrlRequestHandler(
         requestSender,
@@ -108,13 +114,16 @@ TEST_F(TslServiceTest, verifyCertificateValidThenRevokedCASuccess)
     UrlRequestSenderMock requestSender({});
     X509Certificate certificate = X509Certificate::createFromAsnBytes({ reinterpret_cast<const unsigned char*>(userCertificate.data()), userCertificate.size() });
 
-    auto iterator = mTrustStore->mServiceInformationMap.find(
-        {certificate.getIssuer(), certificate.getAuthorityKeyIdentifier()});
-    ASSERT_NE(mTrustStore->mServiceInformationMap.end(), iterator);
-    iterator->second.serviceAcceptanceHistory = {
-        {date::sys_days{date::June/10/2020}, true},
-        {date::sys_days{date::June/10/2032}, false}
-    };
+    const CertificateId caId{certificate.getIssuer(), certificate.getAuthorityKeyIdentifier()};
+    ASSERT_TRUE(mTrustStore->content()->serviceInformationMap.contains(caId));
+    mTrustStore->update([&caId](TrustStore::Content& content) {
+        content.serviceInformationMap.at(caId).serviceAcceptanceHistory = {
+            {date::sys_days{date::June/10/2020}, true},
+            {date::sys_days{date::June/10/2032}, false}
+        };
+    });
+    const auto trustStoreContent = mTrustStore->content();
+    const auto iterator = trustStoreContent->serviceInformationMap.find(caId);
 
     TslTestHelper::setOcspUrlRequestHandler(
         requestSender,
@@ -133,9 +142,10 @@ TEST_F(TslServiceTest, verifyCertificatePolicyNoRestrictionsSuccessful)
     UrlRequestSenderMock requestSender({});
     X509Certificate certificate = X509Certificate::createFromAsnBytes({ reinterpret_cast<const unsigned char*>(userCertificate.data()), userCertificate.size() });
 
-    auto iterator = mTrustStore->mServiceInformationMap.find(
+    const auto trustStoreContent = mTrustStore->content();
+    auto iterator = trustStoreContent->serviceInformationMap.find(
         {certificate.getIssuer(), certificate.getAuthorityKeyIdentifier()});
-    ASSERT_NE(mTrustStore->mServiceInformationMap.end(), iterator);
+    ASSERT_NE(trustStoreContent->serviceInformationMap.end(), iterator);
 
     TslTestHelper::setOcspUrlRequestHandler(
         requestSender,
@@ -157,9 +167,10 @@ TEST_F(TslServiceTest, poppCertificate)
     X509Certificate certificate = X509Certificate::createFromAsnBytes(
         {reinterpret_cast<const unsigned char*>(userCertificate.data()), userCertificate.size()});
 
+    const auto trustStoreContent = mTrustStore->content();
     auto iterator =
-        mTrustStore->mServiceInformationMap.find({certificate.getIssuer(), certificate.getAuthorityKeyIdentifier()});
-    ASSERT_NE(mTrustStore->mServiceInformationMap.end(), iterator);
+        trustStoreContent->serviceInformationMap.find({certificate.getIssuer(), certificate.getAuthorityKeyIdentifier()});
+    ASSERT_NE(trustStoreContent->serviceInformationMap.end(), iterator);
 
     TslTestHelper::setOcspUrlRequestHandler(requestSender, "http://ocsp-testref.tsl.telematik-test/ocsp",
                                             {{Certificate::fromBinaryDer(userCertificate),
@@ -176,9 +187,10 @@ TEST_F(TslServiceTest, verifyCertificatePolicySuccessful)
     UrlRequestSenderMock requestSender({});
     X509Certificate certificate = X509Certificate::createFromAsnBytes({ reinterpret_cast<const unsigned char*>(userCertificate.data()), userCertificate.size() });
 
-    auto iterator = mTrustStore->mServiceInformationMap.find(
+    const auto trustStoreContent = mTrustStore->content();
+    auto iterator = trustStoreContent->serviceInformationMap.find(
         {certificate.getIssuer(), certificate.getAuthorityKeyIdentifier()});
-    ASSERT_NE(mTrustStore->mServiceInformationMap.end(), iterator);
+    ASSERT_NE(trustStoreContent->serviceInformationMap.end(), iterator);
 
     TslTestHelper::setOcspUrlRequestHandler(
         requestSender,
@@ -209,9 +221,10 @@ TEST_F(TslServiceTest, doNotCacheProvidedOcspResponse)
     X509Certificate x509Certificate = X509Certificate::createFromAsnBytes(
         {reinterpret_cast<const unsigned char*>(userCertificate.data()), userCertificate.size()});
 
-    auto iterator = mTrustStore->mServiceInformationMap.find(
+    const auto trustStoreContent = mTrustStore->content();
+    auto iterator = trustStoreContent->serviceInformationMap.find(
         {x509Certificate.getIssuer(), x509Certificate.getAuthorityKeyIdentifier()});
-    ASSERT_NE(mTrustStore->mServiceInformationMap.end(), iterator);
+    ASSERT_NE(trustStoreContent->serviceInformationMap.end(), iterator);
 
     auto cert = Certificate::fromBinaryDer(userCertificate);
     auto certCa = Certificate::fromBase64Der(iterator->second.certificate.toBase64());
@@ -257,3 +270,45 @@ TEST_F(TslServiceTest, doNotCacheProvidedOcspResponse)
         ASSERT_TRUE(mTrustStore->getCachedOcspData(fingerprint).has_value());
     }
 }
+
+
+TEST_F(TslServiceTest, refreshSkipsTslIdenticalToTheOneInUse)
+{
+    // The content is not a TSL at all, so it would fail as soon as a TslParser is created for it.
+    const std::string tslContent = "not a trust service status list";
+    UrlRequestSenderMock requestSender(
+        std::unordered_map<std::string, std::string>{{TslTestHelper::tslDownloadUrl, tslContent}});
+    const std::string newHash = "0000";
+
+    mTrustStore->setTslHashValue(String::toLower(String::toHexString(Hash::sha256(tslContent))));
+    std::optional<TslParser> tslParser;
+    EXPECT_NO_THROW(tslParser = TslService::refreshTslIfNecessary(
+                        requestSender, *StaticData::getXmlValidator(), *mTrustStore, newHash, {}));
+    EXPECT_FALSE(tslParser.has_value());
+
+    // with a different content hash in use the downloaded content is parsed and rejected
+    mTrustStore->setTslHashValue("1111");
+    EXPECT_ANY_THROW((void)TslService::refreshTslIfNecessary(
+        requestSender, *StaticData::getXmlValidator(), *mTrustStore, newHash, {}));
+}
+
+
+TEST_F(TslServiceTest, parsingSkipsTslWithIdAndSequenceNumberInUse)
+{
+    // Id and sequence number are those of the TSL in use, but the signature is broken,
+    // so it would fail as soon as a TslParser is created for it.
+    const std::string tslContent = String::replaceAll(
+        ResourceManager::instance().getStringResource("test/generated_pki/tsl/TSL_valid.xml"),
+        "TEST-ONLY gematik TSL Scheme", "TEST-ONLY gematik TSL Schema");
+
+    std::optional<TslParser> tslParser;
+    EXPECT_NO_THROW(tslParser = TslService::attemptTslParsing(
+                        tslContent, *StaticData::getXmlValidator(), *mTrustStore, {}));
+    EXPECT_FALSE(tslParser.has_value());
+
+    // without a TSL in use the content is parsed and rejected
+    TrustStore emptyTrustStore{TslMode::TSL};
+    EXPECT_THROW((void)TslService::attemptTslParsing(
+                     tslContent, *StaticData::getXmlValidator(), emptyTrustStore, {}),
+                 TslError);
+}
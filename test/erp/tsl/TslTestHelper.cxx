@@ -151,13 +151,13 @@ void TslTestHelper::setCaCertificateTimestamp(
     Expect(trustStore != nullptr, "TrustStore must be set to use the method.");
 
     X509Certificate x509Certificate = X509Certificate::createFromBase64(certificate.toBase64Der());
-    auto iterator = trustStore->mServiceInformationMap.find(
-        {x509Certificate.getSubject(), x509Certificate.getSubjectKeyIdentifier()});
-    Expect(iterator != trustStore->mServiceInformationMap.end(), "Unknown Certificate is provided.");
+    trustStore->update([&](TrustStore::Content& content) {
+        auto iterator = content.serviceInformationMap.find(
+            {x509Certificate.getSubject(), x509Certificate.getSubjectKeyIdentifier()});
+        Expect(iterator != content.serviceInformationMap.end(), "Unknown Certificate is provided.");
 
-    iterator->second.serviceAcceptanceHistory.clear();
-    iterator->second.serviceAcceptanceHistory =
-        TslParser::AcceptanceHistoryMap{{timestamp, true}};
+        iterator->second.serviceAcceptanceHistory = TslParser::AcceptanceHistoryMap{{timestamp, true}};
+    });
 }
 
 
@@ -179,7 +179,9 @@ void TslTestHelper::removeCertificateFromTrustStore(
     Expect(trustStore != nullptr, "TrustStore must be set to use the method.");
 
     X509Certificate x509Certificate = X509Certificate::createFromBase64(certificate.toBase64Der());
-    trustStore->mServiceInformationMap.erase({x509Certificate.getSubject(), x509Certificate.getSubjectKeyIdentifier()});
+    trustStore->update([&x509Certificate](TrustStore::Content& content) {
+        content.serviceInformationMap.erase({x509Certificate.getSubject(), x509Certificate.getSubjectKeyIdentifier()});
+    });
 }
 
 
@@ -0,0 +1,207 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/tsl/VerifiedCertificateCache.hxx"
+#include "shared/tsl/TrustStore.hxx"
+#include "test/util/ResourceManager.hxx"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+
+class VerifiedCertificateCacheTest : public testing::Test
+{
+public:
+    static X509Certificate certificate(const std::string& path)
+    {
+        return X509Certificate::createFromPem(ResourceManager::instance().getStringResource(path));
+    }
+
+    static std::vector<X509Certificate> endEntityCertificates()
+    {
+        return {
+            certificate("test/generated_pki/sub_ca1_ec/certificates/arzt/arzt_cert.pem"),
+            certificate("test/generated_pki/sub_ca1_ec/certificates/apotheker/apotheker_cert.pem"),
+            certificate("test/generated_pki/sub_ca1_ec/certificates/revoked_ec/revoked_ec_cert.pem"),
+        };
+    }
+
+    static VerifiedCertificateCache::Entry entry()
+    {
+        return {.certificateType = CertificateType::C_HP_QES,
+                .issuerCertificate = certificate("test/generated_pki/sub_ca1_ec/ca.pem")};
+    }
+};
+
+
+TEST_F(VerifiedCertificateCacheTest, lookup)
+{
+    using namespace std::chrono_literals;
+    VerifiedCertificateCache cache{1h};
+    TrustStore trustStore{TslMode::TSL};
+    const auto certificates = endEntityCertificates();
+
+    EXPECT_FALSE(cache.lookup(certificates[0], trustStore).has_value());
+
+    cache.store(certificates[0], trustStore, entry(), 1h);
+    EXPECT_EQ(cache.size(), 1);
+
+    const auto hit = cache.lookup(certificates[0], trustStore);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->certificateType, CertificateType::C_HP_QES);
+    EXPECT_EQ(hit->issuerCertificate.getSha256FingerprintHex(), entry().issuerCertificate.getSha256FingerprintHex());
+
+    // other certificate
+    EXPECT_FALSE(cache.lookup(certificates[1], trustStore).has_value());
+
+    // Entries are separated by TSL mode.
+    TrustStore bnaTrustStore{TslMode::BNA};
+    EXPECT_FALSE(cache.lookup(certificates[0], bnaTrustStore).has_value());
+    EXPECT_TRUE(cache.lookup(certificates[0], trustStore).has_value());
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.lookup(certificates[0], trustStore).has_value());
+}
+
+
+TEST_F(VerifiedCertificateCacheTest, trustStoreUpdateInvalidatesEntries)
+{
+    using namespace std::chrono_literals;
+    VerifiedCertificateCache cache{1h};
+    TrustStore trustStore{TslMode::TSL};
+    const auto certificates = endEntityCertificates();
+
+    cache.store(certificates[0], trustStore, entry(), 1h);
+    ASSERT_TRUE(cache.lookup(certificates[0], trustStore).has_value());
+
+    trustStore.distrustCertificates();
+    EXPECT_FALSE(cache.lookup(certificates[0], trustStore).has_value());
+    // the outdated entry is removed on lookup
+    EXPECT_EQ(cache.size(), 0);
+}
+
+
+TEST_F(VerifiedCertificateCacheTest, expiry)
+{
+    using namespace std::chrono_literals;
+    TrustStore trustStore{TslMode::TSL};
+    const auto certificates = endEntityCertificates();
+
+    {
+        // lifetime is bounded by the OCSP grace period
+        VerifiedCertificateCache cache{1h};
+        cache.store(certificates[0], trustStore, entry(), 50ms);
+        cache.store(certificates[1], trustStore, entry(), 1h);
+        ASSERT_TRUE(cache.lookup(certificates[0], trustStore).has_value());
+        std::this_thread::sleep_for(100ms);
+        EXPECT_FALSE(cache.lookup(certificates[0], trustStore).has_value());
+        EXPECT_TRUE(cache.lookup(certificates[1], trustStore).has_value());
+    }
+    {
+        // lifetime is bounded by the maximum age
+        VerifiedCertificateCache cache{50ms};
+        cache.store(certificates[0], trustStore, entry(), 1h);
+        ASSERT_TRUE(cache.lookup(certificates[0], trustStore).has_value());
+        std::this_thread::sleep_for(100ms);
+        EXPECT_FALSE(cache.lookup(certificates[0], trustStore).has_value());
+    }
+    {
+        // a maximum age of zero disables the cache
+        VerifiedCertificateCache cache{0s};
+        cache.store(certificates[0], trustStore, entry(), 1h);
+        EXPECT_EQ(cache.size(), 0);
+        EXPECT_FALSE(cache.lookup(certificates[0], trustStore).has_value());
+    }
+}
+
+
+TEST_F(VerifiedCertificateCacheTest, eviction)
+{
+    using namespace std::chrono_literals;
+    TrustStore trustStore{TslMode::TSL};
+    const auto certificates = endEntityCertificates();
+
+    {
+        // expired entries are removed first
+        VerifiedCertificateCache cache{1h, 2};
+        cache.store(certificates[0], trustStore, entry(), 1h);
+        cache.store(certificates[1], trustStore, entry(), 50ms);
+        std::this_thread::sleep_for(100ms);
+        cache.store(certificates[2], trustStore, entry(), 1h);
+        EXPECT_EQ(cache.size(), 2);
+        EXPECT_TRUE(cache.lookup(certificates[0], trustStore).has_value());
+        EXPECT_FALSE(cache.lookup(certificates[1], trustStore).has_value());
+        EXPECT_TRUE(cache.lookup(certificates[2], trustStore).has_value());
+    }
+    {
+        // without expired entries, the cache is cleared
+        VerifiedCertificateCache cache{1h, 2};
+        cache.store(certificates[0], trustStore, entry(), 1h);
+        cache.store(certificates[1], trustStore, entry(), 1h);
+        cache.store(certificates[2], trustStore, entry(), 1h);
+        EXPECT_EQ(cache.size(), 1);
+        EXPECT_FALSE(cache.lookup(certificates[0], trustStore).has_value());
+        EXPECT_TRUE(cache.lookup(certificates[2], trustStore).has_value());
+    }
+    {
+        // replacing an entry does not count against the limit
+        VerifiedCertificateCache cache{1h, 2};
+        cache.store(certificates[0], trustStore, entry(), 1h);
+        cache.store(certificates[0], trustStore, entry(), 1h);
+        EXPECT_EQ(cache.size(), 1);
+    }
+}
+
+
+TEST_F(VerifiedCertificateCacheTest, concurrentAccess)
+{
+    using namespace std::chrono_literals;
+    constexpr size_t maxEntries = 2;
+    VerifiedCertificateCache cache{1h, maxEntries};
+    TrustStore trustStore{TslMode::TSL};
+    const auto certificates = endEntityCertificates();
+    const auto issuerFingerprint = entry().issuerCertificate.getSha256FingerprintHex();
+
+    std::atomic_size_t hits{0};
+    std::atomic_size_t wrongEntries{0};
+    std::vector<std::thread> threads;
+    for (size_t threadIndex = 0; threadIndex < 8; ++threadIndex)
+    {
+        threads.emplace_back([&, threadIndex] {
+            for (size_t i = 0; i < 500; ++i)
+            {
+                const auto& certificate = certificates[(threadIndex + i) % certificates.size()];
+                if (const auto hit = cache.lookup(certificate, trustStore); hit.has_value())
+                {
+                    ++hits;
+                    if (hit->issuerCertificate.getSha256FingerprintHex() != issuerFingerprint)
+                    {
+                        ++wrongEntries;
+                    }
+                }
+                else
+                {
+                    cache.store(certificate, trustStore, entry(), 1h);
+                }
+                if (i % 100 == 0 && threadIndex == 0)
+                {
+                    trustStore.distrustCertificates();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_GT(hits, 0);
+    EXPECT_EQ(wrongEntries, 0);
+    EXPECT_LE(cache.size(), maxEntries);
+}
@@ -7,6 +7,7 @@
 
 #include "shared/util/Configuration.hxx"
 #include "shared/util/Environment.hxx"
+#include "shared/util/InvalidConfigurationException.hxx"
 #include "shared/ErpConstants.hxx"
 #include "test_config.h"
 #include "test/util/EnvironmentVariableGuard.hxx"
@@ -59,6 +60,36 @@ TEST_F(ConfigurationTest, getIntValue)
 }
 
 
+TEST_F(ConfigurationTest, getIntValueNotAnInteger)
+{
+    ScopedSetEnv scopeEnv(configuration.getEnvironmentVariableName(ConfigurationKey::SERVER_THREAD_COUNT), "17x");
+
+    EXPECT_THROW((void)configuration.getIntValue(ConfigurationKey::SERVER_THREAD_COUNT), InvalidConfigurationException);
+    EXPECT_EQ(configuration.getStringValue(ConfigurationKey::SERVER_THREAD_COUNT), "17x");
+}
+
+
+TEST_F(ConfigurationTest, valuesFollowEnvironment)
+{
+    const auto* variableName = configuration.getEnvironmentVariableName(ConfigurationKey::SERVER_THREAD_COUNT);
+    {
+        ScopedSetEnv scopeEnv(variableName, "17");
+        EXPECT_EQ(configuration.getIntValue(ConfigurationKey::SERVER_THREAD_COUNT), 17);
+        {
+            ScopedSetEnv innerScopeEnv(variableName, "18");
+            EXPECT_EQ(configuration.getIntValue(ConfigurationKey::SERVER_THREAD_COUNT), 18);
+            EXPECT_EQ(configuration.getStringValue(ConfigurationKey::SERVER_THREAD_COUNT), "18");
+        }
+        EXPECT_EQ(configuration.getIntValue(ConfigurationKey::SERVER_THREAD_COUNT), 17);
+    }
+    {
+        ScopedSetEnv scopeEnv(variableName, std::nullopt);
+        EXPECT_EQ(configuration.getOptionalIntValue(ConfigurationKey::SERVER_THREAD_COUNT, 0),
+                  createConfiguration()->getOptionalIntValue(ConfigurationKey::SERVER_THREAD_COUNT, 0));
+    }
+}
+
+
 TEST_F(ConfigurationTest, getOptionalIntValue)
 {
     EnvironmentVariableGuard envGuard{ErpConstants::ConfigurationFileNameVariable,
@@ -243,3 +243,149 @@ TEST_F(UrlArgumentsTest, parseWithBundleLinks_withOrder_failForNegativeOffset)
     EXPECT_ANY_THROW(arguments.parse(request, mKeyDerivation));
 
 }
+
+
+TEST_F(UrlArgumentsTest, parseWithSeekBundleLinks)//NOLINT(readability-function-cognitive-complexity)
+{
+    UrlArguments arguments (
+        {
+            {"date", SearchParameter::Type::Date},
+            {"name", SearchParameter::Type::String},
+        });
+    arguments.enableKeysetPaging();
+
+    const PagingArgument::SeekPosition seek{model::Timestamp::fromXsDateTime("2023-02-15T01:00:00.123+01:00"),
+                                            model::PrescriptionId::fromString("160.000.000.004.711.86")};
+    const PagingArgument::SeekPosition lastEntry{model::Timestamp::fromXsDateTime("2023-02-16T01:00:00.456+01:00"),
+                                                 model::PrescriptionId::fromString("160.000.000.004.713.80")};
+    EXPECT_EQ(PagingArgument::seekValue(seek), "1676419200123_160.000.000.004.711.86");
+
+    auto request = ServerRequest(Header());
+    request.setQueryParameters({
+        {"_count", "3"},
+        {"name",   "somebody"},
+        {"_sort",  "date"},
+        {"__seek", PagingArgument::seekValue(seek)}
+        });
+    arguments.parse(request, mKeyDerivation);
+
+    ASSERT_TRUE(arguments.keysetSortArgument().has_value());
+    ASSERT_TRUE(arguments.isKeysetPaging());
+    EXPECT_EQ(arguments.getSqlSeekExpression(),
+              "(date >= '2023-02-15T00:00:00.123+00:00' AND (date, prescription_type, prescription_id) > "
+              "('2023-02-15T00:00:00.123+00:00', 160, 4711))");
+    EXPECT_EQ(arguments.getSqlSortExpression(),
+              "ORDER BY date ASC, prescription_type ASC, prescription_id ASC");
+
+    arguments.setResultSeekPosition(lastEntry);
+    const auto links = arguments.createBundleLinks("base", "/Resource", 50, UrlArguments::LinkMode::keyset);
+
+    EXPECT_EQ(links.size(), 3);
+    ASSERT_EQ(links.count(model::Link::Self), 1);
+    ASSERT_EQ(links.count(model::Link::Next), 1);
+    ASSERT_EQ(links.count(model::Link::First), 1);
+    EXPECT_EQ(links.find(model::Link::Self)->second,
+              "base/Resource?name=somebody&_sort=date&_count=3&__seek=" + PagingArgument::seekValue(seek));
+    EXPECT_EQ(links.find(model::Link::Next)->second,
+              "base/Resource?name=somebody&_sort=date&_count=3&__seek=1676505600456_160.000.000.004.713.80");
+    EXPECT_EQ(links.find(model::Link::First)->second, "base/Resource?name=somebody&_sort=date&_count=3");
+}
+
+
+TEST_F(UrlArgumentsTest, parseWithSeek_decreasingOrder)
+{
+    UrlArguments arguments({{"date", SearchParameter::Type::Date}});
+    arguments.enableKeysetPaging();
+
+    auto request = ServerRequest(Header());
+    request.setQueryParameters({{"_sort", "-date"}, {"__seek", "1676419200123_162.000.000.004.711.77"}});
+    arguments.parse(request, mKeyDerivation);
+
+    ASSERT_TRUE(arguments.pagingArgument().getSeek().has_value());
+    EXPECT_EQ(arguments.pagingArgument().getSeek()->prescriptionId().toString(), "162.000.000.004.711.77");
+    EXPECT_EQ(arguments.getSqlSeekExpression(),
+              "(date <= '2023-02-15T00:00:00.123+00:00' AND (date, prescription_type, prescription_id) < "
+              "('2023-02-15T00:00:00.123+00:00', 162, 4711))");
+    EXPECT_EQ(arguments.getSqlSortExpression(),
+              "ORDER BY date DESC, prescription_type DESC, prescription_id DESC");
+    // without a seek position for the last entry, there is no next page
+    const auto links = arguments.createBundleLinks("base", "/Resource", 50, UrlArguments::LinkMode::keyset);
+    EXPECT_EQ(links.count(model::Link::Next), 0);
+    EXPECT_EQ(links.count(model::Link::Prev), 0);
+    EXPECT_EQ(links.count(model::Link::Last), 0);
+}
+
+
+TEST_F(UrlArgumentsTest, parseWithoutSeekUsesKeysetOrder)
+{
+    UrlArguments arguments({{"date", SearchParameter::Type::Date}});
+    arguments.enableKeysetPaging();
+
+    auto request = ServerRequest(Header());
+    request.setQueryParameters({{"_sort", "-date"}, {"_count", "10"}});
+    arguments.parse(request, mKeyDerivation);
+
+    // The first page already has to be in the order that the seek comparison of the next page relies on.
+    ASSERT_TRUE(arguments.isKeysetPaging());
+    EXPECT_EQ(arguments.getSqlSeekExpression(), "");
+    EXPECT_EQ(arguments.getSqlSortExpression(),
+              "ORDER BY date DESC, prescription_type DESC, prescription_id DESC");
+}
+
+
+TEST_F(UrlArgumentsTest, parseSeekRequiresSingleDateSort)
+{
+    {
+        UrlArguments arguments({{"date", SearchParameter::Type::Date}, {"name", SearchParameter::Type::String}});
+        arguments.enableKeysetPaging();
+        auto request = ServerRequest(Header());
+        request.setQueryParameters({{"_sort", "name"}, {"__seek", "1676419200123_160.000.000.004.711.86"}});
+        EXPECT_ANY_THROW(arguments.parse(request, mKeyDerivation));
+    }
+    {
+        UrlArguments arguments({{"date", SearchParameter::Type::Date}, {"name", SearchParameter::Type::String}});
+        arguments.enableKeysetPaging();
+        auto request = ServerRequest(Header());
+        request.setQueryParameters({{"_sort", "date,name"}, {"__seek", "1676419200123_160.000.000.004.711.86"}});
+        EXPECT_ANY_THROW(arguments.parse(request, mKeyDerivation));
+    }
+    {
+        UrlArguments arguments({{"date", SearchParameter::Type::Date}});
+        arguments.enableKeysetPaging();
+        auto request = ServerRequest(Header());
+        request.setQueryParameters({{"_sort", "date"}, {"__seek", "12x"}});
+        EXPECT_ANY_THROW(arguments.parse(request, mKeyDerivation));
+    }
+    for (const auto* seek : {"1676419200123", "1676419200123_", "1676419200123_160.000.000.004.711.00",
+                             "12x_160.000.000.004.711.86", "-1_160.000.000.004.711.86"})
+    {
+        UrlArguments arguments({{"date", SearchParameter::Type::Date}});
+        arguments.enableKeysetPaging();
+        auto request = ServerRequest(Header());
+        request.setQueryParameters({{"_sort", "date"}, {"__seek", seek}});
+        EXPECT_ANY_THROW(arguments.parse(request, mKeyDerivation)) << seek;
+    }
+}
+
+
+TEST_F(UrlArgumentsTest, parseDisallowOffsetAndSeekPaging)
+{
+    UrlArguments arguments({{"date", SearchParameter::Type::Date}});
+    arguments.enableKeysetPaging();
+
+    auto request = ServerRequest(Header());
+    request.setQueryParameters({{"_sort", "date"}, {"__offset", "13"}, {"__seek", "1676419200123_160.000.000.004.711.86"}});
+    ASSERT_ANY_THROW(arguments.parse(request, mKeyDerivation));
+}
+
+
+TEST_F(UrlArgumentsTest, parseIgnoresSeekIfNotEnabled)
+{
+    UrlArguments arguments({{"date", SearchParameter::Type::Date}});
+
+    auto request = ServerRequest(Header());
+    request.setQueryParameters({{"_sort", "date"}, {"__seek", "1676419200123_160.000.000.004.711.86"}});
+    ASSERT_NO_THROW(arguments.parse(request, mKeyDerivation));
+    EXPECT_FALSE(arguments.pagingArgument().getSeek().has_value());
+    EXPECT_EQ(arguments.getSqlSeekExpression(), "");
+}
@@ -60,7 +60,8 @@ public:
         .host = Configuration::instance().epaFQDNs().at(0).hostName,
         .port = Configuration::instance().epaFQDNs().at(0).port,
         .lookupResult = EpaAccount::Code::allowed,
-        .failingHosts = {}
+        .failingHosts = {},
+        .consentReused = false
     }
 };
 
@@ -158,6 +159,72 @@ TEST_F(EventProcessorTest, recentCachedHost)
     EXPECT_STREQ(epaAccount.host.c_str(), epaAccountLookupMock.WellKnownHost.c_str());
 }
 
+TEST_F(EventProcessorTest, recentConsentDecisionIsReused)
+{
+    epaAccountLookupMock.WellKnownHost = "mockServer.example.net";
+    model::Kvnr kvnr{"X000000012"};
+    const auto& fqdn = Configuration::instance().epaFQDNs().at(0);
+    const auto assignedEpa = String::split(fqdn.hostName, '.').at(0);
+
+    insertTaskKvnr(kvnr, 0, assignedEpa, model::Timestamp::now());
+    insertTaskEvent(kvnr, prescriptionId1.toString(), model::TaskEvent::UseCase::providePrescription,
+                    model::TaskEvent::State::pending, healthcareProviderPrescription, medicationDispenseBundle,
+                    mDoctorIdentity, std::nullopt);
+
+    EventProcessor eventProcessor(serviceContext, epaAccountLookupMock, Uuid{}.toString());
+    model::EventKvnr eventKvnr(kvnrHashed(kvnr), model::Timestamp::now(), assignedEpa,
+                               model::EventKvnr::State::processing, 0);
+    auto events = database().getAllEventsForKvnr(eventKvnr);
+    database().commitTransaction();
+    const auto& firstEvent = *events.front();
+
+    auto epaAccount = eventProcessor.ePaAccountLookup(eventKvnr, firstEvent);
+    EXPECT_TRUE(epaAccount.consentReused);
+    EXPECT_EQ(epaAccount.lookupResult, EpaAccount::Code::allowed);
+    EXPECT_EQ(epaAccount.host, fqdn.hostName);
+    EXPECT_EQ(epaAccount.port, fqdn.port);
+
+    // without a reuse window the consent decision is looked up again
+    const EnvironmentVariableGuard envGuard{"ERP_MEDICATION_EXPORTER_EPA_ACCOUNT_LOOKUP_CONSENT_REUSE_SECONDS", "0"};
+    EventProcessor eventProcessorWithoutReuse(serviceContext, epaAccountLookupMock, Uuid{}.toString());
+    epaAccount = eventProcessorWithoutReuse.ePaAccountLookup(eventKvnr, firstEvent);
+    EXPECT_FALSE(epaAccount.consentReused);
+    // the mock passes the prefix of the assigned ePA through
+    EXPECT_EQ(epaAccount.host, assignedEpa);
+}
+
+TEST_F(EventProcessorTest, processOne_consentReusedKeepsLastConsentCheck)
+{
+    model::Kvnr kvnr{"X000000012"};
+    const auto assignedEpa = String::split(Configuration::instance().epaFQDNs().at(0).hostName, '.').at(0);
+    // whole seconds, so that the value is not changed by the round trip through the database
+    const model::Timestamp lastConsentCheck{
+        std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now() - 10min)};
+    insertTaskKvnr(kvnr, 0, assignedEpa, lastConsentCheck);
+    insertTaskEvent(kvnr, prescriptionId1.toString(), model::TaskEvent::UseCase::providePrescription,
+                    model::TaskEvent::State::pending, healthcareProviderPrescription, medicationDispenseBundle,
+                    mDoctorIdentity, std::nullopt);
+    model::EventKvnr eventKvnr(kvnrHashed(kvnr), lastConsentCheck, assignedEpa, model::EventKvnr::State::processing,
+                               0);
+
+    EventProcessor eventProcessor(serviceContext, epaAccountLookupMock, Uuid{}.toString());
+    eventProcessor.processOne(eventKvnr);
+
+    {// verify: kvnr processed, the reused consent decision does not refresh last_consent_check
+        auto transaction = createTransaction();
+        const auto results = transaction.exec(
+            "SELECT state, assigned_epa, EXTRACT(EPOCH FROM last_consent_check) FROM erp_event.kvnr "
+            "WHERE kvnr_hashed = $1",
+            pqxx::params{eventKvnr.kvnrHashed()});
+        transaction.commit();
+        ASSERT_EQ(results.size(), 1);
+        EXPECT_EQ(magic_enum::enum_cast<model::EventKvnr::State>(results.at(0, 0).as<std::string>()).value(),
+                  model::EventKvnr::State::processed);
+        EXPECT_EQ(results.at(0, 1).as<std::string>(), assignedEpa);
+        EXPECT_EQ(model::Timestamp(results.at(0, 2).as<double>()), lastConsentCheck);
+    }
+}
+
 TEST_F(EventProcessorTest, process)
 {
     epaAccountLookupMock.WellKnownHost = "epa-as-1-mock";
@@ -991,6 +1058,27 @@ TEST_F(EventProcessorTest, processEpaConflict)
 }
 
 
+TEST_F(EventProcessorTest, processEpaConflictResetsAssignedEpa)
+{
+    model::Kvnr kvnr{"X000000012"};
+    model::EventKvnr eventKvnr(kvnrHashed(kvnr), model::Timestamp::now(), "epa-as-1",
+                               model::EventKvnr::State::processing, 0);
+    insertTaskKvnr(kvnr, 0, "epa-as-1");
+
+    EventProcessor eventProcessor(serviceContext, epaAccountLookupMock, Uuid{}.toString());
+    eventProcessor.processEpaConflict(eventKvnr);
+
+    {// verify: the account moves to another ePA, the next run must ask all ePAs again
+        auto transaction = createTransaction();
+        const auto results = transaction.exec("SELECT assigned_epa FROM erp_event.kvnr WHERE kvnr_hashed = $1",
+                                              pqxx::params{eventKvnr.kvnrHashed()});
+        transaction.commit();
+        ASSERT_EQ(results.size(), 1);
+        EXPECT_EQ(results.at(0, 0).as<std::string>(), "");
+    }
+}
+
+
 TEST_F(EventProcessorTest, processEpaDeniedOrNotFound)
 {
     model::Kvnr kvnr{"X000000012"};
@@ -1067,7 +1155,7 @@ TEST_F(EventProcessorTest, ePaAccountLookup_kvnrIsLogged)
     model::Kvnr kvnr{"X000000012"};
     model::EventKvnr eventKvnr(kvnrHashed(kvnr), std::nullopt, std::nullopt, model::EventKvnr::State::processing, 0);
 
-    EpaAccount epaAccount{kvnr, "", 9, EpaAccount::Code::allowed, {}};
+    EpaAccount epaAccount{kvnr, "", 9, EpaAccount::Code::allowed, {}, false};
 
 
     auto pharmacy = model::TelematikId{"3-SMC-B-Testkarte-883110000120312"};
@@ -1116,7 +1204,7 @@ TEST_F(EventProcessorTest, processEpaAllowed_event_missing_qesDoctorId)
         originalEvent.getJwtDoctorProfessionOid(), std::move(const_cast<model::Bundle&>(originalEvent.getKbvBundle())),
         originalEvent.getLastModified()));
 
-    EpaAccount epaAccount{kvnr, "", 9, EpaAccount::Code::allowed, {}};
+    EpaAccount epaAccount{kvnr, "", 9, EpaAccount::Code::allowed, {}, false};
     testing::internal::CaptureStderr();
     eventProcessor.processEpaAllowed(eventKvnr, epaAccount, events);
     std::string output = testing::internal::GetCapturedStderr();
@@ -0,0 +1,166 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "exporter/client/VzdSearchCache.hxx"
+#include "shared/model/Bundle.hxx"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <latch>
+#include <stdexcept>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+model::Bundle searchResult(bool withEntry)
+{
+    model::Bundle bundle(model::BundleType::searchset, model::FhirResourceBase::NoProfile);
+    if (withEntry)
+    {
+        rapidjson::Document resource;
+        resource.Parse(R"({"resourceType":"HealthcareService"})");
+        bundle.addResource({}, {}, model::BundleSearchMode::match, resource);
+    }
+    return bundle;
+}
+}
+
+
+TEST(VzdSearchCacheTest, cachesResultsPerTelematikId)
+{
+    VzdSearchCache cache{1h, 1h};
+    size_t searches = 0;
+    const auto search = [&searches](const std::string&) {
+        ++searches;
+        return searchResult(true);
+    };
+
+    const auto first = cache.lookup("3-01.2.2023001.16.101.1", search);
+    const auto second = cache.lookup("3-01.2.2023001.16.101.1", search);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(searches, 1);
+
+    cache.lookup("3-01.2.2023001.16.101.2", search);
+    EXPECT_EQ(searches, 2);
+    EXPECT_EQ(cache.size(), 2);
+}
+
+
+TEST(VzdSearchCacheTest, expiredEntriesAreSearchedAgain)
+{
+    VzdSearchCache cache{1h, 1ns};
+    size_t searches = 0;
+    const auto search = [&searches](const std::string&) {
+        ++searches;
+        return searchResult(false);
+    };
+
+    cache.lookup("3-01.2.2023001.16.101.1", search);
+    std::this_thread::sleep_for(1ms);
+    const auto bundle = cache.lookup("3-01.2.2023001.16.101.1", search);
+    ASSERT_NE(bundle, nullptr);
+    EXPECT_EQ(bundle->getResourceCount(), 0);
+    EXPECT_EQ(searches, 2);
+}
+
+
+TEST(VzdSearchCacheTest, negativeCachingCanBeDisabled)
+{
+    VzdSearchCache cache{1h, 0s};
+    size_t searches = 0;
+    const auto search = [&searches](const std::string&) {
+        ++searches;
+        return searchResult(false);
+    };
+
+    cache.lookup("3-01.2.2023001.16.101.1", search);
+    cache.lookup("3-01.2.2023001.16.101.1", search);
+    EXPECT_EQ(searches, 2);
+    EXPECT_EQ(cache.size(), 0);
+}
+
+
+TEST(VzdSearchCacheTest, failuresAreNotCached)
+{
+    VzdSearchCache cache{1h, 1h};
+    size_t searches = 0;
+    const auto failingSearch = [&searches](const std::string&) -> model::Bundle {
+        ++searches;
+        throw std::runtime_error("VZD not reachable");
+    };
+
+    EXPECT_THROW(cache.lookup("3-01.2.2023001.16.101.1", failingSearch), std::runtime_error);
+    EXPECT_THROW(cache.lookup("3-01.2.2023001.16.101.1", failingSearch), std::runtime_error);
+    EXPECT_EQ(searches, 2);
+    EXPECT_EQ(cache.size(), 0);
+}
+
+
+TEST(VzdSearchCacheTest, disabledCacheAlwaysSearches)
+{
+    VzdSearchCache cache{0s, 0s};
+    size_t searches = 0;
+    const auto search = [&searches](const std::string&) {
+        ++searches;
+        return searchResult(true);
+    };
+
+    cache.lookup("3-01.2.2023001.16.101.1", search);
+    cache.lookup("3-01.2.2023001.16.101.1", search);
+    EXPECT_EQ(searches, 2);
+    EXPECT_EQ(cache.size(), 0);
+}
+
+
+TEST(VzdSearchCacheTest, fullCacheIsCleared)
+{
+    VzdSearchCache cache{1h, 1h, 2};
+    const auto search = [](const std::string&) {
+        return searchResult(true);
+    };
+
+    cache.lookup("3-01.2.2023001.16.101.1", search);
+    cache.lookup("3-01.2.2023001.16.101.2", search);
+    EXPECT_EQ(cache.size(), 2);
+    cache.lookup("3-01.2.2023001.16.101.3", search);
+    EXPECT_EQ(cache.size(), 1);
+}
+
+
+TEST(VzdSearchCacheTest, concurrentLookupsAreCoalesced)
+{
+    VzdSearchCache cache{1h, 1h};
+    std::atomic<size_t> searches = 0;
+    std::latch searchStarted{1};
+    std::latch waiterStarted{1};
+    const auto search = [&](const std::string&) {
+        ++searches;
+        searchStarted.count_down();
+        waiterStarted.wait();
+        // give the waiting thread time to find the pending search
+        std::this_thread::sleep_for(50ms);
+        return searchResult(true);
+    };
+
+    std::shared_ptr<const model::Bundle> first;
+    std::shared_ptr<const model::Bundle> second;
+    std::thread searching{[&] {
+        first = cache.lookup("3-01.2.2023001.16.101.1", search);
+    }};
+    searchStarted.wait();
+    std::thread waiting{[&] {
+        waiterStarted.count_down();
+        second = cache.lookup("3-01.2.2023001.16.101.1", search);
+    }};
+    searching.join();
+    waiting.join();
+
+    EXPECT_EQ(searches, 1);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, second);
+}
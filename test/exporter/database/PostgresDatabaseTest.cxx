@@ -11,6 +11,7 @@
 #include "mock/hsm/HsmMockFactory.hxx"
 #include "shared/compression/ZStd.hxx"
 #include "test/exporter/database/PostgresDatabaseTest.hxx"
+#include "test/util/EnvironmentVariableGuard.hxx"
 #include "test/util/ResourceTemplates.hxx"
 #include "test/util/TestUtils.hxx"
 
@@ -170,7 +171,7 @@ TEST_F(PostgresDatabaseTest, assignedEpaPrefix)
                     std::nullopt);
 
     database().finalizeKvnr({kvnrHashed(kvnr), std::nullopt, std::nullopt, model::EventKvnr::State::pending, 0},
-                            "epa-as-1.epa4all.de:443");
+                            "epa-as-1.epa4all.de:443", true);
 
     database().commitTransaction();
 
@@ -181,6 +182,63 @@ TEST_F(PostgresDatabaseTest, assignedEpaPrefix)
     EXPECT_STREQ(results.at(0, 0).c_str(), "epa-as-1");
 }
 
+TEST_F(PostgresDatabaseTest, finalizeKvnrConsentChecked)
+{
+    model::Kvnr checkedKvnr{"X000000012"};
+    model::Kvnr reusedKvnr{"X011300023"};
+    // whole seconds, so that the value is not changed by the round trip through the database
+    const model::Timestamp lastConsentCheck{
+        std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now() - std::chrono::minutes{10})};
+    insertTaskKvnr(checkedKvnr, 0, "epa-as-1", lastConsentCheck);
+    insertTaskKvnr(reusedKvnr, 0, "epa-as-1", lastConsentCheck);
+
+    const auto finalizeStart = model::Timestamp::now();
+    database().finalizeKvnr(
+        {kvnrHashed(checkedKvnr), lastConsentCheck, "epa-as-1", model::EventKvnr::State::processing, 0},
+        "epa-as-2.epa4all.de:443", true);
+    // the consent decision has been reused, the time of the last consent check must not be extended
+    database().finalizeKvnr(
+        {kvnrHashed(reusedKvnr), lastConsentCheck, "epa-as-1", model::EventKvnr::State::processing, 0},
+        "epa-as-1.epa4all.de:443", false);
+    database().commitTransaction();
+
+    auto transaction = pqxx::work{getConnection()};
+    const auto query =
+        "SELECT assigned_epa, EXTRACT(EPOCH FROM last_consent_check) FROM erp_event.kvnr WHERE kvnr_hashed = $1";
+    const auto checked = transaction.exec(query, pqxx::params{kvnrHashed(checkedKvnr)});
+    const auto reused = transaction.exec(query, pqxx::params{kvnrHashed(reusedKvnr)});
+    transaction.commit();
+    ASSERT_EQ(checked.size(), 1);
+    EXPECT_STREQ(checked.at(0, 0).c_str(), "epa-as-2");
+    EXPECT_GE(model::Timestamp{checked.at(0, 1).as<double>()} + std::chrono::seconds{1}, finalizeStart);
+    ASSERT_EQ(reused.size(), 1);
+    EXPECT_STREQ(reused.at(0, 0).c_str(), "epa-as-1");
+    EXPECT_EQ(model::Timestamp{reused.at(0, 1).as<double>()}, lastConsentCheck);
+}
+
+TEST_F(PostgresDatabaseTest, resetAssignedEpa)
+{
+    model::Kvnr kvnr{"X000000012"};
+    model::Kvnr otherKvnr{"X011300023"};
+    insertTaskKvnr(kvnr, 0, "epa-as-1");
+    insertTaskKvnr(otherKvnr, 0, "epa-as-1");
+
+    database().resetAssignedEpa({kvnrHashed(kvnr), std::nullopt, "epa-as-1", model::EventKvnr::State::processing, 0});
+    database().commitTransaction();
+
+    auto transaction = pqxx::work{getConnection()};
+    const auto query = "SELECT assigned_epa, state FROM erp_event.kvnr WHERE kvnr_hashed = $1";
+    const auto reset = transaction.exec(query, pqxx::params{kvnrHashed(kvnr)});
+    const auto other = transaction.exec(query, pqxx::params{kvnrHashed(otherKvnr)});
+    transaction.commit();
+    ASSERT_EQ(reset.size(), 1);
+    EXPECT_STREQ(reset.at(0, 0).c_str(), "");
+    // only the assigned ePA is removed
+    EXPECT_STREQ(reset.at(0, 1).c_str(), "processing");
+    ASSERT_EQ(other.size(), 1);
+    EXPECT_STREQ(other.at(0, 0).c_str(), "epa-as-1");
+}
+
 TEST_F(PostgresDatabaseTest, getAllEventsForKvnr)//NOLINT(readability-function-cognitive-complexity)
 {
     model::Kvnr kvnr{"X000000012"};
@@ -262,6 +320,32 @@ TEST_F(PostgresDatabaseTest, getAllEventsForKvnr)//NOLINT(readability-function-c
     database().commitTransaction();
 }
 
+TEST_F(PostgresDatabaseTest, getAllEventsForKvnr_multiplePages)
+{
+    EnvironmentVariableGuard fetchSizeGuard{ConfigurationKey::MEDICATION_EXPORTER_POSTGRES_EVENT_FETCH_SIZE, "2"};
+    model::Kvnr kvnr{"X000000012"};
+    insertTaskKvnr(kvnr);
+    const std::vector useCases{model::TaskEvent::UseCase::providePrescription,
+                               model::TaskEvent::UseCase::cancelPrescription,
+                               model::TaskEvent::UseCase::providePrescription,
+                               model::TaskEvent::UseCase::cancelPrescription,
+                               model::TaskEvent::UseCase::providePrescription};
+    for (const auto useCase : useCases)
+    {
+        insertTaskEvent(kvnr, "160.000.100.000.001.05", useCase, model::TaskEvent::State::pending,
+                        ResourceTemplates::kbvBundleXml(), std::nullopt, mDoctorIdentity, mPharmacyIdentity);
+    }
+
+    model::EventKvnr eventKvnr{kvnrHashed(kvnr), std::nullopt, std::nullopt, model::EventKvnr::State::pending, 0};
+    const auto events = createDbFrontendCommitGuard(TransactionMode::autocommit).db().getAllEventsForKvnr(eventKvnr);
+
+    ASSERT_EQ(events.size(), useCases.size());
+    for (size_t i = 0; i < useCases.size(); ++i)
+    {
+        EXPECT_EQ(events.at(i)->getUseCase(), useCases.at(i)) << "event " << i;
+    }
+}
+
 TEST_F(PostgresDatabaseTest,
        getAllEventsForKvnr_noHealthcareProviderPrescription)//NOLINT(readability-function-cognitive-complexity)
 {
@@ -90,9 +90,15 @@ void MedicationExporterDatabaseFrontendProxy::updateProcessingDelay(std::int32_t
 }
 
 void MedicationExporterDatabaseFrontendProxy::finalizeKvnr(const model::EventKvnr& kvnr,
-                                                           const std::string& assignedEpaPrefix) const
+                                                           const std::string& assignedEpaPrefix,
+                                                           bool consentChecked) const
 {
-    mDatabase->finalizeKvnr(kvnr, assignedEpaPrefix);
+    mDatabase->finalizeKvnr(kvnr, assignedEpaPrefix, consentChecked);
+}
+
+void MedicationExporterDatabaseFrontendProxy::resetAssignedEpa(const model::EventKvnr& kvnr) const
+{
+    mDatabase->resetAssignedEpa(kvnr);
 }
 
 std::optional<std::unique_ptr<model::TRezeptEvent> > MedicationExporterDatabaseFrontendProxy::processNextTRezeptEvent() const
@@ -53,8 +53,10 @@ public:
     MOCK_METHOD(int, markDeadLetter, (const model::TRezeptEvent& eventData), (const, override));
     MOCK_METHOD(void, updateProcessingDelay,
                 (std::int32_t newRetry, std::chrono::seconds delay, const model::EventKvnr& kvnr), (const, override));
-    MOCK_METHOD(void, finalizeKvnr, (const model::EventKvnr& kvnr, const std::string& assignedEpaPrefix),
+    MOCK_METHOD(void, finalizeKvnr,
+                (const model::EventKvnr& kvnr, const std::string& assignedEpaPrefix, bool consentChecked),
                 (const, override));
+    MOCK_METHOD(void, resetAssignedEpa, (const model::EventKvnr& kvnr), (const, override));
 };
 
 class MedicationExporterDatabaseFrontendProxy : public MedicationExporterDatabaseFrontendInterface
@@ -87,7 +89,9 @@ public:
     int markDeadLetter(const model::TRezeptEvent& eventData) const override;
     void updateProcessingDelay(std::int32_t newRetry, std::chrono::seconds delay,
                                const model::EventKvnr& kvnr) const override;
-    void finalizeKvnr(const model::EventKvnr& kvnr, const std::string& assignedEpaPrefix) const override;
+    void finalizeKvnr(const model::EventKvnr& kvnr, const std::string& assignedEpaPrefix,
+                      bool consentChecked) const override;
+    void resetAssignedEpa(const model::EventKvnr& kvnr) const override;
 
 private:
     gsl::not_null<MedicationExporterDatabaseFrontendInterface*> mDatabase;
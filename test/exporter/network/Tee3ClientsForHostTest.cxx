@@ -0,0 +1,320 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "exporter/network/client/Tee3ClientPool.hxx"
+#include "exporter/network/client/Tee3ClientsForHost.hxx"
+#include "mock/hsm/HsmMockFactory.hxx"
+#include "mock/tsl/MockTslManager.hxx"
+#include "shared/deprecated/Timer.hxx"
+#include "shared/hsm/HsmPool.hxx"
+#include "shared/hsm/TeeTokenUpdater.hxx"
+#include "shared/util/Expect.hxx"
+#include "test/mock/MockBlobDatabase.hxx"
+#include "test/util/EnvironmentVariableGuard.hxx"
+#include "test/util/StaticData.hxx"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/use_future.hpp>
+#include <gtest/gtest.h>
+#include <future>
+
+
+/**
+ * The clients connect to a local acceptor that closes every connection right away, so that each connection
+ * attempt is counted and fails in the TLS handshake. A failed pre-warm returns the client to the pool, which is
+ * enough to test the pool management. Clients are taken with acquireInternal, as acquire() insists on a connection.
+ */
+class Tee3ClientsForHostTest : public testing::Test
+{
+public:
+    using Tee3ClientPtr = Tee3ClientsForHost::Tee3ClientPtr;
+    static constexpr auto timeout = std::chrono::seconds{10};
+
+    void SetUp() override
+    {
+        mAcceptor.open(boost::asio::ip::tcp::v4());
+        mAcceptor.bind({boost::asio::ip::make_address("127.0.0.1"), 0});
+        mAcceptor.listen();
+        accept();
+        mHsmPool = std::make_unique<HsmPool>(
+            std::make_unique<HsmMockFactory>(std::make_unique<HsmMockClient>(),
+                                             MockBlobDatabase::createBlobCache(MockBlobCache::MockTarget::MockedHsm)),
+            TeeTokenUpdater::createMockTeeTokenUpdaterFactory(), std::make_shared<Timer>());
+        mTslManager = MockTslManager::createMockTslManager(StaticData::getXmlValidator());
+        mPool = Tee3ClientPool::create(mIoContext, *mHsmPool, *mTslManager, std::chrono::steady_clock::duration::zero());
+    }
+
+    void TearDown() override
+    {
+        resetClientsForHost();
+        mPool.reset();
+        mAcceptor.close();
+        mIoContext.restart();
+        mIoContext.poll();
+    }
+
+    /// released clients are returned asynchronously, wait for them before the owner is destroyed
+    void resetClientsForHost()
+    {
+        if (mClientsForHost)
+        {
+            waitUntilAllAvailable(*mClientsForHost);
+            mClientsForHost.reset();
+        }
+    }
+
+    Tee3ClientsForHost& createClientsForHost(size_t connectionCount)
+    {
+        resetClientsForHost();
+        mClientsForHost = std::make_unique<Tee3ClientsForHost>(
+            mPool, "127.0.0.1", mAcceptor.local_endpoint().port(), connectionCount);
+        const auto ec = runOnStrand(mClientsForHost->init());
+        EXPECT_FALSE(ec.failed()) << ec.message();
+        return *mClientsForHost;
+    }
+
+    template<typename T>
+    T runOnStrand(boost::asio::awaitable<T> awaitable)
+    {
+        auto future = co_spawn(mPool->mStrand, std::move(awaitable), boost::asio::use_future);
+        runUntil([&future] {
+            return future.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+        });
+        return future.get();
+    }
+
+    void maintain(Tee3ClientsForHost& clientsForHost)
+    {
+        runOnStrand([](Tee3ClientsForHost& self) -> boost::asio::awaitable<void> {
+            self.maintain();
+            co_return;
+        }(clientsForHost));
+    }
+
+    Tee3ClientPtr acquire(Tee3ClientsForHost& clientsForHost)
+    {
+        return runOnStrand(clientsForHost.acquireInternal(mPool));
+    }
+
+    /// run the io context until the predicate is true, throws after `timeout`
+    void runUntil(const std::function<bool()>& predicate)
+    {
+        const auto end = std::chrono::steady_clock::now() + timeout;
+        while (! predicate())
+        {
+            Expect3(std::chrono::steady_clock::now() < end, "timeout waiting for the tee client pool",
+                    std::runtime_error);
+            mIoContext.run_one_for(std::chrono::milliseconds{10});
+        }
+    }
+
+    /// wait until all clients have been returned to the pool
+    void waitUntilAllAvailable(const Tee3ClientsForHost& clientsForHost)
+    {
+        runUntil([&clientsForHost] {
+            return clientsForHost.mAvailableClients.size() == clientsForHost.mClientCount;
+        });
+    }
+
+    static size_t clientCount(const Tee3ClientsForHost& clientsForHost)
+    {
+        return clientsForHost.mClientCount;
+    }
+
+    static size_t availableClientCount(const Tee3ClientsForHost& clientsForHost)
+    {
+        return clientsForHost.mAvailableClients.size();
+    }
+
+protected:
+    void accept()
+    {
+        mAcceptor.async_accept([this](const boost::system::error_code& ec, boost::asio::ip::tcp::socket socket) {
+            if (ec.failed())
+            {
+                return;
+            }
+            ++mConnectionAttempts;
+            socket.close();
+            accept();
+        });
+    }
+
+    EnvironmentVariableGuard mMaintenanceInterval{
+        ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_MAINTENANCE_INTERVAL_SECONDS, "0"};
+    EnvironmentVariableGuard mMinConnections{ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_MIN_CONNECTIONS,
+                                             "1"};
+    // the tests only grow the pool when callers wait, unless they lower the threshold themselves
+    EnvironmentVariableGuard mGrowWait{ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_GROW_WAIT_MILLISECONDS,
+                                       "3600000"};
+    boost::asio::io_context mIoContext;
+    boost::asio::ip::tcp::acceptor mAcceptor{mIoContext};
+    size_t mConnectionAttempts = 0;
+    std::unique_ptr<HsmPool> mHsmPool;
+    std::shared_ptr<TslManager> mTslManager;
+    std::shared_ptr<Tee3ClientPool> mPool;
+    std::unique_ptr<Tee3ClientsForHost> mClientsForHost;
+};
+
+
+TEST_F(Tee3ClientsForHostTest, growUnderLoad)
+{
+    auto& clientsForHost = createClientsForHost(3);
+    EXPECT_EQ(clientCount(clientsForHost), 1);
+
+    auto first = acquire(clientsForHost);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(clientCount(clientsForHost), 1);
+    EXPECT_EQ(mConnectionAttempts, 0);
+
+    // no client available, a new one is added and pre-warmed before it is handed out
+    auto second = acquire(clientsForHost);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(clientCount(clientsForHost), 2);
+    EXPECT_GE(mConnectionAttempts, 1);
+
+    auto third = acquire(clientsForHost);
+    ASSERT_NE(third, nullptr);
+    EXPECT_EQ(clientCount(clientsForHost), 3);
+
+    // the maximum is reached, the caller has to wait for a released client
+    auto fourth = co_spawn(mPool->mStrand, clientsForHost.acquireInternal(mPool), boost::asio::use_future);
+    const auto waitEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds{200};
+    while (std::chrono::steady_clock::now() < waitEnd)
+    {
+        mIoContext.run_one_for(std::chrono::milliseconds{10});
+    }
+    ASSERT_EQ(fourth.wait_for(std::chrono::seconds{0}), std::future_status::timeout);
+    EXPECT_EQ(clientCount(clientsForHost), 3);
+
+    first.reset();
+    runUntil([&fourth] {
+        return fourth.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+    });
+    auto fourthClient = fourth.get();
+    EXPECT_NE(fourthClient, nullptr);
+    EXPECT_EQ(clientCount(clientsForHost), 3);
+
+    second.reset();
+    third.reset();
+    fourthClient.reset();
+    waitUntilAllAvailable(clientsForHost);
+    EXPECT_EQ(availableClientCount(clientsForHost), 3);
+}
+
+
+TEST_F(Tee3ClientsForHostTest, closeIdleClients)
+{
+    {
+        // clients that have not been idle for long enough are kept
+        EnvironmentVariableGuard idleTimeout{ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_IDLE_TIMEOUT_SECONDS,
+                                             "3600"};
+        auto& clientsForHost = createClientsForHost(3);
+        std::vector<Tee3ClientPtr> clients;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            clients.emplace_back(acquire(clientsForHost));
+        }
+        clients.clear();
+        waitUntilAllAvailable(clientsForHost);
+        ASSERT_EQ(clientCount(clientsForHost), 3);
+
+        maintain(clientsForHost);
+        waitUntilAllAvailable(clientsForHost);
+        EXPECT_EQ(clientCount(clientsForHost), 3);
+        EXPECT_EQ(availableClientCount(clientsForHost), 3);
+    }
+    {
+        // idle clients are closed down to the minimum
+        EnvironmentVariableGuard idleTimeout{ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_IDLE_TIMEOUT_SECONDS,
+                                             "0"};
+        auto& clientsForHost = createClientsForHost(3);
+        std::vector<Tee3ClientPtr> clients;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            clients.emplace_back(acquire(clientsForHost));
+        }
+        clients.clear();
+        waitUntilAllAvailable(clientsForHost);
+        ASSERT_EQ(clientCount(clientsForHost), 3);
+
+        maintain(clientsForHost);
+        waitUntilAllAvailable(clientsForHost);
+        EXPECT_EQ(clientCount(clientsForHost), 1);
+        EXPECT_EQ(availableClientCount(clientsForHost), 1);
+
+        // the pool grows again on demand
+        auto first = acquire(clientsForHost);
+        auto second = acquire(clientsForHost);
+        EXPECT_NE(second, nullptr);
+        EXPECT_EQ(clientCount(clientsForHost), 2);
+    }
+}
+
+
+TEST_F(Tee3ClientsForHostTest, growAheadAfterLongWaits)
+{
+    EnvironmentVariableGuard growWait{ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_GROW_WAIT_MILLISECONDS,
+                                      "1"};
+    EnvironmentVariableGuard idleTimeout{ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_IDLE_TIMEOUT_SECONDS,
+                                         "0"};
+    auto& clientsForHost = createClientsForHost(2);
+    auto first = acquire(clientsForHost);
+    auto second = acquire(clientsForHost);
+    ASSERT_EQ(clientCount(clientsForHost), 2);
+
+    // the maximum is reached, the caller waits for at least 200ms, which raises the average wait above 1ms
+    auto third = co_spawn(mPool->mStrand, clientsForHost.acquireInternal(mPool), boost::asio::use_future);
+    const auto waitEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds{200};
+    while (std::chrono::steady_clock::now() < waitEnd)
+    {
+        mIoContext.run_one_for(std::chrono::milliseconds{10});
+    }
+    first.reset();
+    runUntil([&third] {
+        return third.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+    });
+    third.get().reset();
+    second.reset();
+    waitUntilAllAvailable(clientsForHost);
+
+    // shrink to the minimum, the average wait is kept
+    maintain(clientsForHost);
+    waitUntilAllAvailable(clientsForHost);
+    ASSERT_EQ(clientCount(clientsForHost), 1);
+
+    // taking the last idle client adds a new one right away, although this caller did not wait
+    auto fourth = acquire(clientsForHost);
+    EXPECT_NE(fourth, nullptr);
+    EXPECT_EQ(clientCount(clientsForHost), 2);
+}
+
+
+TEST_F(Tee3ClientsForHostTest, renewIdleClients)
+{
+    EnvironmentVariableGuard minConnections{ConfigurationKey::MEDICATION_EXPORTER_VAU_HTTPS_CLIENT_MIN_CONNECTIONS,
+                                            "2"};
+    auto& clientsForHost = createClientsForHost(2);
+    ASSERT_EQ(clientCount(clientsForHost), 2);
+    ASSERT_EQ(mConnectionAttempts, 0);
+
+    // the clients are not connected yet, so they are taken out of the pool and connected in the background
+    maintain(clientsForHost);
+    runUntil([this] {
+        return mConnectionAttempts >= 2;
+    });
+    waitUntilAllAvailable(clientsForHost);
+    EXPECT_EQ(clientCount(clientsForHost), 2);
+    EXPECT_EQ(availableClientCount(clientsForHost), 2);
+
+    // the renewed clients can be acquired without growing the pool
+    auto first = acquire(clientsForHost);
+    auto second = acquire(clientsForHost);
+    EXPECT_NE(first, nullptr);
+    EXPECT_NE(second, nullptr);
+    EXPECT_EQ(clientCount(clientsForHost), 2);
+}
@@ -230,3 +230,28 @@ TEST_F(CodeCachingViewTest, cacheValueSetFullKey)
     }
     testing::Mock::VerifyAndClearExpectations(baseView.get());
 }
+
+TEST_F(CodeCachingViewTest, cachedCodesAreIndexed)
+{
+    EXPECT_CALL(*baseView, findCodeSystemCodes).Times(::testing::AnyNumber());
+    EXPECT_CALL(*baseView, findValueSetCodes).Times(::testing::AnyNumber());
+    const auto cachedView = fhirtools::CodeCachingView::create("cached", baseView);
+    {
+        auto codes = cachedView->findCodeSystemCodes(codeSystemV1Key);
+        ASSERT_NE(codes, nullptr);
+        ASSERT_FALSE(codes->caseSensitive());
+        EXPECT_EQ(codes->size(), 2);
+        EXPECT_TRUE(codes->containsCode("CodeSystemV1Code1"));
+        EXPECT_TRUE(codes->containsCode("codesystemv1code2"));
+        EXPECT_FALSE(codes->containsCode("CodeSystemV2Code1"));
+    }
+    {
+        auto codes = cachedView->findValueSetCodes(valueSetV1Key);
+        ASSERT_NE(codes, nullptr);
+        EXPECT_TRUE(codes->containsCode("CodeSystemV1Code1"));
+        EXPECT_TRUE(codes->containsCode("CODESYSTEMV1CODE2", codeSystemV1Key.url));
+        EXPECT_FALSE(codes->containsCode("CodeSystemV1Code2", "http://erp.test/CodeSystem/other"));
+        EXPECT_FALSE(codes->containsCode("CodeSystemV2Code1"));
+    }
+    testing::Mock::VerifyAndClearExpectations(baseView.get());
+}
@@ -0,0 +1,128 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "test/load-test/LoadGenerator.hxx"
+#include "shared/util/Expect.hxx"
+#include "shared/util/String.hxx"
+#include "shared/util/TLog.hxx"
+
+#include <magic_enum/magic_enum.hpp>
+#include <algorithm>
+#include <charconv>
+#include <random>
+#include <thread>
+
+
+std::vector<std::pair<LoadTestScenario, unsigned int>> LoadGenerator::parseMix(std::string_view mix)
+{
+    std::vector<std::pair<LoadTestScenario, unsigned int>> result;
+    for (const auto& item : String::split(mix, ','))
+    {
+        const auto parts = String::split(item, '=');
+        Expect3(parts.size() == 2, "invalid scenario weight, expected <scenario>=<weight>: " + item,
+                std::invalid_argument);
+        const auto scenario = magic_enum::enum_cast<LoadTestScenario>(parts[0]);
+        Expect3(scenario.has_value(), "unknown scenario: " + parts[0], std::invalid_argument);
+        unsigned int weight{};
+        const auto* end = parts[1].data() + parts[1].size();
+        const auto [ptr, ec] = std::from_chars(parts[1].data(), end, weight);
+        Expect3(ec == std::errc{} && ptr == end, "invalid weight: " + parts[1], std::invalid_argument);
+        result.emplace_back(*scenario, weight);
+    }
+    Expect3(std::ranges::any_of(result, [](const auto& item) { return item.second > 0; }),
+            "scenario mix must contain at least one scenario with a weight greater than zero", std::invalid_argument);
+    return result;
+}
+
+
+LoadGenerator::LoadGenerator(Options options)
+    : mOptions(std::move(options))
+{
+    Expect3(mOptions.concurrency > 0, "concurrency must be greater than zero", std::invalid_argument);
+    Expect3(mOptions.mode == Mode::closed || mOptions.rate > 0, "rate must be greater than zero",
+            std::invalid_argument);
+}
+
+
+LoadTestStatistics LoadGenerator::run()
+{
+    std::vector<LoadTestStatistics> workerStatistics(mOptions.concurrency);
+    const auto start = std::chrono::steady_clock::now();
+    const auto end = start + mOptions.duration;
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(mOptions.concurrency);
+        for (auto& statistics : workerStatistics)
+        {
+            workers.emplace_back([this, &statistics, start, end] {
+                runWorker(statistics, start, end);
+            });
+        }
+    }
+    LoadTestStatistics result;
+    for (const auto& statistics : workerStatistics)
+    {
+        result.merge(statistics);
+    }
+    return result;
+}
+
+
+void LoadGenerator::runWorker(LoadTestStatistics& statistics, std::chrono::steady_clock::time_point start,
+                              std::chrono::steady_clock::time_point end)
+{
+    std::vector<unsigned int> weights;
+    for (const auto& item : mOptions.mix)
+    {
+        weights.emplace_back(item.second);
+    }
+    std::mt19937 random(std::random_device{}());
+    std::discrete_distribution<size_t> scenarioDistribution(weights.begin(), weights.end());
+    const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / mOptions.rate));
+
+    LoadTestClient client{statistics};
+    while (true)
+    {
+        std::chrono::steady_clock::time_point scenarioStart;
+        if (mOptions.mode == Mode::open)
+        {
+            scenarioStart = start + static_cast<std::chrono::steady_clock::duration::rep>(mNextScenario++) * interval;
+            if (scenarioStart >= end)
+            {
+                break;
+            }
+            std::this_thread::sleep_until(scenarioStart);
+        }
+        else
+        {
+            scenarioStart = std::chrono::steady_clock::now();
+            if (scenarioStart >= end)
+            {
+                break;
+            }
+        }
+
+        const auto scenario = mOptions.mix[scenarioDistribution(random)].first;
+        bool success = false;
+        try
+        {
+            success = client.runScenario(scenario);
+        }
+        catch (const std::exception& e)
+        {
+            TLOG(WARNING) << "scenario " << magic_enum::enum_name(scenario) << " failed: " << e.what();
+        }
+        statistics.record("scenario " + std::string{magic_enum::enum_name(scenario)},
+                          std::chrono::steady_clock::now() - scenarioStart, success);
+
+        if (mOptions.mode == Mode::closed && mOptions.thinkTime.count() > 0)
+        {
+            std::this_thread::sleep_for(mOptions.thinkTime);
+        }
+    }
+}
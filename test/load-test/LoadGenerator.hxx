@@ -0,0 +1,73 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#ifndef ERP_PROCESSING_CONTEXT_TEST_LOAD_TEST_LOADGENERATOR_HXX
+#define ERP_PROCESSING_CONTEXT_TEST_LOAD_TEST_LOADGENERATOR_HXX
+
+#include "test/load-test/LoadTestClient.hxx"
+#include "test/load-test/LoadTestStatistics.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * Replays a weighted mix of scenarios with a fixed number of workers.
+ *
+ * In closed-loop mode every worker starts the next scenario as soon as the previous one has finished (plus the optional
+ * think time), so the offered load adapts to the latency of the server.
+ * In open-loop mode scenarios are started at a fixed rate independent of the response times. The latency of a scenario
+ * is then measured from its scheduled start, so that the waiting time of scenarios that could not be started in time
+ * because all workers were busy is included.
+ */
+class LoadGenerator
+{
+public:
+    enum class Mode
+    {
+        closed,
+        open
+    };
+
+    struct Options
+    {
+        size_t concurrency{4};
+        std::chrono::seconds duration{60};
+        Mode mode{Mode::closed};
+        /// scenarios per second in open-loop mode
+        double rate{10};
+        /// pause between two scenarios of a worker in closed-loop mode
+        std::chrono::milliseconds thinkTime{0};
+        std::vector<std::pair<LoadTestScenario, unsigned int>> mix{{LoadTestScenario::lifecycle, 1}};
+    };
+
+    /**
+     * Parses a scenario mix like "lifecycle=5,getTasks=3,communication=1,chargeItem=1".
+     * @throws std::invalid_argument on unknown scenarios or invalid weights
+     */
+    static std::vector<std::pair<LoadTestScenario, unsigned int>> parseMix(std::string_view mix);
+
+    explicit LoadGenerator(Options options);
+
+    /**
+     * Runs the load test and returns the merged statistics of all workers.
+     * Besides the single requests, the statistics contain one entry per scenario prefixed with "scenario ".
+     */
+    LoadTestStatistics run();
+
+private:
+    void runWorker(LoadTestStatistics& statistics, std::chrono::steady_clock::time_point start,
+                   std::chrono::steady_clock::time_point end);
+
+    const Options mOptions;
+    std::atomic<uint64_t> mNextScenario{0};
+};
+
+
+#endif
@@ -0,0 +1,229 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "test/load-test/LoadTestClient.hxx"
+#include "shared/util/Expect.hxx"
+#include "shared/util/Mod10.hxx"
+#include "shared/util/TLog.hxx"
+
+#include <iomanip>
+#include <sstream>
+
+
+namespace
+{
+// keeps the number of insurants for the getTasks scenario bounded in long runs
+constexpr size_t maxKnownKvnrs = 1000;
+}
+
+
+LoadTestClient::LoadTestClient(LoadTestStatistics& statistics)
+    : mStatistics(statistics)
+    , mRandom(std::random_device{}())
+{
+}
+
+
+template<typename ActionT>
+auto LoadTestClient::measure(const std::string& operation, ActionT&& action) -> decltype(action())
+{
+    const auto start = std::chrono::steady_clock::now();
+    decltype(action()) result;
+    try
+    {
+        result = action();
+    }
+    catch (const std::exception& e)
+    {
+        TLOG(WARNING) << operation << " failed: " << e.what();
+    }
+    mStatistics.record(operation, std::chrono::steady_clock::now() - start, result.has_value());
+    return result;
+}
+
+
+bool LoadTestClient::runScenario(LoadTestScenario scenario)
+{
+    switch (scenario)
+    {
+        case LoadTestScenario::lifecycle:
+            return lifecycle();
+        case LoadTestScenario::communication:
+            return communication();
+        case LoadTestScenario::chargeItem:
+            return chargeItem();
+        case LoadTestScenario::getTasks:
+            return getTasks();
+    }
+    Fail("invalid value for LoadTestScenario: " + std::to_string(static_cast<uintmax_t>(scenario)));
+}
+
+
+bool LoadTestClient::lifecycle()
+{
+    const auto kvnr = newKvnr();
+    auto task = createActivatedTask(model::PrescriptionType::apothekenpflichigeArzneimittel, kvnr, std::nullopt);
+    if (! task)
+    {
+        return false;
+    }
+    const auto prescriptionId = task->prescriptionId();
+    const std::string accessCode{task->accessCode()};
+    const auto acceptResult = measure("POST /Task/$accept", [&] {
+        return taskAccept(prescriptionId, accessCode);
+    });
+    if (! acceptResult)
+    {
+        return false;
+    }
+    const auto tasks = acceptResult->getResourcesByType<model::Task>("Task");
+    if (tasks.size() != 1 || ! tasks[0].secret().has_value())
+    {
+        return false;
+    }
+    const auto receipt = measure("POST /Task/$close", [&] {
+        return taskClose(prescriptionId, std::string{*tasks[0].secret()}, kvnr);
+    });
+    if (! receipt)
+    {
+        return false;
+    }
+    if (mKnownKvnrs.size() < maxKnownKvnrs)
+    {
+        mKnownKvnrs.emplace_back(kvnr);
+    }
+    return measure("GET /Task", [&] {
+               return taskGet(kvnr);
+           }).has_value();
+}
+
+
+bool LoadTestClient::communication()
+{
+    const auto kvnr = newKvnr();
+    auto task = createActivatedTask(model::PrescriptionType::apothekenpflichigeArzneimittel, kvnr, std::nullopt);
+    if (! task)
+    {
+        return false;
+    }
+    const auto telematikId = jwtApotheke().stringForClaim(JWT::idNumberClaim);
+    if (! telematikId)
+    {
+        return false;
+    }
+    const auto communication = measure("POST /Communication", [&] {
+        return communicationPost(
+            model::Communication::MessageType::DispReq, *task, ActorRole::Insurant, kvnr, ActorRole::Pharmacists,
+            *telematikId,
+            R"({"version": 1, "supplyOptionsType": "onPremise", "hint": "Ist das Medikament bei Ihnen vorrätig?"})");
+    });
+    if (! communication)
+    {
+        return false;
+    }
+    return measure("GET /Communication", [&] {
+               return communicationsGet(JwtBuilder::testBuilder().makeJwtVersicherter(kvnr));
+           }).has_value();
+}
+
+
+bool LoadTestClient::chargeItem()
+{
+    const auto kvnr = newKvnr();
+    const auto consent = measure("POST /Consent", [&] {
+        return consentPost(model::ConsentType::CHARGCONS, kvnr, model::Timestamp::now());
+    });
+    if (! consent)
+    {
+        return false;
+    }
+    auto task = createActivatedTask(model::PrescriptionType::apothekenpflichtigeArzneimittelPkv, kvnr, "PKV");
+    if (! task)
+    {
+        return false;
+    }
+    const auto prescriptionId = task->prescriptionId();
+    const std::string accessCode{task->accessCode()};
+    const auto acceptResult = measure("POST /Task/$accept", [&] {
+        return taskAccept(prescriptionId, accessCode);
+    });
+    if (! acceptResult)
+    {
+        return false;
+    }
+    const auto tasks = acceptResult->getResourcesByType<model::Task>("Task");
+    if (tasks.size() != 1 || ! tasks[0].secret().has_value())
+    {
+        return false;
+    }
+    const std::string secret{*tasks[0].secret()};
+    const auto receipt = measure("POST /Task/$close", [&] {
+        return taskClose(prescriptionId, secret, kvnr);
+    });
+    if (! receipt)
+    {
+        return false;
+    }
+    const auto telematikId = jwtApotheke().stringForClaim(JWT::idNumberClaim);
+    if (! telematikId)
+    {
+        return false;
+    }
+    return measure("POST /ChargeItem", [&] {
+               return chargeItemPost(prescriptionId, kvnr, *telematikId, secret);
+           }).has_value();
+}
+
+
+bool LoadTestClient::getTasks()
+{
+    if (mKnownKvnrs.empty())
+    {
+        // no completed lifecycle yet, fall back to an insurant without tasks
+        mKnownKvnrs.emplace_back(newKvnr());
+    }
+    std::uniform_int_distribution<size_t> index(0, mKnownKvnrs.size() - 1);
+    const auto& kvnr = mKnownKvnrs[index(mRandom)];
+    return measure("GET /Task", [&] {
+               return taskGet(kvnr);
+           }).has_value();
+}
+
+
+std::optional<model::Task> LoadTestClient::createActivatedTask(model::PrescriptionType prescriptionType,
+                                                               const std::string& kvnr,
+                                                               const std::optional<std::string>& coverageInsuranceType)
+{
+    const auto task = measure("POST /Task/$create", [&] {
+        return taskCreate(prescriptionType);
+    });
+    if (! task)
+    {
+        return std::nullopt;
+    }
+    const auto prescriptionId = task->prescriptionId();
+    const std::string accessCode{task->accessCode()};
+    // the QES signature is created by the client and is not part of the measured request
+    const auto qesBundle = std::get<0>(makeQESBundle(kvnr, prescriptionId, model::Timestamp::now(),
+                                                     coverageInsuranceType,
+                                                     coverageInsuranceType.value_or("") == "PKV"));
+    return measure("POST /Task/$activate", [&] {
+        return taskActivateWithOutcomeValidation(prescriptionId, accessCode, qesBundle);
+    });
+}
+
+
+std::string LoadTestClient::newKvnr()
+{
+    // same scheme as ErpWorkflowTestBase::generateNewRandomKVNR, but without checking the server for existing tasks
+    std::uniform_int_distribution<int64_t> distribution(5001, 99999999);
+    std::ostringstream oss;
+    oss << std::setfill('0') << std::setw(8) << distribution(mRandom);
+    const auto numericPart = oss.str();
+    return "X" + numericPart + checksum::mod10<1, 2>("24" + numericPart);
+}
+
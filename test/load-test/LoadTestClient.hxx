@@ -0,0 +1,66 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#ifndef ERP_PROCESSING_CONTEXT_TEST_LOAD_TEST_LOADTESTCLIENT_HXX
+#define ERP_PROCESSING_CONTEXT_TEST_LOAD_TEST_LOADTESTCLIENT_HXX
+
+#include "test/load-test/LoadTestStatistics.hxx"
+#include "test/workflow-test/ErpWorkflowTestFixture.hxx"
+
+#include <random>
+#include <string>
+#include <vector>
+
+enum class LoadTestScenario
+{
+    /// POST /Task/$create, $activate, $accept, $close and GET /Task of the insurant
+    lifecycle,
+    /// POST /Task/$create, $activate, POST /Communication (DispReq) and GET /Communication of the insurant
+    communication,
+    /// POST /Consent, PKV lifecycle up to $close and POST /ChargeItem
+    chargeItem,
+    /// GET /Task for an insurant that has already been used by this client
+    getTasks,
+};
+
+/**
+ * Runs the scenarios of the load test against the server configured for the workflow tests and records the latency
+ * of each VAU request in the statistics. Every instance owns its own connection and VAU protocol state and must only be
+ * used by one thread.
+ */
+class LoadTestClient : public ErpWorkflowTestBase
+{
+public:
+    explicit LoadTestClient(LoadTestStatistics& statistics);
+
+    /**
+     * @returns true if all requests of the scenario succeeded
+     */
+    bool runScenario(LoadTestScenario scenario);
+
+private:
+    bool lifecycle();
+    bool communication();
+    bool chargeItem();
+    bool getTasks();
+
+    /// Creates and activates a task for the insurant, the returned task is empty on failure.
+    std::optional<model::Task> createActivatedTask(model::PrescriptionType prescriptionType, const std::string& kvnr,
+                                                   const std::optional<std::string>& coverageInsuranceType);
+
+    std::string newKvnr();
+
+    template<typename ActionT>
+    auto measure(const std::string& operation, ActionT&& action) -> decltype(action());
+
+    LoadTestStatistics& mStatistics;
+    std::mt19937_64 mRandom;
+    std::vector<std::string> mKnownKvnrs;
+};
+
+
+#endif
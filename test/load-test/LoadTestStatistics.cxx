@@ -0,0 +1,141 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "test/load-test/LoadTestStatistics.hxx"
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <ostream>
+
+
+namespace
+{
+// nearest-rank percentile of sorted samples
+LoadTestStatistics::Duration percentile(const std::vector<LoadTestStatistics::Duration>& sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return {};
+    }
+    const auto rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+double toMilliseconds(LoadTestStatistics::Duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+}
+
+
+void LoadTestStatistics::record(const std::string& operation, Duration latency, bool success)
+{
+    auto& samples = mSamples[operation];
+    samples.latencies.emplace_back(latency);
+    if (! success)
+    {
+        ++samples.errors;
+    }
+}
+
+
+void LoadTestStatistics::merge(const LoadTestStatistics& other)
+{
+    for (const auto& [operation, otherSamples] : other.mSamples)
+    {
+        auto& samples = mSamples[operation];
+        samples.latencies.insert(samples.latencies.end(), otherSamples.latencies.begin(),
+                                 otherSamples.latencies.end());
+        samples.errors += otherSamples.errors;
+    }
+}
+
+
+std::vector<LoadTestStatistics::Summary> LoadTestStatistics::summarize(Duration wallTime) const
+{
+    const auto seconds = std::chrono::duration<double>(wallTime).count();
+    std::vector<Summary> result;
+    for (const auto& [operation, samples] : mSamples)
+    {
+        auto sorted = samples.latencies;
+        std::ranges::sort(sorted);
+        Summary summary{.operation = operation, .count = sorted.size(), .errors = samples.errors};
+        if (! sorted.empty())
+        {
+            summary.throughput = seconds > 0 ? static_cast<double>(sorted.size()) / seconds : 0;
+            summary.mean = std::accumulate(sorted.begin(), sorted.end(), Duration{}) /
+                           static_cast<Duration::rep>(sorted.size());
+            summary.p50 = percentile(sorted, 50);
+            summary.p90 = percentile(sorted, 90);
+            summary.p99 = percentile(sorted, 99);
+            summary.max = sorted.back();
+        }
+        result.emplace_back(std::move(summary));
+    }
+    return result;
+}
+
+
+void LoadTestStatistics::printReport(std::ostream& os, const std::vector<Summary>& summaries, Duration wallTime)
+{
+    os << "duration: " << std::fixed << std::setprecision(1) << std::chrono::duration<double>(wallTime).count()
+       << "s\n";
+    os << std::left << std::setw(32) << "operation" << std::right << std::setw(8) << "count" << std::setw(8)
+       << "errors" << std::setw(10) << "ops/s" << std::setw(10) << "mean ms" << std::setw(10) << "p50 ms"
+       << std::setw(10) << "p90 ms" << std::setw(10) << "p99 ms" << std::setw(10) << "max ms" << '\n';
+    for (const auto& summary : summaries)
+    {
+        os << std::left << std::setw(32) << summary.operation << std::right << std::setw(8) << summary.count
+           << std::setw(8) << summary.errors << std::setw(10) << std::setprecision(2) << summary.throughput
+           << std::setprecision(1) << std::setw(10) << toMilliseconds(summary.mean) << std::setw(10)
+           << toMilliseconds(summary.p50) << std::setw(10) << toMilliseconds(summary.p90) << std::setw(10)
+           << toMilliseconds(summary.p99) << std::setw(10) << toMilliseconds(summary.max) << '\n';
+    }
+}
+
+
+std::string LoadTestStatistics::toJson(const std::vector<Summary>& summaries, Duration wallTime)
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("durationSeconds");
+    writer.Double(std::chrono::duration<double>(wallTime).count());
+    writer.Key("operations");
+    writer.StartArray();
+    for (const auto& summary : summaries)
+    {
+        writer.StartObject();
+        writer.Key("operation");
+        writer.String(summary.operation.c_str());
+        writer.Key("count");
+        writer.Uint64(summary.count);
+        writer.Key("errors");
+        writer.Uint64(summary.errors);
+        writer.Key("throughput");
+        writer.Double(summary.throughput);
+        writer.Key("meanMs");
+        writer.Double(toMilliseconds(summary.mean));
+        writer.Key("p50Ms");
+        writer.Double(toMilliseconds(summary.p50));
+        writer.Key("p90Ms");
+        writer.Double(toMilliseconds(summary.p90));
+        writer.Key("p99Ms");
+        writer.Double(toMilliseconds(summary.p99));
+        writer.Key("maxMs");
+        writer.Double(toMilliseconds(summary.max));
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    return buffer.GetString();
+}
@@ -0,0 +1,63 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#ifndef ERP_PROCESSING_CONTEXT_TEST_LOAD_TEST_LOADTESTSTATISTICS_HXX
+#define ERP_PROCESSING_CONTEXT_TEST_LOAD_TEST_LOADTESTSTATISTICS_HXX
+
+#include <chrono>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Collects latency samples per operation. An instance is not thread safe, each worker of the load generator uses its
+ * own instance and the results are merged at the end of the run.
+ */
+class LoadTestStatistics
+{
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    struct Summary
+    {
+        std::string operation;
+        size_t count{};
+        size_t errors{};
+        double throughput{};
+        Duration mean{};
+        Duration p50{};
+        Duration p90{};
+        Duration p99{};
+        Duration max{};
+    };
+
+    void record(const std::string& operation, Duration latency, bool success);
+
+    void merge(const LoadTestStatistics& other);
+
+    /**
+     * @param wallTime  duration of the run, used to calculate the throughput
+     */
+    std::vector<Summary> summarize(Duration wallTime) const;
+
+    static void printReport(std::ostream& os, const std::vector<Summary>& summaries, Duration wallTime);
+
+    static std::string toJson(const std::vector<Summary>& summaries, Duration wallTime);
+
+private:
+    struct Samples
+    {
+        std::vector<Duration> latencies;
+        size_t errors{};
+    };
+
+    std::map<std::string, Samples> mSamples;
+};
+
+
+#endif
@@ -959,13 +959,14 @@ void MockDatabase::activateTask(const model::PrescriptionId& taskId,
                                 const model::Timestamp& expiryDate,
                                 const model::Timestamp& acceptDate,
                                 const db_model::EncryptedBlob& healthCareProviderPrescription,
+                                const std::optional<db_model::EncryptedBlob>& prescriptionMetadata,
                                 const db_model::EncryptedBlob&,
                                 const model::Timestamp& lastStatusUpdate,
                                 bool euRedeemable, bool isPkv)
 {
     mTasks.at(taskId.type())
         .activateTask(taskId, encryptedKvnr, hashedKvnr, taskStatus, lastModified, expiryDate, acceptDate,
-                      healthCareProviderPrescription, lastStatusUpdate, euRedeemable, isPkv);
+                      healthCareProviderPrescription, prescriptionMetadata, lastStatusUpdate, euRedeemable, isPkv);
 }
 
 void MockDatabase::updateTaskReceipt(const model::PrescriptionId& taskId, const model::Task::Status& taskStatus,
@@ -1153,6 +1154,12 @@ MockDatabase::retrieveTaskForUpdateAndPrescription(const ::model::PrescriptionId
     return mTasks.at(taskId.type()).retrieveTaskForUpdateAndPrescription(taskId);
 }
 
+std::optional<db_model::Task>
+MockDatabase::retrieveTaskForUpdateAndPrescriptionMetadata(const model::PrescriptionId& taskId)
+{
+    return mTasks.at(taskId.type()).retrieveTaskForUpdateAndPrescriptionMetadata(taskId);
+}
+
 std::optional<db_model::Blob> MockDatabase::insertOrReturnAccountSalt(const db_model::HashedId& accountId,
                                                                       db_model::MasterKeyType masterKeyType,
                                                                       BlobId blobId,
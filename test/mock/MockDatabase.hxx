@@ -75,6 +75,7 @@ public:
                       const db_model::HashedKvnr& hashedKvnr, model::Task::Status taskStatus,
                       const model::Timestamp& lastModified, const model::Timestamp& expiryDate,
                       const model::Timestamp& acceptDate, const db_model::EncryptedBlob& healthCareProviderPrescription,
+                      const std::optional<db_model::EncryptedBlob>& prescriptionMetadata,
                       const db_model::EncryptedBlob& doctorIdentity,
                       const model::Timestamp& lastStatusUpdate,
                       bool euRedeemable, bool isPkv);
@@ -122,6 +123,8 @@ public:
     virtual std::optional<db_model::Task> retrieveTaskForUpdate (const model::PrescriptionId& taskId);
     [[nodiscard]] ::std::optional<::db_model::Task>
     virtual retrieveTaskForUpdateAndPrescription(const ::model::PrescriptionId& taskId);
+    virtual std::optional<db_model::Task>
+    retrieveTaskForUpdateAndPrescriptionMetadata(const model::PrescriptionId& taskId);
     virtual std::optional<db_model::Task> retrieveTaskAndReceipt(const model::PrescriptionId& taskId);
     virtual std::optional<db_model::Task> retrieveTaskAndPrescription(const model::PrescriptionId& taskId);
     virtual std::optional<db_model::Task> retrieveTaskWithSecretAndPrescription(const model::PrescriptionId& taskId);
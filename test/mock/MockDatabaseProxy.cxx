@@ -10,6 +10,7 @@
 #include "shared/crypto/CMAC.hxx"
 #include "shared/hsm/HsmClient.hxx"
 #include "test/mock/MockDatabase.hxx"
+#include "test/mock/TestUrlArguments.hxx"
 
 thread_local bool MockDatabaseProxy::TransactionMonitor::inProgress = false;
 
@@ -32,13 +33,15 @@ void MockDatabaseProxy::activateTask(const model::PrescriptionId& taskId, const
                                      const model::Timestamp& lastModified, const model::Timestamp& expiryDate,
                                      const model::Timestamp& acceptDate,
                                      const db_model::EncryptedBlob& healthCareProviderPrescription,
+                                     const std::optional<db_model::EncryptedBlob>& prescriptionMetadata,
                                      const db_model::EncryptedBlob& doctorIdentity,
                                      const model::Timestamp& lastStatusUpdate,
                                      bool euRedeemable, bool isPkv)
 {
     Expect3(transactionMonitor.inProgress, "transaction already committed!", std::logic_error);
     mDatabase->activateTask(taskId, encryptedKvnr, hashedKvnr, taskStatus, lastModified, expiryDate, acceptDate,
-                           healthCareProviderPrescription, doctorIdentity, lastStatusUpdate, euRedeemable, isPkv);
+                           healthCareProviderPrescription, prescriptionMetadata, doctorIdentity, lastStatusUpdate,
+                           euRedeemable, isPkv);
 }
 
 void MockDatabaseProxy::updateTaskReceipt(const model::PrescriptionId& taskId, const model::Task::Status& taskStatus,
@@ -160,6 +163,35 @@ uint64_t MockDatabaseProxy::countAllEgkRedeemableTasks(const db_model::HashedKvn
     return mDatabase->countAllEgkRedeemableTasks(kvnr, search);
 }
 
+std::tuple<std::vector<db_model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+MockDatabaseProxy::retrieveAllTasksForPatientWithTotal(const db_model::HashedKvnr& kvnrHashed,
+                                                       const std::optional<UrlArguments>& search)
+{
+    // Use the virtual single-purpose methods, so that they can be intercepted by derived test classes.
+    auto tasks = retrieveAllTasksForPatient(kvnrHashed, search);
+    const auto total = countAllTasksForPatient(kvnrHashed, search);
+    std::optional<PagingArgument::SeekPosition> nextSeek;
+    if (search.has_value() && search->isKeysetPaging() && ! tasks.empty())
+    {
+        // Emulate the additional row that the database query reads to find out whether there is a next page.
+        auto lastEntry = TestUrlArguments::seekPosition(*search, tasks.back());
+        if (! retrieveAllTasksForPatient(kvnrHashed, TestUrlArguments::withSeek(*search, lastEntry)).empty())
+        {
+            nextSeek.emplace(std::move(lastEntry));
+        }
+    }
+    return {std::move(tasks), total, std::move(nextSeek)};
+}
+
+std::tuple<std::vector<db_model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+MockDatabaseProxy::retrieveAllEgkRedeemableTasksWithAccessCodeAndTotal(const db_model::HashedKvnr& kvnrHashed,
+                                                                       const std::optional<UrlArguments>& search)
+{
+    auto tasks = retrieveAllEgkRedeemableTasksWithAccessCode(kvnrHashed, search);
+    const auto total = countAllEgkRedeemableTasks(kvnrHashed, search);
+    return {std::move(tasks), total, std::nullopt};
+}
+
 std::vector<db_model::Task> MockDatabaseProxy::retrieveAllTasksForEu(const db_model::HashedKvnr& kvnr,
                                                                      const std::optional<UrlArguments>& search)
 {
@@ -249,6 +281,13 @@ MockDatabaseProxy::retrieveTaskForUpdateAndPrescription(const ::model::Prescript
     return mDatabase->retrieveTaskForUpdateAndPrescription(taskId);
 }
 
+std::optional<db_model::Task>
+MockDatabaseProxy::retrieveTaskForUpdateAndPrescriptionMetadata(const model::PrescriptionId& taskId)
+{
+    Expect3(transactionMonitor.inProgress, "transaction already committed!", std::logic_error);
+    return mDatabase->retrieveTaskForUpdateAndPrescriptionMetadata(taskId);
+}
+
 std::string MockDatabaseProxy::storeAuditEventData(db_model::AuditData& auditData)
 {
     Expect3(transactionMonitor.inProgress, "transaction already committed!", std::logic_error);
@@ -56,6 +56,7 @@ public:
                       const db_model::HashedKvnr& hashedKvnr, model::Task::Status taskStatus,
                       const model::Timestamp& lastModified, const model::Timestamp& expiryDate,
                       const model::Timestamp& acceptDate, const db_model::EncryptedBlob& healthCareProviderPrescription,
+                      const std::optional<db_model::EncryptedBlob>& prescriptionMetadata,
                       const db_model::EncryptedBlob& doctorIdentity,
                       const model::Timestamp& lastStatusUpdate,
                       bool euRedeemable, bool isPkv) override;
@@ -101,6 +102,8 @@ public:
     std::optional<db_model::Task> retrieveTaskForUpdate(const model::PrescriptionId& taskId) override;
     [[nodiscard]] ::std::optional<::db_model::Task>
     retrieveTaskForUpdateAndPrescription(const ::model::PrescriptionId& taskId) override;
+    [[nodiscard]] std::optional<db_model::Task>
+    retrieveTaskForUpdateAndPrescriptionMetadata(const model::PrescriptionId& taskId) override;
     std::optional<db_model::Task> retrieveTaskAndReceipt(const model::PrescriptionId& taskId) override;
     std::optional<db_model::Task> retrieveTaskAndPrescription(const model::PrescriptionId& taskId) override;
     std::optional<db_model::Task> retrieveTaskWithSecretAndPrescription(const model::PrescriptionId& taskId) override;
@@ -113,6 +116,12 @@ public:
     uint64_t countAllTasksForPatient(const db_model::HashedKvnr& kvnr,
                                      const std::optional<UrlArguments>& search) override;
     uint64_t countAllEgkRedeemableTasks(const db_model::HashedKvnr& kvnr, const std::optional<UrlArguments>& search) override;
+    std::tuple<std::vector<db_model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+    retrieveAllTasksForPatientWithTotal(const db_model::HashedKvnr& kvnrHashed,
+                                        const std::optional<UrlArguments>& search) override;
+    std::tuple<std::vector<db_model::Task>, uint64_t, std::optional<PagingArgument::SeekPosition>>
+    retrieveAllEgkRedeemableTasksWithAccessCodeAndTotal(const db_model::HashedKvnr& kvnrHashed,
+                                                        const std::optional<UrlArguments>& search) override;
     std::vector<db_model::Task> retrieveAllTasksForEu(const db_model::HashedKvnr& kvnr,
                                                       const std::optional<UrlArguments>& search) override;
     uint64_t countAllTasksForEu(const db_model::HashedKvnr& kvnr, const std::optional<UrlArguments>& search) override;
@@ -159,6 +159,7 @@ void MockTaskTable::activateTask(const model::PrescriptionId& taskId,
                                 const model::Timestamp& expiryDate,
                                 const model::Timestamp& acceptDate,
                                 const db_model::EncryptedBlob& healthCareProviderPrescription,
+                                const std::optional<db_model::EncryptedBlob>& prescriptionMetadata,
                                 const model::Timestamp& lastStatusUpdate,
                                 bool euRedeemable, bool isPkv)
 {
@@ -173,6 +174,7 @@ void MockTaskTable::activateTask(const model::PrescriptionId& taskId,
     taskRow.expiryDate.emplace(expiryDate.localDay(model::Timestamp::GermanTimezone));
     taskRow.acceptDate.emplace(acceptDate.localDay(model::Timestamp::GermanTimezone));
     taskRow.healthcareProviderPrescription = healthCareProviderPrescription;
+    taskRow.prescriptionMetadata = prescriptionMetadata;
     taskRow.isEuRedeemable = euRedeemable;
     taskRow.isPkv = isPkv;
 }
@@ -312,6 +314,7 @@ void MockTaskTable::updateTaskClearPersonalData(const model::PrescriptionId& tas
     taskRow.secret.reset();
     taskRow.owner.reset();
     taskRow.healthcareProviderPrescription.reset();
+    taskRow.prescriptionMetadata.reset();
     taskRow.receipt.reset();
     taskRow.whenHandedOver.reset();
     taskRow.whenPrepared.reset();
@@ -382,7 +385,16 @@ MockTaskTable::retrieveTaskForUpdateAndPrescription(const model::PrescriptionId&
 {
     return select(taskId.toDatabaseId(),
                   {prescription_id, kvnr, last_modified, authored_on, expiry_date, accept_date, status, salt,
-                   task_key_blob_id, access_code, secret, owner, healthcare_provider_prescription, last_medication_dispense,
+                   task_key_blob_id, access_code, secret, owner, healthcare_provider_prescription,
+                   last_medication_dispense, redeemable_by_patient, eu_redeemable, is_pkv});
+}
+
+std::optional<db_model::Task>
+MockTaskTable::retrieveTaskForUpdateAndPrescriptionMetadata(const model::PrescriptionId& taskId)
+{
+    return select(taskId.toDatabaseId(),
+                  {prescription_id, kvnr, last_modified, authored_on, expiry_date, accept_date, status, salt,
+                   task_key_blob_id, access_code, secret, owner, prescription_metadata, last_medication_dispense,
                    redeemable_by_patient, eu_redeemable, is_pkv});
 }
 
@@ -541,6 +553,7 @@ std::optional<db_model::Task> MockTaskTable::select(int64_t databaseId,
     dbTask->owner = fields.count(owner)?t.owner:std::nullopt;
     dbTask->healthcareProviderPrescription =
             fields.count(healthcare_provider_prescription)?t.healthcareProviderPrescription:std::nullopt;
+    dbTask->prescriptionMetadata = fields.count(prescription_metadata)?t.prescriptionMetadata:std::nullopt;
     dbTask->receipt = fields.count(receipt)?t.receipt:std::nullopt;
     dbTask->lastMedicationDispense = fields.count(last_medication_dispense)?t.lastMedicationDispense:std::nullopt;
     dbTask->euRedeemableByPatient = fields.count(redeemable_by_patient) ? t.euRedeemableByPatient : false;
@@ -39,6 +39,7 @@ public:
         std::optional<db_model::EncryptedBlob> secret = std::nullopt;
         std::optional<db_model::EncryptedBlob> owner = std::nullopt;
         std::optional<db_model::EncryptedBlob> healthcareProviderPrescription = std::nullopt;
+        std::optional<db_model::EncryptedBlob> prescriptionMetadata = std::nullopt;
         std::optional<db_model::EncryptedBlob> receipt = std::nullopt;
         std::optional<model::Timestamp> whenHandedOver = std::nullopt;
         std::optional<model::Timestamp> whenPrepared = std::nullopt;
@@ -87,6 +88,7 @@ public:
                       const model::Timestamp& expiryDate,
                       const model::Timestamp& acceptDate,
                       const db_model::EncryptedBlob& healthCareProviderPrescription,
+                      const std::optional<db_model::EncryptedBlob>& prescriptionMetadata,
                       const model::Timestamp& lastStatusUpdate,
                       bool euRedeemable, bool isPkv);
     void updateTaskReceipt(const model::PrescriptionId& taskId, const model::Task::Status& taskStatus,
@@ -133,6 +135,7 @@ public:
     std::optional<db_model::Task> retrieveTaskBasics (const model::PrescriptionId& taskId);
     std::optional<db_model::Task> retrieveTaskAndReceipt(const model::PrescriptionId& taskId);
     ::std::optional<::db_model::Task> retrieveTaskForUpdateAndPrescription(const ::model::PrescriptionId& taskId);
+    std::optional<db_model::Task> retrieveTaskForUpdateAndPrescriptionMetadata(const model::PrescriptionId& taskId);
     std::optional<db_model::Task> retrieveTaskAndPrescription(const model::PrescriptionId& taskId);
     std::optional<db_model::Task> retrieveTaskWithSecretAndPrescription(const model::PrescriptionId& taskId);
     std::optional<db_model::Task> retrieveTaskAndPrescriptionAndReceipt(const model::PrescriptionId& taskId);
@@ -177,6 +180,7 @@ private:
         secret,
         owner,
         healthcare_provider_prescription,
+        prescription_metadata,
         receipt,
         when_handed_over,
         when_prepared,
@@ -70,6 +70,26 @@ namespace {
         return a.id < b.id;
     }
 
+    // Order of keyset paging as the database applies it: the sort key value, which task dates store with
+    // millisecond precision, the prescription type and the prescription id.
+    using KeysetKey = std::tuple<std::chrono::milliseconds, uint8_t, int64_t>;
+
+    KeysetKey keysetKey (const PagingArgument::SeekPosition& position)
+    {
+        return {std::chrono::floor<std::chrono::milliseconds>(position.sortValue.toChronoTimePoint().time_since_epoch()),
+                static_cast<uint8_t>(position.prescriptionType), position.prescriptionDatabaseId};
+    }
+
+    const model::Timestamp& keysetSortValue (const SortArgument& sortArgument, const db_model::Task& task)
+    {
+        return sortArgument.nameDb == "last_modified" ? task.lastModified : task.authoredOn;
+    }
+
+    KeysetKey keysetKey (const SortArgument& sortArgument, const db_model::Task& task)
+    {
+        return keysetKey(PagingArgument::SeekPosition{keysetSortValue(sortArgument, task), task.prescriptionId});
+    }
+
     bool compareTasks(const db_model::Task& taskA,
                       const db_model::Task& taskB,
                       const std::vector<SortArgument>& sortArguments)
@@ -595,7 +615,16 @@ TestUrlArguments::Tasks TestUrlArguments::applySort (TestUrlArguments::Tasks&& t
         std::sort(
             indices.begin(),
             indices.end(),
-            [&](const size_t& a, const size_t&b){return compareTasks(tasks[a], tasks[b], mUrlArguments.mSortArguments);});
+            [&](const size_t& a, const size_t&b){
+                if (mUrlArguments.isKeysetPaging())
+                {
+                    const auto sortArgument = *mUrlArguments.keysetSortArgument();
+                    return sortArgument.order == SortArgument::Order::Increasing
+                               ? keysetKey(sortArgument, tasks[a]) < keysetKey(sortArgument, tasks[b])
+                               : keysetKey(sortArgument, tasks[b]) < keysetKey(sortArgument, tasks[a]);
+                }
+                return compareTasks(tasks[a], tasks[b], mUrlArguments.mSortArguments);
+            });
 
         // Use a brute-force approach to avoid swapping or assignment operator in model::Communication.
         Tasks sortedTasks;
@@ -611,6 +640,17 @@ TestUrlArguments::Tasks TestUrlArguments::applySort (TestUrlArguments::Tasks&& t
 
 TestUrlArguments::Tasks TestUrlArguments::applyPaging (TestUrlArguments::Tasks&& tasks) const
 {
+    const auto& seek = mUrlArguments.mPagingArgument.getSeek();
+    if (seek.has_value() && mUrlArguments.isKeysetPaging())
+    {
+        const auto sortArgument = *mUrlArguments.keysetSortArgument();
+        const auto seekKey = keysetKey(*seek);
+        std::erase_if(tasks, [&](const db_model::Task& task) {
+            const auto key = keysetKey(sortArgument, task);
+            return sortArgument.order == SortArgument::Order::Increasing ? key <= seekKey : key >= seekKey;
+        });
+    }
+
     const auto countArg = mUrlArguments.mPagingArgument.getCount();
     const size_t offset = mUrlArguments.mPagingArgument.getOffset();
     const ptrdiff_t remaining = gsl::narrow<ptrdiff_t>(tasks.size()) - gsl::narrow<ptrdiff_t>(offset);
@@ -628,6 +668,24 @@ TestUrlArguments::Tasks TestUrlArguments::applyPaging (TestUrlArguments::Tasks&&
 }
 
 
+PagingArgument::SeekPosition TestUrlArguments::seekPosition (const UrlArguments& urlArguments,
+                                                            const db_model::Task& task)
+{
+    const auto sortArgument = urlArguments.keysetSortArgument();
+    Expect3(sortArgument.has_value(), "no keyset sort argument", std::logic_error);
+    return PagingArgument::SeekPosition{model::Timestamp{std::chrono::floor<std::chrono::milliseconds>(
+                                            keysetSortValue(*sortArgument, task).toChronoTimePoint())},
+                                        task.prescriptionId};
+}
+
+UrlArguments TestUrlArguments::withSeek (const UrlArguments& urlArguments, const PagingArgument::SeekPosition& seek)
+{
+    UrlArguments nextPage{urlArguments};
+    nextPage.mPagingArgument.setSeek(seek);
+    return nextPage;
+}
+
+
 TestUrlArguments::AuditDataContainer
 TestUrlArguments::applySearch(TestUrlArguments::AuditDataContainer&& auditEvents) const
 {
@@ -68,6 +68,17 @@ public:
     template<class T>
     bool matches (const std::string& parameterName, const std::optional<T>& value) const;
 
+    /**
+     * Return the keyset paging position of `task`, i.e. its sort key value truncated to milliseconds and its
+     * prescription id.
+     */
+    static PagingArgument::SeekPosition seekPosition (const UrlArguments& urlArguments, const db_model::Task& task);
+
+    /**
+     * Return a copy of `urlArguments` that selects the page behind `seek` with keyset paging.
+     */
+    static UrlArguments withSeek (const UrlArguments& urlArguments, const PagingArgument::SeekPosition& seek);
+
 private:
     const UrlArguments& mUrlArguments;
 
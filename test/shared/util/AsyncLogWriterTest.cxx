@@ -0,0 +1,113 @@
+/*
+ * (C) Copyright IBM Deutschland GmbH 2021, 2025
+ * (C) Copyright IBM Corp. 2021, 2025
+ *
+ * non-exclusively licensed to gematik GmbH
+ */
+
+#include "shared/util/AsyncLogWriter.hxx"
+#include "test/util/LogTestBase.hxx"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+
+
+class AsyncLogWriterTest : public testing::Test
+{
+public:
+    void TearDown() override
+    {
+        AsyncLogWriter::instance().stop();
+    }
+
+    std::vector<std::string> linesWithMarker() const
+    {
+        std::vector<std::string> result;
+        std::ranges::copy_if(mSink.lines(), std::back_inserter(result), [](const std::string& line) {
+            return line.find(marker) != std::string::npos;
+        });
+        return result;
+    }
+
+    static void writeRecords(size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            AsyncLogWriter::instance().write(google::GLOG_INFO, __FILE__, __LINE__,
+                                             std::string{marker} + std::to_string(i));
+        }
+    }
+
+    static constexpr std::string_view marker = "AsyncLogWriterTest-";
+    LogTestBase::TestLogSink mSink;
+};
+
+
+TEST_F(AsyncLogWriterTest, writesSynchronouslyWhenNotRunning)
+{
+    ASSERT_FALSE(AsyncLogWriter::instance().isRunning());
+    writeRecords(1);
+    const auto lines = linesWithMarker();
+    ASSERT_EQ(lines.size(), 1);
+    EXPECT_EQ(lines[0], std::string{marker} + "0");
+}
+
+
+TEST_F(AsyncLogWriterTest, writesPendingRecordsOnStop)
+{
+    AsyncLogWriter::instance().start(1000);
+    ASSERT_TRUE(AsyncLogWriter::instance().isRunning());
+    writeRecords(100);
+    AsyncLogWriter::instance().stop();
+    ASSERT_FALSE(AsyncLogWriter::instance().isRunning());
+
+    const auto lines = linesWithMarker();
+    ASSERT_EQ(lines.size(), 100);
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        EXPECT_EQ(lines[i], std::string{marker} + std::to_string(i));
+    }
+}
+
+
+TEST_F(AsyncLogWriterTest, dropsRecordsWhenBufferIsFull)
+{
+    static constexpr size_t recordCount = 1000;
+    const auto droppedBefore = AsyncLogWriter::instance().droppedRecords();
+    AsyncLogWriter::instance().start(1);
+    // the buffer is created per thread, use a new thread to get one with the small capacity
+    std::thread{[] {
+        writeRecords(recordCount);
+    }}.join();
+    AsyncLogWriter::instance().stop();
+
+    const auto dropped = AsyncLogWriter::instance().droppedRecords() - droppedBefore;
+    EXPECT_GT(dropped, 0);
+    EXPECT_EQ(linesWithMarker().size() + dropped, recordCount);
+}
+
+
+TEST_F(AsyncLogWriterTest, noRecordsLostOnConcurrentStop)
+{
+    static constexpr size_t recordCount = 2000;
+    static constexpr size_t threadCount = 4;
+    const auto droppedBefore = AsyncLogWriter::instance().droppedRecords();
+    AsyncLogWriter::instance().start(recordCount);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back([] {
+            writeRecords(recordCount);
+        });
+    }
+    // stop while the threads are still writing, the remaining records are written synchronously
+    AsyncLogWriter::instance().stop();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const auto dropped = AsyncLogWriter::instance().droppedRecords() - droppedBefore;
+    EXPECT_EQ(linesWithMarker().size() + dropped, recordCount * threadCount);
+}
@@ -110,3 +110,66 @@ backend_duration_seconds_bucket{category="enrolment",metric="one",le="+Inf"} 2
     EXPECT_EQ(serialized, expected) << serialized;
 }
 
+
+TEST_F(MetricsRegistryTest, cacheLookups)
+{
+    EXPECT_NO_THROW(MetricsRegistry::instance().countCacheLookup("somecache", true));
+    EXPECT_NO_THROW(MetricsRegistry::instance().countCacheLookup("somecache", true));
+    EXPECT_NO_THROW(MetricsRegistry::instance().countCacheLookup("somecache", false));
+    std::string serialized;
+    ASSERT_NO_THROW(serialized = MetricsRegistry::instance().serialize());
+
+    EXPECT_NE(serialized.find(R"(cache_lookups_total{cache="somecache",result="hit"} 2)"), std::string::npos)
+        << serialized;
+    EXPECT_NE(serialized.find(R"(cache_lookups_total{cache="somecache",result="miss"} 1)"), std::string::npos)
+        << serialized;
+}
+
+TEST_F(MetricsRegistryTest, cacheRefreshes)
+{
+    EXPECT_NO_THROW(MetricsRegistry::instance().countCacheRefresh("somecache", true));
+    EXPECT_NO_THROW(MetricsRegistry::instance().countCacheRefresh("somecache", false));
+    EXPECT_NO_THROW(MetricsRegistry::instance().countCacheRefresh("somecache", false));
+    std::string serialized;
+    ASSERT_NO_THROW(serialized = MetricsRegistry::instance().serialize());
+
+    EXPECT_NE(serialized.find(R"(cache_refreshes_total{cache="somecache",result="success"} 1)"), std::string::npos)
+        << serialized;
+    EXPECT_NE(serialized.find(R"(cache_refreshes_total{cache="somecache",result="failure"} 2)"), std::string::npos)
+        << serialized;
+}
+
+TEST_F(MetricsRegistryTest, droppedLogRecords)
+{
+    EXPECT_NO_THROW(MetricsRegistry::instance().countDroppedLogRecords(3));
+    EXPECT_NO_THROW(MetricsRegistry::instance().countDroppedLogRecords(2));
+    std::string serialized;
+    ASSERT_NO_THROW(serialized = MetricsRegistry::instance().serialize());
+
+    EXPECT_NE(serialized.find("log_records_dropped_total 5"), std::string::npos) << serialized;
+}
+
+TEST_F(MetricsRegistryTest, connectionPool)
+{
+    EXPECT_NO_THROW(MetricsRegistry::instance().observeConnectionPoolWait("somepool", "somehost", 0ms));
+    EXPECT_NO_THROW(MetricsRegistry::instance().observeConnectionPoolWait("somepool", "somehost", 200ms));
+    EXPECT_NO_THROW(MetricsRegistry::instance().observeConnectionHandshake("somepool", "somehost", 300ms, true));
+    EXPECT_NO_THROW(MetricsRegistry::instance().observeConnectionHandshake("somepool", "somehost", 2s, false));
+    std::string serialized;
+    ASSERT_NO_THROW(serialized = MetricsRegistry::instance().serialize());
+
+    EXPECT_NE(serialized.find(R"(connection_pool_wait_seconds_count{host="somehost",pool="somepool"} 2)"),
+              std::string::npos)
+        << serialized;
+    EXPECT_NE(serialized.find(R"(connection_pool_wait_seconds_bucket{host="somehost",pool="somepool",le="0.001"} 1)"),
+              std::string::npos)
+        << serialized;
+    EXPECT_NE(
+        serialized.find(R"(connection_handshake_seconds_count{host="somehost",pool="somepool",result="success"} 1)"),
+        std::string::npos)
+        << serialized;
+    EXPECT_NE(
+        serialized.find(R"(connection_handshake_seconds_count{host="somehost",pool="somepool",result="failure"} 1)"),
+        std::string::npos)
+        << serialized;
+}